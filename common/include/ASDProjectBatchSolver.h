@@ -0,0 +1,214 @@
+#pragma once
+
+#include "Graph.h"
+#include "DotParser.h"
+#include "OutputBuffer.h"
+#include "ASDProjectSolverCache.h"
+
+#include <string>
+#include <iostream>
+#include <mutex>
+
+/**
+* Solves many graphs inside the same process, using a pool of workers that take the jobs from a work-stealing queue.
+* Every worker has its own parser lists, graphs and buffers, which are kept between the jobs so that their memory is reused.
+* Every result is written to its own file inside the output folder or, if no folder is given, to a single stream
+* where the results are written in the same order of the inputs, each followed by a new line.
+* A job that fails writes a line starting with "ERROR:" instead of its result.
+*/
+class ASDProjectBatchSolver
+{
+public:
+	/** The formats used to write the results */
+	enum OutputFormat
+	{
+		OF_Dot,
+		OF_Binary,
+		OF_Delta,
+		OF_DeltaDot
+	};
+
+	typedef List<std::string> PathsList;
+
+private:
+	/** A graph to solve */
+	struct Job
+	{
+		/** Default constructor */
+		Job()
+			: _start(0)
+			, _end(-1)
+			, _completed(false)
+			, _solved(false)
+		{ }
+
+		/** Name of the job, used to name the output file */
+		std::string _name;
+
+		/** Path of the input file. If empty the graph is inside the input stream */
+		std::string _inputFilePath;
+
+		/** Position of the graph inside the input stream */
+		int _start;
+
+		/** Position after the end of the graph inside the input stream or -1 if the graph isn't closed */
+		int _end;
+
+		/** The result waiting for the results of the previous jobs to be written */
+		std::string _result;
+
+		/** True when the job was completed */
+		bool _completed;
+
+		/** True if the graph was solved */
+		bool _solved;
+	};
+
+	/** The state of a worker */
+	struct Worker
+	{
+		/** Default constructor */
+		Worker()
+			: _firstJob(0)
+			, _lastJob(0)
+		{ }
+
+		/** The graph of the current job */
+		Graph _inputGraph;
+
+		/** The result of the current job */
+		Graph _resultGraph;
+
+		/** The lists used by the parser */
+		DotParser::PendingGraph _pendingGraph;
+
+		/** The content of the current input file */
+		std::string _inputContent;
+
+		/** The buffer where the results are written */
+		OutputBuffer _outputBuffer;
+
+		/** The jobs in the range [_firstJob.._lastJob) are the queue of the worker */
+		int _firstJob;
+		int _lastJob;
+
+		/** Protects the queue of the worker, since the other workers can steal its jobs */
+		std::mutex _queueMutex;
+	};
+
+public:
+	/**
+	* Constructor
+	* outputFormat: the format used to write the results
+	* outputFolderPath: the folder where every result is written to its own file. If empty the results are written to the output stream
+	* threadsCount: the number of workers, each one with its own thread (the first worker uses the calling thread)
+	*/
+	ASDProjectBatchSolver(OutputFormat outputFormat = OF_Dot, const std::string& outputFolderPath = "", int threadsCount = 1);
+
+	/** Destructor */
+	~ASDProjectBatchSolver();
+
+private:
+	/** The batch solver can't be copied */
+	ASDProjectBatchSolver(const ASDProjectBatchSolver& src);
+	ASDProjectBatchSolver& operator=(const ASDProjectBatchSolver& src);
+
+public:
+	/**
+	* Solves the graphs of the given DOT or binary graph files, one job for each file
+	* Returns the number of jobs that were completed successfully
+	*/
+	int SolveFiles(const PathsList& inputFilesPaths, std::ostream& output);
+
+	/**
+	* Solves all the DOT graphs written one after the other inside the given stream, one job for each graph
+	* Returns the number of jobs that were completed successfully
+	*/
+	int SolveStream(std::istream& input, std::ostream& output);
+
+	/** Sets the cache used to solve the graphs. If nullptr every graph is solved */
+	void SetCache(ASDProjectSolverCache* cache) { _cache = cache; }
+
+	/** Sets the options (see ASDProjectSolver::Options) used to solve the graphs without the cache. The cache uses the ones it was created with */
+	void SetSolverOptions(int solverOptions) { _solverOptions = solverOptions; }
+
+	/** Returns the number of jobs that failed in the last call to SolveFiles or SolveStream */
+	int GetFailedJobsCount() const { return _failedJobsCount; }
+
+	/** Returns the extension of the files written with the given format */
+	static const char* GetOutputFileExtension(OutputFormat outputFormat);
+
+	/**
+	* Writes the given result graph to the buffer with the given format
+	* If the buffer has an output stream the data is written to it, otherwise the data is kept inside the buffer
+	*/
+	static bool WriteResult(const Graph& resultGraph, OutputFormat outputFormat, OutputBuffer& buffer);
+
+private:
+	/** Solves all the jobs using the workers and returns the number of jobs solved */
+	int SolveJobs(std::ostream& output);
+
+	/** Loop of a worker: takes the jobs from its queue, or steals them from the other workers, until there are no jobs left */
+	void RunWorker(int workerIndex);
+
+	/** Returns the next job for the given worker or -1 if there are no jobs left */
+	int GetNextJob(int workerIndex);
+
+	/** Solves the given job using the state of the given worker */
+	void SolveJob(Worker& worker, int jobIndex);
+
+	/** Loads the graph of the given DOT or binary graph file into the input graph of the worker */
+	bool LoadFile(Worker& worker, const std::string& filePath);
+
+	/** Reads the whole given file into the content of the worker */
+	bool ReadFileContent(Worker& worker, const std::string& filePath);
+
+	/** Writes the result of the job, inside the buffer of the worker, and all the following completed jobs in the same order of the inputs */
+	void EmitResult(Worker& worker, int jobIndex);
+
+	/** Returns the position of the first line that starts a new graph after fromIndex, or the length of the content if there aren't any */
+	static int FindNextGraphStart(const std::string& content, int fromIndex);
+
+private:
+	/** The format used to write the results */
+	OutputFormat _outputFormat;
+
+	/** The folder where the results are written. If empty the results are written to the output stream */
+	std::string _outputFolderPath;
+
+	/** The cache used to solve the graphs, or nullptr */
+	ASDProjectSolverCache* _cache;
+
+	/** The options used to solve the graphs without the cache */
+	int _solverOptions;
+
+	/** The workers */
+	Worker* _workers;
+
+	/** The number of workers */
+	int _workersCount;
+
+	/** The jobs of the current batch */
+	Job* _jobs;
+
+	/** The number of jobs of the current batch */
+	int _jobsCount;
+
+	/** The content of the input stream */
+	std::string _inputContent;
+
+	/** The stream where the results are written if there isn't an output folder */
+	std::ostream* _output;
+
+	/** The index of the next job whose result has to be written to the output stream */
+	int _nextJobToEmit;
+
+	/** Protects the output stream, the completed jobs and the counters */
+	std::mutex _outputMutex;
+
+	/** The number of jobs solved in the current batch */
+	int _solvedJobsCount;
+
+	/** The number of jobs that failed in the current batch */
+	int _failedJobsCount;
+};
\ No newline at end of file
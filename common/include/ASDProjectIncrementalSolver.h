@@ -0,0 +1,213 @@
+#pragma once
+
+#include "Graph.h"
+
+#include <string>
+#include <iostream>
+#include <functional>
+
+/**
+* Solver that keeps the state of the last solved graph so that, after a few edges are inserted or removed, the solution
+* can be updated without solving the whole graph again. The result is always the same of ASDProjectSolver::ProcessData.
+* For every candidate root (node without entrant edges) the solver keeps the number of unreachable nodes and the edges
+* added to reach them. When the graph changes the solver finds the nodes whose reachable nodes have changed: only the
+* candidates for which one of them would make a different edge be chosen are solved again, starting from that edge, while
+* all the other ones reuse the edges found before.
+* An instance must be used by one thread at a time.
+*/
+class ASDProjectIncrementalSolver
+{
+public:
+	/** The type of a change of the graph */
+	enum EdgeChangeType
+	{
+		ECT_Insert,
+		ECT_Remove
+	};
+
+	/** A change of the graph: the edge to insert or to remove */
+	struct EdgeChange
+	{
+		/** Default constructor */
+		EdgeChange(const Graph::NamedEdgeDefinition& edge = Graph::NamedEdgeDefinition(), EdgeChangeType type = ECT_Insert)
+			: _edge(edge)
+			, _type(type)
+		{ }
+
+		/** The nodes of the edge. The nodes of an inserted edge that don't exist are added to the graph */
+		Graph::NamedEdgeDefinition _edge;
+
+		/** If the edge has to be inserted or removed */
+		EdgeChangeType _type;
+	};
+
+	typedef List<EdgeChange> EdgeChangeList;
+
+private:
+	/** The result of a candidate root */
+	struct CandidateResult
+	{
+		/** True if the result was computed and the changes of the graph didn't affect it */
+		bool _valid;
+
+		/** The number of nodes that the candidate can't reach */
+		int _unreachableNodesCount;
+
+		/** The number of edges added to reach all the nodes. If the result isn't valid, the number of added edges that are still valid */
+		int _addedEdgesCount;
+
+		/** The indices of the end nodes of the added edges, in the order they were added, and the number of indices they can store */
+		int* _addedEdges;
+		int _addedEdgesCapacity;
+	};
+
+	/** Address of a node together with its index inside the list of nodes of the graph */
+	struct NodeAddress
+	{
+		/** Comparison by address, used to sort and search the nodes */
+		bool operator<(const NodeAddress& rhs) const { return std::less<const Node*>()(_node, rhs._node); }
+
+		const Node* _node;
+		int _nodeIndex;
+	};
+
+public:
+	/** Default constructor */
+	ASDProjectIncrementalSolver();
+
+	/** Destructor */
+	~ASDProjectIncrementalSolver();
+
+private:
+	/** The solver can't be copied */
+	ASDProjectIncrementalSolver(const ASDProjectIncrementalSolver& src);
+	ASDProjectIncrementalSolver& operator=(const ASDProjectIncrementalSolver& src);
+
+public:
+	/**
+	* Solves the given graph from scratch saving the result into the graph 'result', like ASDProjectSolver::ProcessData does,
+	* and keeps a copy of the graph so that it can be changed by Update
+	*/
+	bool Solve(const Graph& inputGraph, Graph& result, std::ostream& messages);
+
+	/**
+	* Applies the given changes, in order, to the graph of the last call to Solve or Update and saves its solution into the graph 'result'
+	* Inserting an edge that already exists or removing an edge that doesn't exist does nothing
+	*/
+	bool Update(const EdgeChangeList& changes, Graph& result, std::ostream& messages);
+
+	/** Returns the graph with all the changes applied */
+	const Graph& GetGraph() const { return _graph; }
+
+	/** Returns the number of candidate roots that were solved, completely or starting from the edges that were still valid, by the last call to Solve or Update */
+	int GetSolvedCandidatesCount() const { return _solvedCandidatesCount; }
+
+	/** Returns the number of candidate roots whose result was reused by the last call to Update */
+	int GetReusedCandidatesCount() const { return _reusedCandidatesCount; }
+
+private:
+	/** Finds the best root using the results of the candidates, solving the ones that aren't valid, and builds the result */
+	bool SolveCandidates(Graph& result, std::ostream& messages);
+
+	/**
+	* Computes the result of the given candidate root, keeping the added edges that it already has.
+	* The edges are chosen like ASDProjectSolver::FindBestRoot does
+	*/
+	void SolveCandidate(int nodeIndex);
+
+	/**
+	* Returns the number of added edges of the given candidate that would still be chosen after the changes of the graph.
+	* unreachableNodesCount is set to the number of nodes that the candidate can't reach with those edges. The root must not be a changed node
+	*/
+	int GetValidAddedEdgesCount(int nodeIndex, int& unreachableNodesCount);
+
+	/**
+	* Marks as changed the nodes whose reachable nodes change when the edge between the given nodes is inserted or removed.
+	* They are the nodes that reach the start node without reaching the end node. It must be called when the graph doesn't contain the edge
+	* Returns false if inserting the edge would create a cycle
+	*/
+	bool MarkChangedNodes(int startNodeIndex, int endNodeIndex);
+
+	/** Marks with 1 the nodes that can reach the given one, including the node itself */
+	void MarkAncestors(int nodeIndex, unsigned char* marks);
+
+	/** Returns true if the graph contains cycles */
+	bool IsGraphCyclic();
+
+	/** Returns the number of connected components of the undirected graph. The nodes are left colored black */
+	int CountComponents();
+
+	/** Sets the color of all the nodes */
+	void SetNodesColor(Node::NodeColor color);
+
+	/** Colors black the white nodes that can be reached from the given node through white nodes. Returns the number of colored nodes */
+	int MarkReachableNodes(Node* node);
+
+	/** Returns the number of white nodes that can be reached from the given node through white nodes, without changing their color */
+	int CountReachableNodes(Node* node);
+
+	/**
+	* Invalidates the results of the candidates affected by the changed nodes and of the nodes that aren't candidates anymore.
+	* A candidate that isn't changed keeps the added edges that are still chosen, so that only the following ones are chosen again
+	*/
+	void InvalidateAffectedCandidates();
+
+	/** Invalidates the result of the given candidate */
+	void InvalidateCandidate(int nodeIndex);
+
+	/** Invalidates the results of all the candidates */
+	void InvalidateAllCandidates();
+
+	/** Returns the index of the node with the given name. If it doesn't exist it is added if addIfMissing is true, otherwise -1 is returned */
+	int GetNodeIndex(const Graph::NodeDefinition& node, bool addIfMissing);
+
+	/** Returns the index of the given node of the graph */
+	int GetNodeIndex(const Node* node);
+
+	/** Makes sure the arrays of the nodes can store the given number of nodes */
+	void Reserve(int nodesCount);
+
+private:
+	/** The graph with all the changes applied */
+	Graph _graph;
+
+	/** True if the graph contains cycles */
+	bool _cyclic;
+
+	/** The number of nodes of the graph and the number of nodes that the arrays below can store */
+	int _nodesCount;
+	int _nodesCapacity;
+
+	/** The nodes of the graph, by index */
+	Node** _nodes;
+
+	/** The nodes sorted by address, used to find the index of a node. Rebuilt when the number of nodes changes */
+	NodeAddress* _nodesAddresses;
+	int _nodesAddressesCount;
+
+	/** The indices of the start nodes of the edges that enter every node */
+	List<int>* _entrantNodes;
+
+	/** The result of every node as candidate root */
+	CandidateResult* _candidates;
+
+	/** The nodes whose reachable nodes were changed by the last call to Update */
+	unsigned char* _changedNodes;
+	int* _changedNodesIndices;
+	int _changedNodesCount;
+
+	/** Marks and stack used to find the ancestors of the nodes */
+	unsigned char* _startAncestors;
+	unsigned char* _endAncestors;
+	int* _stack;
+
+	/** Stack and visited nodes used to find the reachable nodes */
+	Node** _nodesStack;
+	Node** _visitedNodes;
+
+	/** Statistics of the last call to Solve or Update */
+	int _solvedCandidatesCount;
+	int _reusedCandidatesCount;
+};
+
+template<> struct ContainerElementDefaultValue<ASDProjectIncrementalSolver::EdgeChange> { static ASDProjectIncrementalSolver::EdgeChange Value() { return ASDProjectIncrementalSolver::EdgeChange(); } };
\ No newline at end of file
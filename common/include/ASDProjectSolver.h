@@ -5,25 +5,191 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <atomic>
 
 class ASDProjectSolver
 {
 public:
-	/** Process the data reading the DOT file from the standard input or the input file and returns the result into the 'result' graph */
-	static bool ProcessData(Graph& result, int argc, char *argv[]);
+	/** Options that change how the graphs are solved. They can be combined with the | operator */
+	enum Options
+	{
+		O_None = 0,
 
-	/** Process the data reading the DOT data from the given dotFileContent and returns the result into the 'result' graph */
-	static bool ProcessData(Graph& result, const std::string& dotFileContent);
+		/**
+		* Instead of rejecting a cyclic directed graph, every strongly connected component is condensed into one node and the condensation is solved.
+		* The root is the first node of the chosen component and the added edges go to the first node of the other components
+		*/
+		O_CondenseCycles = 1,
+
+		/** The candidate roots of the weakly connected components of a graph are evaluated on one thread for each core */
+		O_ParallelComponents = 2,
+
+		/** The reachability of the nodes is computed on the transitive reduction of the graph, without the edges implied by other paths. The result doesn't change */
+		O_ReduceTransitiveEdges = 4
+	};
+
+private:
+	/**
+	* A graph split into its weakly connected components, with the nodes given by their index inside the list of nodes of the graph.
+	* The edges added from a root to the nodes of a component don't change the nodes reached inside the other components, so the
+	* candidate roots and the edges added to reach every component are computed for one component at a time
+	*/
+	struct ComponentsGraph
+	{
+		/** Constructor */
+		ComponentsGraph();
+
+		/** Destructor */
+		~ComponentsGraph();
+
+		/** The number of nodes of the graph and the nodes by index */
+		int _nodesCount;
+		Node** _nodes;
+
+		/** The nodes adjacent to the node i are the ones between _adjacentNodes[_adjacencyBegin[i]] and _adjacentNodes[_adjacencyBegin[i + 1]] */
+		int* _adjacencyBegin;
+		int* _adjacentNodes;
+
+		/** 1 for the nodes without entrant edges, which are the candidate roots */
+		unsigned char* _candidates;
+
+		/** The number of components. The nodes of the component c are the ones between _componentsNodes[_componentsBegin[c]] and _componentsNodes[_componentsBegin[c + 1]], in the order of the list of nodes */
+		int _componentsCount;
+		int* _componentsBegin;
+		int* _componentsNodes;
+
+		/** The component of every node */
+		int* _nodesComponents;
+
+		/**
+		* The end nodes of the edges added to reach all the nodes of every component when none of them is reached, in the order they are added, and the
+		* number of nodes reached by every edge. Every component can add at most one edge for each node, so its edges are stored at the position of its nodes
+		*/
+		int* _addedEdgesNodes;
+		int* _addedEdgesGains;
+		int* _addedEdgesCounts;
+
+		/** The candidate of every component that adds the least edges to reach all the nodes of the component (-1 if there isn't one) and the number of edges it adds */
+		int* _bestCandidates;
+		int* _bestCandidatesAddedEdges;
+
+		/** 1 for the nodes reached by the root being evaluated and the last count that visited every node */
+		unsigned char* _reachedNodes;
+		int* _visitStamps;
+
+		/** The components sorted from the largest to the smallest and the next one to solve, used when the components are solved on many threads */
+		int* _componentsOrder;
+		std::atomic<int> _nextComponent;
+
+		/** Set to true when a choice between two equal candidates or two equal added edges was made by the order of the list of nodes */
+		std::atomic<bool> _tiesBrokenByOrder;
+	};
+
+public:
+	/** What ProcessData found while solving a graph besides the result, used by ASDProjectSolverCache to reuse the result for the same graph with the nodes in another order */
+	struct SolutionDetails
+	{
+		/** Constructor */
+		SolutionDetails();
+
+		/** Destructor */
+		~SolutionDetails();
+
+		/**
+		* True if the root or the added edges were chosen between equal ones by the order of the list of nodes, so that the same graph
+		* with the nodes in another order could have a different result
+		*/
+		bool _tiesBrokenByOrder;
+
+		/**
+		* The number of nodes that every added edge makes reachable, in the order the edges were added. The edges are added by decreasing number
+		* and then in the order of their end nodes, so without ties the edges of the same graph with the nodes in another order are sorted again by it
+		*/
+		int* _addedEdgesGains;
+		int _addedEdgesCount;
+
+	private:
+		/** The details can't be copied */
+		SolutionDetails(const SolutionDetails& src);
+		SolutionDetails& operator=(const SolutionDetails& src);
+	};
+
+	/** Process the data reading the DOT or binary graph file from the standard input or the input file and returns the result into the 'result' graph */
+	static bool ProcessData(Graph& result, int argc, char *argv[], int options = O_None);
+
+	/** Process the data reading the DOT or binary graph data from the given fileContent and returns the result into the 'result' graph */
+	static bool ProcessData(Graph& result, const std::string& fileContent);
 
 	/** Process the given graph and solves the project saving the result into the graph 'result' */
 	static bool ProcessData(const Graph& inputGraph, Graph& result);
+
+	/**
+	* Process the given graph and solves the project saving the result into the graph 'result'
+	* The error messages are written to 'messages' so that many graphs can be solved at the same time on different threads
+	* options: a combination of the values of Options
+	* details: if not nullptr, it's filled with the details of the solution (see SolutionDetails)
+	*/
+	static bool ProcessData(const Graph& inputGraph, Graph& result, std::ostream& messages, int options = O_None, SolutionDetails* details = nullptr);
 	
 private:
-	static Node* FindBestRoot(Graph& graph, int& addedEdges);
+	/**
+	* Finds the candidate root (a node without entrant edges) that has to add the least edges to reach all the nodes, and adds them to the graph.
+	* Every time the root adds the edge to the unreachable node that leaves the least unreachable nodes: the first candidate and the first node inside
+	* the list of nodes are chosen when more than one are equal.
+	* details, if not nullptr, is filled with the number of nodes reached by every added edge and tells if one of these choices was made between equal ones.
+	* Returns the root or nullptr if the graph has no candidate or if every candidate would need an edge that closes a cycle
+	*/
+	static Node* FindBestRoot(Graph& graph, int& addedEdges, SolutionDetails* details, std::ostream& messages, int options);
+
+	/**
+	* Solves the cyclic graph 'graph' condensing its strongly connected components, adding the edges to the graph.
+	* The first node of a component depends on the order of the nodes, so the ties of details, if not nullptr, are always counted as broken by the order.
+	* Returns the root or nullptr if the condensation can't be solved
+	*/
+	static Node* FindBestRootOfCondensation(Graph& graph, int& addedEdges, SolutionDetails* details, std::ostream& messages, int options);
 
-	static int AddEdgesToRoot(Graph& graph, Node* root, Graph::NodePointersList& unreachableNodes);
+	/**
+	* Splits the given graph into its weakly connected components with a union-find over its edges.
+	* With O_ReduceTransitiveEdges only the edges of the transitive reduction of the graph are kept
+	*/
+	static void BuildComponentsGraph(Graph& graph, ComponentsGraph& componentsGraph, int options);
+
+	/** Solves the components taken from the shared order of the given graph until there are no components left. Used by every thread */
+	static void RunComponentsWorker(ComponentsGraph& componentsGraph);
+
+	/**
+	* Computes the edges added to reach the nodes of the given component when none of them is reached, and the best candidate of the component.
+	* The candidates are evaluated in order until one adds one edge for each of the other candidates, which is the least possible number.
+	* The candidates that aren't evaluated could add as many edges, so the choice counts as a tie broken by the order
+	*/
+	static void SolveComponent(ComponentsGraph& componentsGraph, int componentIndex, int* stack);
+
+	/**
+	* Chooses the edges that a root adds to reach the nodes of the given component that aren't reached yet, marking them as reached.
+	* The choice stops when the number of added edges reaches addedEdgesLimit, since the root can't be better than another one anymore.
+	* addedEdgesNodes and addedEdgesGains, if not nullptr, are filled with the end nodes of the edges and the number of nodes reached by every edge.
+	* The nodes that reach as many nodes as the chosen one are all chosen next, in any order, if none of them reaches the nodes of the others:
+	* otherwise the choice depends on the order of the nodes and _tiesBrokenByOrder is set.
+	* Returns the number of added edges
+	*/
+	static int ChooseAddedEdges(ComponentsGraph& componentsGraph, int componentIndex, int* stack, int& visitStamp, int addedEdgesLimit, int* addedEdgesNodes, int* addedEdgesGains);
+
+	/** Returns true if all the nodes of the given component are reached */
+	static bool IsComponentReached(const ComponentsGraph& componentsGraph, int componentIndex);
+
+	/** Returns the number of nodes that aren't reached yet that the given node can reach */
+	static int CountUnreachedNodes(ComponentsGraph& componentsGraph, int nodeIndex, int* stack, int visitStamp);
+
+	/** Marks as reached the nodes that the given node can reach. Returns the number of nodes that weren't reached before */
+	static int MarkReachedNodes(ComponentsGraph& componentsGraph, int nodeIndex, int* stack);
 	
 public:
+	/** Reads the DOT or binary graph file from the standard input or the input file into 'inputGraph' */
+	static bool LoadInputGraph(Graph& inputGraph, int argc, char *argv[]);
+
+	/** Reads the DOT or binary graph data from the given fileContent into 'inputGraph' */
+	static bool LoadInputGraph(Graph& inputGraph, const std::string& fileContent);
+
 	/** Method that gets the input file content (both from standard input or from the first argument of the process) */
 	static std::string GetInputFileContent(int argc, char *argv[]);
 
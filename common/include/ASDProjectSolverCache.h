@@ -0,0 +1,200 @@
+#pragma once
+
+#include "Graph.h"
+#include "DotParser.h"
+#include "ASDProjectSolver.h"
+
+#include <cstdint>
+#include <string>
+#include <iostream>
+#include <mutex>
+#include <atomic>
+
+/**
+* Cache of the results of ASDProjectSolver, placed in front of ASDProjectSolver::ProcessData.
+* The results are keyed on a canonical hash of the graph: its type, the sorted names of the nodes and the sorted pairs of names of the edges,
+* so the key doesn't depend on the order of the statements, on the attributes, on the comments, on the whitespaces or on the name of the graph.
+* The key can be computed from the elements found by the parser or from the records of a binary graph, so a hit builds only the result graph.
+* An entry stores the root and the end nodes of the added edges by name. A hit adds them to the graph like the solver does and computes the
+* best paths again, since the edge of the best path of a node depends on the order of the edges.
+* The solver breaks the ties between the roots and between the added edges by the order of the nodes: when it had to, the entry also keeps
+* a hash of the order of the nodes and it's used only by the graphs with the nodes in the same order. A graph with the nodes in another order
+* is solved and its result replaces the entry.
+* The entries are kept in memory and, if a store folder is given, also written to one file for each entry.
+* The methods can be called from many threads at the same time.
+*/
+class ASDProjectSolverCache
+{
+private:
+	/** The result of a graph */
+	struct Entry
+	{
+		/** The hash of the graph */
+		uint64_t _key[2];
+
+		/** The size of the graph, checked together with the key */
+		int _nodesCount;
+		int _edgesCount;
+
+		/** True if the solver broke a tie by the order of the nodes. The entry is used only by the graphs whose nodes have the order with the hash _nodesOrderKey */
+		bool _orderDependent;
+		uint64_t _nodesOrderKey[2];
+
+		/** True if the graph was solved. Otherwise _message contains the error written by the solver */
+		bool _solved;
+		std::string _message;
+
+		/** The name of the root */
+		std::string _root;
+
+		/**
+		* The number of edges added by the solver, the names of their end nodes and the number of nodes that every edge makes reachable,
+		* in the order they were added. Without ties broken by the order they are sorted again for the order of the nodes of the graph
+		*/
+		int _addedEdgesCount;
+		std::string* _addedEdgesNodes;
+		int* _addedEdgesGains;
+
+		/** The last time the entry was used, to remove the oldest entries when the cache is full */
+		unsigned long long _lastUse;
+	};
+
+	/** The key of a graph and its size */
+	struct GraphKey
+	{
+		/** Constructor */
+		GraphKey();
+
+		/** The number of different nodes and the number of edges */
+		int _nodesCount;
+		int _edgesCount;
+
+		/** The canonical hash of the graph */
+		uint64_t _key[2];
+
+		/** The hash of the order of the nodes */
+		uint64_t _nodesOrderKey[2];
+	};
+
+public:
+	/**
+	* Constructor
+	* maxEntriesCount: the maximum number of entries kept in memory (the oldest ones are removed first). 0 means no limit
+	* storeFolderPath: the folder where the entries are stored so that they can be used by other processes. If empty nothing is stored
+	* solverOptions: the options (see ASDProjectSolver::Options) used to solve the graphs. They are part of the key of the entries
+	*/
+	ASDProjectSolverCache(int maxEntriesCount = 0, const std::string& storeFolderPath = "", int solverOptions = 0);
+
+	/** Destructor */
+	~ASDProjectSolverCache();
+
+private:
+	/** The cache can't be copied */
+	ASDProjectSolverCache(const ASDProjectSolverCache& src);
+	ASDProjectSolverCache& operator=(const ASDProjectSolverCache& src);
+
+public:
+	/**
+	* Solves the given graph like ASDProjectSolver::ProcessData, saving the result into the graph 'result'
+	* If the same graph was already solved its result is applied to a copy of the graph without solving it
+	*/
+	bool ProcessData(const Graph& inputGraph, Graph& result, std::ostream& messages);
+
+	/**
+	* Solves the DOT graph that starts at parseIndex inside data, or the binary graph contained inside data, like ASDProjectSolver::ProcessData,
+	* saving the result into the graph 'result'. The key is computed from the elements found by DotParser::ParseElements or from the records
+	* of the binary graph: if the same graph was already solved only 'result' is built, otherwise the graph is built into inputGraph and solved.
+	* parseIndex is moved after the graph like DotParser::Parse does and pendingGraph stores the elements found, so that its arrays can be reused for many graphs.
+	* validInputGraph is set to false if data doesn't contain a valid graph, in which case the error is written to the standard error like the readers do and false is returned
+	*/
+	bool ProcessData(const std::string& data, int& parseIndex, DotParser::PendingGraph& pendingGraph, Graph& inputGraph, Graph& result, std::ostream& messages, bool& validInputGraph);
+
+	/** Returns the number of graphs whose result was found inside the cache */
+	long long GetHitsCount() const { return _hitsCount; }
+
+	/** Returns the number of graphs that were solved */
+	long long GetMissesCount() const { return _missesCount; }
+
+	/** Computes the canonical hash of the given graph */
+	static void ComputeKey(const Graph& graph, uint64_t key[2]);
+
+private:
+	/** Computes the key of the given graph */
+	static void BuildGraphKey(const Graph& graph, GraphKey& graphKey);
+
+	/** Computes the key of the graph found by DotParser::ParseElements */
+	static void BuildPendingGraphKey(const DotParser::PendingGraph& pendingGraph, GraphKey& graphKey);
+
+	/** Computes the key of the given binary graph. Returns false if the data isn't a valid binary graph */
+	static bool BuildBinaryGraphKey(const char* data, size_t dataLength, GraphKey& graphKey);
+
+	/** Adds to the key the options that change the results, so that the same graph has a different entry for each of them */
+	void AddOptionsToKey(GraphKey& graphKey) const;
+
+	/** Returns a copy of the entry that can be used for the graph with the given key, looking inside the memory and then inside the store folder, or nullptr if there isn't one */
+	Entry* GetEntry(const GraphKey& graphKey);
+
+	/** Solves inputGraph saving the result into 'result', and adds the entry of the result to the cache */
+	bool SolveGraph(const Graph& inputGraph, const GraphKey& graphKey, Graph& result, std::ostream& messages);
+
+	/** Creates the entry that describes the solution contained inside result. Returns nullptr if result isn't a solution of the graph */
+	static Entry* CreateEntry(const GraphKey& graphKey, const Graph& result, bool solved, const std::string& message, const ASDProjectSolver::SolutionDetails& details);
+
+	/**
+	* Applies the given entry to result, which contains the graph of the entry, changing it like the solver would
+	* Returns false if the entry doesn't match the graph
+	*/
+	static bool ApplyEntry(const Entry& entry, Graph& result, std::ostream& messages);
+
+	/** Returns the entry with the given key kept in memory, or nullptr if there isn't one */
+	Entry* FindEntry(const GraphKey& graphKey);
+
+	/** Adds the entry to the memory, replacing the entry with the same key or removing the oldest entry if the cache is full */
+	void AddEntry(Entry* entry);
+
+	/** Returns the position of the first entry whose key is not less than the given one */
+	static int FindKeyPosition(Entry* const* entries, int entriesCount, const uint64_t key[2]);
+
+	/** Returns the path of the file of the entry with the given key inside the store folder */
+	std::string GetEntryFilePath(const uint64_t key[2]) const;
+
+	/** Writes the entry to the store folder */
+	bool SaveEntry(const Entry& entry) const;
+
+	/** Reads the entry with the given key from the store folder. Returns nullptr if there isn't one */
+	Entry* LoadEntry(const uint64_t key[2]) const;
+
+	/** Returns a copy of the given entry */
+	static Entry* CopyEntry(const Entry& entry);
+
+	/** Creates an entry without results */
+	static Entry* NewEntry();
+
+	/** Deletes the entry and its values */
+	static void DeleteEntry(Entry* entry);
+
+private:
+	/** The entries kept in memory sorted by key */
+	Entry** _entries;
+	int _entriesCount;
+	int _entriesCapacity;
+
+	/** The maximum number of entries kept in memory. 0 means no limit */
+	int _maxEntriesCount;
+
+	/** The folder where the entries are stored. If empty nothing is stored */
+	std::string _storeFolderPath;
+
+	/** The options used to solve the graphs */
+	int _solverOptions;
+
+	/** Incremented every time an entry is used */
+	unsigned long long _useCounter;
+
+	/** Statistics */
+	std::atomic<long long> _hitsCount;
+	std::atomic<long long> _missesCount;
+
+	/** Protects the entries */
+	std::mutex _mutex;
+};
\ No newline at end of file
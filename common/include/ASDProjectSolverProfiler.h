@@ -0,0 +1,113 @@
+#pragma once
+
+/**
+* Instrumentation of the phases of ASDProjectSolver. The solver marks every phase with ASD_PROFILE_PHASE, which creates a ScopedTimer
+* that adds the time spent inside the scope to the phase. A phase nested inside another one is not counted in the enclosing phase,
+* so the times of the phases add up to the time spent inside the instrumented scopes.
+* The times are kept for every thread, so the graphs solved by other threads don't change them.
+* A thread can also set a reader of counters (e.g. hardware performance counters): their increments are then added to the phases like the times.
+* The timers are compiled only when ASD_PROFILE_SOLVER is defined (the CMake option ASD_PROFILE_SOLVER or "make PROFILE=1"),
+* otherwise ASD_PROFILE_PHASE does nothing and all the times are 0.
+*/
+class ASDProjectSolverProfiler
+{
+public:
+	/** The phases of the solver */
+	enum Phase
+	{
+		/** Copy of the input graph into the result */
+		P_CopyInput,
+
+		/** Check that the graph has no cycles */
+		P_CycleCheck,
+
+		/** Computation of the strongly connected components of a cyclic graph (O_CondenseCycles) */
+		P_Condensation,
+
+		/** Computation of the transitive reduction (O_ReduceTransitiveEdges) */
+		P_TransitiveReduction,
+
+		/** Split of the graph into its weakly connected components */
+		P_Components,
+
+		/** Evaluation of the candidate roots of every component */
+		P_Candidates,
+
+		/** Choice of the edges of the best root and their addition to the graph */
+		P_AddedEdges,
+
+		/** ComputeBestPathsFromRoot on the result */
+		P_BestPaths,
+
+		P_Count
+	};
+
+	/** The maximum number of counters that a reader can read */
+	static const int MaxCountersCount = 8;
+
+	/** Function that stores the current values of the counters into 'values', which has MaxCountersCount elements */
+	typedef void (*CountersReader)(void* context, long long* values);
+
+	/** Adds the time spent inside a scope to a phase of the calling thread, not counting the time of the scopes nested inside it */
+	class ScopedTimer
+	{
+	public:
+		/** Starts measuring the given phase */
+		ScopedTimer(Phase phase);
+
+		/** Adds the time spent since the constructor to the phase */
+		~ScopedTimer();
+
+	private:
+		/** The timer can't be copied */
+		ScopedTimer(const ScopedTimer& src);
+		ScopedTimer& operator=(const ScopedTimer& src);
+
+	private:
+		Phase _phase;
+		double _startTime;
+
+		/** The time spent inside the nested timers */
+		double _nestedTime;
+
+		/** The values of the counters when the timer was created and their increments inside the nested timers */
+		long long _startCounters[MaxCountersCount];
+		long long _nestedCounters[MaxCountersCount];
+
+		/** The timer that was running when this one was created */
+		ScopedTimer* _parent;
+	};
+
+public:
+	/** Returns true if the solver was compiled with the timers */
+	static bool IsEnabled();
+
+	/** Returns the name of the given phase */
+	static const char* GetPhaseName(Phase phase);
+
+	/** Copies the time (in seconds) spent inside every phase by the calling thread since the last call to Reset into 'times', which must contain P_Count elements */
+	static void GetPhaseTimes(double* times);
+
+	/**
+	* Sets the reader of the counters added to the phases by the calling thread, or removes it if reader is nullptr.
+	* The reader is called twice by every timer, so it should be fast. It must not be changed while a timer of the thread is running
+	*/
+	static void SetCountersReader(CountersReader reader, void* context);
+
+	/**
+	* Copies the increments of the counters inside every phase of the calling thread since the last call to Reset into 'counters',
+	* which must contain P_Count * MaxCountersCount elements (the counters of a phase are consecutive)
+	*/
+	static void GetPhaseCounters(long long* counters);
+
+	/** Sets to 0 the times and the counters of the phases of the calling thread */
+	static void Reset();
+};
+
+#ifdef ASD_PROFILE_SOLVER
+#define ASD_PROFILE_PHASE_CONCAT_(name, line) name##line
+#define ASD_PROFILE_PHASE_CONCAT(name, line) ASD_PROFILE_PHASE_CONCAT_(name, line)
+#define ASD_PROFILE_PHASE(phase) ASDProjectSolverProfiler::ScopedTimer ASD_PROFILE_PHASE_CONCAT(profilerScopedTimer, __LINE__)(ASDProjectSolverProfiler::phase)
+#else
+#define ASD_PROFILE_PHASE(phase)
+#endif
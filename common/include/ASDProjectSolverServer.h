@@ -0,0 +1,209 @@
+#pragma once
+
+#include "Graph.h"
+#include "DotParser.h"
+#include "OutputBuffer.h"
+#include "ASDProjectBatchSolver.h"
+#include "ASDProjectSolverCache.h"
+
+#include <string>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+/**
+* Server that keeps the solver running and solves the graphs sent to a local Unix domain socket, so that the
+* clients don't pay the start of the process for every graph.
+* The requests are served by a pool of workers, each one with its own graphs, parser lists and buffers
+* that are kept between the requests so that their memory is reused. A worker serves one request of a connection
+* and gives the connection back: the connections without a request are watched with poll by the thread that accepts
+* them, so the idle clients don't hold a worker. Once a request has started it has to arrive within the request timeout,
+* otherwise its connection is closed and the request counts as failed, so a client that stops in the middle of a request
+* doesn't hold a worker either.
+*
+* Every request and every response starts with a text line ended by '\n'. A connection can send any number of requests:
+*   SOLVE <PayloadLength> [dot|binary|delta|delta-dot]
+*     followed by PayloadLength bytes with a DOT or binary graph. The response is
+*     OK <ResultLength> <Microseconds> followed by the result or
+*     ERROR <MessageLength> <Microseconds> followed by the error message
+*   STATS
+*     the response is OK <Length> 0 followed by the latency statistics of all the requests (and the hits and misses
+*     of the cache if there is one), one "name value" pair per line
+*   QUIT
+*     closes the connection
+*/
+class ASDProjectSolverServer
+{
+public:
+	/** The statistics of the time spent to serve the SOLVE requests */
+	struct LatencyStats
+	{
+		/** The number of buckets of the histogram. The bucket i counts the requests that took less than 2^i microseconds */
+		static const int s_bucketsCount = 40;
+
+		/** Default constructor */
+		LatencyStats();
+
+		/** Adds a request that took the given time */
+		void Add(long long microseconds, bool failed);
+
+		/** Returns an upper bound of the time taken by the given fraction (0..1) of the requests */
+		long long GetPercentile(double fraction) const;
+
+		/** The number of requests */
+		long long _requestsCount;
+
+		/** The number of requests that failed */
+		long long _failedRequestsCount;
+
+		/** The total, minimum and maximum times, in microseconds */
+		long long _totalMicroseconds;
+		long long _minMicroseconds;
+		long long _maxMicroseconds;
+
+		/** Histogram of the times */
+		long long _buckets[s_bucketsCount];
+	};
+
+private:
+	/** The state of a worker, kept between the requests */
+	struct Worker
+	{
+		/** The graph of the current request */
+		Graph _inputGraph;
+
+		/** The result of the current request */
+		Graph _resultGraph;
+
+		/** The lists used by the parser */
+		DotParser::PendingGraph _pendingGraph;
+
+		/** The payload of the current request */
+		std::string _payload;
+
+		/** The buffer where the results are written */
+		OutputBuffer _outputBuffer;
+	};
+
+public:
+	/** The maximum length of the payload of a request */
+	static const long long s_maxPayloadLength = 1LL << 30;
+
+	/** The default time, in milliseconds, given to a request to arrive from its first byte to the last byte of its payload */
+	static const int s_defaultRequestTimeoutMilliseconds = 30000;
+
+	/**
+	* Constructor
+	* threadsCount: the number of workers, which is the number of requests served at the same time
+	* defaultOutputFormat: the format of the results when a SOLVE request doesn't specify it
+	*/
+	ASDProjectSolverServer(int threadsCount = 1, ASDProjectBatchSolver::OutputFormat defaultOutputFormat = ASDProjectBatchSolver::OF_Dot);
+
+	/** Destructor */
+	~ASDProjectSolverServer();
+
+private:
+	/** The server can't be copied */
+	ASDProjectSolverServer(const ASDProjectSolverServer& src);
+	ASDProjectSolverServer& operator=(const ASDProjectSolverServer& src);
+
+public:
+	/**
+	* Listens on the socket with the given path and serves the connections until Stop is called
+	* Returns false if the socket can't be created
+	*/
+	bool Run(const std::string& socketPath);
+
+	/** Sets the cache used to solve the graphs. If nullptr every graph is solved. It must be called before Run */
+	void SetCache(ASDProjectSolverCache* cache) { _cache = cache; }
+
+	/** Sets the options (see ASDProjectSolver::Options) used to solve the graphs without the cache. The cache uses the ones it was created with */
+	void SetSolverOptions(int solverOptions) { _solverOptions = solverOptions; }
+
+	/** Sets the time, in milliseconds, given to a request to arrive from its first byte to the last byte of its payload (< 1: no limit). It must be called before Run */
+	void SetRequestTimeout(int milliseconds) { _requestTimeoutMilliseconds = milliseconds; }
+
+	/** Asks the server to stop. It can be called from a signal handler */
+	void Stop() { _running = false; }
+
+	/** Returns a copy of the latency statistics of the requests served so far */
+	LatencyStats GetStats();
+
+	/** Returns the latency statistics, and the statistics of the cache if there is one, as text, one "name value" pair per line */
+	std::string GetStatsText();
+
+private:
+	/** Loop of a worker: serves one request of the connections waiting in the queue, and gives them back, until the server stops */
+	void RunWorker(int workerIndex);
+
+	/** Gives the connection back to the thread that watches the idle connections, which waits for its next request */
+	void ReturnConnection(int connection);
+
+	/** Serves one request of the given connection. Returns false if the connection has to be closed */
+	bool ServeRequest(Worker& worker, int connection);
+
+	/** Solves the payload of the worker and sends the response. Returns false if the connection has to be closed */
+	bool Solve(Worker& worker, int connection, ASDProjectBatchSolver::OutputFormat outputFormat);
+
+	/** Sends a response with the given status and data. Returns false if the connection has to be closed */
+	bool SendResponse(int connection, const char* status, const char* data, size_t dataLength, long long microseconds);
+
+	/** Counts as failed the request that started at the given time if its deadline has expired, which is why it couldn't be read */
+	void CountExpiredRequest(const std::chrono::steady_clock::time_point& start, const std::chrono::steady_clock::time_point& deadline);
+
+	/** Reads a line ended by '\n', without the '\n'. Returns false if the connection was closed, the deadline expired or the server is stopping */
+	bool ReceiveLine(int connection, std::string& line, const std::chrono::steady_clock::time_point& deadline);
+
+	/** Reads exactly the given number of bytes. Returns false if the connection was closed, the deadline expired or the server is stopping */
+	bool ReceiveData(int connection, char* data, size_t dataLength, const std::chrono::steady_clock::time_point& deadline);
+
+	/** Waits until there is data to read. Returns false if the deadline expired or the server is stopping */
+	bool WaitForData(int connection, const std::chrono::steady_clock::time_point& deadline);
+
+	/** Writes all the given bytes. Returns false on errors */
+	static bool SendData(int connection, const char* data, size_t dataLength);
+
+private:
+	/** The workers */
+	Worker* _workers;
+
+	/** The number of workers */
+	int _workersCount;
+
+	/** The format of the results when a SOLVE request doesn't specify it */
+	ASDProjectBatchSolver::OutputFormat _defaultOutputFormat;
+
+	/** The cache used to solve the graphs, or nullptr */
+	ASDProjectSolverCache* _cache;
+
+	/** The options used to solve the graphs without the cache */
+	int _solverOptions;
+
+	/** The time given to a request to arrive, in milliseconds (< 1: no limit) */
+	int _requestTimeoutMilliseconds;
+
+	/** False when the server has to stop */
+	std::atomic<bool> _running;
+
+	/** The connections with a request that are waiting for a worker */
+	List<int> _pendingConnections;
+
+	/** The connections given back by the workers, that are waiting to be watched again */
+	List<int> _returnedConnections;
+
+	/** Protects the pending and the returned connections */
+	std::mutex _connectionsMutex;
+
+	/** Wakes up the workers when a connection has a request or the server stops */
+	std::condition_variable _connectionsCondition;
+
+	/** The pipe written by the workers to wake up the thread that watches the idle connections */
+	int _wakeUpPipe[2];
+
+	/** The latency statistics */
+	LatencyStats _stats;
+
+	/** Protects the latency statistics */
+	std::mutex _statsMutex;
+};
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+* Layout of the binary graph files written by BinaryGraphWriter and read by BinaryGraphReader.
+*
+* A file is made of, in this order:
+*	- the header
+*	- the table of the nodes (one NodeRecord for each node, in the same order of the list of nodes of the graph)
+*	- the table of the edges (one EdgeRecord for each edge, in the same order of the list of edges of the graph)
+*	- the table of the attributes (the attributes of the nodes first and then the ones of the edges, contiguous for every element)
+*	- the blob of the strings. Every string is stored only once and referenced by offset and length (not null-terminated)
+*
+* All the values are 32 bit unsigned integers stored with the byte order of the machine that wrote the file,
+* so that the records can be copied out of a memory mapped file without conversions.
+*/
+namespace BinaryGraphFormat
+{
+	/** Value that identifies a binary graph file ("ASDG") */
+	static const uint32_t s_magic = 0x47445341;
+
+	/** Value used to check that the file was written with the same byte order of the reading machine */
+	static const uint32_t s_byteOrderMark = 0x01020304;
+
+	/** Version of the format. Increment it every time the layout changes */
+	static const uint32_t s_version = 1;
+
+	/** Flags of the header */
+	static const uint32_t s_graphFlagDirected = 1 << 0;
+	static const uint32_t s_graphFlagEncloseNameInDoubleQuotes = 1 << 1;
+
+	/** Flags of nodes and attributes */
+	static const uint32_t s_flagEncloseNameInDoubleQuotes = 1 << 0;
+	static const uint32_t s_flagEncloseValueInDoubleQuotes = 1 << 1;
+
+	/** Header of the file */
+	struct Header
+	{
+		uint32_t _magic;
+		uint32_t _byteOrderMark;
+		uint32_t _version;
+		uint32_t _flags;
+		uint32_t _nodesCount;
+		uint32_t _edgesCount;
+		uint32_t _attributesCount;
+		uint32_t _stringsBlobSize;
+		uint32_t _nameOffset;
+		uint32_t _nameLength;
+	};
+
+	/** Record of a node */
+	struct NodeRecord
+	{
+		uint32_t _nameOffset;
+		uint32_t _nameLength;
+		uint32_t _flags;
+		uint32_t _firstAttribute;
+		uint32_t _attributesCount;
+	};
+
+	/** Record of an edge. The nodes are given as indices inside the table of the nodes */
+	struct EdgeRecord
+	{
+		uint32_t _startNode;
+		uint32_t _endNode;
+		uint32_t _firstAttribute;
+		uint32_t _attributesCount;
+	};
+
+	/** Record of an attribute */
+	struct AttributeRecord
+	{
+		uint32_t _nameOffset;
+		uint32_t _nameLength;
+		uint32_t _valueOffset;
+		uint32_t _valueLength;
+		uint32_t _flags;
+	};
+}
\ No newline at end of file
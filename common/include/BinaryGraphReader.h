@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Graph.h"
+
+#include <string>
+
+/** Reads a graph written using the binary format described inside BinaryGraphFormat.h */
+class BinaryGraphReader
+{
+public:
+	/** Default constructor */
+	BinaryGraphReader() { }
+
+	/** Destructor */
+	~BinaryGraphReader() { }
+
+public:
+	/** Returns true if the given data starts like a binary graph file */
+	static bool IsBinaryGraph(const char* data, size_t dataLength);
+
+	/** Returns true if the file at the given path is a binary graph file */
+	static bool IsBinaryGraphFile(const std::string& filePath);
+
+	/**
+	* Reads the graph from the given data, which must contain a whole binary graph file. The data can have any alignment
+	* Returns false if the data is not a valid binary graph, in which case the graph is cleared
+	*/
+	static bool Read(Graph& resultGraph, const char* data, size_t dataLength);
+
+	/**
+	* Reads the graph from the file at the given path. Where available the file is memory mapped instead of being copied
+	* Returns false if the file cannot be opened or it is not a valid binary graph (see Read)
+	*/
+	static bool ReadFile(Graph& resultGraph, const std::string& filePath);
+};
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Graph.h"
+
+#include <string>
+
+/** Writes a graph using the binary format described inside BinaryGraphFormat.h */
+class BinaryGraphWriter
+{
+public:
+	/** Default constructor */
+	BinaryGraphWriter() { }
+
+	/** Destructor */
+	~BinaryGraphWriter() { }
+
+public:
+	/** Writes the given graph to the given output stream. The stream must be opened in binary mode */
+	static bool Write(const Graph& graph, std::ostream& output);
+
+	/** Writes the given graph to the file at the given path */
+	static bool WriteFile(const Graph& graph, const std::string& filePath);
+};
\ No newline at end of file
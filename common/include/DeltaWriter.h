@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Graph.h"
+#include "OutputBuffer.h"
+
+/**
+* Writes only the changes made by the ASDProjectSolver to a graph: the root, the number of added edges,
+* the added edges and, for every node reached from the root, the edge of its best path and its distance.
+* The graph must be a result of ASDProjectSolver::ProcessData.
+*/
+class DeltaWriter
+{
+public:
+	/** The formats supported by the writer */
+	enum DeltaFormat
+	{
+		/**
+		* One change for each line:
+		*	root RootName AddedEdgesCount
+		*	added StartNodeName EndNodeName
+		*	path NodeName ParentNodeName Distance
+		* The names are written as in the DOT output (enclosed between double quotes if needed)
+		*/
+		DF_Lines,
+
+		/** A DOT graph that contains only the nodes and the edges changed by the solver, with all their attributes */
+		DF_Dot
+	};
+
+public:
+	/** Default constructor */
+	DeltaWriter() { }
+
+	/** Destructor */
+	~DeltaWriter() { }
+
+public:
+	/** Writes the changes to the given stream using the given format */
+	static bool Write(const Graph& graph, std::ostream& output, DeltaFormat format);
+
+	/** Appends the changes to the given buffer using the given format, without flushing it */
+	static bool Write(const Graph& graph, OutputBuffer& output, DeltaFormat format);
+
+	/** Returns the root chosen by the solver, the node with distance 0 from the root, or nullptr if the graph was not solved */
+	static const Node* GetRoot(const Graph& graph);
+
+	/** Returns true if the given edge is the edge of the best path of one of its nodes */
+	static bool IsEdgeForBestPath(const Edge& edge);
+};
\ No newline at end of file
@@ -29,6 +29,82 @@ class DotParser
 		TOK_NotValid
 	};
 
+public:
+	/** Attribute found while parsing. It's set to its node or edge when the parsed graph is built */
+	struct PendingAttribute
+	{
+		/** Default constructor */
+		PendingAttribute(int target = -1, bool targetIsEdge = false, const GraphElement::Attribute& attribute = GraphElement::Attribute())
+			: _target(target)
+			, _targetIsEdge(targetIsEdge)
+			, _attribute(attribute)
+		{ }
+
+		/** Position of the node or of the edge inside the lists of PendingGraph */
+		int _target;
+
+		/** True if the attribute is of an edge, false if it's of a node */
+		bool _targetIsEdge;
+
+		/** The attribute to set */
+		GraphElement::Attribute _attribute;
+	};
+
+	/**
+	* Type, name, nodes, edges and attributes found while parsing.
+	* They are added to the graph all at once when the parse is completed using the bulk construction methods of Graph.
+	* They are stored inside arrays that are kept by Clear, so a PendingGraph reused for many graphs stops allocating
+	* once it has grown to the largest graph, and the names of the nodes reuse the memory of the previous ones
+	*/
+	struct PendingGraph
+	{
+		/** Default constructor */
+		PendingGraph();
+
+		/** Destructor */
+		~PendingGraph();
+
+		/** Removes all the elements keeping the arrays */
+		void Clear();
+
+		/** Adds a node and returns its position */
+		int AddNode(const std::string& name, bool encloseNameInDoubleQuotes);
+
+		/** Adds an edge between the nodes at the given positions and returns its position */
+		int AddEdge(int startNodePosition, int endNodePosition);
+
+		/** Adds an attribute of the node or of the edge at the given position */
+		void AddAttribute(int target, bool targetIsEdge, const GraphElement::Attribute& attribute);
+
+		/** The type of the graph */
+		Graph::GraphType _graphType;
+
+		/** The name of the graph, if _named is true */
+		bool _named;
+		std::string _name;
+		bool _encloseNameInDoubleQuotes;
+
+		/** Every node found (both from node and edge declarations) in the order they were found */
+		Graph::NodeDefinition* _nodes;
+		int _nodesCount;
+		int _nodesCapacity;
+
+		/** Every edge found. The indices of the nodes are positions inside _nodes */
+		Graph::EdgeDefinition* _edges;
+		int _edgesCount;
+		int _edgesCapacity;
+
+		/** Every attribute found for the nodes and edges, in the order they were found */
+		PendingAttribute* _attributes;
+		int _attributesCount;
+		int _attributesCapacity;
+
+	private:
+		/** The pending graph can't be copied */
+		PendingGraph(const PendingGraph& src);
+		PendingGraph& operator=(const PendingGraph& src);
+	};
+
 public:
 	/** Default constructor */
 	DotParser() { }
@@ -39,9 +115,39 @@ public:
 public:
 	static bool Parse(Graph& resultGraph, const std::string& dotDefinition);
 
+	/**
+	* Parses the graph that starts at parseIndex inside dotDefinition, which can contain many graphs one after the other.
+	* When the function returns parseIndex is after the closing bracket of the parsed graph.
+	* pendingGraph is cleared and used to store the elements found, so that its lists can be reused for many graphs
+	*/
+	static bool Parse(Graph& resultGraph, const std::string& dotDefinition, int& parseIndex, PendingGraph& pendingGraph);
+
+	/**
+	* Parses the graph that starts at parseIndex inside dotDefinition like Parse, storing its elements inside pendingGraph without building any graph.
+	* The elements can be read before the graph is built with BuildGraph, like ASDProjectSolverCache does to compute its key
+	*/
+	static bool ParseElements(const std::string& dotDefinition, int& parseIndex, PendingGraph& pendingGraph);
+
+	/** Adds the elements found by ParseElements to the given graph, setting its type and name. Returns false if the elements aren't a valid graph */
+	static bool BuildGraph(Graph& graph, const PendingGraph& pendingGraph);
+
+	/**
+	* Skips the spaces and the comments starting from parseIndex inside dotDefinition
+	* Returns true if something else follows, which should be another graph
+	*/
+	static bool HasMoreGraphs(const std::string& dotDefinition, int& parseIndex);
+
+	/**
+	* Finds the end of the graph that starts at parseIndex inside dotDefinition without parsing it, looking for the bracket
+	* that closes the first open one while skipping comments and IDs enclosed between double quotes.
+	* Returns the position after the closing bracket or -1 if the graph isn't closed
+	*/
+	static int FindGraphEnd(const std::string& dotDefinition, int parseIndex);
+
 private:
 	static bool ParseID(std::string& id, bool& enclosedWithDoubleQuotes, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber);
-	static bool ParseStatementList(Graph& graph, bool bracketAlreadyFound, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber);
+
+	static bool ParseStatementList(Graph::GraphType graphType, PendingGraph& pendingGraph, bool bracketAlreadyFound, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber);
 
 	static bool MoveToFirstOccurenceOfChar(char c, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber);
 
@@ -53,7 +159,7 @@ private:
 
 	static bool ReadComment(std::string& result, bool singleLine, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber);
 
-	static bool ParseAttributesList(GraphElement* singleElement, List<GraphElement*>* elements, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber);
+	static bool ParseAttributesList(PendingGraph* pendingGraph, bool targetsAreEdges, int firstTarget, int targetsCount, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber);
 
-	static bool ParseEdgeList(Graph& graph, const std::string& firstNodeId, bool firstNodeIdBetweenDoubleQuotes, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber);
-};
\ No newline at end of file
+	static bool ParseEdgeList(Graph::GraphType graphType, PendingGraph& pendingGraph, const std::string& firstNodeId, bool firstNodeIdBetweenDoubleQuotes, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber);
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Graph.h"
+#include "OutputBuffer.h"
 
 //#include <fstream>
 //#include <sstream>
@@ -17,4 +18,24 @@ public:
 		
 public:
 	static bool Write(const Graph& graph, std::ostream& output);
+
+	/** Writes the graph to the given stream formatting it inside the given buffer, which can be reused for many graphs */
+	static bool Write(const Graph& graph, std::ostream& output, OutputBuffer& buffer);
+
+	/** Appends the graph to the given buffer without flushing it */
+	static bool Write(const Graph& graph, OutputBuffer& output);
+
+	/**
+	* Writes the graph to the given stream formatting disjoint ranges of nodes and edges on different threads.
+	* The output is the same of Write. Small graphs are written using less threads or sequentially
+	* threadsCount: the number of threads to use, including the calling one
+	*/
+	static bool WriteParallel(const Graph& graph, std::ostream& output, int threadsCount);
+
+	/** Same as WriteParallel, but the graph declaration is formatted inside the given buffer, which can be reused for many graphs */
+	static bool WriteParallel(const Graph& graph, std::ostream& output, OutputBuffer& buffer, int threadsCount);
+
+private:
+	/** Minimum number of nodes and edges formatted by a thread of WriteParallel */
+	static const int s_minimumElementsPerThread = 16384;
 };
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Graph.h"
+
+#include <functional>
+
+/**
+* Keeps the best paths from a root, the ones computed by Graph::ComputeBestPathsFromRoot, up to date while edges are added to
+* or removed from the graph, so that the effect of an edge can be tried on a solved graph without computing all the paths again.
+* Every edge has weight 1 and only the nodes whose best path can change are visited, like the algorithm of Ramalingam and Reps does:
+*	- an inserted edge updates the nodes that it brings closer to the root
+*	- a removed edge that was a best edge updates the nodes whose best path passed through it. A node that has another entrant edge
+*	  from a node at the same distance only changes its best edge, the other ones get the distance from their best unaffected entrant node
+* The distances, the best edges, the labels of the nodes and the "dashed" style of the best edges are kept as ComputeBestPathsFromRoot sets them.
+* When a node has more than one best edge the one chosen may differ from the one that a new call to ComputeBestPathsFromRoot would choose.
+* While the graph is attached its edges must be changed only through this class. Nodes can be added to the graph at any time
+*/
+class DynamicBestPaths
+{
+private:
+	/** Address of a node together with its index inside the list of nodes of the graph */
+	struct NodeAddress
+	{
+		/** Comparison by address, used to sort and search the nodes */
+		bool operator<(const NodeAddress& rhs) const { return std::less<const Node*>()(_node, rhs._node); }
+
+		const Node* _node;
+		int _nodeIndex;
+	};
+
+public:
+	/** Default constructor */
+	DynamicBestPaths();
+
+	/** Destructor */
+	~DynamicBestPaths();
+
+private:
+	/** The best paths can't be copied */
+	DynamicBestPaths(const DynamicBestPaths& src);
+	DynamicBestPaths& operator=(const DynamicBestPaths& src);
+
+public:
+	/**
+	* Computes the best paths of the given graph from the given root with Graph::ComputeBestPathsFromRoot and keeps them up to date from now on.
+	* If the graph was solved from the same root the paths are the same it already has.
+	* Returns false if the root isn't a node of the graph
+	*/
+	bool Attach(Graph& graph, Node* root);
+
+	/** Stops keeping the best paths of the attached graph up to date */
+	void Detach();
+
+	/**
+	* Adds an edge to the attached graph, like Graph::AddEdge does, and updates the best paths of the nodes that it brings closer to the root.
+	* Returns the new edge or nullptr if it can't be added
+	*/
+	Edge* AddEdge(Node* startNode, Node* endNode);
+
+	/**
+	* Removes the given edge from the attached graph and updates the best paths that passed through it.
+	* Returns false if the edge isn't an edge of the graph
+	*/
+	bool RemoveEdge(Edge* edge);
+
+	/** Returns the attached graph, or nullptr */
+	Graph* GetGraph() const { return _graph; }
+
+	/** Returns the root of the best paths, or nullptr */
+	Node* GetRoot() const { return _root; }
+
+	/** Returns the number of nodes whose best path was changed by the last call to AddEdge or RemoveEdge */
+	int GetUpdatedNodesCount() const { return _updatedNodesCount; }
+
+private:
+	/** Relaxes the given edge that goes from the node 'startNodeIndex' and updates the nodes that get closer to the root, in breadth-first order */
+	void InsertBestPaths(Edge* edge, int startNodeIndex, int endNodeIndex);
+
+	/** Updates the best paths of the subtree of the given node, whose best edge was removed */
+	void RemoveBestPaths(int nodeIndex);
+
+	/** Sets the best edge and the distance of the given node, moving the dashed style to the new edge and updating the label of the node */
+	void SetBestPath(int nodeIndex, Edge* edge, int distance);
+
+	/** Adds the nodes that were added to the graph after the last call to this method */
+	void AddNewNodes();
+
+	/** Returns the index of the given node or -1 if it isn't a node of the graph */
+	int GetNodeIndex(const Node* node);
+
+	/** Makes sure the arrays of the nodes can store the given number of nodes */
+	void Reserve(int nodesCount);
+
+private:
+	/** The attached graph */
+	Graph* _graph;
+
+	/** The root of the best paths */
+	Node* _root;
+
+	/** The number of nodes of the graph and the number of nodes that the arrays below can store */
+	int _nodesCount;
+	int _nodesCapacity;
+
+	/** The nodes of the graph, by index */
+	Node** _nodes;
+
+	/** The nodes sorted by address, used to find the index of a node. Rebuilt when the number of nodes changes */
+	NodeAddress* _nodesAddresses;
+	int _nodesAddressesCount;
+
+	/** The edges that enter and the edges that leave every node. If the graph is not directed both contain all the edges of the node */
+	Graph::EdgePointersList* _entrantEdges;
+	Graph::EdgePointersList* _exitingEdges;
+
+	/** The state of the nodes while a removed edge is processed: 0 not affected, 1 affected, 2 affected and with its new best path */
+	unsigned char* _marks;
+
+	/** The new distance and best edge of the affected nodes */
+	int* _distances;
+	Edge** _edges;
+
+	/** The queue of the nodes to visit, the affected nodes and the affected nodes sorted by distance */
+	int* _queue;
+	int* _affectedNodes;
+	int* _sortedNodes;
+
+	/** The number of nodes whose best path was changed by the last call to AddEdge or RemoveEdge */
+	int _updatedNodesCount;
+};
\ No newline at end of file
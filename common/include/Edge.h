@@ -7,12 +7,16 @@
 class Node;
 class Graph;
 class ASDProjectSolver;
+class ASDProjectSolverCache;
+class ASDProjectIncrementalSolver;
 
 class Edge : public GraphElement
 {
 	friend ContainerElementDefaultValue<Edge>;
 	friend Graph;
 	friend ASDProjectSolver;
+	friend ASDProjectSolverCache;
+	friend ASDProjectIncrementalSolver;
 
 protected:
 	/**
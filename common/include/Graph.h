@@ -7,15 +7,111 @@
 #include <string>
 
 class ASDProjectSolver;
+class ASDProjectSolverCache;
+class ASDProjectIncrementalSolver;
+class DynamicBestPaths;
+class BinaryGraphReader;
 
 class Graph
 {
 	friend ASDProjectSolver;
+	friend ASDProjectSolverCache;
+	friend ASDProjectIncrementalSolver;
+	friend DynamicBestPaths;
+	friend BinaryGraphReader;
 
 public:
 	typedef List<Edge> EdgeList;
 	typedef List<Node> NodeList;
 	typedef List<Node*, ContainerDefaultElementDestructor<Node*>, false> NodePointersList;
+	typedef List<Edge*, ContainerDefaultElementDestructor<Edge*>, false> EdgePointersList;
+
+	/** Definition of a node used by the bulk construction methods (see Graph::AddNodes) */
+	struct NodeDefinition
+	{
+		/** Default constructor */
+		NodeDefinition(const std::string& name = "", bool encloseNameInDoubleQuotes = false)
+			: _name(name)
+			, _encloseNameInDoubleQuotes(encloseNameInDoubleQuotes)
+		{ }
+
+		/** Name of the node */
+		std::string _name;
+
+		/** If true then a writer needs to enclose the name of the node between double quotes */
+		bool _encloseNameInDoubleQuotes;
+	};
+
+	/** Definition of an edge given by the indices of its nodes inside the list of nodes of the graph (see Graph::AddEdges) */
+	struct EdgeDefinition
+	{
+		/** Default constructor */
+		EdgeDefinition(int startNodeIndex = -1, int endNodeIndex = -1)
+			: _startNodeIndex(startNodeIndex)
+			, _endNodeIndex(endNodeIndex)
+		{ }
+
+		/** Index of the start node of the edge */
+		int _startNodeIndex;
+
+		/** Index of the end node of the edge */
+		int _endNodeIndex;
+	};
+
+	/** Definition of an edge given by the names of its nodes (see Graph::AddEdges) */
+	struct NamedEdgeDefinition
+	{
+		/** Default constructor */
+		NamedEdgeDefinition(const NodeDefinition& startNode = NodeDefinition(), const NodeDefinition& endNode = NodeDefinition())
+			: _startNode(startNode)
+			, _endNode(endNode)
+		{ }
+
+		/** Definition of the start node of the edge */
+		NodeDefinition _startNode;
+
+		/** Definition of the end node of the edge */
+		NodeDefinition _endNode;
+	};
+
+	typedef List<NodeDefinition> NodeDefinitionList;
+	typedef List<EdgeDefinition> EdgeDefinitionList;
+	typedef List<NamedEdgeDefinition> NamedEdgeDefinitionList;
+
+	/** The memory used by a graph, in bytes, divided by what it stores (see Graph::GetMemoryFootprint) */
+	struct MemoryFootprint
+	{
+		/** Default constructor */
+		MemoryFootprint()
+			: _graphBytes(0)
+			, _nodesBytes(0)
+			, _edgesBytes(0)
+			, _adjacencyBytes(0)
+			, _attributesBytes(0)
+			, _freeListSlackBytes(0)
+		{ }
+
+		/** Returns the total number of bytes */
+		long long GetTotal() const { return _graphBytes + _nodesBytes + _edgesBytes + _adjacencyBytes + _attributesBytes + _freeListSlackBytes; }
+
+		/** The graph object and the memory of its name */
+		long long _graphBytes;
+
+		/** The items of the list of nodes that are in use and the memory of the names of the nodes */
+		long long _nodesBytes;
+
+		/** The items of the list of edges that are in use */
+		long long _edgesBytes;
+
+		/** The items of the lists of adjacent nodes that are in use */
+		long long _adjacencyBytes;
+
+		/** The items of the lists of attributes of the nodes and of the edges that are in use and the memory of the names and of the values of the attributes */
+		long long _attributesBytes;
+
+		/** The items allocated by all the lists above and not in use, kept to be reused by the next elements */
+		long long _freeListSlackBytes;
+	};
 
 public:
 	enum GraphType
@@ -98,6 +194,69 @@ public:
 	*/
 	Edge* AddEdge(const std::string& startNodeName, const std::string& endNodeName, bool encloseStartNodeNameInDoubleQuotes, bool encloseEndNodeNameInDoubleQuotes);
 
+	/**
+	* Removes all the nodes and the edges and resets the name and the type of the graph.
+	* The memory allocated for the nodes and the edges is kept to reuse it for the next graph stored inside this one
+	*/
+	Graph& Clear();
+
+	/**
+	* Makes sure the graph can store the given number of nodes and edges without allocating more memory.
+	* Use this before adding a big amount of nodes and edges to the graph
+	* nodesCount: the total number of nodes that the graph will contain
+	* edgesCount: the total number of edges that the graph will contain
+	*/
+	Graph& Reserve(int nodesCount, int edgesCount);
+
+	/**
+	* Adds a batch of nodes to the graph. Names which are already used by a node of the graph or that are repeated
+	* inside the batch don't create new nodes. The new nodes are added in the order of the first occurrence of their name.
+	* The result is the same of calling AddNode for every definition but the names are looked up all at once.
+	* nodes: the definitions of the nodes to add
+	* nodesIndices: if not nullptr, it's filled with the index inside the list of nodes of the graph of every given definition
+	* Returns false if one of the names is empty, in which case nothing is added
+	*/
+	bool AddNodes(const NodeDefinitionList& nodes, List<int>* nodesIndices = nullptr);
+
+	/**
+	* Adds a batch of nodes stored inside an array, like the other AddNodes does
+	* nodes: the definitions of the nodes to add
+	* nodesCount: the number of definitions
+	* nodesIndices: if not nullptr, it's an array of nodesCount elements filled with the index inside the list of nodes of the graph of every given definition
+	* Returns false if one of the names is empty, in which case nothing is added
+	*/
+	bool AddNodes(const NodeDefinition* nodes, int nodesCount, int* nodesIndices = nullptr);
+
+	/**
+	* Adds a batch of edges to the graph given the indices of their nodes.
+	* The duplicated edges (both inside the batch and with the edges already inside the graph) are removed all at once
+	* and the adjacency lists of the nodes are built in one pass. The edges are added in the same order of the batch,
+	* so the result is the same of calling AddEdge for every definition.
+	* edges: the definitions of the edges to add
+	* addedEdges: if not nullptr, it's filled with the pointer to the edge created for every given definition (nullptr if it was a duplicate)
+	* Returns the number of added edges or -1 if one of the indices is not valid, in which case nothing is added
+	*/
+	int AddEdges(const EdgeDefinitionList& edges, EdgePointersList* addedEdges = nullptr);
+
+	/**
+	* Adds a batch of edges stored inside an array given the indices of their nodes, like the other AddEdges does
+	* edges: the definitions of the edges to add
+	* edgesCount: the number of definitions
+	* addedEdges: if not nullptr, it's an array of edgesCount elements filled with the pointer to the edge created for every given definition (nullptr if it was a duplicate)
+	* Returns the number of added edges or -1 if one of the indices is not valid, in which case nothing is added
+	*/
+	int AddEdges(const EdgeDefinition* edges, int edgesCount, Edge** addedEdges = nullptr);
+
+	/**
+	* Adds a batch of edges to the graph given the names of their nodes.
+	* The nodes that don't exist are added in the order of the first occurrence of their name, like AddNodes does.
+	* The edges are then added like the other AddEdges does.
+	* edges: the definitions of the edges to add
+	* addedEdges: if not nullptr, it's filled with the pointer to the edge created for every given definition (nullptr if it was a duplicate)
+	* Returns the number of added edges or -1 if one of the names is empty, in which case nothing is added
+	*/
+	int AddEdges(const NamedEdgeDefinitionList& edges, EdgePointersList* addedEdges = nullptr);
+
 	/** Removes the edge at the given index from the edges of the graph */
 	Graph& RemoveEdge(int edgeIndex);
 	
@@ -146,6 +305,18 @@ public:
 	/** Returns the list of edges of this graph */
 	const NodeList& GetNodes() const { return _nodes; }
 
+	/**
+	* Fills the given array with the pointers to the nodes of this graph, in the same order of the list of nodes
+	* so that a node can be found by its index without looping through the list. The array must contain at least GetNodes().GetSize() elements
+	*/
+	void GetNodesArray(Node** nodes);
+
+	/**
+	* Returns the memory used by this graph, computed from the number of items of its lists and from the lengths of its strings.
+	* The memory of a string is counted only if it doesn't fit inside the string object, and the overhead of the heap isn't counted
+	*/
+	MemoryFootprint GetMemoryFootprint() const;
+
 	/**
 	* Applies the DSF algorithm to see if the graph contains cycles inside.
 	* setNodesColorToWhiteAtStart: if the caller of this method is not sure that all the nodes are currently white-colord, pass this parameter as true
@@ -185,6 +356,26 @@ public:
 	/** Returns a list containing the pointer to all the nodes that don't have any entrant edge */
 	NodePointersList GetNonEntrantNodes();
 
+	/**
+	* Finds the strongly connected components of this graph with an iterative version of the Tarjan algorithm, which visits every node and edge once.
+	* If the graph is not directed the components are the connected components.
+	* nodesComponents: filled with the index of the component of every node, in the order of the list of nodes. The array must contain at least GetNodes().GetSize() elements.
+	*                  The components are numbered in the order of their first node inside the list of nodes
+	* condensation: if not nullptr, it's filled with the condensation of this graph: a directed graph with one node for every component, in the order
+	*               of the indices of the components and named like their first node, and one edge for every pair of components connected by an edge of this graph
+	* Returns the number of components
+	*/
+	int ComputeStronglyConnectedComponents(int* nodesComponents, Graph* condensation = nullptr) const;
+
+	/**
+	* Finds the edges of this directed acyclic graph that belong to its transitive reduction: an edge a->c is redundant if c can be reached from a through
+	* another path, like a->b->c, so removing it doesn't change the nodes reached from any node. The nodes reached from every node are kept as bitsets,
+	* computed in reverse topological order for a range of the nodes at a time so that the memory used stays bounded.
+	* redundantEdges: filled with 1 for the redundant edges and 0 for the other ones, in the order of the list of edges. The array must contain at least GetEdges().GetSize() elements
+	* Returns the number of redundant edges or -1 if the graph isn't directed or contains cycles
+	*/
+	int ComputeTransitiveReduction(unsigned char* redundantEdges) const;
+
 	/**
 	* Given a node as root, computes the best paths that connects the root to all the nodes that it can reach. Works event if there is a cycle
 	* root: the node which is to be used as root
@@ -218,10 +409,20 @@ private:
 	Graph& RemoveEdgesAddedByASDProjectSolver();
 
 	/**
-	* Adds a new edge without doing any check. (Utility for the copy operator and constructor)
+	* Adds a new edge without doing any check. (Utility for the copy operator and constructor and the bulk construction methods)
 	* Returns a pointer to the new edge.
 	*/
-	Edge* AddEdgeNoCheck(const std::string& startNodeName, const std::string& endNodeName);
+	Edge* AddEdgeNoCheck(Node* startNode, Node* endNode);
+
+	/**
+	* Adds a new node without checking if a node with the same name already exists. (Utility for the readers that load graphs known to be valid)
+	* Returns a pointer to the new node.
+	*/
+	Node* AddNodeNoCheck(const std::string& name, bool encloseNodeNameInDoubleQuotes);
+
+	/** Adds the batch of nodes given by the pointers to their definitions. Used by both the AddNodes methods */
+	bool AddNodeDefinitions(const NodeDefinition** definitions, int definitionsCount, int* nodesIndices);
+
 		
 private:
 	/** The type of this graph */
@@ -238,4 +439,8 @@ private:
 
 	/** List of all the nodes of this graph */
 	NodeList _nodes;
-};
\ No newline at end of file
+};
+
+template<> struct ContainerElementDefaultValue<Graph::NodeDefinition> { static Graph::NodeDefinition Value() { return Graph::NodeDefinition(); } };
+template<> struct ContainerElementDefaultValue<Graph::EdgeDefinition> { static Graph::EdgeDefinition Value() { return Graph::EdgeDefinition(); } };
+template<> struct ContainerElementDefaultValue<Graph::NamedEdgeDefinition> { static Graph::NamedEdgeDefinition Value() { return Graph::NamedEdgeDefinition(); } };
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "MemoryAccounting.h"
+
 #include <iostream>
+#include <string>
 
 /** Default element destructor used by List. It does nothing */
 template<typename T> struct ContainerDefaultElementDestructor
@@ -33,6 +36,7 @@ template<> struct ContainerElementDefaultValue<long long> { inline static long l
 template<> struct ContainerElementDefaultValue<unsigned long long> { inline static unsigned long long Value() { return 0; } };
 template<> struct ContainerElementDefaultValue<float> { inline static float Value() { return 0.0f; } };
 template<> struct ContainerElementDefaultValue<double> { inline static double Value() { return 0; } };
+template<> struct ContainerElementDefaultValue<std::string> { inline static std::string Value() { return ""; } };
 
 template<
 	typename T, /** Type of objects to be stored inside the list */
@@ -615,6 +619,9 @@ private:
 			// Create a new item
 			ListItem* newItem = new ListItem(DefaultValue());
 
+			if (MemoryAccounting::IsEnabled())
+				MemoryAccounting::AddAllocation(MemoryAccounting::MC_ListItems, sizeof(ListItem));
+
 			// Set the previous item of the new item as the current tail of the list
 			newItem->_prev = _freeItemsTail;
 
@@ -1251,6 +1258,9 @@ public:
 
 				delete currentItem;
 				currentItem = nextItem;
+
+				if (MemoryAccounting::IsEnabled())
+					MemoryAccounting::AddDeallocation(MemoryAccounting::MC_ListItems, sizeof(ListItem));
 			}
 		}
 		
@@ -1617,12 +1627,27 @@ public:
 		}
 	}
 
+	/**
+	* Makes sure the list can store at least the given number of elements without the need to allocate more memory.
+	* If the list can already store that many elements nothing is done.
+	* capacity: the number of elements that the list must be able to store
+	*/
+	List& Reserve(int capacity)
+	{
+		if (capacity > _capacity)
+			Grow(capacity - _capacity);
+		return *this;
+	}
+
 	/** Returns the number of elements inside the list */
 	int GetSize() const { return _size; }
 
 	/** Returns the number of elements that the list can store without the need to allocate more memory */
 	int GetCapacity() const { return _capacity; }
 
+	/** Returns the number of bytes allocated for every element that the list can store */
+	static size_t GetItemSize() { return sizeof(ListItem); }
+
 	/** Returns an iterator that points to the first element of the list */
 	Iterator Begin() { return Iterator(this, _head, true, false); }
 
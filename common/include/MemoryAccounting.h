@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/**
+* Counters of the memory allocated by the project, used to measure how much memory a graph or a run of the solver needs.
+* The allocations are divided in categories: the items of the lists (counted by List), the scratch arrays of the solver
+* (allocated with CountedMalloc/CountedCalloc) and all the heap allocations made with operator new, which are counted only
+* by the programs that replace it (time_tester). The counters are shared by all the threads and count only while enabled,
+* so the programs that don't enable them pay only a check of a flag for every allocation.
+*/
+class MemoryAccounting
+{
+public:
+	/** The categories of the allocations */
+	enum Category
+	{
+		/** Items of List, allocated when a list grows */
+		MC_ListItems,
+
+		/** Scratch arrays of ASDProjectSolver and of the algorithms of Graph that it runs (strongly connected components, transitive reduction) */
+		MC_SolverScratch,
+
+		/** Every allocation made with operator new, including the strings of the names and of the attributes and the items of the lists */
+		MC_Heap,
+
+		MC_Count
+	};
+
+	/** The counters of a category since the last call to Reset */
+	struct Counters
+	{
+		/** The number of allocations and of deallocations */
+		long long _allocationsCount;
+		long long _deallocationsCount;
+
+		/** The total number of bytes allocated */
+		long long _allocatedBytes;
+
+		/**
+		* The bytes allocated and not released yet, and their maximum. The memory of CountedMalloc that was allocated while the counters were disabled
+		* isn't subtracted when released, while the items of the lists and the heap (where it isn't allocated with CountedMalloc) can't tell it apart,
+		* so their current bytes can go below 0
+		*/
+		long long _currentBytes;
+		long long _peakBytes;
+	};
+
+public:
+	/** Enables or disables the counters. They are disabled by default */
+	static void SetEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+
+	/** Returns true if the counters are enabled */
+	static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+
+	/** Sets to 0 the counters of all the categories */
+	static void Reset();
+
+	/** Copies the counters of the given category into 'counters' */
+	static void GetCounters(Category category, Counters& counters);
+
+	/** Returns the name of the given category */
+	static const char* GetCategoryName(Category category);
+
+	/** Counts an allocation of the given number of bytes, if the counters are enabled */
+	static void AddAllocation(Category category, size_t bytes);
+
+	/** Counts the release of an allocation of the given number of bytes, if the counters are enabled */
+	static void AddDeallocation(Category category, size_t bytes);
+
+	/**
+	* Allocates memory like malloc and counts it in the given category. The memory must be released with CountedFree.
+	* Returns nullptr if the memory can't be allocated
+	*/
+	static void* CountedMalloc(Category category, size_t bytes);
+
+	/** Allocates memory set to 0 like calloc and counts it in the given category. The memory must be released with CountedFree */
+	static void* CountedCalloc(Category category, size_t count, size_t size);
+
+	/** Releases the memory allocated by CountedMalloc or CountedCalloc. It does nothing if memory is nullptr */
+	static void CountedFree(Category category, void* memory);
+
+private:
+	/** True if the counters are enabled */
+	static std::atomic<bool> _enabled;
+};
\ No newline at end of file
@@ -8,11 +8,13 @@
 // Forward declaration of used types
 class Edge;
 class Graph;
+class BinaryGraphReader;
 
 class Node : public GraphElement
 {
 	friend ContainerElementDefaultValue<Node>;
 	friend Graph;
+	friend BinaryGraphReader;
 
 public:
 	/**
@@ -77,12 +79,21 @@ private:
 	*/
 	Node& AddAdjacentNode(Node* adjacentNode);
 
+	/**
+	* Adds the given node to the list of adjacent nodes of this node without checking if it is already inside the list.
+	* Used by the bulk construction methods of Graph which have already removed the duplicated edges
+	*/
+	Node& AddAdjacentNodeNoCheck(Node* adjacentNode) { _adjacentNodes.Add(adjacentNode); return *this; }
+
+	/** Makes sure the list of adjacent nodes of this node can store the given number of nodes without allocating more memory */
+	Node& ReserveAdjacentNodes(int adjacentNodesCount) { _adjacentNodes.Reserve(adjacentNodesCount); return *this; }
+
 	/** Removes the given node from the list of adjacent nodes of this node */
 	Node& RemoveAdjacentNode(const Node* adjacentNode);
 		
 public:
 	/** Returns the name of this node */
-	const std::string GetName() const { return _name; }
+	const std::string& GetName() const { return _name; }
 
 	/** Returns true if a write needs to enclose the name of this node between double quotes */
 	bool EncloseNameInDoubleQuotes() const { return _encloseNameInDoubleQuotes; }
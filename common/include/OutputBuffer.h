@@ -0,0 +1,107 @@
+#pragma once
+
+#include <string>
+#include <cstring>
+#include <ostream>
+
+/**
+* Byte buffer used by the writers to format their output without going through the std::ostream operators.
+* The data is appended to the buffer and written to the output stream with a single write() call
+* every time the buffer is full or Flush is called.
+* If no output stream is set the buffer grows instead, keeping all the data in memory (used to format
+* parts of an output on different threads and write them later).
+* The buffer can be reused for many outputs to avoid allocating it every time.
+*/
+class OutputBuffer
+{
+public:
+	/** Default capacity of the buffer (in bytes) */
+	static const size_t s_defaultCapacity = 256 * 1024;
+
+public:
+	/** Default constructor */
+	OutputBuffer(size_t capacity = s_defaultCapacity);
+
+	/** Destructor. Doesn't flush the buffer since the output stream could be already destroyed */
+	~OutputBuffer();
+
+private:
+	/** The buffer can't be copied */
+	OutputBuffer(const OutputBuffer& src);
+	OutputBuffer& operator=(const OutputBuffer& src);
+
+public:
+	/** Sets the stream where the buffer is written. Any data still inside the buffer is discarded */
+	OutputBuffer& SetOutput(std::ostream* output) { _output = output; _size = 0; return *this; }
+
+	/** Gets the stream where the buffer is written */
+	std::ostream* GetOutput() const { return _output; }
+
+	/** Returns the data inside the buffer that wasn't written yet */
+	const char* GetData() const { return _data; }
+
+	/** Returns the number of bytes inside the buffer that weren't written yet */
+	size_t GetSize() const { return _size; }
+
+	/** Discards all the data inside the buffer without writing it */
+	OutputBuffer& Clear() { _size = 0; return *this; }
+
+	/**
+	* Writes all the data inside the buffer to the output stream. Returns false if the output stream failed
+	* Does nothing if there isn't an output stream
+	*/
+	bool Flush();
+
+	/** Appends a single character */
+	OutputBuffer& Append(char character)
+	{
+		if (_size == _capacity)
+			MakeRoom(1);
+
+		_data[_size++] = character;
+		return *this;
+	}
+
+	/** Appends the given characters */
+	OutputBuffer& Append(const char* data, size_t length)
+	{
+		if (length <= _capacity - _size)
+		{
+			memcpy(_data + _size, data, length);
+			_size += length;
+			return *this;
+		}
+
+		return AppendLarge(data, length);
+	}
+
+	/** Appends a string literal without computing its length at runtime */
+	template<size_t N>
+	OutputBuffer& Append(const char (&literal)[N]) { return Append(literal, N - 1); }
+
+	/** Appends the content of the given string */
+	OutputBuffer& Append(const std::string& string) { return Append(string.data(), string.length()); }
+
+	/** Appends the given integer as decimal text */
+	OutputBuffer& AppendInteger(long long value);
+
+private:
+	/** Appends data that doesn't fit into the free space of the buffer */
+	OutputBuffer& AppendLarge(const char* data, size_t length);
+
+	/** Makes room for the given number of bytes flushing the buffer or, if there isn't an output stream, growing it */
+	void MakeRoom(size_t length);
+
+private:
+	/** The stream where the buffer is written */
+	std::ostream* _output;
+
+	/** The bytes of the buffer */
+	char* _data;
+
+	/** Number of bytes used inside the buffer */
+	size_t _size;
+
+	/** Number of bytes allocated for the buffer */
+	size_t _capacity;
+};
\ No newline at end of file
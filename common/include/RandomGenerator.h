@@ -15,6 +15,13 @@ public:
 	/** Gets a new randon number in the range [min..max] given */
 	static double GetRandom(double min, double max);
 
+	/**
+	* Returns the seed of the index-th sequence derived from the given seed. The derived seeds are scattered over the whole range
+	* of the generator, so that the sequences of consecutive indices are unrelated, and they depend only on the seed and on the index
+	*/
+	static double DeriveSeed(double seed, long long index);
+
 private:
-	static double s_seed;
+	/** The seed is kept for each thread so that every thread generates its own sequence of numbers */
+	static thread_local double s_seed;
 };
\ No newline at end of file
@@ -0,0 +1,419 @@
+#include "ASDProjectBatchSolver.h"
+#include "ASDProjectSolver.h"
+#include "BinaryGraphReader.h"
+#include "BinaryGraphWriter.h"
+#include "DotWriter.h"
+#include "DeltaWriter.h"
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+/**
+* Constructor
+* outputFormat: the format used to write the results
+* outputFolderPath: the folder where every result is written to its own file. If empty the results are written to the output stream
+* threadsCount: the number of workers, each one with its own thread (the first worker uses the calling thread)
+*/
+ASDProjectBatchSolver::ASDProjectBatchSolver(OutputFormat outputFormat, const std::string& outputFolderPath, int threadsCount)
+	: _outputFormat(outputFormat)
+	, _outputFolderPath(outputFolderPath)
+	, _cache(nullptr)
+	, _solverOptions(ASDProjectSolver::O_None)
+	, _workers(nullptr)
+	, _workersCount(threadsCount > 0 ? threadsCount : 1)
+	, _jobs(nullptr)
+	, _jobsCount(0)
+	, _output(nullptr)
+	, _nextJobToEmit(0)
+	, _solvedJobsCount(0)
+	, _failedJobsCount(0)
+{
+	if (_outputFolderPath.empty() == false && _outputFolderPath[_outputFolderPath.length() - 1] != '/')
+		_outputFolderPath += "/";
+
+	_workers = new Worker[_workersCount];
+}
+
+/** Destructor */
+ASDProjectBatchSolver::~ASDProjectBatchSolver()
+{
+	delete[] _jobs;
+	delete[] _workers;
+}
+
+/**
+* Solves the graphs of the given DOT or binary graph files, one job for each file
+* Returns the number of jobs that were completed successfully
+*/
+int ASDProjectBatchSolver::SolveFiles(const PathsList& inputFilesPaths, std::ostream& output)
+{
+	delete[] _jobs;
+	_jobsCount = inputFilesPaths.GetSize();
+	_jobs = new Job[_jobsCount > 0 ? _jobsCount : 1];
+
+	PathsList::ConstIterator it = inputFilesPaths.Begin();
+	PathsList::ConstIterator end = inputFilesPaths.End();
+
+	for (int jobIndex = 0; it && it != end; jobIndex++, ++it)
+	{
+		const std::string& filePath = *it;
+
+		// The name of the job is the name of the file without the folders and the extension
+		size_t nameStart = filePath.find_last_of("/\\");
+		nameStart = (nameStart == std::string::npos) ? 0 : nameStart + 1;
+
+		size_t extensionStart = filePath.find_last_of('.');
+		if (extensionStart == std::string::npos || extensionStart < nameStart)
+			extensionStart = filePath.length();
+
+		_jobs[jobIndex]._name = filePath.substr(nameStart, extensionStart - nameStart);
+		_jobs[jobIndex]._inputFilePath = filePath;
+	}
+
+	return SolveJobs(output);
+}
+
+/**
+* Solves all the DOT graphs written one after the other inside the given stream, one job for each graph
+* Returns the number of jobs that were completed successfully
+*/
+int ASDProjectBatchSolver::SolveStream(std::istream& input, std::ostream& output)
+{
+	_inputContent = ASDProjectSolver::ReadFile(input);
+
+	// Find where every graph starts and ends so that the graphs can be parsed by different workers
+	int parseIndex = 0;
+	int graphsCount = 0;
+
+	while (DotParser::HasMoreGraphs(_inputContent, parseIndex))
+	{
+		int graphEnd = DotParser::FindGraphEnd(_inputContent, parseIndex);
+		parseIndex = (graphEnd >= 0) ? graphEnd : FindNextGraphStart(_inputContent, parseIndex);
+		graphsCount++;
+	}
+
+	delete[] _jobs;
+	_jobsCount = graphsCount;
+	_jobs = new Job[_jobsCount > 0 ? _jobsCount : 1];
+
+	parseIndex = 0;
+
+	for (int jobIndex = 0; jobIndex < _jobsCount && DotParser::HasMoreGraphs(_inputContent, parseIndex); jobIndex++)
+	{
+		_jobs[jobIndex]._name = std::to_string(jobIndex);
+		_jobs[jobIndex]._start = parseIndex;
+		_jobs[jobIndex]._end = DotParser::FindGraphEnd(_inputContent, parseIndex);
+
+		// After a graph that isn't closed restart from the next line that starts a graph
+		parseIndex = (_jobs[jobIndex]._end >= 0) ? _jobs[jobIndex]._end : FindNextGraphStart(_inputContent, parseIndex);
+	}
+
+	return SolveJobs(output);
+}
+
+/** Returns the extension of the files written with the given format */
+const char* ASDProjectBatchSolver::GetOutputFileExtension(OutputFormat outputFormat)
+{
+	switch (outputFormat)
+	{
+	case OF_Binary:
+		return ".asdg";
+	case OF_Delta:
+		return ".delta";
+	default:
+		return ".dot";
+	}
+}
+
+/** Solves all the jobs using the workers and returns the number of jobs solved */
+int ASDProjectBatchSolver::SolveJobs(std::ostream& output)
+{
+	_output = &output;
+	_nextJobToEmit = 0;
+	_solvedJobsCount = 0;
+	_failedJobsCount = 0;
+
+	// Split the jobs into contiguous ranges, one for each worker, so that the results are mostly completed in order
+	for (int i = 0; i < _workersCount; i++)
+	{
+		_workers[i]._firstJob = (int)(((long long)_jobsCount * i) / _workersCount);
+		_workers[i]._lastJob = (int)(((long long)_jobsCount * (i + 1)) / _workersCount);
+	}
+
+	// The first worker uses this thread
+	int threadsCount = (_workersCount < _jobsCount) ? _workersCount : _jobsCount;
+	std::thread* threads = new std::thread[threadsCount > 0 ? threadsCount : 1];
+
+	for (int i = 1; i < threadsCount; i++)
+		threads[i] = std::thread(&ASDProjectBatchSolver::RunWorker, this, i);
+
+	RunWorker(0);
+
+	for (int i = 1; i < threadsCount; i++)
+		threads[i].join();
+
+	delete[] threads;
+
+	// Release the results and the input stream content
+	delete[] _jobs;
+	_jobs = nullptr;
+	_jobsCount = 0;
+	_inputContent.clear();
+	_output = nullptr;
+
+	output.flush();
+
+	return _solvedJobsCount;
+}
+
+/** Loop of a worker: takes the jobs from its queue, or steals them from the other workers, until there are no jobs left */
+void ASDProjectBatchSolver::RunWorker(int workerIndex)
+{
+	Worker& worker = _workers[workerIndex];
+	int jobIndex = -1;
+
+	while ((jobIndex = GetNextJob(workerIndex)) >= 0)
+		SolveJob(worker, jobIndex);
+}
+
+/** Returns the next job for the given worker or -1 if there are no jobs left */
+int ASDProjectBatchSolver::GetNextJob(int workerIndex)
+{
+	// Take the first job of the queue of the worker
+	{
+		Worker& worker = _workers[workerIndex];
+		std::lock_guard<std::mutex> lock(worker._queueMutex);
+
+		if (worker._firstJob < worker._lastJob)
+			return worker._firstJob++;
+	}
+
+	// The queue is empty so steal the last job of the queue of another worker, which is the job that its owner would solve last
+	for (int i = 1; i < _workersCount; i++)
+	{
+		Worker& victim = _workers[(workerIndex + i) % _workersCount];
+		std::lock_guard<std::mutex> lock(victim._queueMutex);
+
+		if (victim._firstJob < victim._lastJob)
+			return --victim._lastJob;
+	}
+
+	return -1;
+}
+
+/** Solves the given job using the state of the given worker */
+void ASDProjectBatchSolver::SolveJob(Worker& worker, int jobIndex)
+{
+	Job& job = _jobs[jobIndex];
+
+	// Load and solve the graph. The solver messages are collected to be written in the right place
+	std::ostringstream solverMessages;
+	bool validInputGraph = false;
+	bool solved = false;
+
+	if (_cache != nullptr)
+	{
+		// The cache computes its key from the content, so a graph found inside it is built only as the result
+		bool streamJob = job._inputFilePath.empty();
+		int parseIndex = streamJob ? job._start : 0;
+
+		if (streamJob || ReadFileContent(worker, job._inputFilePath))
+			solved = _cache->ProcessData(streamJob ? _inputContent : worker._inputContent, parseIndex, worker._pendingGraph, worker._inputGraph, worker._resultGraph, solverMessages, validInputGraph);
+	}
+	else
+	{
+		if (job._inputFilePath.empty() == false)
+			validInputGraph = LoadFile(worker, job._inputFilePath);
+		else
+		{
+			int parseIndex = job._start;
+
+			worker._inputGraph.Clear();
+			validInputGraph = DotParser::Parse(worker._inputGraph, _inputContent, parseIndex, worker._pendingGraph);
+		}
+
+		if (validInputGraph)
+			solved = ASDProjectSolver::ProcessData(worker._inputGraph, worker._resultGraph, solverMessages, _solverOptions);
+	}
+
+	std::string errorMessage = "ERROR: couldn't read the graph";
+
+	if (validInputGraph && solved == false)
+		errorMessage = solverMessages.str();
+
+	job._solved = solved;
+
+	// Write the result to its own file
+	if (_outputFolderPath.empty() == false)
+	{
+		if (solved)
+		{
+			std::ofstream outputFile(_outputFolderPath + "out_" + job._name + GetOutputFileExtension(_outputFormat), std::ios::out | std::ios::binary | std::ios::trunc);
+
+			if (outputFile.is_open())
+			{
+				worker._outputBuffer.SetOutput(&outputFile);
+				job._solved = WriteResult(worker._resultGraph, _outputFormat, worker._outputBuffer) && worker._outputBuffer.Flush();
+				worker._outputBuffer.SetOutput(nullptr);
+			}
+			else
+				job._solved = false;
+		}
+
+		std::lock_guard<std::mutex> lock(_outputMutex);
+
+		if (solved == false)
+			std::cerr << "Job " << job._name << " failed: " << errorMessage << std::endl;
+		else if (job._solved == false)
+			std::cerr << "ASDProjectBatchSolver error [SolveJob]: cannot write the output file for the job " << job._name << std::endl;
+
+		if (job._solved)
+			_solvedJobsCount++;
+		else
+			_failedJobsCount++;
+
+		return;
+	}
+
+	// Format the result or the error followed by a new line inside the buffer of the worker, which has no output stream
+	worker._outputBuffer.SetOutput(nullptr);
+	worker._outputBuffer.Clear();
+
+	if (solved)
+		job._solved = WriteResult(worker._resultGraph, _outputFormat, worker._outputBuffer);
+	else
+		worker._outputBuffer.Append(errorMessage);
+
+	worker._outputBuffer.Append('\n');
+
+	EmitResult(worker, jobIndex);
+}
+
+/** Loads the graph of the given DOT or binary graph file into the input graph of the worker */
+bool ASDProjectBatchSolver::LoadFile(Worker& worker, const std::string& filePath)
+{
+	worker._inputGraph.Clear();
+
+	if (BinaryGraphReader::IsBinaryGraphFile(filePath))
+		return BinaryGraphReader::ReadFile(worker._inputGraph, filePath);
+
+	if (ReadFileContent(worker, filePath) == false)
+		return false;
+
+	int parseIndex = 0;
+
+	return DotParser::Parse(worker._inputGraph, worker._inputContent, parseIndex, worker._pendingGraph);
+}
+
+/** Reads the whole given file into the content of the worker */
+bool ASDProjectBatchSolver::ReadFileContent(Worker& worker, const std::string& filePath)
+{
+	std::ifstream file(filePath, std::ios::in | std::ios::binary);
+
+	if (!file.is_open())
+	{
+		std::cerr << "ASDProjectBatchSolver error [ReadFileContent]: cannot open the file " << filePath << std::endl;
+		return false;
+	}
+
+	// Read the whole file inside the content of the previous job, which keeps its memory if it's big enough
+	file.seekg(0, std::ios::end);
+	std::streamoff fileSize = file.tellg();
+	file.seekg(0, std::ios::beg);
+
+	if (fileSize < 0)
+		return false;
+
+	worker._inputContent.resize((size_t)fileSize);
+
+	return fileSize == 0 || !!file.read(&worker._inputContent[0], fileSize);
+}
+
+/**
+* Writes the given result graph to the buffer with the given format
+* If the buffer has an output stream the data is written to it, otherwise the data is kept inside the buffer
+*/
+bool ASDProjectBatchSolver::WriteResult(const Graph& resultGraph, OutputFormat outputFormat, OutputBuffer& buffer)
+{
+	switch (outputFormat)
+	{
+	case OF_Binary:
+	{
+		// The binary writer writes to a stream
+		if (buffer.GetOutput() != nullptr)
+		{
+			buffer.Flush();
+			return BinaryGraphWriter::Write(resultGraph, *buffer.GetOutput());
+		}
+
+		std::ostringstream binaryGraph(std::ios::out | std::ios::binary);
+		bool result = BinaryGraphWriter::Write(resultGraph, binaryGraph);
+		buffer.Append(binaryGraph.str());
+
+		return result;
+	}
+	case OF_Delta:
+		return DeltaWriter::Write(resultGraph, buffer, DeltaWriter::DF_Lines);
+	case OF_DeltaDot:
+		return DeltaWriter::Write(resultGraph, buffer, DeltaWriter::DF_Dot);
+	default:
+		return DotWriter::Write(resultGraph, buffer);
+	}
+}
+
+/** Writes the result of the job, inside the buffer of the worker, and all the following completed jobs in the same order of the inputs */
+void ASDProjectBatchSolver::EmitResult(Worker& worker, int jobIndex)
+{
+	std::lock_guard<std::mutex> lock(_outputMutex);
+
+	Job& job = _jobs[jobIndex];
+
+	if (job._solved)
+		_solvedJobsCount++;
+	else
+		_failedJobsCount++;
+
+	// If the previous results weren't written yet keep a copy of the result
+	if (jobIndex != _nextJobToEmit)
+	{
+		job._result.assign(worker._outputBuffer.GetData(), worker._outputBuffer.GetSize());
+		job._completed = true;
+		return;
+	}
+
+	_output->write(worker._outputBuffer.GetData(), worker._outputBuffer.GetSize());
+	job._completed = true;
+	_nextJobToEmit++;
+
+	// Write the results of the following jobs that were already completed
+	while (_nextJobToEmit < _jobsCount && _jobs[_nextJobToEmit]._completed)
+	{
+		std::string& result = _jobs[_nextJobToEmit]._result;
+
+		_output->write(result.data(), result.length());
+
+		// Release the memory of the result
+		std::string().swap(result);
+
+		_nextJobToEmit++;
+	}
+}
+
+/** Returns the position of the first line that starts a new graph after fromIndex, or the length of the content if there aren't any */
+int ASDProjectBatchSolver::FindNextGraphStart(const std::string& content, int fromIndex)
+{
+	static const char* s_graphKeywords[] = { "\ndigraph", "\ngraph", "\nstrict" };
+
+	size_t nextGraphStart = content.length();
+
+	for (int i = 0; i < 3; i++)
+	{
+		size_t position = content.find(s_graphKeywords[i], (size_t)fromIndex);
+
+		if (position != std::string::npos && position + 1 < nextGraphStart)
+			nextGraphStart = position + 1;
+	}
+
+	return (int)nextGraphStart;
+}
\ No newline at end of file
@@ -0,0 +1,682 @@
+#include "ASDProjectIncrementalSolver.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+/** Comparator used to find a node of the graph by name */
+struct IncrementalSolverNodeNameComparator
+{
+	IncrementalSolverNodeNameComparator(const std::string& name)
+		: _name(name)
+	{ }
+
+	inline bool operator()(const Node& node)
+	{
+		return node.GetName() == _name;
+	}
+
+	const std::string& _name;
+};
+
+/** Comparator used to find an edge of the graph by its nodes */
+struct IncrementalSolverEdgeComparator
+{
+	IncrementalSolverEdgeComparator(const Node* startNode, const Node* endNode, Graph::GraphType graphType)
+		: _startNode(startNode)
+		, _endNode(endNode)
+		, _graphType(graphType)
+	{ }
+
+	inline bool operator()(const Edge& edge)
+	{
+		if (edge.GetStartNode() == _startNode && edge.GetEndNode() == _endNode)
+			return true;
+
+		// If the graph is not directed the edge can have the nodes in the other order
+		return _graphType != Graph::GT_Directed && edge.GetStartNode() == _endNode && edge.GetEndNode() == _startNode;
+	}
+
+	const Node* _startNode;
+	const Node* _endNode;
+	Graph::GraphType _graphType;
+};
+
+/** Default constructor */
+ASDProjectIncrementalSolver::ASDProjectIncrementalSolver()
+	: _cyclic(false)
+	, _nodesCount(0)
+	, _nodesCapacity(0)
+	, _nodes(nullptr)
+	, _nodesAddresses(nullptr)
+	, _nodesAddressesCount(0)
+	, _entrantNodes(nullptr)
+	, _candidates(nullptr)
+	, _changedNodes(nullptr)
+	, _changedNodesIndices(nullptr)
+	, _changedNodesCount(0)
+	, _startAncestors(nullptr)
+	, _endAncestors(nullptr)
+	, _stack(nullptr)
+	, _nodesStack(nullptr)
+	, _visitedNodes(nullptr)
+	, _solvedCandidatesCount(0)
+	, _reusedCandidatesCount(0)
+{ }
+
+/** Destructor */
+ASDProjectIncrementalSolver::~ASDProjectIncrementalSolver()
+{
+	for (int nodeIndex = 0; nodeIndex < _nodesCapacity; nodeIndex++)
+		free(_candidates[nodeIndex]._addedEdges);
+
+	free(_nodes);
+	free(_nodesAddresses);
+	free(_candidates);
+	free(_changedNodes);
+	free(_changedNodesIndices);
+	free(_startAncestors);
+	free(_endAncestors);
+	free(_stack);
+	free(_nodesStack);
+	free(_visitedNodes);
+
+	delete[] _entrantNodes;
+}
+
+/**
+* Solves the given graph from scratch saving the result into the graph 'result', like ASDProjectSolver::ProcessData does,
+* and keeps a copy of the graph so that it can be changed by Update
+*/
+bool ASDProjectIncrementalSolver::Solve(const Graph& inputGraph, Graph& result, std::ostream& messages)
+{
+	InvalidateAllCandidates();
+
+	_graph = inputGraph;
+	_nodesAddressesCount = 0;
+
+	int nodesCount = _graph.GetNodes().GetSize();
+
+	Reserve(nodesCount);
+
+	_nodesCount = nodesCount;
+	_graph.GetNodesArray(_nodes);
+
+	for (int nodeIndex = 0; nodeIndex < _nodesCount; nodeIndex++)
+		_entrantNodes[nodeIndex].Clear();
+
+	// Build the lists of entrant nodes from the edges, so that a node is a candidate root when its list is empty
+	Graph::EdgeList::ConstIterator it = _graph.GetEdges().Begin();
+	Graph::EdgeList::ConstIterator end = _graph.GetEdges().End();
+
+	for (; it && it != end; ++it)
+		_entrantNodes[GetNodeIndex((*it).GetEndNode())].Add(GetNodeIndex((*it).GetStartNode()));
+
+	_cyclic = IsGraphCyclic();
+
+	return SolveCandidates(result, messages);
+}
+
+/**
+* Applies the given changes, in order, to the graph of the last call to Solve or Update and saves its solution into the graph 'result'
+* Inserting an edge that already exists or removing an edge that doesn't exist does nothing
+*/
+bool ASDProjectIncrementalSolver::Update(const EdgeChangeList& changes, Graph& result, std::ostream& messages)
+{
+	if (_nodesCount > 0)
+		memset(_changedNodes, 0, sizeof(unsigned char) * _nodesCount);
+	_changedNodesCount = 0;
+
+	// The changed nodes can be found only while the graph is a directed graph without cycles.
+	// Otherwise all the candidates are solved again
+	bool trackChangedNodes = _cyclic == false && _graph.GetGraphType() == Graph::GT_Directed;
+
+	if (trackChangedNodes == false)
+		InvalidateAllCandidates();
+
+	EdgeChangeList::ConstIterator it = changes.Begin();
+	EdgeChangeList::ConstIterator end = changes.End();
+
+	for (; it && it != end; ++it)
+	{
+		bool insert = (*it)._type == ECT_Insert;
+
+		int startNodeIndex = GetNodeIndex((*it)._edge._startNode, insert);
+		int endNodeIndex = GetNodeIndex((*it)._edge._endNode, insert);
+
+		// A removed edge with a node that doesn't exist doesn't exist either
+		if (startNodeIndex == -1 || endNodeIndex == -1)
+			continue;
+
+		Node* startNode = _nodes[startNodeIndex];
+		Node* endNode = _nodes[endNodeIndex];
+
+		int edgeIndex = _graph._edges.Find(IncrementalSolverEdgeComparator(startNode, endNode, _graph.GetGraphType()));
+
+		if (insert)
+		{
+			if (edgeIndex != -1)
+				continue;
+
+			// If the edge creates a cycle the changed nodes can't be found anymore
+			if (trackChangedNodes && MarkChangedNodes(startNodeIndex, endNodeIndex) == false)
+			{
+				trackChangedNodes = false;
+				InvalidateAllCandidates();
+			}
+
+			_graph.AddEdge(startNode, endNode);
+			_entrantNodes[endNodeIndex].Add(startNodeIndex);
+		}
+		else
+		{
+			if (edgeIndex == -1)
+				continue;
+
+			// In a non directed graph the edge can have the nodes in the other order
+			if (_graph.GetEdge(edgeIndex)->GetStartNode() != startNode)
+				std::swap(startNodeIndex, endNodeIndex);
+
+			_graph.RemoveEdge(edgeIndex);
+			_entrantNodes[endNodeIndex].Remove(startNodeIndex);
+
+			if (trackChangedNodes)
+				MarkChangedNodes(startNodeIndex, endNodeIndex);
+		}
+	}
+
+	if (trackChangedNodes)
+		InvalidateAffectedCandidates();
+	else
+		_cyclic = IsGraphCyclic();
+
+	return SolveCandidates(result, messages);
+}
+
+/** Finds the best root using the results of the candidates, solving the ones that aren't valid, and builds the result */
+bool ASDProjectIncrementalSolver::SolveCandidates(Graph& result, std::ostream& messages)
+{
+	_solvedCandidatesCount = 0;
+	_reusedCandidatesCount = 0;
+
+	result = _graph;
+
+	// Rename the graph
+	result.SetName("out_" + result.GetName(), result.EncloseNameInDoubleQuotes());
+
+	// Make sure that the graph hasn't got any cycle
+	if (_cyclic)
+	{
+		messages << "ERROR: the graph contains cycles!";
+		return false;
+	}
+
+	// Every edge of an undirected graph closes a cycle, so like ASDProjectSolver a root can't reach the other components of an undirected graph
+	if (_graph.GetGraphType() != Graph::GT_Directed && CountComponents() > 1)
+	{
+		messages << "ERROR: couldn't find the best root";
+		return false;
+	}
+
+	// Loop through the candidates in the same order of ASDProjectSolver so that the same root is chosen
+	int bestRoot = -1;
+	int bestAddedEdges = -1;
+	bool candidateFound = false;
+
+	for (int nodeIndex = 0; nodeIndex < _nodesCount; nodeIndex++)
+	{
+		if (_entrantNodes[nodeIndex].GetSize() > 0)
+			continue;
+
+		candidateFound = true;
+
+		if (_candidates[nodeIndex]._valid)
+			_reusedCandidatesCount++;
+		else
+		{
+			SolveCandidate(nodeIndex);
+			_solvedCandidatesCount++;
+		}
+
+		const CandidateResult& candidate = _candidates[nodeIndex];
+
+		// A candidate that reaches all the nodes is chosen immediately
+		if (candidate._unreachableNodesCount == 0)
+		{
+			bestRoot = nodeIndex;
+			bestAddedEdges = 0;
+			break;
+		}
+
+		if (bestAddedEdges == -1 || candidate._addedEdgesCount < bestAddedEdges)
+		{
+			bestRoot = nodeIndex;
+			bestAddedEdges = candidate._addedEdgesCount;
+		}
+	}
+
+	if (candidateFound == false)
+		messages << "ERROR: the graph doesn't contain any node without edges or with only entrant edges so there isn't any valid node for the root!";
+
+	if (bestRoot == -1)
+	{
+		messages << "ERROR: couldn't find the best root";
+		return false;
+	}
+
+	// Add the edges of the best root to the result like ASDProjectSolver does
+	Node** resultNodes = (Node**)malloc(sizeof(Node*) * _nodesCount);
+	result.GetNodesArray(resultNodes);
+
+	Node* root = resultNodes[bestRoot];
+	const CandidateResult& best = _candidates[bestRoot];
+
+	for (int edgeIndex = 0; edgeIndex < bestAddedEdges; edgeIndex++)
+	{
+		Edge* addedEdge = result.AddEdge(root, resultNodes[best._addedEdges[edgeIndex]]);
+
+		// Add the red colored attribute to the edge as the problem says
+		addedEdge->SetAttribute("color", "red", false, false);
+
+		// Mark the edge as added by the ASDProjectSolver
+		addedEdge->SetAddedBySolver(true);
+	}
+
+	free(resultNodes);
+
+	// Label the root to show the number of added edges
+	root->SetAttribute("label", "root = " + root->GetName() + "; |E| - |E'| = " + std::to_string(bestAddedEdges), false, true);
+
+	// Compute the best paths from the root
+	result.ComputeBestPathsFromRoot(root);
+
+	return true;
+}
+
+/**
+* Computes the result of the given candidate root, keeping the added edges that it already has.
+* The edges are chosen like ASDProjectSolver::FindBestRoot does: every time the edge to the unreachable node that leaves the least
+* unreachable nodes is added (the first one inside the list of nodes if more than one leaves the same number).
+* The edges start from a node without entrant edges, so they can't create a cycle and there is no need to check it
+*/
+void ASDProjectIncrementalSolver::SolveCandidate(int nodeIndex)
+{
+	CandidateResult& candidate = _candidates[nodeIndex];
+
+	SetNodesColor(Node::NodeColor::NC_White);
+
+	int unreachableNodesCount = _nodesCount - MarkReachableNodes(_nodes[nodeIndex]);
+
+	candidate._unreachableNodesCount = unreachableNodesCount;
+
+	for (int addedEdgeIndex = 0; addedEdgeIndex < candidate._addedEdgesCount; addedEdgeIndex++)
+		unreachableNodesCount -= MarkReachableNodes(_nodes[candidate._addedEdges[addedEdgeIndex]]);
+
+	while (unreachableNodesCount > 0)
+	{
+		int bestNodeIndex = -1;
+		int bestUnreachableNodesCount = unreachableNodesCount;
+
+		// The unreachable nodes are the white ones
+		for (int nodeToAddIndex = 0; nodeToAddIndex < _nodesCount; nodeToAddIndex++)
+		{
+			if (_nodes[nodeToAddIndex]->GetColor() != Node::NodeColor::NC_White)
+				continue;
+
+			int localUnreachableNodesCount = unreachableNodesCount - CountReachableNodes(_nodes[nodeToAddIndex]);
+
+			if (bestNodeIndex == -1 || localUnreachableNodesCount < bestUnreachableNodesCount)
+			{
+				bestNodeIndex = nodeToAddIndex;
+				bestUnreachableNodesCount = localUnreachableNodesCount;
+
+				// If the edge makes the root able to reach all the nodes we can stop right here
+				if (localUnreachableNodesCount == 0)
+					break;
+			}
+		}
+
+		if (candidate._addedEdgesCount == candidate._addedEdgesCapacity)
+		{
+			candidate._addedEdgesCapacity = std::max(4, candidate._addedEdgesCapacity * 2);
+			candidate._addedEdges = (int*)realloc(candidate._addedEdges, sizeof(int) * candidate._addedEdgesCapacity);
+		}
+
+		candidate._addedEdges[candidate._addedEdgesCount++] = bestNodeIndex;
+		unreachableNodesCount -= MarkReachableNodes(_nodes[bestNodeIndex]);
+	}
+
+	candidate._valid = true;
+}
+
+/**
+* Returns the number of added edges of the given candidate that would still be chosen after the changes of the graph.
+* The root must not be a changed node
+*/
+int ASDProjectIncrementalSolver::GetValidAddedEdgesCount(int nodeIndex, int& unreachableNodesCount)
+{
+	const CandidateResult& candidate = _candidates[nodeIndex];
+
+	SetNodesColor(Node::NodeColor::NC_White);
+
+	unreachableNodesCount = _nodesCount - MarkReachableNodes(_nodes[nodeIndex]);
+
+	// While the root and the chosen nodes haven't changed the unreachable nodes are the same of the ones found when the
+	// edges were chosen, and only the changed nodes can leave a different number of unreachable nodes than before.
+	// So an edge is still chosen if none of the changed nodes leaves less unreachable nodes than the chosen one
+	for (int addedEdgeIndex = 0; addedEdgeIndex < candidate._addedEdgesCount; addedEdgeIndex++)
+	{
+		int chosenNodeIndex = candidate._addedEdges[addedEdgeIndex];
+
+		if (_changedNodes[chosenNodeIndex])
+			return addedEdgeIndex;
+
+		int chosenUnreachableNodesCount = unreachableNodesCount - CountReachableNodes(_nodes[chosenNodeIndex]);
+
+		for (int changedNodeIndex = 0; changedNodeIndex < _changedNodesCount; changedNodeIndex++)
+		{
+			int nodeToCheckIndex = _changedNodesIndices[changedNodeIndex];
+
+			// The changed nodes that are already reached can't be chosen
+			if (_nodes[nodeToCheckIndex]->GetColor() != Node::NodeColor::NC_White)
+				continue;
+
+			int localUnreachableNodesCount = unreachableNodesCount - CountReachableNodes(_nodes[nodeToCheckIndex]);
+
+			if (localUnreachableNodesCount < chosenUnreachableNodesCount || (localUnreachableNodesCount == chosenUnreachableNodesCount && nodeToCheckIndex < chosenNodeIndex))
+				return addedEdgeIndex;
+		}
+
+		unreachableNodesCount -= MarkReachableNodes(_nodes[chosenNodeIndex]);
+	}
+
+	return candidate._addedEdgesCount;
+}
+
+/**
+* Marks as changed the nodes whose reachable nodes change when the edge between the given nodes is inserted or removed.
+* They are the nodes that reach the start node without reaching the end node. It must be called when the graph doesn't contain the edge
+* Returns false if inserting the edge would create a cycle
+*/
+bool ASDProjectIncrementalSolver::MarkChangedNodes(int startNodeIndex, int endNodeIndex)
+{
+	MarkAncestors(startNodeIndex, _startAncestors);
+
+	// If the end node reaches the start node the edge closes a cycle
+	if (_startAncestors[endNodeIndex])
+		return false;
+
+	MarkAncestors(endNodeIndex, _endAncestors);
+
+	for (int nodeIndex = 0; nodeIndex < _nodesCount; nodeIndex++)
+	{
+		if (_startAncestors[nodeIndex] && _endAncestors[nodeIndex] == 0 && _changedNodes[nodeIndex] == 0)
+		{
+			_changedNodes[nodeIndex] = 1;
+			_changedNodesIndices[_changedNodesCount++] = nodeIndex;
+		}
+	}
+
+	return true;
+}
+
+/** Marks with 1 the nodes that can reach the given one, including the node itself */
+void ASDProjectIncrementalSolver::MarkAncestors(int nodeIndex, unsigned char* marks)
+{
+	memset(marks, 0, sizeof(unsigned char) * _nodesCount);
+
+	// Visit the entrant nodes with a stack instead of recursion since the paths can be as long as the number of nodes
+	int stackSize = 0;
+
+	marks[nodeIndex] = 1;
+	_stack[stackSize++] = nodeIndex;
+
+	while (stackSize > 0)
+	{
+		const List<int>& entrantNodes = _entrantNodes[_stack[--stackSize]];
+
+		List<int>::ConstIterator it = entrantNodes.Begin();
+		List<int>::ConstIterator end = entrantNodes.End();
+
+		for (; it && it != end; ++it)
+		{
+			if (marks[*it] == 0)
+			{
+				marks[*it] = 1;
+				_stack[stackSize++] = *it;
+			}
+		}
+	}
+}
+
+/** Returns true if the graph contains cycles */
+bool ASDProjectIncrementalSolver::IsGraphCyclic()
+{
+	// Set the nodes to white here since the colors are changed by the searches of the unreachable nodes
+	SetNodesColor(Node::NodeColor::NC_White);
+
+	return _graph.IsCyclic();
+}
+
+/** Returns the number of connected components of the undirected graph. The nodes are left colored black */
+int ASDProjectIncrementalSolver::CountComponents()
+{
+	SetNodesColor(Node::NodeColor::NC_White);
+
+	int componentsCount = 0;
+
+	for (int nodeIndex = 0; nodeIndex < _nodesCount; nodeIndex++)
+	{
+		if (_nodes[nodeIndex]->GetColor() == Node::NodeColor::NC_White)
+		{
+			MarkReachableNodes(_nodes[nodeIndex]);
+			componentsCount++;
+		}
+	}
+
+	return componentsCount;
+}
+
+/** Sets the color of all the nodes */
+void ASDProjectIncrementalSolver::SetNodesColor(Node::NodeColor color)
+{
+	for (int nodeIndex = 0; nodeIndex < _nodesCount; nodeIndex++)
+		_nodes[nodeIndex]->SetColor(color);
+}
+
+/** Colors black the white nodes that can be reached from the given node through white nodes. Returns the number of colored nodes */
+int ASDProjectIncrementalSolver::MarkReachableNodes(Node* node)
+{
+	if (node->GetColor() != Node::NodeColor::NC_White)
+		return 0;
+
+	int stackSize = 0;
+	int markedNodesCount = 0;
+
+	node->SetColor(Node::NodeColor::NC_Black);
+	_nodesStack[stackSize++] = node;
+
+	while (stackSize > 0)
+	{
+		const List<Node*>& adjacentNodes = _nodesStack[--stackSize]->GetAdjacentNodes();
+
+		List<Node*>::ConstIterator it = adjacentNodes.Begin();
+		List<Node*>::ConstIterator end = adjacentNodes.End();
+
+		for (; it && it != end; ++it)
+		{
+			if (it->GetColor() == Node::NodeColor::NC_White)
+			{
+				it->SetColor(Node::NodeColor::NC_Black);
+				_nodesStack[stackSize++] = *it;
+			}
+		}
+
+		markedNodesCount++;
+	}
+
+	return markedNodesCount;
+}
+
+/** Returns the number of white nodes that can be reached from the given node through white nodes, without changing their color */
+int ASDProjectIncrementalSolver::CountReachableNodes(Node* node)
+{
+	int stackSize = 0;
+	int visitedNodesCount = 0;
+
+	// Color the visited nodes gray and remember them to color them white again at the end
+	node->SetColor(Node::NodeColor::NC_Gray);
+	_nodesStack[stackSize++] = node;
+	_visitedNodes[visitedNodesCount++] = node;
+
+	while (stackSize > 0)
+	{
+		const List<Node*>& adjacentNodes = _nodesStack[--stackSize]->GetAdjacentNodes();
+
+		List<Node*>::ConstIterator it = adjacentNodes.Begin();
+		List<Node*>::ConstIterator end = adjacentNodes.End();
+
+		for (; it && it != end; ++it)
+		{
+			if (it->GetColor() == Node::NodeColor::NC_White)
+			{
+				it->SetColor(Node::NodeColor::NC_Gray);
+				_nodesStack[stackSize++] = *it;
+				_visitedNodes[visitedNodesCount++] = *it;
+			}
+		}
+	}
+
+	for (int visitedNodeIndex = 0; visitedNodeIndex < visitedNodesCount; visitedNodeIndex++)
+		_visitedNodes[visitedNodeIndex]->SetColor(Node::NodeColor::NC_White);
+
+	return visitedNodesCount;
+}
+
+/**
+* Invalidates the results of the candidates affected by the changed nodes and of the nodes that aren't candidates anymore.
+* A candidate that isn't changed keeps the added edges that are still chosen, so that only the following ones are chosen again
+*/
+void ASDProjectIncrementalSolver::InvalidateAffectedCandidates()
+{
+	for (int nodeIndex = 0; nodeIndex < _nodesCount; nodeIndex++)
+	{
+		CandidateResult& candidate = _candidates[nodeIndex];
+
+		if (candidate._valid == false)
+			continue;
+
+		if (_entrantNodes[nodeIndex].GetSize() > 0 || _changedNodes[nodeIndex])
+			InvalidateCandidate(nodeIndex);
+		else if (_changedNodesCount > 0)
+		{
+			int unreachableNodesCount = 0;
+			int validAddedEdgesCount = GetValidAddedEdgesCount(nodeIndex, unreachableNodesCount);
+
+			// If all the edges are still chosen the root can still reach all the nodes, unless new nodes were added
+			if (validAddedEdgesCount < candidate._addedEdgesCount || unreachableNodesCount > 0)
+			{
+				candidate._valid = false;
+				candidate._addedEdgesCount = validAddedEdgesCount;
+			}
+		}
+	}
+}
+
+/** Invalidates the result of the given candidate */
+void ASDProjectIncrementalSolver::InvalidateCandidate(int nodeIndex)
+{
+	// The memory of the added edges is kept to be reused
+	_candidates[nodeIndex]._valid = false;
+	_candidates[nodeIndex]._addedEdgesCount = 0;
+}
+
+/** Invalidates the results of all the candidates */
+void ASDProjectIncrementalSolver::InvalidateAllCandidates()
+{
+	for (int nodeIndex = 0; nodeIndex < _nodesCount; nodeIndex++)
+		InvalidateCandidate(nodeIndex);
+}
+
+/** Returns the index of the node with the given name. If it doesn't exist it is added if addIfMissing is true, otherwise -1 is returned */
+int ASDProjectIncrementalSolver::GetNodeIndex(const Graph::NodeDefinition& node, bool addIfMissing)
+{
+	if (node._name.empty())
+		return -1;
+
+	int nodeIndex = _graph._nodes.Find(IncrementalSolverNodeNameComparator(node._name));
+
+	if (nodeIndex != -1 || addIfMissing == false)
+		return nodeIndex;
+
+	Reserve(_nodesCount + 1);
+
+	nodeIndex = _nodesCount++;
+	_nodes[nodeIndex] = _graph.AddNodeNoCheck(node._name, node._encloseNameInDoubleQuotes);
+
+	// The new node has no edges yet and it has to be checked like the nodes whose reachable nodes have changed
+	_entrantNodes[nodeIndex].Clear();
+	InvalidateCandidate(nodeIndex);
+
+	_changedNodes[nodeIndex] = 1;
+	_changedNodesIndices[_changedNodesCount++] = nodeIndex;
+
+	return nodeIndex;
+}
+
+/** Returns the index of the given node of the graph */
+int ASDProjectIncrementalSolver::GetNodeIndex(const Node* node)
+{
+	// Sort the nodes by address the first time an index is needed after the nodes have changed
+	if (_nodesAddressesCount != _nodesCount)
+	{
+		for (int nodeIndex = 0; nodeIndex < _nodesCount; nodeIndex++)
+		{
+			_nodesAddresses[nodeIndex]._node = _nodes[nodeIndex];
+			_nodesAddresses[nodeIndex]._nodeIndex = nodeIndex;
+		}
+
+		std::sort(_nodesAddresses, _nodesAddresses + _nodesCount);
+
+		_nodesAddressesCount = _nodesCount;
+	}
+
+	NodeAddress entry = { node, -1 };
+
+	return std::lower_bound(_nodesAddresses, _nodesAddresses + _nodesCount, entry)->_nodeIndex;
+}
+
+/** Makes sure the arrays of the nodes can store the given number of nodes */
+void ASDProjectIncrementalSolver::Reserve(int nodesCount)
+{
+	if (nodesCount <= _nodesCapacity)
+		return;
+
+	int capacity = std::max(nodesCount, _nodesCapacity * 2);
+
+	_nodes = (Node**)realloc(_nodes, sizeof(Node*) * capacity);
+	_nodesAddresses = (NodeAddress*)realloc(_nodesAddresses, sizeof(NodeAddress) * capacity);
+	_candidates = (CandidateResult*)realloc(_candidates, sizeof(CandidateResult) * capacity);
+	_changedNodes = (unsigned char*)realloc(_changedNodes, sizeof(unsigned char) * capacity);
+	_changedNodesIndices = (int*)realloc(_changedNodesIndices, sizeof(int) * capacity);
+	_startAncestors = (unsigned char*)realloc(_startAncestors, sizeof(unsigned char) * capacity);
+	_endAncestors = (unsigned char*)realloc(_endAncestors, sizeof(unsigned char) * capacity);
+	_stack = (int*)realloc(_stack, sizeof(int) * capacity);
+	_nodesStack = (Node**)realloc(_nodesStack, sizeof(Node*) * capacity);
+	_visitedNodes = (Node**)realloc(_visitedNodes, sizeof(Node*) * capacity);
+
+	// The new candidates have no result
+	memset(_candidates + _nodesCapacity, 0, sizeof(CandidateResult) * (capacity - _nodesCapacity));
+	memset(_changedNodes + _nodesCapacity, 0, sizeof(unsigned char) * (capacity - _nodesCapacity));
+
+	// Move the lists of entrant nodes to the new array
+	List<int>* entrantNodes = new List<int>[capacity];
+
+	for (int nodeIndex = 0; nodeIndex < _nodesCount; nodeIndex++)
+		entrantNodes[nodeIndex] = std::move(_entrantNodes[nodeIndex]);
+
+	delete[] _entrantNodes;
+	_entrantNodes = entrantNodes;
+
+	_nodesCapacity = capacity;
+}
\ No newline at end of file
@@ -1,17 +1,153 @@
 #include "ASDProjectSolver.h"
 #include "DotParser.h"
+#include "BinaryGraphReader.h"
+#include "ASDProjectSolverProfiler.h"
+#include "MemoryAccounting.h"
+
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <thread>
+
+/** Allocates a scratch array of the solver, counted by MemoryAccounting. It must be released with FreeSolverScratch */
+static inline void* AllocateSolverScratch(size_t bytes)
+{
+	return MemoryAccounting::CountedMalloc(MemoryAccounting::MC_SolverScratch, bytes);
+}
+
+/** Allocates a scratch array of the solver set to 0, counted by MemoryAccounting. It must be released with FreeSolverScratch */
+static inline void* AllocateZeroedSolverScratch(size_t count, size_t size)
+{
+	return MemoryAccounting::CountedCalloc(MemoryAccounting::MC_SolverScratch, count, size);
+}
+
+/** Releases a scratch array allocated by AllocateSolverScratch or AllocateZeroedSolverScratch */
+static inline void FreeSolverScratch(void* memory)
+{
+	MemoryAccounting::CountedFree(MemoryAccounting::MC_SolverScratch, memory);
+}
+
+/** Address of a node together with an index: the index of the node inside the list of nodes or the index of the component of a node of the condensation */
+struct SolverNodeAddressEntry
+{
+	const Node* _node;
+	int _index;
+};
+
+/** Comparator used to sort and search the SolverNodeAddressEntry by address */
+struct SolverNodeAddressEntryComparator
+{
+	inline bool operator()(const SolverNodeAddressEntry& lhs, const SolverNodeAddressEntry& rhs) const
+	{
+		return std::less<const Node*>()(lhs._node, rhs._node);
+	}
+};
+
+/** End node of an edge added by the solver together with the number of nodes that the edge makes reachable */
+struct SolverAddedEdgeEntry
+{
+	int _nodeIndex;
+	int _gain;
+};
+
+/** Comparator that sorts the SolverAddedEdgeEntry in the order the edges are added: by number of reached nodes and then by position of the node */
+struct SolverAddedEdgeEntryComparator
+{
+	inline bool operator()(const SolverAddedEdgeEntry& lhs, const SolverAddedEdgeEntry& rhs) const
+	{
+		return (lhs._gain != rhs._gain) ? (lhs._gain > rhs._gain) : (lhs._nodeIndex < rhs._nodeIndex);
+	}
+};
 
-bool ASDProjectSolver::ProcessData(Graph& result, int argc, char *argv[])
+/** Comparator that sorts the indices of the components from the largest to the smallest component */
+struct SolverComponentSizeComparator
 {
-	return ProcessData(result, GetInputFileContent(argc, argv));
+	SolverComponentSizeComparator(const int* componentsBegin) : _componentsBegin(componentsBegin) { }
+
+	inline bool operator()(int lhs, int rhs) const
+	{
+		int lhsSize = _componentsBegin[lhs + 1] - _componentsBegin[lhs];
+		int rhsSize = _componentsBegin[rhs + 1] - _componentsBegin[rhs];
+
+		return (lhsSize != rhsSize) ? (lhsSize > rhsSize) : (lhs < rhs);
+	}
+
+	const int* _componentsBegin;
+};
+
+/** Constructor */
+ASDProjectSolver::ComponentsGraph::ComponentsGraph()
+	: _nodesCount(0)
+	, _nodes(nullptr)
+	, _adjacencyBegin(nullptr)
+	, _adjacentNodes(nullptr)
+	, _candidates(nullptr)
+	, _componentsCount(0)
+	, _componentsBegin(nullptr)
+	, _componentsNodes(nullptr)
+	, _nodesComponents(nullptr)
+	, _addedEdgesNodes(nullptr)
+	, _addedEdgesGains(nullptr)
+	, _addedEdgesCounts(nullptr)
+	, _bestCandidates(nullptr)
+	, _bestCandidatesAddedEdges(nullptr)
+	, _reachedNodes(nullptr)
+	, _visitStamps(nullptr)
+	, _componentsOrder(nullptr)
+	, _nextComponent(0)
+	, _tiesBrokenByOrder(false)
+{ }
+
+/** Destructor */
+ASDProjectSolver::ComponentsGraph::~ComponentsGraph()
+{
+	FreeSolverScratch(_nodes);
+	FreeSolverScratch(_adjacencyBegin);
+	FreeSolverScratch(_adjacentNodes);
+	FreeSolverScratch(_candidates);
+	FreeSolverScratch(_componentsBegin);
+	FreeSolverScratch(_componentsNodes);
+	FreeSolverScratch(_nodesComponents);
+	FreeSolverScratch(_addedEdgesNodes);
+	FreeSolverScratch(_addedEdgesGains);
+	FreeSolverScratch(_addedEdgesCounts);
+	FreeSolverScratch(_bestCandidates);
+	FreeSolverScratch(_bestCandidatesAddedEdges);
+	FreeSolverScratch(_reachedNodes);
+	FreeSolverScratch(_visitStamps);
+	FreeSolverScratch(_componentsOrder);
+}
+
+/** Constructor */
+ASDProjectSolver::SolutionDetails::SolutionDetails()
+	: _tiesBrokenByOrder(false)
+	, _addedEdgesGains(nullptr)
+	, _addedEdgesCount(0)
+{ }
+
+/** Destructor */
+ASDProjectSolver::SolutionDetails::~SolutionDetails()
+{
+	free(_addedEdgesGains);
 }
 
-bool ASDProjectSolver::ProcessData(Graph& result, const std::string& dotFileContent)
+bool ASDProjectSolver::ProcessData(Graph& result, int argc, char *argv[], int options)
 {
 	Graph inputGraph;
 
-	// Parse the DOT file to get the starting graph
-	if (DotParser::Parse(inputGraph, dotFileContent) == false)
+	if (LoadInputGraph(inputGraph, argc, argv) == false)
+		return false;
+
+	return ProcessData(inputGraph, result, std::cout, options);
+}
+
+bool ASDProjectSolver::ProcessData(Graph& result, const std::string& fileContent)
+{
+	Graph inputGraph;
+
+	if (LoadInputGraph(inputGraph, fileContent) == false)
 		return false;
 
 	return ProcessData(inputGraph, result);
@@ -20,25 +156,58 @@ bool ASDProjectSolver::ProcessData(Graph& result, const std::string& dotFileCont
 /** Process the given graph and modifies it to solve the project */
 bool ASDProjectSolver::ProcessData(const Graph& inputGraph, Graph& result)
 {
-	result = inputGraph;
+	return ProcessData(inputGraph, result, std::cout);
+}
+
+/**
+* Process the given graph and solves the project saving the result into the graph 'result'
+* The error messages are written to 'messages' so that many graphs can be solved at the same time on different threads
+* options: a combination of the values of Options
+* details: if not nullptr, it's filled with the details of the solution (see SolutionDetails)
+*/
+bool ASDProjectSolver::ProcessData(const Graph& inputGraph, Graph& result, std::ostream& messages, int options, SolutionDetails* details)
+{
+	if (details != nullptr)
+	{
+		details->_tiesBrokenByOrder = false;
+		details->_addedEdgesCount = 0;
+	}
+
+	{
+		ASD_PROFILE_PHASE(P_CopyInput);
+		result = inputGraph;
+	}
 
 	// Rename the graph
 	result.SetName("out_" + result.GetName(), result.EncloseNameInDoubleQuotes());
 
-	// Make sure that the graph hasn't got any cycle
-	if (result.IsCyclic())
+	// Make sure that the graph hasn't got any cycle, unless the cycles of a directed graph can be condensed
+	bool condenseCycles = false;
+	bool cyclic = false;
+
 	{
-		std::cout << "ERROR: the graph contains cycles!";
-		return false;
+		ASD_PROFILE_PHASE(P_CycleCheck);
+		cyclic = result.IsCyclic();
+	}
+
+	if (cyclic)
+	{
+		if ((options & O_CondenseCycles) == 0 || result.GetGraphType() != Graph::GT_Directed)
+		{
+			messages << "ERROR: the graph contains cycles!";
+			return false;
+		}
+
+		condenseCycles = true;
 	}
 
 	// Loop through the possible roots of the graph to find the one that adds the least amount of edges
 	Node* root = nullptr;
 	int addedEdges = 0;
 
-	if ((root = FindBestRoot(result, addedEdges)) == nullptr)
+	if ((root = condenseCycles ? FindBestRootOfCondensation(result, addedEdges, details, messages, options) : FindBestRoot(result, addedEdges, details, messages, options)) == nullptr)
 	{
-		std::cout << "ERROR: couldn't find the best root";
+		messages << "ERROR: couldn't find the best root";
 		return false;
 	}
 
@@ -46,140 +215,732 @@ bool ASDProjectSolver::ProcessData(const Graph& inputGraph, Graph& result)
 	root->SetAttribute("label", "root = " + root->GetName() + "; |E| - |E'| = " + std::to_string(addedEdges), false, true);
 
 	// Compute the best paths from the root
+	ASD_PROFILE_PHASE(P_BestPaths);
 	result.ComputeBestPathsFromRoot(root);
 
 	return true;
 }
 
-Node* ASDProjectSolver::FindBestRoot(Graph& graph, int& addedEdges)
+/**
+* Finds the candidate root (a node without entrant edges) that has to add the least edges to reach all the nodes, and adds them to the graph.
+* Every time the root adds the edge to the unreachable node that leaves the least unreachable nodes: the first candidate and the first node inside
+* the list of nodes are chosen when more than one are equal.
+* details, if not nullptr, is filled with the number of nodes reached by every added edge and tells if one of these choices was made between equal ones.
+* Returns the root or nullptr if the graph has no candidate or if every candidate would need an edge that closes a cycle
+*/
+Node* ASDProjectSolver::FindBestRoot(Graph& graph, int& addedEdges, SolutionDetails* details, std::ostream& messages, int options)
 {
-	Graph bestGraph;
-	std::string bestRootName = "";
-	int bestAddedEdges = -1;
-	
-	// Get all the nodes that are a valid candidate for the root
+	ComponentsGraph componentsGraph;
+
+	{
+		ASD_PROFILE_PHASE(P_Components);
+		BuildComponentsGraph(graph, componentsGraph, options);
+	}
+
 	// The possible candidates are all the nodes that don't have any entrant edge
-	Graph::NodePointersList possibleRoots = graph.GetNonEntrantNodes();
+	int candidatesCount = 0;
+
+	for (int nodeIndex = 0; nodeIndex < componentsGraph._nodesCount; nodeIndex++)
+		candidatesCount += componentsGraph._candidates[nodeIndex];
 
 	// Should never reach here because if there isn't any node without edges or with only exiting edges there must be a cycle
-	if (possibleRoots.GetSize() == 0)
+	if (candidatesCount == 0)
 	{
-		std::cout << "ERROR: the graph doesn't contain any node without edges or with only entrant edges so there isn't any valid node for the root!";
+		messages << "ERROR: the graph doesn't contain any node without edges or with only entrant edges so there isn't any valid node for the root!";
+		return nullptr;
+	}
+
+	// Every edge of an undirected graph closes a cycle (see Graph::IsCyclic), so a root can't reach the other components of an undirected graph
+	if (graph.GetGraphType() != Graph::GT_Directed && componentsGraph._componentsCount > 1)
 		return nullptr;
+
+	int* stack = (int*)AllocateSolverScratch(sizeof(int) * componentsGraph._nodesCount);
+	int threadsCount = 1;
+
+	if ((options & O_ParallelComponents) != 0)
+	{
+		threadsCount = (int)std::thread::hardware_concurrency();
+
+		if (threadsCount > componentsGraph._componentsCount)
+			threadsCount = componentsGraph._componentsCount;
 	}
 
-	Graph::NodePointersList::Iterator possibleRootsIt = possibleRoots.Begin();
-	Graph::NodePointersList::Iterator possibleRootsEnd = possibleRoots.End();
-		
-	for (; possibleRootsIt && possibleRootsIt != possibleRootsEnd; ++possibleRootsIt)
+	if (threadsCount > 1)
 	{
-		// Get all the unreachable nodes from the candidate root
-		Graph::NodePointersList unreachableNodes = graph.GetUnreachableNodes(*possibleRootsIt, true);
+		ASD_PROFILE_PHASE(P_Candidates);
 
-		// If all the nodes can be reached from the given root then set the local graph ast the result and return
-		if (unreachableNodes.GetSize() == 0)
-		{
-			addedEdges = 0;
-			return *possibleRootsIt;
-		}
+		// Solve the largest components first so that the threads end at about the same time
+		componentsGraph._componentsOrder = (int*)AllocateSolverScratch(sizeof(int) * componentsGraph._componentsCount);
+
+		for (int componentIndex = 0; componentIndex < componentsGraph._componentsCount; componentIndex++)
+			componentsGraph._componentsOrder[componentIndex] = componentIndex;
+
+		std::sort(componentsGraph._componentsOrder, componentsGraph._componentsOrder + componentsGraph._componentsCount, SolverComponentSizeComparator(componentsGraph._componentsBegin));
+
+		componentsGraph._nextComponent = 0;
+
+		// This thread is one of the workers
+		std::thread* threads = new std::thread[threadsCount];
+
+		for (int i = 1; i < threadsCount; i++)
+			threads[i] = std::thread(&ASDProjectSolver::RunComponentsWorker, std::ref(componentsGraph));
+
+		RunComponentsWorker(componentsGraph);
+
+		for (int i = 1; i < threadsCount; i++)
+			threads[i].join();
+
+		delete[] threads;
+	}
+	else
+	{
+		ASD_PROFILE_PHASE(P_Candidates);
+
+		for (int componentIndex = 0; componentIndex < componentsGraph._componentsCount; componentIndex++)
+			SolveComponent(componentsGraph, componentIndex, stack);
+	}
+
+	// A root adds the edges of its own component plus the edges that reach every other component from none of its nodes
+	int totalAddedEdges = 0;
+
+	for (int componentIndex = 0; componentIndex < componentsGraph._componentsCount; componentIndex++)
+		totalAddedEdges += componentsGraph._addedEdgesCounts[componentIndex];
+
+	int bestRootIndex = -1;
+	int bestAddedEdges = -1;
 
-		int localAddedEdges = AddEdgesToRoot(graph, *possibleRootsIt, unreachableNodes);
+	for (int componentIndex = 0; componentIndex < componentsGraph._componentsCount; componentIndex++)
+	{
+		int candidateIndex = componentsGraph._bestCandidates[componentIndex];
+
+		if (candidateIndex < 0)
+			continue;
+
+		int localAddedEdges = componentsGraph._bestCandidatesAddedEdges[componentIndex] + totalAddedEdges - componentsGraph._addedEdgesCounts[componentIndex];
 
-		if (localAddedEdges >= 0 && (bestAddedEdges == -1 || localAddedEdges < bestAddedEdges))
+		if (bestRootIndex != -1 && localAddedEdges == bestAddedEdges)
+			componentsGraph._tiesBrokenByOrder = true;
+
+		if (bestRootIndex == -1 || localAddedEdges < bestAddedEdges || (localAddedEdges == bestAddedEdges && candidateIndex < bestRootIndex))
 		{
-			bestGraph = graph;
-			bestRootName = possibleRootsIt->GetName();
+			bestRootIndex = candidateIndex;
 			bestAddedEdges = localAddedEdges;
 		}
-		
-		// Remove the edges added from the current possible root
-		// If the current possible root is the best, the complete graph with all the added edges is stored inside 'bestGraph' any way
-		graph.RemoveEdgesAddedByASDProjectSolver();
 	}
 
-	// If bestAddedEdges is still negative then we couldn't find any valid root
-	if (bestAddedEdges == -1)
+	// If bestRootIndex is still negative then we couldn't find any valid root
+	if (bestRootIndex == -1)
+	{
+		FreeSolverScratch(stack);
 		return nullptr;
-	
-	// Move the best graph to the result and return true
-	// Using std::move to save up some loops inside the graph copy ctor
-	graph = bestGraph;
+	}
+
+	// Choose again the edges of the component of the root, starting from the nodes that the root reaches
+	ASD_PROFILE_PHASE(P_AddedEdges);
+
+	int rootComponentIndex = componentsGraph._nodesComponents[bestRootIndex];
+	int rootComponentBegin = componentsGraph._componentsBegin[rootComponentIndex];
+	int rootComponentEnd = componentsGraph._componentsBegin[rootComponentIndex + 1];
+	int visitStamp = 0;
+
+	for (int i = rootComponentBegin; i < rootComponentEnd; i++)
+	{
+		componentsGraph._reachedNodes[componentsGraph._componentsNodes[i]] = 0;
+		componentsGraph._visitStamps[componentsGraph._componentsNodes[i]] = 0;
+	}
+
+	MarkReachedNodes(componentsGraph, bestRootIndex, stack);
+
+	componentsGraph._addedEdgesCounts[rootComponentIndex] = ChooseAddedEdges(componentsGraph, rootComponentIndex, stack, visitStamp, INT_MAX,
+		componentsGraph._addedEdgesNodes + rootComponentBegin, componentsGraph._addedEdgesGains + rootComponentBegin);
+
+	// The edges chosen for the whole graph are the edges of the components merged by number of reached nodes and then by position inside the list of nodes,
+	// since the edges of a component don't change the number of nodes reached by the edges of the other components
+	SolverAddedEdgeEntry* addedEdgesEntries = (SolverAddedEdgeEntry*)AllocateSolverScratch(sizeof(SolverAddedEdgeEntry) * (bestAddedEdges > 0 ? bestAddedEdges : 1));
+	int addedEdgesEntriesCount = 0;
+
+	for (int componentIndex = 0; componentIndex < componentsGraph._componentsCount; componentIndex++)
+	{
+		int componentBegin = componentsGraph._componentsBegin[componentIndex];
+
+		for (int i = 0; i < componentsGraph._addedEdgesCounts[componentIndex]; i++)
+		{
+			addedEdgesEntries[addedEdgesEntriesCount]._nodeIndex = componentsGraph._addedEdgesNodes[componentBegin + i];
+			addedEdgesEntries[addedEdgesEntriesCount]._gain = componentsGraph._addedEdgesGains[componentBegin + i];
+			addedEdgesEntriesCount++;
+		}
+	}
+
+	std::sort(addedEdgesEntries, addedEdgesEntries + addedEdgesEntriesCount, SolverAddedEdgeEntryComparator());
+
+	Node* root = componentsGraph._nodes[bestRootIndex];
+
+	for (int i = 0; i < addedEdgesEntriesCount; i++)
+	{
+		Edge* addedEdge = graph.AddEdge(root, componentsGraph._nodes[addedEdgesEntries[i]._nodeIndex]);
+
+		// Add the red colored attribute to the edge as the problem says
+		addedEdge->SetAttribute("color", "red", false, false);
+
+		// Mark the edge as added by the ASDProjectSolver
+		addedEdge->SetAddedBySolver(true);
+	}
+
+	if (details != nullptr)
+	{
+		details->_tiesBrokenByOrder = details->_tiesBrokenByOrder || componentsGraph._tiesBrokenByOrder;
+		details->_addedEdgesGains = (int*)realloc(details->_addedEdgesGains, sizeof(int) * (addedEdgesEntriesCount > 0 ? addedEdgesEntriesCount : 1));
+		details->_addedEdgesCount = addedEdgesEntriesCount;
+
+		for (int i = 0; i < addedEdgesEntriesCount; i++)
+			details->_addedEdgesGains[i] = addedEdgesEntries[i]._gain;
+	}
+
+	FreeSolverScratch(addedEdgesEntries);
+	FreeSolverScratch(stack);
+
 	addedEdges = bestAddedEdges;
 
-	return graph.GetNode(bestRootName);
+	return root;
 }
 
-int ASDProjectSolver::AddEdgesToRoot(Graph& graph, Node* root, Graph::NodePointersList& unreachableNodes)
+/**
+* Solves the cyclic graph 'graph' condensing its strongly connected components, adding the edges to the graph.
+* The first node of a component depends on the order of the nodes, so the ties of details, if not nullptr, are always counted as broken by the order.
+* Returns the root or nullptr if the condensation can't be solved
+*/
+Node* ASDProjectSolver::FindBestRootOfCondensation(Graph& graph, int& addedEdges, SolutionDetails* details, std::ostream& messages, int options)
 {
-	int addedEdgesCount = 0;
+	int nodesCount = graph.GetNodes().GetSize();
+
+	Graph condensation;
+	int* nodesComponents = (int*)AllocateSolverScratch(sizeof(int) * nodesCount);
+
+	int componentsCount = 0;
+
+	{
+		ASD_PROFILE_PHASE(P_Condensation);
+		componentsCount = graph.ComputeStronglyConnectedComponents(nodesComponents, &condensation);
+	}
+
+	// The condensation has no cycles, so it is solved like any other graph
+	Node* condensationRoot = FindBestRoot(condensation, addedEdges, details, messages, options);
+
+	if (details != nullptr)
+		details->_tiesBrokenByOrder = true;
+
+	if (condensationRoot == nullptr)
+	{
+		FreeSolverScratch(nodesComponents);
+		return nullptr;
+	}
+
+	// Find the first node of every component
+	ASD_PROFILE_PHASE(P_AddedEdges);
+
+	Node** nodes = (Node**)AllocateSolverScratch(sizeof(Node*) * nodesCount);
+	Node** componentsNodes = (Node**)AllocateSolverScratch(sizeof(Node*) * componentsCount);
+
+	graph.GetNodesArray(nodes);
+
+	for (int nodeIndex = nodesCount - 1; nodeIndex >= 0; nodeIndex--)
+		componentsNodes[nodesComponents[nodeIndex]] = nodes[nodeIndex];
+
+	// The nodes of the condensation are in the order of the components. Sort them by address to find the component of a node
+	SolverNodeAddressEntry* condensationNodes = (SolverNodeAddressEntry*)AllocateSolverScratch(sizeof(SolverNodeAddressEntry) * componentsCount);
+
+	Graph::NodeList::ConstIterator nodesIt = condensation.GetNodes().Begin();
+	Graph::NodeList::ConstIterator nodesEnd = condensation.GetNodes().End();
 
-	while (unreachableNodes.GetSize() > 0)
+	for (int componentIndex = 0; nodesIt && nodesIt != nodesEnd; componentIndex++, ++nodesIt)
 	{
-		Graph::NodePointersList::Iterator it = unreachableNodes.Begin();
-		Graph::NodePointersList::Iterator end = unreachableNodes.End();
+		condensationNodes[componentIndex]._node = &(*nodesIt);
+		condensationNodes[componentIndex]._index = componentIndex;
+	}
+
+	std::sort(condensationNodes, condensationNodes + componentsCount, SolverNodeAddressEntryComparator());
+
+	SolverNodeAddressEntry rootEntry = { condensationRoot, -1 };
+	Node* root = componentsNodes[std::lower_bound(condensationNodes, condensationNodes + componentsCount, rootEntry, SolverNodeAddressEntryComparator())->_index];
+
+	// Add the edges added to the condensation from the root to the first nodes of the components, in the same order
+	Graph::EdgeList::ConstIterator edgesIt = condensation.GetEdges().Begin();
+	Graph::EdgeList::ConstIterator edgesEnd = condensation.GetEdges().End();
+
+	for (; edgesIt && edgesIt != edgesEnd; ++edgesIt)
+	{
+		if ((*edgesIt).IsAddedBySolver() == false)
+			continue;
+
+		SolverNodeAddressEntry endEntry = { (*edgesIt).GetEndNode(), -1 };
+		Node* endNode = componentsNodes[std::lower_bound(condensationNodes, condensationNodes + componentsCount, endEntry, SolverNodeAddressEntryComparator())->_index];
+
+		Edge* addedEdge = graph.AddEdge(root, endNode);
+
+		// Add the red colored attribute to the edge as the problem says
+		addedEdge->SetAttribute("color", "red", false, false);
+
+		// Mark the edge as added by the ASDProjectSolver
+		addedEdge->SetAddedBySolver(true);
+	}
+
+	FreeSolverScratch(nodes);
+	FreeSolverScratch(componentsNodes);
+	FreeSolverScratch(condensationNodes);
+	FreeSolverScratch(nodesComponents);
+
+	return root;
+}
+
+/**
+* Splits the given graph into its weakly connected components with a union-find over its edges.
+* With O_ReduceTransitiveEdges only the edges of the transitive reduction of the graph are kept
+*/
+void ASDProjectSolver::BuildComponentsGraph(Graph& graph, ComponentsGraph& componentsGraph, int options)
+{
+	int nodesCount = graph.GetNodes().GetSize();
+	int edgesCount = graph.GetEdges().GetSize();
 
-		Node* bestNodeToAdd = nullptr;
-		int unreachableNodesCount = unreachableNodes.GetSize();
+	// A redundant edge a->c has the same nodes reached through another path a->b->c, so without it the nodes reached from every node,
+	// the components and the nodes without entrant edges don't change. The output graph keeps all the edges
+	unsigned char* redundantEdges = (unsigned char*)AllocateSolverScratch(sizeof(unsigned char) * (edgesCount > 0 ? edgesCount : 1));
 
-		// Loop through the unreachable nodes and add the missing edges, checking that we're not creating any cycle
-		for (; it && it != end; ++it)
+	int redundantEdgesCount = -1;
+
+	if ((options & O_ReduceTransitiveEdges) != 0)
+	{
+		ASD_PROFILE_PHASE(P_TransitiveReduction);
+		redundantEdgesCount = graph.ComputeTransitiveReduction(redundantEdges);
+	}
+
+	if (redundantEdgesCount < 0)
+		memset(redundantEdges, 0, sizeof(unsigned char) * (edgesCount > 0 ? edgesCount : 1));
+	int adjacentNodesCount = (graph.GetGraphType() == Graph::GT_Directed) ? edgesCount : edgesCount * 2;
+
+	// Allocate at least one element so that empty graphs don't need special cases
+	int allocatedNodesCount = nodesCount > 0 ? nodesCount : 1;
+
+	componentsGraph._nodesCount = nodesCount;
+	componentsGraph._nodes = (Node**)AllocateSolverScratch(sizeof(Node*) * allocatedNodesCount);
+	componentsGraph._adjacencyBegin = (int*)AllocateZeroedSolverScratch(allocatedNodesCount + 1, sizeof(int));
+	componentsGraph._adjacentNodes = (int*)AllocateSolverScratch(sizeof(int) * (adjacentNodesCount > 0 ? adjacentNodesCount : 1));
+	componentsGraph._candidates = (unsigned char*)AllocateSolverScratch(sizeof(unsigned char) * allocatedNodesCount);
+	componentsGraph._componentsBegin = (int*)AllocateSolverScratch(sizeof(int) * (allocatedNodesCount + 1));
+	componentsGraph._componentsNodes = (int*)AllocateSolverScratch(sizeof(int) * allocatedNodesCount);
+	componentsGraph._nodesComponents = (int*)AllocateSolverScratch(sizeof(int) * allocatedNodesCount);
+	componentsGraph._addedEdgesNodes = (int*)AllocateSolverScratch(sizeof(int) * allocatedNodesCount);
+	componentsGraph._addedEdgesGains = (int*)AllocateSolverScratch(sizeof(int) * allocatedNodesCount);
+	componentsGraph._reachedNodes = (unsigned char*)AllocateZeroedSolverScratch(allocatedNodesCount, sizeof(unsigned char));
+	componentsGraph._visitStamps = (int*)AllocateZeroedSolverScratch(allocatedNodesCount, sizeof(int));
+
+	graph.GetNodesArray(componentsGraph._nodes);
+
+	// Sort the nodes by address to find the index of the nodes of the edges
+	SolverNodeAddressEntry* nodesAddresses = (SolverNodeAddressEntry*)AllocateSolverScratch(sizeof(SolverNodeAddressEntry) * allocatedNodesCount);
+
+	for (int nodeIndex = 0; nodeIndex < nodesCount; nodeIndex++)
+	{
+		nodesAddresses[nodeIndex]._node = componentsGraph._nodes[nodeIndex];
+		nodesAddresses[nodeIndex]._index = nodeIndex;
+		componentsGraph._candidates[nodeIndex] = 1;
+	}
+
+	std::sort(nodesAddresses, nodesAddresses + nodesCount, SolverNodeAddressEntryComparator());
+
+	int* edgesNodes = (int*)AllocateSolverScratch(sizeof(int) * (edgesCount > 0 ? edgesCount * 2 : 1));
+	int* parents = (int*)AllocateSolverScratch(sizeof(int) * allocatedNodesCount);
+	int* sizes = (int*)AllocateSolverScratch(sizeof(int) * allocatedNodesCount);
+
+	for (int nodeIndex = 0; nodeIndex < nodesCount; nodeIndex++)
+	{
+		parents[nodeIndex] = nodeIndex;
+		sizes[nodeIndex] = 1;
+	}
+
+	// Count the adjacent nodes of every node and join the nodes of every edge
+	Graph::EdgeList::ConstIterator edgesIt = graph.GetEdges().Begin();
+	Graph::EdgeList::ConstIterator edgesEnd = graph.GetEdges().End();
+
+	for (int edgeIndex = 0; edgesIt && edgesIt != edgesEnd; edgeIndex++, ++edgesIt)
+	{
+		if (redundantEdges[edgeIndex] != 0)
+			continue;
+
+		SolverNodeAddressEntry startEntry = { (*edgesIt).GetStartNode(), -1 };
+		SolverNodeAddressEntry endEntry = { (*edgesIt).GetEndNode(), -1 };
+
+		int startNodeIndex = std::lower_bound(nodesAddresses, nodesAddresses + nodesCount, startEntry, SolverNodeAddressEntryComparator())->_index;
+		int endNodeIndex = std::lower_bound(nodesAddresses, nodesAddresses + nodesCount, endEntry, SolverNodeAddressEntryComparator())->_index;
+
+		edgesNodes[edgeIndex * 2] = startNodeIndex;
+		edgesNodes[edgeIndex * 2 + 1] = endNodeIndex;
+
+		componentsGraph._candidates[endNodeIndex] = 0;
+		componentsGraph._adjacencyBegin[startNodeIndex + 1]++;
+
+		if (graph.GetGraphType() != Graph::GT_Directed)
+			componentsGraph._adjacencyBegin[endNodeIndex + 1]++;
+
+		// Find the roots of the sets of the nodes, halving the paths, and join the smaller set to the larger one
+		while (parents[startNodeIndex] != startNodeIndex)
+			startNodeIndex = parents[startNodeIndex] = parents[parents[startNodeIndex]];
+
+		while (parents[endNodeIndex] != endNodeIndex)
+			endNodeIndex = parents[endNodeIndex] = parents[parents[endNodeIndex]];
+
+		if (startNodeIndex == endNodeIndex)
+			continue;
+
+		if (sizes[startNodeIndex] < sizes[endNodeIndex])
+			std::swap(startNodeIndex, endNodeIndex);
+
+		parents[endNodeIndex] = startNodeIndex;
+		sizes[startNodeIndex] += sizes[endNodeIndex];
+	}
+
+	// Fill the adjacent nodes, keeping the order of the edges
+	for (int nodeIndex = 0; nodeIndex < nodesCount; nodeIndex++)
+		componentsGraph._adjacencyBegin[nodeIndex + 1] += componentsGraph._adjacencyBegin[nodeIndex];
+
+	int* adjacencyEnd = sizes;
+
+	memcpy(adjacencyEnd, componentsGraph._adjacencyBegin, sizeof(int) * nodesCount);
+
+	for (int edgeIndex = 0; edgeIndex < edgesCount; edgeIndex++)
+	{
+		if (redundantEdges[edgeIndex] != 0)
+			continue;
+
+		int startNodeIndex = edgesNodes[edgeIndex * 2];
+		int endNodeIndex = edgesNodes[edgeIndex * 2 + 1];
+
+		componentsGraph._adjacentNodes[adjacencyEnd[startNodeIndex]++] = endNodeIndex;
+
+		if (graph.GetGraphType() != Graph::GT_Directed)
+			componentsGraph._adjacentNodes[adjacencyEnd[endNodeIndex]++] = startNodeIndex;
+	}
+
+	// Number the components in the order of their first node and count their nodes
+	int* setsComponents = sizes;
+	int componentsCount = 0;
+
+	for (int nodeIndex = 0; nodeIndex < nodesCount; nodeIndex++)
+		setsComponents[nodeIndex] = -1;
+
+	for (int nodeIndex = 0; nodeIndex < nodesCount; nodeIndex++)
+	{
+		int setIndex = nodeIndex;
+
+		while (parents[setIndex] != setIndex)
+			setIndex = parents[setIndex];
+
+		if (setsComponents[setIndex] == -1)
 		{
-			Edge* addedEdge = graph.AddEdge(root, *it);
+			setsComponents[setIndex] = componentsCount;
+			componentsGraph._componentsBegin[componentsCount + 1] = 0;
+			componentsCount++;
+		}
 
-			// Make sure the edge was successfully added
-			if (addedEdge)
-			{
-				// Mark the edge as added by the ASDProjectSolver
-				addedEdge->SetAddedBySolver(true);
+		componentsGraph._nodesComponents[nodeIndex] = setsComponents[setIndex];
+		componentsGraph._componentsBegin[setsComponents[setIndex] + 1]++;
+	}
+
+	componentsGraph._componentsCount = componentsCount;
+	componentsGraph._componentsBegin[0] = 0;
+
+	for (int componentIndex = 0; componentIndex < componentsCount; componentIndex++)
+		componentsGraph._componentsBegin[componentIndex + 1] += componentsGraph._componentsBegin[componentIndex];
+
+	// Fill the nodes of the components in the order of the list of nodes
+	int* componentsEnd = parents;
+
+	memcpy(componentsEnd, componentsGraph._componentsBegin, sizeof(int) * componentsCount);
+
+	for (int nodeIndex = 0; nodeIndex < nodesCount; nodeIndex++)
+		componentsGraph._componentsNodes[componentsEnd[componentsGraph._nodesComponents[nodeIndex]]++] = nodeIndex;
+
+	int allocatedComponentsCount = componentsCount > 0 ? componentsCount : 1;
+
+	componentsGraph._addedEdgesCounts = (int*)AllocateZeroedSolverScratch(allocatedComponentsCount, sizeof(int));
+	componentsGraph._bestCandidates = (int*)AllocateSolverScratch(sizeof(int) * allocatedComponentsCount);
+	componentsGraph._bestCandidatesAddedEdges = (int*)AllocateSolverScratch(sizeof(int) * allocatedComponentsCount);
+
+	for (int componentIndex = 0; componentIndex < componentsCount; componentIndex++)
+		componentsGraph._bestCandidates[componentIndex] = -1;
+
+	FreeSolverScratch(redundantEdges);
+	FreeSolverScratch(nodesAddresses);
+	FreeSolverScratch(edgesNodes);
+	FreeSolverScratch(parents);
+	FreeSolverScratch(sizes);
+}
+
+/** Solves the components taken from the shared order of the given graph until there are no components left. Used by every thread */
+void ASDProjectSolver::RunComponentsWorker(ComponentsGraph& componentsGraph)
+{
+	int* stack = (int*)AllocateSolverScratch(sizeof(int) * componentsGraph._nodesCount);
+	int orderIndex = 0;
 
-				// Check if the addition of the edge has created any cycle, in which case remove the edge
-				if (graph.IsCyclic(true) == false)
+	while ((orderIndex = componentsGraph._nextComponent++) < componentsGraph._componentsCount)
+		SolveComponent(componentsGraph, componentsGraph._componentsOrder[orderIndex], stack);
+
+	FreeSolverScratch(stack);
+}
+
+/**
+* Computes the edges added to reach the nodes of the given component when none of them is reached, and the best candidate of the component.
+* The candidates are evaluated in order until one adds one edge for each of the other candidates, which is the least possible number.
+* The candidates that aren't evaluated could add as many edges, so the choice counts as a tie broken by the order
+*/
+void ASDProjectSolver::SolveComponent(ComponentsGraph& componentsGraph, int componentIndex, int* stack)
+{
+	int componentBegin = componentsGraph._componentsBegin[componentIndex];
+	int componentEnd = componentsGraph._componentsBegin[componentIndex + 1];
+	int visitStamp = 0;
+
+	int bestCandidateIndex = -1;
+	int bestAddedEdges = INT_MAX;
+
+	// A candidate can only be reached through an edge added from the root, since it has no entrant edges, so every root adds
+	// at least one edge for each of the other candidates of its component. No candidate can add less edges than this bound
+	int addedEdgesLowerBound = -1;
+
+	for (int i = componentBegin; i < componentEnd; i++)
+		addedEdgesLowerBound += componentsGraph._candidates[componentsGraph._componentsNodes[i]];
+
+	for (int i = componentBegin; i < componentEnd; i++)
+	{
+		int candidateIndex = componentsGraph._componentsNodes[i];
+
+		if (componentsGraph._candidates[candidateIndex] == 0)
+			continue;
+
+		for (int j = componentBegin; j < componentEnd; j++)
+			componentsGraph._reachedNodes[componentsGraph._componentsNodes[j]] = 0;
+
+		MarkReachedNodes(componentsGraph, candidateIndex, stack);
+
+		// A candidate that can't add less edges than the best one is discarded as soon as it reaches the same number of edges
+		int localAddedEdges = ChooseAddedEdges(componentsGraph, componentIndex, stack, visitStamp, bestAddedEdges, nullptr, nullptr);
+
+		if (localAddedEdges < bestAddedEdges)
+		{
+			bestCandidateIndex = candidateIndex;
+			bestAddedEdges = localAddedEdges;
+
+			// If the candidate adds the least possible edges the following candidates are dominated by it, since they can only add as many edges
+			if (bestAddedEdges == addedEdgesLowerBound)
+			{
+				for (int j = i + 1; j < componentEnd; j++)
 				{
-					int localUnreachableNodesCount = graph.GetUnreachableNodesCount(root, true);
-
-					// If we have added an edge that makes the root able to reach all the nodes we can stop right here
-					if (localUnreachableNodesCount == 0)
-					{
-						// Add the red colored attribute to the edge as the problem says
-						addedEdge->SetAttribute("color", "red", false, false);
-
-						return ++addedEdgesCount;
-					}
-					
-					if (bestNodeToAdd == nullptr || localUnreachableNodesCount < unreachableNodesCount)
-					{
-						bestNodeToAdd = *it;
-						unreachableNodesCount = localUnreachableNodesCount;
-					}
+					if (componentsGraph._candidates[componentsGraph._componentsNodes[j]] != 0)
+						componentsGraph._tiesBrokenByOrder = true;
 				}
 
-				graph.RemoveEdge(addedEdge);
+				break;
 			}
 		}
+		// The discarded candidate ties with the best one only if its edges reached all the nodes
+		else if (componentsGraph._tiesBrokenByOrder == false && IsComponentReached(componentsGraph, componentIndex))
+			componentsGraph._tiesBrokenByOrder = true;
+	}
 
-		// If we couldn't find any node that could be reached by the root without creating a cycle return immediately
-		if (bestNodeToAdd == nullptr)
-			return -1;
-		
-		// Add the edge with the best node (the one that minimizes the unreachable nodes from the root)
-		Edge* addedEdge = graph.AddEdge(root, bestNodeToAdd);
+	for (int i = componentBegin; i < componentEnd; i++)
+		componentsGraph._reachedNodes[componentsGraph._componentsNodes[i]] = 0;
 
-		// Add the red colored attribute to the edge as the problem says
-		addedEdge->SetAttribute("color", "red", false, false);
+	componentsGraph._addedEdgesCounts[componentIndex] = ChooseAddedEdges(componentsGraph, componentIndex, stack, visitStamp, INT_MAX,
+		componentsGraph._addedEdgesNodes + componentBegin, componentsGraph._addedEdgesGains + componentBegin);
 
-		// Mark the edge as added by the ASDProjectSolver
-		addedEdge->SetAddedBySolver(true);
+	componentsGraph._bestCandidates[componentIndex] = bestCandidateIndex;
+	componentsGraph._bestCandidatesAddedEdges[componentIndex] = bestAddedEdges;
+}
 
-		// Increment the number of added edges
-		addedEdgesCount++;
+/**
+* Chooses the edges that a root adds to reach the nodes of the given component that aren't reached yet, marking them as reached.
+* The choice stops when the number of added edges reaches addedEdgesLimit, since the root can't be better than another one anymore.
+* addedEdgesNodes and addedEdgesGains, if not nullptr, are filled with the end nodes of the edges and the number of nodes reached by every edge.
+* Returns the number of added edges
+*/
+int ASDProjectSolver::ChooseAddedEdges(ComponentsGraph& componentsGraph, int componentIndex, int* stack, int& visitStamp, int addedEdgesLimit, int* addedEdgesNodes, int* addedEdgesGains)
+{
+	int componentBegin = componentsGraph._componentsBegin[componentIndex];
+	int componentEnd = componentsGraph._componentsBegin[componentIndex + 1];
+	int unreachedNodesCount = 0;
+	int addedEdgesCount = 0;
+
+	// The nodes that reached as many nodes as the last chosen one and weren't chosen yet
+	int tiedNodesCount = 0;
+	int tiedGain = 0;
+
+	for (int i = componentBegin; i < componentEnd; i++)
+		unreachedNodesCount += (componentsGraph._reachedNodes[componentsGraph._componentsNodes[i]] == 0) ? 1 : 0;
+
+	while (unreachedNodesCount > 0 && addedEdgesCount < addedEdgesLimit)
+	{
+		int bestNodeIndex = -1;
+		int bestGain = 0;
+		int bestGainNodesCount = 0;
+
+		// Loop through the unreached nodes and find the one that reaches the most unreached nodes
+		for (int i = componentBegin; i < componentEnd; i++)
+		{
+			int nodeIndex = componentsGraph._componentsNodes[i];
+
+			if (componentsGraph._reachedNodes[nodeIndex] != 0)
+				continue;
+
+			// Start again with the stamps when they are all used
+			if (visitStamp == INT_MAX)
+			{
+				for (int j = componentBegin; j < componentEnd; j++)
+					componentsGraph._visitStamps[componentsGraph._componentsNodes[j]] = 0;
+
+				visitStamp = 0;
+			}
+
+			int gain = CountUnreachedNodes(componentsGraph, nodeIndex, stack, ++visitStamp);
+
+			if (gain > bestGain)
+			{
+				bestNodeIndex = nodeIndex;
+				bestGain = gain;
+				bestGainNodesCount = 1;
+
+				// If the node reaches all the unreached nodes we can stop right here. No other node can, since it would reach this one and be reached by it
+				if (bestGain == unreachedNodesCount)
+					break;
+			}
+			else if (gain == bestGain)
+				bestGainNodesCount++;
+		}
+
+		// The tied nodes are chosen one after the other, whatever their order, only if choosing one doesn't change what the others reach
+		if (tiedNodesCount > 0 && (bestGain != tiedGain || bestGainNodesCount != tiedNodesCount))
+			componentsGraph._tiesBrokenByOrder = true;
+
+		tiedNodesCount = bestGainNodesCount - 1;
+		tiedGain = bestGain;
+
+		MarkReachedNodes(componentsGraph, bestNodeIndex, stack);
+
+		if (addedEdgesNodes != nullptr)
+		{
+			addedEdgesNodes[addedEdgesCount] = bestNodeIndex;
+			addedEdgesGains[addedEdgesCount] = bestGain;
+		}
 
-		// Get the new list of unreachable nodes
-		unreachableNodes = graph.GetUnreachableNodes(root, true);
+		unreachedNodesCount -= bestGain;
+		addedEdgesCount++;
 	}
 
+	// Tied nodes left when all the nodes are reached were reached by the chosen ones. If the choice stopped at the limit they are still unreached
+	// and would reach as many nodes as the chosen one, so the number of added edges doesn't depend on which one was chosen
+	if (tiedNodesCount > 0 && unreachedNodesCount == 0)
+		componentsGraph._tiesBrokenByOrder = true;
+
 	return addedEdgesCount;
 }
 
+/** Returns true if all the nodes of the given component are reached */
+bool ASDProjectSolver::IsComponentReached(const ComponentsGraph& componentsGraph, int componentIndex)
+{
+	int componentEnd = componentsGraph._componentsBegin[componentIndex + 1];
+
+	for (int i = componentsGraph._componentsBegin[componentIndex]; i < componentEnd; i++)
+	{
+		if (componentsGraph._reachedNodes[componentsGraph._componentsNodes[i]] == 0)
+			return false;
+	}
+
+	return true;
+}
+
+/** Returns the number of nodes that aren't reached yet that the given node can reach */
+int ASDProjectSolver::CountUnreachedNodes(ComponentsGraph& componentsGraph, int nodeIndex, int* stack, int visitStamp)
+{
+	// The nodes reached from a reached node are reached too, so the visit doesn't go through them
+	int stackSize = 0;
+	int count = 0;
+
+	stack[stackSize++] = nodeIndex;
+	componentsGraph._visitStamps[nodeIndex] = visitStamp;
+
+	while (stackSize > 0)
+	{
+		int currentNodeIndex = stack[--stackSize];
+		int adjacencyEnd = componentsGraph._adjacencyBegin[currentNodeIndex + 1];
+
+		count++;
+
+		for (int i = componentsGraph._adjacencyBegin[currentNodeIndex]; i < adjacencyEnd; i++)
+		{
+			int adjacentNodeIndex = componentsGraph._adjacentNodes[i];
+
+			if (componentsGraph._reachedNodes[adjacentNodeIndex] == 0 && componentsGraph._visitStamps[adjacentNodeIndex] != visitStamp)
+			{
+				componentsGraph._visitStamps[adjacentNodeIndex] = visitStamp;
+				stack[stackSize++] = adjacentNodeIndex;
+			}
+		}
+	}
+
+	return count;
+}
+
+/** Marks as reached the nodes that the given node can reach. Returns the number of nodes that weren't reached before */
+int ASDProjectSolver::MarkReachedNodes(ComponentsGraph& componentsGraph, int nodeIndex, int* stack)
+{
+	if (componentsGraph._reachedNodes[nodeIndex] != 0)
+		return 0;
+
+	int stackSize = 0;
+	int count = 0;
+
+	stack[stackSize++] = nodeIndex;
+	componentsGraph._reachedNodes[nodeIndex] = 1;
+
+	while (stackSize > 0)
+	{
+		int currentNodeIndex = stack[--stackSize];
+		int adjacencyEnd = componentsGraph._adjacencyBegin[currentNodeIndex + 1];
+
+		count++;
+
+		for (int i = componentsGraph._adjacencyBegin[currentNodeIndex]; i < adjacencyEnd; i++)
+		{
+			int adjacentNodeIndex = componentsGraph._adjacentNodes[i];
+
+			if (componentsGraph._reachedNodes[adjacentNodeIndex] == 0)
+			{
+				componentsGraph._reachedNodes[adjacentNodeIndex] = 1;
+				stack[stackSize++] = adjacentNodeIndex;
+			}
+		}
+	}
+
+	return count;
+}
+
+/** Reads the DOT or binary graph file from the standard input or the input file into 'inputGraph' */
+bool ASDProjectSolver::LoadInputGraph(Graph& inputGraph, int argc, char *argv[])
+{
+	// Binary graph files are memory mapped instead of being read into a string
+	if (argc > 1 && BinaryGraphReader::IsBinaryGraphFile(argv[1]))
+		return BinaryGraphReader::ReadFile(inputGraph, argv[1]);
+
+	return LoadInputGraph(inputGraph, GetInputFileContent(argc, argv));
+}
+
+/** Reads the DOT or binary graph data from the given fileContent into 'inputGraph' */
+bool ASDProjectSolver::LoadInputGraph(Graph& inputGraph, const std::string& fileContent)
+{
+	// Read the binary graph or parse the DOT file to get the starting graph
+	if (BinaryGraphReader::IsBinaryGraph(fileContent.data(), fileContent.length()))
+		return BinaryGraphReader::Read(inputGraph, fileContent.data(), fileContent.length());
+
+	return DotParser::Parse(inputGraph, fileContent);
+}
+
 /** Method that gets the input file content (both from standard input or from the first argument of the process) */
 std::string ASDProjectSolver::GetInputFileContent(int argc, char *argv[])
 {
@@ -189,7 +950,7 @@ std::string ASDProjectSolver::GetInputFileContent(int argc, char *argv[])
 	if (argc > 1)
 	{
 		// Try to open the file
-		std::ifstream file(argv[1]);
+		std::ifstream file(argv[1], std::ios::in | std::ios::binary);
 
 		// If the file was opened then read its content and create the graph
 		if (file)
@@ -0,0 +1,1032 @@
+#include "ASDProjectSolverCache.h"
+#include "BinaryGraphReader.h"
+#include "BinaryGraphFormat.h"
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/** Value that identifies an entry file of the store folder ("ASDC") */
+static const uint32_t s_entryFileMagic = 0x43445341;
+
+/** Value used to check that the entry file was written with the same byte order of the reading machine */
+static const uint32_t s_entryFileByteOrderMark = 0x01020304;
+
+/** Version of the entry files. Increment it every time the layout changes */
+static const uint32_t s_entryFileVersion = 3;
+
+/**
+* Header of an entry file. It's followed by the message, by the name of the root and by every added edge:
+* the number of nodes it makes reachable, the length of the name of its end node and the name
+*/
+struct SolverCacheEntryFileHeader
+{
+	uint32_t _magic;
+	uint32_t _byteOrderMark;
+	uint32_t _version;
+	uint32_t _solved;
+	uint64_t _key[2];
+	uint64_t _nodesOrderKey[2];
+	int32_t _nodesCount;
+	int32_t _edgesCount;
+	int32_t _orderDependent;
+	int32_t _addedEdgesCount;
+	int32_t _rootLength;
+	int32_t _messageLength;
+};
+
+/** Name of a node together with its position inside the graph, or inside the elements found by the parser */
+struct SolverCacheNodeName
+{
+	const char* _name;
+	size_t _length;
+	int _position;
+};
+
+/** Returns a negative number, zero or a positive number if the name lhs comes before, is equal to or comes after the name rhs */
+static inline int CompareNames(const char* lhs, size_t lhsLength, const char* rhs, size_t rhsLength)
+{
+	int result = memcmp(lhs, rhs, lhsLength < rhsLength ? lhsLength : rhsLength);
+
+	if (result != 0)
+		return result;
+
+	return (lhsLength < rhsLength) ? -1 : (lhsLength > rhsLength ? 1 : 0);
+}
+
+/** Comparator used to sort the SolverCacheNodeName by name and then by position */
+struct SolverCacheNodeNameComparator
+{
+	inline bool operator()(const SolverCacheNodeName& lhs, const SolverCacheNodeName& rhs) const
+	{
+		int result = CompareNames(lhs._name, lhs._length, rhs._name, rhs._length);
+
+		return (result != 0) ? (result < 0) : (lhs._position < rhs._position);
+	}
+};
+
+/** Address of a node together with its position inside the list of the graph */
+struct SolverCacheAddressEntry
+{
+	const void* _address;
+	int _position;
+};
+
+/** Comparator used to sort the SolverCacheAddressEntry by address */
+struct SolverCacheAddressEntryComparator
+{
+	inline bool operator()(const SolverCacheAddressEntry& lhs, const SolverCacheAddressEntry& rhs) const
+	{
+		return std::less<const void*>()(lhs._address, rhs._address);
+	}
+};
+
+/** Edge added by the solver, given by the position of its end node, together with the number of nodes it makes reachable */
+struct SolverCacheAddedEdge
+{
+	int _nodePosition;
+	int _gain;
+};
+
+/** Comparator used to sort the SolverCacheAddedEdge like the solver adds them: by number of reached nodes and then by position of the node */
+struct SolverCacheAddedEdgeComparator
+{
+	inline bool operator()(const SolverCacheAddedEdge& lhs, const SolverCacheAddedEdge& rhs) const
+	{
+		return (lhs._gain != rhs._gain) ? (lhs._gain > rhs._gain) : (lhs._nodePosition < rhs._nodePosition);
+	}
+};
+
+/** Adds the given bytes to the two hashes of the key */
+static inline void HashBytes(uint64_t key[2], const void* data, size_t length)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+
+	// FNV-1a for the first hash and a multiplicative hash with a different constant for the second one,
+	// so that a collision would need to happen for both at the same time
+	for (size_t i = 0; i < length; i++)
+	{
+		key[0] = (key[0] ^ bytes[i]) * 0x100000001b3ULL;
+		key[1] = (key[1] + bytes[i] + 1) * 0x9e3779b97f4a7c15ULL;
+		key[1] ^= key[1] >> 29;
+	}
+}
+
+/** Adds the given value to the two hashes of the key */
+static inline void HashValue(uint64_t key[2], int64_t value)
+{
+	HashBytes(key, &value, sizeof(value));
+}
+
+/** Sets the two hashes of the key to their starting values */
+static inline void InitializeKey(uint64_t key[2])
+{
+	key[0] = 0xcbf29ce484222325ULL;
+	key[1] = 0x84222325cbf29ce4ULL;
+}
+
+/**
+* Computes the canonical hash of a graph given by the names of its nodes and by the positions of the nodes of its edges, together with the hash of the order of its nodes.
+* The same name can be found more than once, like inside the elements found by the parser: the node is placed where its name is found the first time.
+* The names are hashed sorted and the edges are hashed as sorted pairs of indices of the sorted names, so the order of the nodes and of the edges doesn't change the key.
+* The order of the nodes is hashed separately, as the indices of the sorted names in the order of the nodes.
+* nodesNames: the names of the nodes, in their order. They are sorted by this function
+* edgesNodes: the positions of the start node and of the end node of every edge
+* Returns the number of different nodes
+*/
+static int HashCanonicalGraph(Graph::GraphType graphType, SolverCacheNodeName* nodesNames, int nodesNamesCount, const int* edgesNodes, int edgesCount, uint64_t key[2], uint64_t nodesOrderKey[2])
+{
+	// The index of the sorted name of every position and the first position of every sorted name
+	int* namesIndices = (int*)malloc(sizeof(int) * (nodesNamesCount > 0 ? nodesNamesCount : 1));
+	int* firstPositions = (int*)malloc(sizeof(int) * (nodesNamesCount > 0 ? nodesNamesCount : 1));
+
+	std::sort(nodesNames, nodesNames + nodesNamesCount, SolverCacheNodeNameComparator());
+
+	InitializeKey(key);
+	HashValue(key, (int64_t)graphType);
+
+	int nodesCount = 0;
+
+	for (int i = 0; i < nodesNamesCount; i++)
+	{
+		const SolverCacheNodeName& nodeName = nodesNames[i];
+
+		// The equal names are sorted by position, so the first one is where the node is placed
+		if (i == 0 || CompareNames(nodeName._name, nodeName._length, nodesNames[i - 1]._name, nodesNames[i - 1]._length) != 0)
+		{
+			HashValue(key, (int64_t)nodeName._length);
+			HashBytes(key, nodeName._name, nodeName._length);
+
+			firstPositions[nodesCount++] = nodeName._position;
+		}
+
+		namesIndices[nodeName._position] = nodesCount - 1;
+	}
+
+	HashValue(key, nodesCount);
+
+	InitializeKey(nodesOrderKey);
+
+	for (int position = 0; position < nodesNamesCount; position++)
+	{
+		if (firstPositions[namesIndices[position]] == position)
+			HashValue(nodesOrderKey, namesIndices[position]);
+	}
+
+	// The nodes of an edge of an undirected graph can be given in any order
+	uint64_t* edges = (uint64_t*)malloc(sizeof(uint64_t) * (edgesCount > 0 ? edgesCount : 1));
+
+	for (int i = 0; i < edgesCount; i++)
+	{
+		uint64_t startNode = (uint64_t)namesIndices[edgesNodes[i * 2]];
+		uint64_t endNode = (uint64_t)namesIndices[edgesNodes[i * 2 + 1]];
+
+		if (graphType != Graph::GT_Directed && endNode < startNode)
+			std::swap(startNode, endNode);
+
+		edges[i] = (startNode << 32) | endNode;
+	}
+
+	std::sort(edges, edges + edgesCount);
+
+	HashValue(key, edgesCount);
+	HashBytes(key, edges, sizeof(uint64_t) * edgesCount);
+
+	free(edges);
+	free(firstPositions);
+	free(namesIndices);
+
+	return nodesCount;
+}
+
+/** Returns the position of the node with the given name, looking inside the sorted names, or -1 if there isn't one */
+static int FindNodePosition(const SolverCacheNodeName* nodesNames, int nodesCount, const std::string& name)
+{
+	int low = 0;
+	int high = nodesCount;
+
+	while (low < high)
+	{
+		int middle = (low + high) / 2;
+
+		if (CompareNames(nodesNames[middle]._name, nodesNames[middle]._length, name.data(), name.length()) < 0)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	if (low == nodesCount || CompareNames(nodesNames[low]._name, nodesNames[low]._length, name.data(), name.length()) != 0)
+		return -1;
+
+	return nodesNames[low]._position;
+}
+
+/** Returns true if the key lhs comes before the key rhs */
+static inline bool IsKeyLess(const uint64_t lhs[2], const uint64_t rhs[2])
+{
+	return lhs[0] != rhs[0] ? lhs[0] < rhs[0] : lhs[1] < rhs[1];
+}
+
+/** Constructor */
+ASDProjectSolverCache::GraphKey::GraphKey()
+	: _nodesCount(0)
+	, _edgesCount(0)
+{
+	_key[0] = 0;
+	_key[1] = 0;
+	_nodesOrderKey[0] = 0;
+	_nodesOrderKey[1] = 0;
+}
+
+/**
+* Constructor
+* maxEntriesCount: the maximum number of entries kept in memory (the oldest ones are removed first). 0 means no limit
+* storeFolderPath: the folder where the entries are stored so that they can be used by other processes. If empty nothing is stored
+*/
+ASDProjectSolverCache::ASDProjectSolverCache(int maxEntriesCount, const std::string& storeFolderPath, int solverOptions)
+	: _entries(nullptr)
+	, _entriesCount(0)
+	, _entriesCapacity(0)
+	, _maxEntriesCount(maxEntriesCount > 0 ? maxEntriesCount : 0)
+	, _storeFolderPath(storeFolderPath)
+	, _solverOptions(solverOptions)
+	, _useCounter(0)
+	, _hitsCount(0)
+	, _missesCount(0)
+{
+	if (_storeFolderPath.empty() == false && _storeFolderPath[_storeFolderPath.length() - 1] != '/')
+		_storeFolderPath += "/";
+}
+
+/** Destructor */
+ASDProjectSolverCache::~ASDProjectSolverCache()
+{
+	for (int i = 0; i < _entriesCount; i++)
+		DeleteEntry(_entries[i]);
+
+	free(_entries);
+}
+
+/**
+* Solves the given graph like ASDProjectSolver::ProcessData, saving the result into the graph 'result'
+* If the same graph was already solved its result is applied to a copy of the graph without solving it
+*/
+bool ASDProjectSolverCache::ProcessData(const Graph& inputGraph, Graph& result, std::ostream& messages)
+{
+	GraphKey graphKey;
+	BuildGraphKey(inputGraph, graphKey);
+	AddOptionsToKey(graphKey);
+
+	Entry* entry = GetEntry(graphKey);
+
+	if (entry != nullptr)
+	{
+		result = inputGraph;
+
+		bool applied = ApplyEntry(*entry, result, messages);
+		bool solved = entry->_solved;
+
+		DeleteEntry(entry);
+
+		if (applied)
+		{
+			_hitsCount++;
+			return solved;
+		}
+	}
+
+	return SolveGraph(inputGraph, graphKey, result, messages);
+}
+
+/**
+* Solves the DOT graph that starts at parseIndex inside data, or the binary graph contained inside data, like ASDProjectSolver::ProcessData,
+* saving the result into the graph 'result'. The key is computed from the elements found by DotParser::ParseElements or from the records
+* of the binary graph: if the same graph was already solved only 'result' is built, otherwise the graph is built into inputGraph and solved.
+* parseIndex is moved after the graph like DotParser::Parse does and pendingGraph stores the elements found, so that its arrays can be reused for many graphs.
+* validInputGraph is set to false if data doesn't contain a valid graph, in which case the error is written to the standard error like the readers do and false is returned
+*/
+bool ASDProjectSolverCache::ProcessData(const std::string& data, int& parseIndex, DotParser::PendingGraph& pendingGraph, Graph& inputGraph, Graph& result, std::ostream& messages, bool& validInputGraph)
+{
+	validInputGraph = false;
+
+	if (parseIndex < 0 || parseIndex > (int)data.length())
+		return false;
+
+	const char* binaryData = data.data() + parseIndex;
+	size_t binaryDataLength = data.length() - parseIndex;
+	bool binaryGraph = BinaryGraphReader::IsBinaryGraph(binaryData, binaryDataLength);
+
+	GraphKey graphKey;
+
+	if (binaryGraph)
+	{
+		// A binary graph takes all the data
+		parseIndex = (int)data.length();
+
+		// The reader tells what's wrong with the data
+		if (BuildBinaryGraphKey(binaryData, binaryDataLength, graphKey) == false)
+		{
+			inputGraph.Clear();
+			BinaryGraphReader::Read(inputGraph, binaryData, binaryDataLength);
+			return false;
+		}
+	}
+	else
+	{
+		if (DotParser::ParseElements(data, parseIndex, pendingGraph) == false)
+			return false;
+
+		BuildPendingGraphKey(pendingGraph, graphKey);
+	}
+
+	AddOptionsToKey(graphKey);
+
+	// On a hit the graph is built only into the result. Building it still checks that it's valid
+	Entry* entry = GetEntry(graphKey);
+
+	if (entry != nullptr)
+	{
+		result.Clear();
+
+		if ((binaryGraph ? BinaryGraphReader::Read(result, binaryData, binaryDataLength) : DotParser::BuildGraph(result, pendingGraph)) == false)
+		{
+			DeleteEntry(entry);
+			return false;
+		}
+
+		validInputGraph = true;
+
+		bool applied = ApplyEntry(*entry, result, messages);
+		bool solved = entry->_solved;
+
+		DeleteEntry(entry);
+
+		if (applied)
+		{
+			_hitsCount++;
+			return solved;
+		}
+	}
+
+	inputGraph.Clear();
+
+	if ((binaryGraph ? BinaryGraphReader::Read(inputGraph, binaryData, binaryDataLength) : DotParser::BuildGraph(inputGraph, pendingGraph)) == false)
+		return false;
+
+	validInputGraph = true;
+
+	return SolveGraph(inputGraph, graphKey, result, messages);
+}
+
+/** Computes the canonical hash of the given graph */
+void ASDProjectSolverCache::ComputeKey(const Graph& graph, uint64_t key[2])
+{
+	GraphKey graphKey;
+	BuildGraphKey(graph, graphKey);
+
+	key[0] = graphKey._key[0];
+	key[1] = graphKey._key[1];
+}
+
+/** Computes the key of the given graph */
+void ASDProjectSolverCache::BuildGraphKey(const Graph& graph, GraphKey& graphKey)
+{
+	int nodesCount = graph.GetNodes().GetSize();
+	int edgesCount = graph.GetEdges().GetSize();
+
+	SolverCacheNodeName* nodesNames = (SolverCacheNodeName*)malloc(sizeof(SolverCacheNodeName) * (nodesCount > 0 ? nodesCount : 1));
+	SolverCacheAddressEntry* nodesAddresses = (SolverCacheAddressEntry*)malloc(sizeof(SolverCacheAddressEntry) * (nodesCount > 0 ? nodesCount : 1));
+	int* edgesNodes = (int*)malloc(sizeof(int) * (edgesCount > 0 ? edgesCount * 2 : 1));
+
+	Graph::NodeList::ConstIterator nodesIt = graph.GetNodes().Begin();
+	Graph::NodeList::ConstIterator nodesEnd = graph.GetNodes().End();
+
+	for (int position = 0; nodesIt && nodesIt != nodesEnd; position++, ++nodesIt)
+	{
+		const std::string& name = (*nodesIt).GetName();
+
+		nodesNames[position]._name = name.data();
+		nodesNames[position]._length = name.length();
+		nodesNames[position]._position = position;
+
+		nodesAddresses[position]._address = &(*nodesIt);
+		nodesAddresses[position]._position = position;
+	}
+
+	// The edges give their nodes by address
+	std::sort(nodesAddresses, nodesAddresses + nodesCount, SolverCacheAddressEntryComparator());
+
+	Graph::EdgeList::ConstIterator edgesIt = graph.GetEdges().Begin();
+	Graph::EdgeList::ConstIterator edgesEnd = graph.GetEdges().End();
+
+	for (int i = 0; edgesIt && edgesIt != edgesEnd; i++, ++edgesIt)
+	{
+		SolverCacheAddressEntry startNode = { (*edgesIt).GetStartNode(), -1 };
+		SolverCacheAddressEntry endNode = { (*edgesIt).GetEndNode(), -1 };
+
+		edgesNodes[i * 2] = std::lower_bound(nodesAddresses, nodesAddresses + nodesCount, startNode, SolverCacheAddressEntryComparator())->_position;
+		edgesNodes[i * 2 + 1] = std::lower_bound(nodesAddresses, nodesAddresses + nodesCount, endNode, SolverCacheAddressEntryComparator())->_position;
+	}
+
+	graphKey._nodesCount = HashCanonicalGraph(graph.GetGraphType(), nodesNames, nodesCount, edgesNodes, edgesCount, graphKey._key, graphKey._nodesOrderKey);
+	graphKey._edgesCount = edgesCount;
+
+	free(edgesNodes);
+	free(nodesAddresses);
+	free(nodesNames);
+}
+
+/** Computes the key of the graph found by DotParser::ParseElements */
+void ASDProjectSolverCache::BuildPendingGraphKey(const DotParser::PendingGraph& pendingGraph, GraphKey& graphKey)
+{
+	int nodesCount = pendingGraph._nodesCount;
+	int edgesCount = pendingGraph._edgesCount;
+
+	// The parser stores a node every time it's found, so the same name can be there more than once
+	SolverCacheNodeName* nodesNames = (SolverCacheNodeName*)malloc(sizeof(SolverCacheNodeName) * (nodesCount > 0 ? nodesCount : 1));
+	int* edgesNodes = (int*)malloc(sizeof(int) * (edgesCount > 0 ? edgesCount * 2 : 1));
+
+	for (int position = 0; position < nodesCount; position++)
+	{
+		nodesNames[position]._name = pendingGraph._nodes[position]._name.data();
+		nodesNames[position]._length = pendingGraph._nodes[position]._name.length();
+		nodesNames[position]._position = position;
+	}
+
+	for (int i = 0; i < edgesCount; i++)
+	{
+		edgesNodes[i * 2] = pendingGraph._edges[i]._startNodeIndex;
+		edgesNodes[i * 2 + 1] = pendingGraph._edges[i]._endNodeIndex;
+	}
+
+	graphKey._nodesCount = HashCanonicalGraph(pendingGraph._graphType, nodesNames, nodesCount, edgesNodes, edgesCount, graphKey._key, graphKey._nodesOrderKey);
+	graphKey._edgesCount = edgesCount;
+
+	free(edgesNodes);
+	free(nodesNames);
+}
+
+/** Computes the key of the given binary graph. Returns false if the data isn't a valid binary graph */
+bool ASDProjectSolverCache::BuildBinaryGraphKey(const char* data, size_t dataLength, GraphKey& graphKey)
+{
+	if (BinaryGraphReader::IsBinaryGraph(data, dataLength) == false || dataLength < sizeof(BinaryGraphFormat::Header))
+		return false;
+
+	BinaryGraphFormat::Header header;
+	memcpy(&header, data, sizeof(header));
+
+	unsigned long long expectedLength = sizeof(BinaryGraphFormat::Header)
+		+ (unsigned long long)header._nodesCount * sizeof(BinaryGraphFormat::NodeRecord)
+		+ (unsigned long long)header._edgesCount * sizeof(BinaryGraphFormat::EdgeRecord)
+		+ (unsigned long long)header._attributesCount * sizeof(BinaryGraphFormat::AttributeRecord)
+		+ (unsigned long long)header._stringsBlobSize;
+
+	if (header._byteOrderMark != BinaryGraphFormat::s_byteOrderMark || header._version != BinaryGraphFormat::s_version || expectedLength > (unsigned long long)dataLength)
+		return false;
+
+	const char* nodes = data + sizeof(BinaryGraphFormat::Header);
+	const char* edges = nodes + (size_t)header._nodesCount * sizeof(BinaryGraphFormat::NodeRecord);
+	const char* strings = edges + (size_t)header._edgesCount * sizeof(BinaryGraphFormat::EdgeRecord) + (size_t)header._attributesCount * sizeof(BinaryGraphFormat::AttributeRecord);
+
+	int nodesCount = (int)header._nodesCount;
+	int edgesCount = (int)header._edgesCount;
+	bool valid = true;
+
+	// Only the names of the nodes and the nodes of the edges are read. The records are copied one at a time, like the reader does, since the data can have any alignment
+	SolverCacheNodeName* nodesNames = (SolverCacheNodeName*)malloc(sizeof(SolverCacheNodeName) * (nodesCount > 0 ? nodesCount : 1));
+	int* edgesNodes = (int*)malloc(sizeof(int) * (edgesCount > 0 ? edgesCount * 2 : 1));
+
+	for (int position = 0; valid && position < nodesCount; position++)
+	{
+		BinaryGraphFormat::NodeRecord node;
+		memcpy(&node, nodes + (size_t)position * sizeof(node), sizeof(node));
+
+		valid = node._nameOffset <= header._stringsBlobSize && node._nameLength <= header._stringsBlobSize - node._nameOffset && node._nameLength > 0;
+
+		nodesNames[position]._name = strings + node._nameOffset;
+		nodesNames[position]._length = node._nameLength;
+		nodesNames[position]._position = position;
+	}
+
+	for (int i = 0; valid && i < edgesCount; i++)
+	{
+		BinaryGraphFormat::EdgeRecord edge;
+		memcpy(&edge, edges + (size_t)i * sizeof(edge), sizeof(edge));
+
+		valid = edge._startNode < header._nodesCount && edge._endNode < header._nodesCount;
+
+		edgesNodes[i * 2] = (int)edge._startNode;
+		edgesNodes[i * 2 + 1] = (int)edge._endNode;
+	}
+
+	if (valid)
+	{
+		Graph::GraphType graphType = (header._flags & BinaryGraphFormat::s_graphFlagDirected) != 0 ? Graph::GT_Directed : Graph::GT_Simple;
+
+		graphKey._nodesCount = HashCanonicalGraph(graphType, nodesNames, nodesCount, edgesNodes, edgesCount, graphKey._key, graphKey._nodesOrderKey);
+		graphKey._edgesCount = edgesCount;
+	}
+
+	free(edgesNodes);
+	free(nodesNames);
+
+	return valid;
+}
+
+/** Adds to the key the options that change the results, so that the same graph has a different entry for each of them */
+void ASDProjectSolverCache::AddOptionsToKey(GraphKey& graphKey) const
+{
+	// Without them the key is the one of the graph, so the stored entries stay valid
+	graphKey._key[0] ^= (uint64_t)(_solverOptions & ASDProjectSolver::O_CondenseCycles) * 0x9E3779B97F4A7C15ULL;
+}
+
+/** Returns a copy of the entry that can be used for the graph with the given key, looking inside the memory and then inside the store folder, or nullptr if there isn't one */
+ASDProjectSolverCache::Entry* ASDProjectSolverCache::GetEntry(const GraphKey& graphKey)
+{
+	// The entry is copied so that it's applied without holding the lock
+	Entry* entry = nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		Entry* foundEntry = FindEntry(graphKey);
+		if (foundEntry != nullptr)
+			entry = CopyEntry(*foundEntry);
+	}
+
+	if (entry == nullptr && _storeFolderPath.empty() == false && (entry = LoadEntry(graphKey._key)) != nullptr)
+	{
+		if (entry->_nodesCount != graphKey._nodesCount || entry->_edgesCount != graphKey._edgesCount)
+		{
+			DeleteEntry(entry);
+			return nullptr;
+		}
+
+		Entry* memoryEntry = CopyEntry(*entry);
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		AddEntry(memoryEntry);
+	}
+
+	// The result of a tie broken by the order of the nodes can be used only by the graphs with the nodes in the same order
+	if (entry != nullptr && entry->_orderDependent && (entry->_nodesOrderKey[0] != graphKey._nodesOrderKey[0] || entry->_nodesOrderKey[1] != graphKey._nodesOrderKey[1]))
+	{
+		DeleteEntry(entry);
+		return nullptr;
+	}
+
+	return entry;
+}
+
+/** Solves inputGraph saving the result into 'result', and adds the entry of the result to the cache */
+bool ASDProjectSolverCache::SolveGraph(const Graph& inputGraph, const GraphKey& graphKey, Graph& result, std::ostream& messages)
+{
+	// Solve the graph and keep the messages of the solver for the next times
+	std::ostringstream solverMessages;
+	ASDProjectSolver::SolutionDetails details;
+
+	bool solved = ASDProjectSolver::ProcessData(inputGraph, result, solverMessages, _solverOptions, &details);
+
+	messages << solverMessages.str();
+
+	Entry* entry = CreateEntry(graphKey, result, solved, solverMessages.str(), details);
+
+	if (entry != nullptr && _storeFolderPath.empty() == false)
+		SaveEntry(*entry);
+
+	_missesCount++;
+
+	if (entry != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		AddEntry(entry);
+	}
+
+	return solved;
+}
+
+/** Creates the entry that describes the solution contained inside result. Returns nullptr if result isn't a solution of the graph */
+ASDProjectSolverCache::Entry* ASDProjectSolverCache::CreateEntry(const GraphKey& graphKey, const Graph& result, bool solved, const std::string& message, const ASDProjectSolver::SolutionDetails& details)
+{
+	Entry* entry = NewEntry();
+	entry->_key[0] = graphKey._key[0];
+	entry->_key[1] = graphKey._key[1];
+	entry->_nodesCount = graphKey._nodesCount;
+	entry->_edgesCount = graphKey._edgesCount;
+	entry->_nodesOrderKey[0] = graphKey._nodesOrderKey[0];
+	entry->_nodesOrderKey[1] = graphKey._nodesOrderKey[1];
+	entry->_solved = solved;
+
+	if (solved == false)
+	{
+		entry->_message = message;
+		return entry;
+	}
+
+	// The root is the only node at distance 0
+	const Node* root = nullptr;
+
+	Graph::NodeList::ConstIterator nodesIt = result.GetNodes().Begin();
+	Graph::NodeList::ConstIterator nodesEnd = result.GetNodes().End();
+
+	for (; root == nullptr && nodesIt && nodesIt != nodesEnd; ++nodesIt)
+	{
+		if ((*nodesIt).GetDistanceFromRoot() == 0)
+			root = &(*nodesIt);
+	}
+
+	// The solver keeps the edges of the input graph and adds its edges at the end
+	int addedEdgesCount = result.GetEdges().GetSize() - graphKey._edgesCount;
+
+	if (root == nullptr || addedEdgesCount < 0 || addedEdgesCount != details._addedEdgesCount)
+	{
+		DeleteEntry(entry);
+		return nullptr;
+	}
+
+	entry->_orderDependent = details._tiesBrokenByOrder;
+	entry->_root = root->GetName();
+	entry->_addedEdgesCount = addedEdgesCount;
+	entry->_addedEdgesNodes = new std::string[addedEdgesCount > 0 ? addedEdgesCount : 1];
+	entry->_addedEdgesGains = (int*)malloc(sizeof(int) * (addedEdgesCount > 0 ? addedEdgesCount : 1));
+
+	bool valid = true;
+
+	Graph::EdgeList::ConstIterator edgesIt = result.GetEdges().Begin();
+	Graph::EdgeList::ConstIterator edgesEnd = result.GetEdges().End();
+
+	for (int position = 0; valid && edgesIt && edgesIt != edgesEnd; position++, ++edgesIt)
+	{
+		const Edge& edge = *edgesIt;
+		int addedEdgeIndex = position - graphKey._edgesCount;
+
+		if (edge.IsAddedBySolver() != (addedEdgeIndex >= 0) || (addedEdgeIndex >= 0 && edge.GetStartNode() != root))
+			valid = false;
+		else if (addedEdgeIndex >= 0)
+		{
+			entry->_addedEdgesNodes[addedEdgeIndex] = edge.GetEndNode()->GetName();
+			entry->_addedEdgesGains[addedEdgeIndex] = details._addedEdgesGains[addedEdgeIndex];
+		}
+	}
+
+	if (valid == false)
+	{
+		DeleteEntry(entry);
+		return nullptr;
+	}
+
+	return entry;
+}
+
+/**
+* Applies the given entry to result, which contains the graph of the entry, changing it like the solver would
+* Returns false if the entry doesn't match the graph
+*/
+bool ASDProjectSolverCache::ApplyEntry(const Entry& entry, Graph& result, std::ostream& messages)
+{
+	if (entry._solved == false)
+	{
+		messages << entry._message;
+		return true;
+	}
+
+	int nodesCount = result.GetNodes().GetSize();
+
+	// Find the nodes by name
+	Node** nodes = (Node**)malloc(sizeof(Node*) * (nodesCount > 0 ? nodesCount : 1));
+	SolverCacheNodeName* nodesNames = (SolverCacheNodeName*)malloc(sizeof(SolverCacheNodeName) * (nodesCount > 0 ? nodesCount : 1));
+	SolverCacheAddedEdge* addedEdges = (SolverCacheAddedEdge*)malloc(sizeof(SolverCacheAddedEdge) * (entry._addedEdgesCount > 0 ? entry._addedEdgesCount : 1));
+
+	result.GetNodesArray(nodes);
+
+	for (int position = 0; position < nodesCount; position++)
+	{
+		nodesNames[position]._name = nodes[position]->GetName().data();
+		nodesNames[position]._length = nodes[position]->GetName().length();
+		nodesNames[position]._position = position;
+	}
+
+	std::sort(nodesNames, nodesNames + nodesCount, SolverCacheNodeNameComparator());
+
+	int rootPosition = FindNodePosition(nodesNames, nodesCount, entry._root);
+	bool valid = rootPosition >= 0;
+
+	for (int i = 0; valid && i < entry._addedEdgesCount; i++)
+	{
+		addedEdges[i]._nodePosition = FindNodePosition(nodesNames, nodesCount, entry._addedEdgesNodes[i]);
+		addedEdges[i]._gain = entry._addedEdgesGains[i];
+
+		valid = addedEdges[i]._nodePosition >= 0;
+	}
+
+	// Without ties broken by the order of the nodes, the solver adds the same edges sorted by the number of reached nodes and then by the order of the nodes of this graph
+	if (valid && entry._orderDependent == false)
+		std::sort(addedEdges, addedEdges + entry._addedEdgesCount, SolverCacheAddedEdgeComparator());
+
+	// Rename the graph and add the edges from the root like the solver does
+	result.SetName("out_" + result.GetName(), result.EncloseNameInDoubleQuotes());
+
+	for (int i = 0; valid && i < entry._addedEdgesCount; i++)
+	{
+		Edge* addedEdge = result.AddEdge(nodes[rootPosition], nodes[addedEdges[i]._nodePosition]);
+
+		if (addedEdge == nullptr)
+			valid = false;
+		else
+		{
+			addedEdge->SetAttribute("color", "red", false, false);
+			addedEdge->SetAddedBySolver(true);
+		}
+	}
+
+	if (valid)
+	{
+		Node* root = nodes[rootPosition];
+		root->SetAttribute("label", "root = " + root->GetName() + "; |E| - |E'| = " + std::to_string(entry._addedEdgesCount), false, true);
+
+		// The edge of the best path of a node depends on the order of the edges, so the best paths are computed again
+		result.ComputeBestPathsFromRoot(root);
+	}
+
+	free(addedEdges);
+	free(nodesNames);
+	free(nodes);
+
+	return valid;
+}
+
+/** Returns the entry with the given key kept in memory, or nullptr if there isn't one */
+ASDProjectSolverCache::Entry* ASDProjectSolverCache::FindEntry(const GraphKey& graphKey)
+{
+	int position = FindKeyPosition(_entries, _entriesCount, graphKey._key);
+
+	if (position == _entriesCount || IsKeyLess(graphKey._key, _entries[position]->_key))
+		return nullptr;
+
+	Entry* entry = _entries[position];
+
+	if (entry->_nodesCount != graphKey._nodesCount || entry->_edgesCount != graphKey._edgesCount)
+		return nullptr;
+
+	entry->_lastUse = ++_useCounter;
+
+	return entry;
+}
+
+/** Adds the entry to the memory, replacing the entry with the same key or removing the oldest entry if the cache is full */
+void ASDProjectSolverCache::AddEntry(Entry* entry)
+{
+	int position = FindKeyPosition(_entries, _entriesCount, entry->_key);
+
+	entry->_lastUse = ++_useCounter;
+
+	// The entry with the same key was added by another thread, or it was solved for another order of the nodes
+	if (position < _entriesCount && IsKeyLess(entry->_key, _entries[position]->_key) == false)
+	{
+		DeleteEntry(_entries[position]);
+		_entries[position] = entry;
+		return;
+	}
+
+	// Remove the entry used the longest time ago
+	if (_maxEntriesCount > 0 && _entriesCount >= _maxEntriesCount)
+	{
+		int oldestEntry = 0;
+
+		for (int i = 1; i < _entriesCount; i++)
+		{
+			if (_entries[i]->_lastUse < _entries[oldestEntry]->_lastUse)
+				oldestEntry = i;
+		}
+
+		DeleteEntry(_entries[oldestEntry]);
+		memmove(_entries + oldestEntry, _entries + oldestEntry + 1, sizeof(Entry*) * (_entriesCount - oldestEntry - 1));
+		_entriesCount--;
+
+		if (oldestEntry < position)
+			position--;
+	}
+
+	if (_entriesCount == _entriesCapacity)
+	{
+		_entriesCapacity = (_entriesCapacity > 0) ? _entriesCapacity * 2 : 64;
+		_entries = (Entry**)realloc(_entries, sizeof(Entry*) * _entriesCapacity);
+	}
+
+	// Keep the entries sorted by key
+	memmove(_entries + position + 1, _entries + position, sizeof(Entry*) * (_entriesCount - position));
+	_entries[position] = entry;
+	_entriesCount++;
+}
+
+/** Returns the position of the first entry whose key is not less than the given one */
+int ASDProjectSolverCache::FindKeyPosition(Entry* const* entries, int entriesCount, const uint64_t key[2])
+{
+	int low = 0;
+	int high = entriesCount;
+
+	while (low < high)
+	{
+		int middle = (low + high) / 2;
+
+		if (IsKeyLess(entries[middle]->_key, key))
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return low;
+}
+
+/** Returns the path of the file of the entry with the given key inside the store folder */
+std::string ASDProjectSolverCache::GetEntryFilePath(const uint64_t key[2]) const
+{
+	char fileName[48];
+	snprintf(fileName, sizeof(fileName), "%016llx%016llx.asdc", (unsigned long long)key[0], (unsigned long long)key[1]);
+
+	return _storeFolderPath + fileName;
+}
+
+/** Writes the entry to the store folder */
+bool ASDProjectSolverCache::SaveEntry(const Entry& entry) const
+{
+	SolverCacheEntryFileHeader header;
+	header._magic = s_entryFileMagic;
+	header._byteOrderMark = s_entryFileByteOrderMark;
+	header._version = s_entryFileVersion;
+	header._solved = entry._solved ? 1 : 0;
+	header._key[0] = entry._key[0];
+	header._key[1] = entry._key[1];
+	header._nodesOrderKey[0] = entry._nodesOrderKey[0];
+	header._nodesOrderKey[1] = entry._nodesOrderKey[1];
+	header._nodesCount = entry._nodesCount;
+	header._edgesCount = entry._edgesCount;
+	header._orderDependent = entry._orderDependent ? 1 : 0;
+	header._addedEdgesCount = entry._addedEdgesCount;
+	header._rootLength = (int32_t)entry._root.length();
+	header._messageLength = (int32_t)entry._message.length();
+
+	// Write to a temporary file and rename it, so that the other processes never read a file that is being written
+	std::string filePath = GetEntryFilePath(entry._key);
+	std::string temporaryFilePath = filePath + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+	{
+		std::ofstream file(temporaryFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		if (!file.is_open())
+		{
+			std::cerr << "ASDProjectSolverCache error [SaveEntry]: cannot create the file " << temporaryFilePath << std::endl;
+			return false;
+		}
+
+		file.write((const char*)&header, sizeof(header));
+		file.write(entry._message.data(), entry._message.length());
+		file.write(entry._root.data(), entry._root.length());
+
+		for (int i = 0; i < entry._addedEdgesCount; i++)
+		{
+			int32_t gain = entry._addedEdgesGains[i];
+			int32_t nameLength = (int32_t)entry._addedEdgesNodes[i].length();
+
+			file.write((const char*)&gain, sizeof(gain));
+			file.write((const char*)&nameLength, sizeof(nameLength));
+			file.write(entry._addedEdgesNodes[i].data(), nameLength);
+		}
+
+		if (!file)
+		{
+			std::cerr << "ASDProjectSolverCache error [SaveEntry]: cannot write the file " << temporaryFilePath << std::endl;
+			file.close();
+			std::remove(temporaryFilePath.c_str());
+			return false;
+		}
+	}
+
+	if (std::rename(temporaryFilePath.c_str(), filePath.c_str()) != 0)
+	{
+		std::remove(temporaryFilePath.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/** Reads the entry with the given key from the store folder. Returns nullptr if there isn't one */
+ASDProjectSolverCache::Entry* ASDProjectSolverCache::LoadEntry(const uint64_t key[2]) const
+{
+	std::ifstream file(GetEntryFilePath(key), std::ios::in | std::ios::binary);
+
+	if (!file.is_open())
+		return nullptr;
+
+	SolverCacheEntryFileHeader header;
+
+	if (!file.read((char*)&header, sizeof(header)) || header._magic != s_entryFileMagic || header._byteOrderMark != s_entryFileByteOrderMark ||
+		header._version != s_entryFileVersion || header._key[0] != key[0] || header._key[1] != key[1] || header._nodesCount < 0 || header._edgesCount < 0 ||
+		header._addedEdgesCount < 0 || header._addedEdgesCount > header._nodesCount || header._rootLength < 0 || header._messageLength < 0)
+		return nullptr;
+
+	Entry* entry = NewEntry();
+	entry->_key[0] = key[0];
+	entry->_key[1] = key[1];
+	entry->_nodesOrderKey[0] = header._nodesOrderKey[0];
+	entry->_nodesOrderKey[1] = header._nodesOrderKey[1];
+	entry->_nodesCount = header._nodesCount;
+	entry->_edgesCount = header._edgesCount;
+	entry->_orderDependent = header._orderDependent != 0;
+	entry->_solved = header._solved != 0;
+
+	entry->_message.resize((size_t)header._messageLength);
+	entry->_root.resize((size_t)header._rootLength);
+
+	bool valid = (header._messageLength == 0 || file.read(&entry->_message[0], header._messageLength)) && (header._rootLength == 0 || file.read(&entry->_root[0], header._rootLength));
+
+	if (valid && entry->_solved)
+	{
+		entry->_addedEdgesCount = header._addedEdgesCount;
+		entry->_addedEdgesNodes = new std::string[entry->_addedEdgesCount > 0 ? entry->_addedEdgesCount : 1];
+		entry->_addedEdgesGains = (int*)malloc(sizeof(int) * (entry->_addedEdgesCount > 0 ? entry->_addedEdgesCount : 1));
+
+		for (int i = 0; valid && i < entry->_addedEdgesCount; i++)
+		{
+			int32_t gain = 0;
+			int32_t nameLength = 0;
+
+			valid = file.read((char*)&gain, sizeof(gain)) && file.read((char*)&nameLength, sizeof(nameLength)) && nameLength > 0;
+
+			if (valid)
+			{
+				entry->_addedEdgesGains[i] = gain;
+				entry->_addedEdgesNodes[i].resize((size_t)nameLength);
+				valid = !!file.read(&entry->_addedEdgesNodes[i][0], nameLength);
+			}
+		}
+	}
+
+	if (valid == false)
+	{
+		std::cerr << "ASDProjectSolverCache error [LoadEntry]: the file " << GetEntryFilePath(key) << " is not valid" << std::endl;
+		DeleteEntry(entry);
+		return nullptr;
+	}
+
+	return entry;
+}
+
+/** Returns a copy of the given entry */
+ASDProjectSolverCache::Entry* ASDProjectSolverCache::CopyEntry(const Entry& entry)
+{
+	Entry* copy = new Entry(entry);
+
+	if (entry._addedEdgesNodes != nullptr)
+	{
+		int allocatedCount = entry._addedEdgesCount > 0 ? entry._addedEdgesCount : 1;
+
+		copy->_addedEdgesNodes = new std::string[allocatedCount];
+		copy->_addedEdgesGains = (int*)malloc(sizeof(int) * allocatedCount);
+
+		for (int i = 0; i < entry._addedEdgesCount; i++)
+		{
+			copy->_addedEdgesNodes[i] = entry._addedEdgesNodes[i];
+			copy->_addedEdgesGains[i] = entry._addedEdgesGains[i];
+		}
+	}
+
+	return copy;
+}
+
+/** Creates an entry without results */
+ASDProjectSolverCache::Entry* ASDProjectSolverCache::NewEntry()
+{
+	Entry* entry = new Entry();
+	entry->_key[0] = 0;
+	entry->_key[1] = 0;
+	entry->_nodesCount = 0;
+	entry->_edgesCount = 0;
+	entry->_orderDependent = false;
+	entry->_nodesOrderKey[0] = 0;
+	entry->_nodesOrderKey[1] = 0;
+	entry->_solved = false;
+	entry->_addedEdgesCount = 0;
+	entry->_addedEdgesNodes = nullptr;
+	entry->_addedEdgesGains = nullptr;
+	entry->_lastUse = 0;
+
+	return entry;
+}
+
+/** Deletes the entry and its values */
+void ASDProjectSolverCache::DeleteEntry(Entry* entry)
+{
+	if (entry == nullptr)
+		return;
+
+	delete[] entry->_addedEdgesNodes;
+	free(entry->_addedEdgesGains);
+	delete entry;
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "ASDProjectSolverProfiler.h"
+
+#include <chrono>
+#include <cstring>
+
+/** The time spent inside every phase by the thread */
+static thread_local double s_phaseTimes[ASDProjectSolverProfiler::P_Count] = { };
+
+/** The increments of the counters inside every phase of the thread */
+static thread_local long long s_phaseCounters[ASDProjectSolverProfiler::P_Count][ASDProjectSolverProfiler::MaxCountersCount] = { };
+
+/** The reader of the counters of the thread and its context */
+static thread_local ASDProjectSolverProfiler::CountersReader s_countersReader = nullptr;
+static thread_local void* s_countersReaderContext = nullptr;
+
+/** The innermost timer running on the thread */
+static thread_local ASDProjectSolverProfiler::ScopedTimer* s_currentTimer = nullptr;
+
+/** Returns the time of the monotonic clock, in seconds */
+static double GetProfilerTime()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** Starts measuring the given phase */
+ASDProjectSolverProfiler::ScopedTimer::ScopedTimer(Phase phase)
+	: _phase(phase)
+	, _startTime(0.0)
+	, _nestedTime(0.0)
+	, _parent(s_currentTimer)
+{
+	s_currentTimer = this;
+
+	if (s_countersReader != nullptr)
+	{
+		memset(_nestedCounters, 0, sizeof(_nestedCounters));
+		s_countersReader(s_countersReaderContext, _startCounters);
+	}
+
+	_startTime = GetProfilerTime();
+}
+
+/** Adds the time spent since the constructor to the phase */
+ASDProjectSolverProfiler::ScopedTimer::~ScopedTimer()
+{
+	double time = GetProfilerTime() - _startTime;
+
+	s_phaseTimes[_phase] += time - _nestedTime;
+
+	if (_parent != nullptr)
+		_parent->_nestedTime += time;
+
+	if (s_countersReader != nullptr)
+	{
+		long long counters[MaxCountersCount];
+		s_countersReader(s_countersReaderContext, counters);
+
+		for (int i = 0; i < MaxCountersCount; i++)
+		{
+			long long increment = counters[i] - _startCounters[i];
+
+			s_phaseCounters[_phase][i] += increment - _nestedCounters[i];
+
+			if (_parent != nullptr)
+				_parent->_nestedCounters[i] += increment;
+		}
+	}
+
+	s_currentTimer = _parent;
+}
+
+/** Returns true if the solver was compiled with the timers */
+bool ASDProjectSolverProfiler::IsEnabled()
+{
+#ifdef ASD_PROFILE_SOLVER
+	return true;
+#else
+	return false;
+#endif
+}
+
+/** Returns the name of the given phase */
+const char* ASDProjectSolverProfiler::GetPhaseName(Phase phase)
+{
+	switch (phase)
+	{
+	case P_CopyInput:
+		return "copy input";
+	case P_CycleCheck:
+		return "cycle check";
+	case P_Condensation:
+		return "condensation";
+	case P_TransitiveReduction:
+		return "transitive reduction";
+	case P_Components:
+		return "components";
+	case P_Candidates:
+		return "candidate roots";
+	case P_AddedEdges:
+		return "added edges";
+	case P_BestPaths:
+		return "best paths";
+	case P_Count:
+		break;
+	}
+
+	return "";
+}
+
+/** Copies the time (in seconds) spent inside every phase by the calling thread since the last call to Reset into 'times', which must contain P_Count elements */
+void ASDProjectSolverProfiler::GetPhaseTimes(double* times)
+{
+	memcpy(times, s_phaseTimes, sizeof(double) * P_Count);
+}
+
+/**
+* Sets the reader of the counters added to the phases by the calling thread, or removes it if reader is nullptr.
+* The reader is called twice by every timer, so it should be fast. It must not be changed while a timer of the thread is running
+*/
+void ASDProjectSolverProfiler::SetCountersReader(CountersReader reader, void* context)
+{
+	s_countersReader = reader;
+	s_countersReaderContext = context;
+}
+
+/**
+* Copies the increments of the counters inside every phase of the calling thread since the last call to Reset into 'counters',
+* which must contain P_Count * MaxCountersCount elements (the counters of a phase are consecutive)
+*/
+void ASDProjectSolverProfiler::GetPhaseCounters(long long* counters)
+{
+	memcpy(counters, s_phaseCounters, sizeof(long long) * P_Count * MaxCountersCount);
+}
+
+/** Sets to 0 the times and the counters of the phases of the calling thread */
+void ASDProjectSolverProfiler::Reset()
+{
+	memset(s_phaseTimes, 0, sizeof(double) * P_Count);
+	memset(s_phaseCounters, 0, sizeof(long long) * P_Count * MaxCountersCount);
+}
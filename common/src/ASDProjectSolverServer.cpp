@@ -0,0 +1,637 @@
+#include "ASDProjectSolverServer.h"
+#include "ASDProjectSolver.h"
+#include "BinaryGraphReader.h"
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// Not every platform has the flag. Without it a client that closes the connection raises SIGPIPE
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+
+/** The time waited by the blocking calls before checking if the server is stopping */
+static const int s_pollTimeoutMilliseconds = 250;
+
+/** The maximum length of the header line of a request */
+static const size_t s_maxHeaderLength = 256;
+
+#ifndef _WIN32
+/** Adds a connection to the idle connections, growing the array of the connections and the one of their poll descriptors (which has two more elements) if needed */
+static void AddIdleConnection(int*& idleConnections, pollfd*& pollDescriptors, int& idleConnectionsCount, int& idleConnectionsCapacity, int connection)
+{
+	if (idleConnectionsCount == idleConnectionsCapacity)
+	{
+		idleConnectionsCapacity *= 2;
+		idleConnections = (int*)realloc(idleConnections, sizeof(int) * idleConnectionsCapacity);
+		pollDescriptors = (pollfd*)realloc(pollDescriptors, sizeof(pollfd) * (idleConnectionsCapacity + 2));
+	}
+
+	idleConnections[idleConnectionsCount++] = connection;
+}
+#endif
+
+/** Returns the output format with the given name, or false if the name is not valid */
+static bool ParseOutputFormatName(const std::string& name, ASDProjectBatchSolver::OutputFormat& outputFormat)
+{
+	if (name == "dot")
+		outputFormat = ASDProjectBatchSolver::OF_Dot;
+	else if (name == "binary")
+		outputFormat = ASDProjectBatchSolver::OF_Binary;
+	else if (name == "delta")
+		outputFormat = ASDProjectBatchSolver::OF_Delta;
+	else if (name == "delta-dot")
+		outputFormat = ASDProjectBatchSolver::OF_DeltaDot;
+	else
+		return false;
+
+	return true;
+}
+
+/** Default constructor */
+ASDProjectSolverServer::LatencyStats::LatencyStats()
+	: _requestsCount(0)
+	, _failedRequestsCount(0)
+	, _totalMicroseconds(0)
+	, _minMicroseconds(0)
+	, _maxMicroseconds(0)
+{
+	for (int i = 0; i < s_bucketsCount; i++)
+		_buckets[i] = 0;
+}
+
+/** Adds a request that took the given time */
+void ASDProjectSolverServer::LatencyStats::Add(long long microseconds, bool failed)
+{
+	if (_requestsCount == 0 || microseconds < _minMicroseconds)
+		_minMicroseconds = microseconds;
+	if (microseconds > _maxMicroseconds)
+		_maxMicroseconds = microseconds;
+
+	_requestsCount++;
+	_totalMicroseconds += microseconds;
+
+	if (failed)
+		_failedRequestsCount++;
+
+	int bucket = 0;
+	while (bucket < s_bucketsCount - 1 && (1LL << bucket) <= microseconds)
+		bucket++;
+
+	_buckets[bucket]++;
+}
+
+/** Returns an upper bound of the time taken by the given fraction (0..1) of the requests */
+long long ASDProjectSolverServer::LatencyStats::GetPercentile(double fraction) const
+{
+	if (_requestsCount == 0)
+		return 0;
+
+	long long requestsToCount = (long long)(fraction * _requestsCount + 0.5);
+	long long requests = 0;
+
+	for (int i = 0; i < s_bucketsCount; i++)
+	{
+		requests += _buckets[i];
+
+		// The maximum is a better bound than the end of the last bucket
+		if (requests >= requestsToCount)
+			return (1LL << i) < _maxMicroseconds ? (1LL << i) : _maxMicroseconds;
+	}
+
+	return _maxMicroseconds;
+}
+
+/**
+* Constructor
+* threadsCount: the number of workers, which is the number of requests served at the same time
+* defaultOutputFormat: the format of the results when a SOLVE request doesn't specify it
+*/
+ASDProjectSolverServer::ASDProjectSolverServer(int threadsCount, ASDProjectBatchSolver::OutputFormat defaultOutputFormat)
+	: _workers(nullptr)
+	, _workersCount(threadsCount > 0 ? threadsCount : 1)
+	, _defaultOutputFormat(defaultOutputFormat)
+	, _cache(nullptr)
+	, _solverOptions(ASDProjectSolver::O_None)
+	, _requestTimeoutMilliseconds(s_defaultRequestTimeoutMilliseconds)
+	, _running(false)
+{
+	_workers = new Worker[_workersCount];
+	_wakeUpPipe[0] = -1;
+	_wakeUpPipe[1] = -1;
+}
+
+/** Destructor */
+ASDProjectSolverServer::~ASDProjectSolverServer()
+{
+	delete[] _workers;
+}
+
+/**
+* Listens on the socket with the given path and serves the connections until Stop is called
+* Returns false if the socket can't be created
+*/
+bool ASDProjectSolverServer::Run(const std::string& socketPath)
+{
+#ifndef _WIN32
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+
+	if (socketPath.empty() || socketPath.length() >= sizeof(address.sun_path))
+	{
+		std::cerr << "ASDProjectSolverServer error [Run]: the socket path is empty or too long" << std::endl;
+		return false;
+	}
+
+	memcpy(address.sun_path, socketPath.c_str(), socketPath.length());
+
+	int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0)
+	{
+		std::cerr << "ASDProjectSolverServer error [Run]: cannot create the socket (" << strerror(errno) << ")" << std::endl;
+		return false;
+	}
+
+	// Remove the socket left by a previous server
+	unlink(socketPath.c_str());
+
+	if (bind(listener, (sockaddr*)&address, sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0)
+	{
+		std::cerr << "ASDProjectSolverServer error [Run]: cannot listen on " << socketPath << " (" << strerror(errno) << ")" << std::endl;
+		close(listener);
+		return false;
+	}
+
+	// The workers write to the pipe to wake up this thread when they give a connection back. Neither end blocks
+	if (pipe(_wakeUpPipe) != 0 || fcntl(_wakeUpPipe[0], F_SETFL, O_NONBLOCK) != 0 || fcntl(_wakeUpPipe[1], F_SETFL, O_NONBLOCK) != 0)
+	{
+		std::cerr << "ASDProjectSolverServer error [Run]: cannot create the wake up pipe (" << strerror(errno) << ")" << std::endl;
+		close(listener);
+		unlink(socketPath.c_str());
+		return false;
+	}
+
+	_running = true;
+
+	std::thread* threads = new std::thread[_workersCount];
+	for (int i = 0; i < _workersCount; i++)
+		threads[i] = std::thread(&ASDProjectSolverServer::RunWorker, this, i);
+
+	// The connections without a request are watched here together with the listener and the pipe, so that they don't hold a worker.
+	// The first two poll descriptors are the ones of the listener and of the pipe
+	int idleConnectionsCount = 0;
+	int idleConnectionsCapacity = 16;
+	int* idleConnections = (int*)malloc(sizeof(int) * idleConnectionsCapacity);
+	pollfd* pollDescriptors = (pollfd*)malloc(sizeof(pollfd) * (idleConnectionsCapacity + 2));
+
+	while (_running)
+	{
+		// Watch again the connections given back by the workers
+		{
+			std::lock_guard<std::mutex> lock(_connectionsMutex);
+
+			while (_returnedConnections.GetSize() > 0)
+			{
+				List<int>::Iterator it = _returnedConnections.Begin();
+				AddIdleConnection(idleConnections, pollDescriptors, idleConnectionsCount, idleConnectionsCapacity, *it);
+				_returnedConnections.Remove(it);
+			}
+		}
+
+		pollDescriptors[0].fd = listener;
+		pollDescriptors[1].fd = _wakeUpPipe[0];
+
+		for (int i = 0; i < idleConnectionsCount; i++)
+			pollDescriptors[i + 2].fd = idleConnections[i];
+
+		for (int i = 0; i < idleConnectionsCount + 2; i++)
+		{
+			pollDescriptors[i].events = POLLIN;
+			pollDescriptors[i].revents = 0;
+		}
+
+		if (poll(pollDescriptors, idleConnectionsCount + 2, s_pollTimeoutMilliseconds) <= 0)
+			continue;
+
+		// Empty the pipe. The connections given back are taken at the next iteration
+		if (pollDescriptors[1].revents != 0)
+		{
+			char wakeUps[64];
+			while (read(_wakeUpPipe[0], wakeUps, sizeof(wakeUps)) > 0)
+				;
+		}
+
+		// Queue the connections with a request for the workers. The ones closed by the client are queued too, and closed by the worker that reads them
+		int keptConnectionsCount = 0;
+
+		for (int i = 0; i < idleConnectionsCount; i++)
+		{
+			if (pollDescriptors[i + 2].revents == 0)
+			{
+				idleConnections[keptConnectionsCount++] = idleConnections[i];
+				continue;
+			}
+
+			std::lock_guard<std::mutex> lock(_connectionsMutex);
+			_pendingConnections.Add(idleConnections[i]);
+			_connectionsCondition.notify_one();
+		}
+
+		idleConnectionsCount = keptConnectionsCount;
+
+		// A new connection is watched like the others until its first request arrives
+		if (pollDescriptors[0].revents != 0)
+		{
+			int connection = accept(listener, nullptr, nullptr);
+			if (connection >= 0)
+				AddIdleConnection(idleConnections, pollDescriptors, idleConnectionsCount, idleConnectionsCapacity, connection);
+		}
+	}
+
+	close(listener);
+	unlink(socketPath.c_str());
+
+	{
+		std::lock_guard<std::mutex> lock(_connectionsMutex);
+		_connectionsCondition.notify_all();
+	}
+
+	for (int i = 0; i < _workersCount; i++)
+		threads[i].join();
+
+	delete[] threads;
+
+	// Close the connections that are still open
+	for (int i = 0; i < idleConnectionsCount; i++)
+		close(idleConnections[i]);
+
+	while (_pendingConnections.GetSize() > 0)
+	{
+		List<int>::Iterator it = _pendingConnections.Begin();
+		close(*it);
+		_pendingConnections.Remove(it);
+	}
+
+	while (_returnedConnections.GetSize() > 0)
+	{
+		List<int>::Iterator it = _returnedConnections.Begin();
+		close(*it);
+		_returnedConnections.Remove(it);
+	}
+
+	free(pollDescriptors);
+	free(idleConnections);
+
+	close(_wakeUpPipe[0]);
+	close(_wakeUpPipe[1]);
+	_wakeUpPipe[0] = -1;
+	_wakeUpPipe[1] = -1;
+
+	return true;
+#else
+	std::cerr << "ASDProjectSolverServer error [Run]: Unix domain sockets are not supported on this platform" << std::endl;
+	return false;
+#endif
+}
+
+/** Returns a copy of the latency statistics of the requests served so far */
+ASDProjectSolverServer::LatencyStats ASDProjectSolverServer::GetStats()
+{
+	std::lock_guard<std::mutex> lock(_statsMutex);
+	return _stats;
+}
+
+/** Returns the latency statistics, and the statistics of the cache if there is one, as text, one "name value" pair per line */
+std::string ASDProjectSolverServer::GetStatsText()
+{
+	LatencyStats stats = GetStats();
+	std::ostringstream text;
+
+	text
+		<< "requests " << stats._requestsCount << "\n"
+		<< "failed " << stats._failedRequestsCount << "\n"
+		<< "mean_us " << (stats._requestsCount > 0 ? stats._totalMicroseconds / stats._requestsCount : 0) << "\n"
+		<< "min_us " << stats._minMicroseconds << "\n"
+		<< "max_us " << stats._maxMicroseconds << "\n"
+		<< "p50_us " << stats.GetPercentile(0.50) << "\n"
+		<< "p90_us " << stats.GetPercentile(0.90) << "\n"
+		<< "p99_us " << stats.GetPercentile(0.99) << "\n";
+
+	if (_cache != nullptr)
+	{
+		text
+			<< "cache_hits " << _cache->GetHitsCount() << "\n"
+			<< "cache_misses " << _cache->GetMissesCount() << "\n";
+	}
+
+	return text.str();
+}
+
+/** Loop of a worker: serves one request of the connections waiting in the queue, and gives them back, until the server stops */
+void ASDProjectSolverServer::RunWorker(int workerIndex)
+{
+	Worker& worker = _workers[workerIndex];
+
+	while (true)
+	{
+		int connection = -1;
+
+		{
+			std::unique_lock<std::mutex> lock(_connectionsMutex);
+
+			while (_running && _pendingConnections.GetSize() == 0)
+				_connectionsCondition.wait(lock);
+
+			if (_running == false)
+				return;
+
+			List<int>::Iterator it = _pendingConnections.Begin();
+			connection = *it;
+			_pendingConnections.Remove(it);
+		}
+
+		if (ServeRequest(worker, connection))
+			ReturnConnection(connection);
+#ifndef _WIN32
+		else
+			close(connection);
+#endif
+	}
+}
+
+/** Gives the connection back to the thread that watches the idle connections, which waits for its next request */
+void ASDProjectSolverServer::ReturnConnection(int connection)
+{
+	{
+		std::lock_guard<std::mutex> lock(_connectionsMutex);
+		_returnedConnections.Add(connection);
+	}
+
+#ifndef _WIN32
+	// If the pipe is full the thread is already going to wake up
+	char wakeUp = 0;
+	if (write(_wakeUpPipe[1], &wakeUp, 1) < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+		std::cerr << "ASDProjectSolverServer error [ReturnConnection]: cannot wake up the server (" << strerror(errno) << ")" << std::endl;
+#endif
+}
+
+/** Serves one request of the given connection. Returns false if the connection has to be closed */
+bool ASDProjectSolverServer::ServeRequest(Worker& worker, int connection)
+{
+	// The worker gets the connection when the first byte of the request arrives, so the time given to the whole request starts now
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+
+	if (_requestTimeoutMilliseconds > 0)
+		deadline = start + std::chrono::milliseconds(_requestTimeoutMilliseconds);
+
+	std::string header;
+
+	if (!ReceiveLine(connection, header, deadline))
+	{
+		CountExpiredRequest(start, deadline);
+		return false;
+	}
+
+	std::istringstream headerStream(header);
+	std::string command;
+	headerStream >> command;
+
+	if (command == "SOLVE")
+	{
+		long long payloadLength = -1;
+		std::string outputFormatName;
+		ASDProjectBatchSolver::OutputFormat outputFormat = _defaultOutputFormat;
+
+		headerStream >> payloadLength >> outputFormatName;
+
+		// Without a valid length the payload can't be skipped, so the connection is closed
+		if (payloadLength < 0 || payloadLength > s_maxPayloadLength)
+		{
+			static const char s_invalidLength[] = "ERROR: invalid payload length";
+			SendResponse(connection, "ERROR", s_invalidLength, sizeof(s_invalidLength) - 1, 0);
+			return false;
+		}
+
+		worker._payload.resize((size_t)payloadLength);
+		if (payloadLength > 0 && !ReceiveData(connection, &worker._payload[0], (size_t)payloadLength, deadline))
+		{
+			CountExpiredRequest(start, deadline);
+			return false;
+		}
+
+		if (outputFormatName.empty() == false && ParseOutputFormatName(outputFormatName, outputFormat) == false)
+		{
+			static const char s_invalidFormat[] = "ERROR: invalid output format";
+			return SendResponse(connection, "ERROR", s_invalidFormat, sizeof(s_invalidFormat) - 1, 0);
+		}
+
+		return Solve(worker, connection, outputFormat);
+	}
+	else if (command == "STATS")
+	{
+		std::string stats = GetStatsText();
+		return SendResponse(connection, "OK", stats.data(), stats.length(), 0);
+	}
+	else if (command == "QUIT")
+		return false;
+
+	static const char s_unknownCommand[] = "ERROR: unknown command";
+	return SendResponse(connection, "ERROR", s_unknownCommand, sizeof(s_unknownCommand) - 1, 0);
+}
+
+/** Solves the payload of the worker and sends the response. Returns false if the connection has to be closed */
+bool ASDProjectSolverServer::Solve(Worker& worker, int connection, ASDProjectBatchSolver::OutputFormat outputFormat)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	// Load and solve the graph, writing the result inside the buffer of the worker, which has no output stream
+	std::ostringstream solverMessages;
+	bool validInputGraph = false;
+	bool solved = false;
+
+	if (_cache != nullptr)
+	{
+		// The cache computes its key from the payload, so a graph found inside it is built only as the result
+		int parseIndex = 0;
+		solved = _cache->ProcessData(worker._payload, parseIndex, worker._pendingGraph, worker._inputGraph, worker._resultGraph, solverMessages, validInputGraph);
+	}
+	else
+	{
+		worker._inputGraph.Clear();
+
+		if (BinaryGraphReader::IsBinaryGraph(worker._payload.data(), worker._payload.length()))
+			validInputGraph = BinaryGraphReader::Read(worker._inputGraph, worker._payload.data(), worker._payload.length());
+		else
+		{
+			int parseIndex = 0;
+			validInputGraph = DotParser::Parse(worker._inputGraph, worker._payload, parseIndex, worker._pendingGraph);
+		}
+
+		if (validInputGraph)
+			solved = ASDProjectSolver::ProcessData(worker._inputGraph, worker._resultGraph, solverMessages, _solverOptions);
+	}
+
+	std::string errorMessage = "ERROR: couldn't read the graph";
+
+	if (validInputGraph && solved == false)
+		errorMessage = solverMessages.str();
+
+	worker._outputBuffer.SetOutput(nullptr);
+	worker._outputBuffer.Clear();
+
+	if (solved && ASDProjectBatchSolver::WriteResult(worker._resultGraph, outputFormat, worker._outputBuffer) == false)
+	{
+		solved = false;
+		errorMessage = "ERROR: couldn't write the result";
+	}
+
+	long long microseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+	{
+		std::lock_guard<std::mutex> lock(_statsMutex);
+		_stats.Add(microseconds, solved == false);
+	}
+
+	if (solved)
+		return SendResponse(connection, "OK", worker._outputBuffer.GetData(), worker._outputBuffer.GetSize(), microseconds);
+
+	return SendResponse(connection, "ERROR", errorMessage.data(), errorMessage.length(), microseconds);
+}
+
+/** Sends a response with the given status and data. Returns false if the connection has to be closed */
+bool ASDProjectSolverServer::SendResponse(int connection, const char* status, const char* data, size_t dataLength, long long microseconds)
+{
+	std::string header = std::string(status) + " " + std::to_string(dataLength) + " " + std::to_string(microseconds) + "\n";
+
+	return SendData(connection, header.data(), header.length()) && SendData(connection, data, dataLength);
+}
+
+/** Counts as failed the request that started at the given time if its deadline has expired, which is why it couldn't be read */
+void ASDProjectSolverServer::CountExpiredRequest(const std::chrono::steady_clock::time_point& start, const std::chrono::steady_clock::time_point& deadline)
+{
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+	if (now < deadline)
+		return;
+
+	long long microseconds = std::chrono::duration_cast<std::chrono::microseconds>(now - start).count();
+
+	std::lock_guard<std::mutex> lock(_statsMutex);
+	_stats.Add(microseconds, true);
+}
+
+/** Reads a line ended by '\n', without the '\n'. Returns false if the connection was closed, the deadline expired or the server is stopping */
+bool ASDProjectSolverServer::ReceiveLine(int connection, std::string& line, const std::chrono::steady_clock::time_point& deadline)
+{
+	line.clear();
+
+	// The header is read one byte at a time so that the payload that follows it stays inside the socket
+	char character = 0;
+
+	while (ReceiveData(connection, &character, 1, deadline))
+	{
+		if (character == '\n')
+			return true;
+
+		if (line.length() >= s_maxHeaderLength)
+			return false;
+
+		if (character != '\r')
+			line += character;
+	}
+
+	return false;
+}
+
+/** Reads exactly the given number of bytes. Returns false if the connection was closed, the deadline expired or the server is stopping */
+bool ASDProjectSolverServer::ReceiveData(int connection, char* data, size_t dataLength, const std::chrono::steady_clock::time_point& deadline)
+{
+#ifndef _WIN32
+	while (dataLength > 0)
+	{
+		if (!WaitForData(connection, deadline))
+			return false;
+
+		ssize_t received = recv(connection, data, dataLength, 0);
+
+		if (received < 0 && errno == EINTR)
+			continue;
+
+		if (received <= 0)
+			return false;
+
+		data += received;
+		dataLength -= (size_t)received;
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+/** Waits until there is data to read. Returns false if the deadline expired or the server is stopping */
+bool ASDProjectSolverServer::WaitForData(int connection, const std::chrono::steady_clock::time_point& deadline)
+{
+#ifndef _WIN32
+	while (_running)
+	{
+		long long remainingMilliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+
+		if (remainingMilliseconds <= 0)
+			return false;
+
+		pollfd pollConnection = { connection, POLLIN, 0 };
+
+		int result = poll(&pollConnection, 1, remainingMilliseconds < s_pollTimeoutMilliseconds ? (int)remainingMilliseconds : s_pollTimeoutMilliseconds);
+
+		if (result > 0)
+			return true;
+
+		if (result < 0 && errno != EINTR)
+			return false;
+	}
+#endif
+
+	return false;
+}
+
+/** Writes all the given bytes. Returns false on errors */
+bool ASDProjectSolverServer::SendData(int connection, const char* data, size_t dataLength)
+{
+#ifndef _WIN32
+	while (dataLength > 0)
+	{
+		// MSG_NOSIGNAL avoids the SIGPIPE signal if the client has closed the connection
+		ssize_t sent = send(connection, data, dataLength, MSG_NOSIGNAL);
+
+		if (sent < 0 && errno == EINTR)
+			continue;
+
+		if (sent <= 0)
+			return false;
+
+		data += sent;
+		dataLength -= (size_t)sent;
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
\ No newline at end of file
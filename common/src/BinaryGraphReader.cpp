@@ -0,0 +1,278 @@
+#include "BinaryGraphReader.h"
+#include "BinaryGraphFormat.h"
+
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/**
+* Utility function to test if a string of the blob is valid.
+* A string is valid if it is completely contained inside the blob
+*/
+static bool IsValidString(uint32_t offset, uint32_t length, uint32_t stringsBlobSize)
+{
+	return offset <= stringsBlobSize && length <= stringsBlobSize - offset;
+}
+
+/**
+* Utility function that copies the record with the given index out of its table.
+* The records are copied since the data can have any alignment
+*/
+template <typename T>
+static inline T ReadRecord(const char* table, uint32_t index)
+{
+	T record;
+	memcpy(&record, table + (size_t)index * sizeof(T), sizeof(T));
+
+	return record;
+}
+
+/** Utility function that sets the attributes of the records [firstAttribute..firstAttribute + attributesCount) to the given element */
+static bool ReadAttributes(GraphElement* element, uint32_t firstAttribute, uint32_t attributesCount, const char* attributes, uint32_t totalAttributesCount, const char* strings, uint32_t stringsBlobSize)
+{
+	if (firstAttribute > totalAttributesCount || attributesCount > totalAttributesCount - firstAttribute)
+		return false;
+
+	for (uint32_t index = firstAttribute; index < firstAttribute + attributesCount; index++)
+	{
+		BinaryGraphFormat::AttributeRecord attribute = ReadRecord<BinaryGraphFormat::AttributeRecord>(attributes, index);
+
+		if (IsValidString(attribute._nameOffset, attribute._nameLength, stringsBlobSize) == false || IsValidString(attribute._valueOffset, attribute._valueLength, stringsBlobSize) == false)
+			return false;
+
+		element->SetAttribute(
+			std::string(strings + attribute._nameOffset, attribute._nameLength),
+			std::string(strings + attribute._valueOffset, attribute._valueLength),
+			(attribute._flags & BinaryGraphFormat::s_flagEncloseNameInDoubleQuotes) != 0,
+			(attribute._flags & BinaryGraphFormat::s_flagEncloseValueInDoubleQuotes) != 0);
+	}
+
+	return true;
+}
+
+/** Returns true if the given data starts like a binary graph file */
+bool BinaryGraphReader::IsBinaryGraph(const char* data, size_t dataLength)
+{
+	if (data == nullptr || dataLength < sizeof(uint32_t))
+		return false;
+
+	uint32_t magic = 0;
+	memcpy(&magic, data, sizeof(uint32_t));
+
+	return magic == BinaryGraphFormat::s_magic;
+}
+
+/** Returns true if the file at the given path is a binary graph file */
+bool BinaryGraphReader::IsBinaryGraphFile(const std::string& filePath)
+{
+	std::ifstream file(filePath, std::ios::in | std::ios::binary);
+
+	char magic[sizeof(uint32_t)];
+
+	if (!file.is_open() || !file.read(magic, sizeof(magic)))
+		return false;
+
+	return IsBinaryGraph(magic, sizeof(magic));
+}
+
+/**
+* Reads the graph from the given data, which must contain a whole binary graph file. The data can have any alignment
+* Returns false if the data is not a valid binary graph, in which case the graph is cleared
+*/
+bool BinaryGraphReader::Read(Graph& resultGraph, const char* data, size_t dataLength)
+{
+	if (IsBinaryGraph(data, dataLength) == false || dataLength < sizeof(BinaryGraphFormat::Header))
+	{
+		std::cerr << "BinaryGraphReader error [Read]: the data is not a binary graph" << std::endl;
+		resultGraph.Clear();
+		return false;
+	}
+
+	BinaryGraphFormat::Header header;
+	memcpy(&header, data, sizeof(header));
+
+	if (header._byteOrderMark != BinaryGraphFormat::s_byteOrderMark)
+	{
+		std::cerr << "BinaryGraphReader error [Read]: the binary graph was written with a different byte order" << std::endl;
+		resultGraph.Clear();
+		return false;
+	}
+
+	if (header._version != BinaryGraphFormat::s_version)
+	{
+		std::cerr << "BinaryGraphReader error [Read]: unsupported version " << header._version << " (expected " << BinaryGraphFormat::s_version << ")" << std::endl;
+		resultGraph.Clear();
+		return false;
+	}
+
+	// Make sure the data contains all the tables and the strings
+	unsigned long long expectedLength = sizeof(BinaryGraphFormat::Header)
+		+ (unsigned long long)header._nodesCount * sizeof(BinaryGraphFormat::NodeRecord)
+		+ (unsigned long long)header._edgesCount * sizeof(BinaryGraphFormat::EdgeRecord)
+		+ (unsigned long long)header._attributesCount * sizeof(BinaryGraphFormat::AttributeRecord)
+		+ (unsigned long long)header._stringsBlobSize;
+
+	if (expectedLength > (unsigned long long)dataLength || IsValidString(header._nameOffset, header._nameLength, header._stringsBlobSize) == false)
+	{
+		std::cerr << "BinaryGraphReader error [Read]: the binary graph is truncated or corrupted" << std::endl;
+		resultGraph.Clear();
+		return false;
+	}
+
+	// The records are copied out of the tables one at a time, so the data doesn't need to be aligned
+	const char* nodes = data + sizeof(BinaryGraphFormat::Header);
+	const char* edges = nodes + (size_t)header._nodesCount * sizeof(BinaryGraphFormat::NodeRecord);
+	const char* attributes = edges + (size_t)header._edgesCount * sizeof(BinaryGraphFormat::EdgeRecord);
+	const char* strings = attributes + (size_t)header._attributesCount * sizeof(BinaryGraphFormat::AttributeRecord);
+
+	int nodesCount = (int)header._nodesCount;
+	int edgesCount = (int)header._edgesCount;
+	int previousNodesCount = resultGraph.GetNodes().GetSize();
+
+	resultGraph.SetGraphType((header._flags & BinaryGraphFormat::s_graphFlagDirected) != 0 ? Graph::GT_Directed : Graph::GT_Simple);
+	resultGraph.SetName(std::string(strings + header._nameOffset, header._nameLength), (header._flags & BinaryGraphFormat::s_graphFlagEncloseNameInDoubleQuotes) != 0);
+	resultGraph.Reserve(previousNodesCount + nodesCount, resultGraph.GetEdges().GetSize() + edgesCount);
+
+	std::string error = "";
+
+	// Add all the nodes at once, like the parser does. Every record must create its own node
+	Graph::NodeDefinitionList nodeDefinitions(nodesCount);
+
+	for (int index = 0; index < nodesCount && error.empty(); index++)
+	{
+		BinaryGraphFormat::NodeRecord node = ReadRecord<BinaryGraphFormat::NodeRecord>(nodes, index);
+
+		if (IsValidString(node._nameOffset, node._nameLength, header._stringsBlobSize) == false || node._nameLength == 0)
+			error = "the binary graph contains invalid records";
+		else
+			nodeDefinitions.Add(Graph::NodeDefinition(std::string(strings + node._nameOffset, node._nameLength), (node._flags & BinaryGraphFormat::s_flagEncloseNameInDoubleQuotes) != 0));
+	}
+
+	if (error.empty() && (resultGraph.AddNodes(nodeDefinitions) == false || resultGraph.GetNodes().GetSize() != previousNodesCount + nodesCount))
+		error = "a node with the same name was stored more than once";
+
+	// Add all the edges at once. The same edge cannot be stored twice
+	Graph::EdgeDefinitionList edgeDefinitions(edgesCount);
+	Graph::EdgePointersList addedEdges(edgesCount);
+
+	for (int index = 0; index < edgesCount && error.empty(); index++)
+	{
+		BinaryGraphFormat::EdgeRecord edge = ReadRecord<BinaryGraphFormat::EdgeRecord>(edges, index);
+
+		if (edge._startNode >= header._nodesCount || edge._endNode >= header._nodesCount)
+			error = "the binary graph contains invalid records";
+		else
+			edgeDefinitions.Add(Graph::EdgeDefinition(previousNodesCount + (int)edge._startNode, previousNodesCount + (int)edge._endNode));
+	}
+
+	if (error.empty() && resultGraph.AddEdges(edgeDefinitions, &addedEdges) != edgesCount)
+		error = "an edge with the same nodes was stored more than once";
+
+	// Set the attributes to the new nodes and edges
+	if (error.empty())
+	{
+		Node** graphNodes = (Node**)malloc(sizeof(Node*) * (previousNodesCount + nodesCount > 0 ? previousNodesCount + nodesCount : 1));
+		resultGraph.GetNodesArray(graphNodes);
+
+		for (int index = 0; index < nodesCount && error.empty(); index++)
+		{
+			BinaryGraphFormat::NodeRecord node = ReadRecord<BinaryGraphFormat::NodeRecord>(nodes, index);
+
+			if (ReadAttributes(graphNodes[previousNodesCount + index], node._firstAttribute, node._attributesCount, attributes, header._attributesCount, strings, header._stringsBlobSize) == false)
+				error = "the binary graph contains invalid records";
+		}
+
+		free(graphNodes);
+
+		Graph::EdgePointersList::Iterator addedEdgesIt = addedEdges.Begin();
+		Graph::EdgePointersList::Iterator addedEdgesEnd = addedEdges.End();
+
+		for (int index = 0; addedEdgesIt && addedEdgesIt != addedEdgesEnd && error.empty(); index++, ++addedEdgesIt)
+		{
+			BinaryGraphFormat::EdgeRecord edge = ReadRecord<BinaryGraphFormat::EdgeRecord>(edges, index);
+
+			if (ReadAttributes(*addedEdgesIt, edge._firstAttribute, edge._attributesCount, attributes, header._attributesCount, strings, header._stringsBlobSize) == false)
+				error = "the binary graph contains invalid records";
+		}
+	}
+
+	// Don't leave a graph built only in part
+	if (error.empty() == false)
+	{
+		std::cerr << "BinaryGraphReader error [Read]: " << error << std::endl;
+		resultGraph.Clear();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+* Reads the graph from the file at the given path. Where available the file is memory mapped instead of being copied
+* Returns false if the file cannot be opened or it is not a valid binary graph (see Read)
+*/
+bool BinaryGraphReader::ReadFile(Graph& resultGraph, const std::string& filePath)
+{
+#ifndef _WIN32
+	int fileDescriptor = open(filePath.c_str(), O_RDONLY);
+
+	if (fileDescriptor < 0)
+	{
+		std::cerr << "BinaryGraphReader error [ReadFile]: cannot open the file " << filePath << std::endl;
+		return false;
+	}
+
+	struct stat fileStatus;
+
+	if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size <= 0)
+	{
+		std::cerr << "BinaryGraphReader error [ReadFile]: the file " << filePath << " is empty" << std::endl;
+		close(fileDescriptor);
+		return false;
+	}
+
+	size_t fileSize = (size_t)fileStatus.st_size;
+	void* data = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+	// The mapping stays valid after the file is closed
+	close(fileDescriptor);
+
+	if (data == MAP_FAILED)
+	{
+		std::cerr << "BinaryGraphReader error [ReadFile]: cannot map the file " << filePath << std::endl;
+		return false;
+	}
+
+	// The tables are read once from start to end
+	madvise(data, fileSize, MADV_SEQUENTIAL);
+
+	bool result = Read(resultGraph, (const char*)data, fileSize);
+
+	munmap(data, fileSize);
+
+	return result;
+#else
+	std::ifstream file(filePath, std::ios::in | std::ios::binary);
+
+	if (!file.is_open())
+	{
+		std::cerr << "BinaryGraphReader error [ReadFile]: cannot open the file " << filePath << std::endl;
+		return false;
+	}
+
+	std::ostringstream content;
+	content << file.rdbuf();
+
+	std::string data = content.str();
+
+	return Read(resultGraph, data.data(), data.length());
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include "BinaryGraphWriter.h"
+#include "BinaryGraphFormat.h"
+
+#include <fstream>
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+/** Occurrence of a string that has to be stored inside the blob of the strings */
+struct StringSlot
+{
+	/** The string to store */
+	const std::string* _string;
+
+	/** Position of the occurrence inside the list of all the occurrences */
+	int _slot;
+};
+
+/** Comparator used to sort the StringSlot by content so that equal strings are stored only once */
+struct StringSlotComparator
+{
+	inline bool operator()(const StringSlot& lhs, const StringSlot& rhs) const
+	{
+		int comparison = lhs._string->compare(*rhs._string);
+
+		if (comparison != 0)
+			return comparison < 0;
+		return lhs._slot < rhs._slot;
+	}
+};
+
+/** Address of a node with its index, used to find the index of the nodes of an edge */
+struct NodeAddress
+{
+	/** Address of the node */
+	const Node* _node;
+
+	/** Index of the node inside the list of nodes of the graph */
+	int _index;
+
+	bool operator<(const NodeAddress& rhs) const { return std::less<const Node*>()(_node, rhs._node); }
+};
+
+/** Function-object used to add the attributes of a graph element to the table of the attributes */
+struct AttributesCollector
+{
+	AttributesCollector(BinaryGraphFormat::AttributeRecord* attributes, StringSlot* slots, int& attributeIndex, int& slotIndex)
+		: _attributes(attributes)
+		, _slots(slots)
+		, _attributeIndex(attributeIndex)
+		, _slotIndex(slotIndex)
+	{ }
+
+	bool operator()(const GraphElement::Attribute& attribute, int /*index*/, bool /*lastElement*/)
+	{
+		BinaryGraphFormat::AttributeRecord& record = _attributes[_attributeIndex++];
+
+		record._flags = 0;
+		if (attribute._encloseNameInDoubleQuotes)
+			record._flags |= BinaryGraphFormat::s_flagEncloseNameInDoubleQuotes;
+		if (attribute._encloseValueInDoubleQuotes)
+			record._flags |= BinaryGraphFormat::s_flagEncloseValueInDoubleQuotes;
+
+		// The offsets of the strings are known only when all the strings are collected
+		_slots[_slotIndex]._string = &attribute._name;
+		_slots[_slotIndex]._slot = _slotIndex;
+		_slotIndex++;
+
+		_slots[_slotIndex]._string = &attribute._value;
+		_slots[_slotIndex]._slot = _slotIndex;
+		_slotIndex++;
+
+		return true;
+	}
+
+	BinaryGraphFormat::AttributeRecord* _attributes;
+	StringSlot* _slots;
+	int& _attributeIndex;
+	int& _slotIndex;
+};
+
+/** Utility function that sets the offsets and the lengths of the name and the value of an attribute from its two slots */
+static void SetAttributeStrings(BinaryGraphFormat::AttributeRecord& record, const StringSlot* slots, const uint32_t* offsets)
+{
+	record._nameOffset = offsets[0];
+	record._nameLength = (uint32_t)slots[0]._string->length();
+	record._valueOffset = offsets[1];
+	record._valueLength = (uint32_t)slots[1]._string->length();
+}
+
+/** Writes the given graph to the given output stream. The stream must be opened in binary mode */
+bool BinaryGraphWriter::Write(const Graph& graph, std::ostream& output)
+{
+	// Cannot write a graph if it is not valid or if the output stream is not valid
+	if (!output || graph.GetGraphType() == Graph::GT_NotValid)
+		return false;
+
+	const Graph::NodeList& nodes = graph.GetNodes();
+	const Graph::EdgeList& edges = graph.GetEdges();
+
+	int nodesCount = nodes.GetSize();
+	int edgesCount = edges.GetSize();
+	int attributesCount = 0;
+
+	Graph::NodeList::ConstIterator nodesIt = nodes.Begin();
+	Graph::NodeList::ConstIterator nodesEnd = nodes.End();
+	for (; nodesIt && nodesIt != nodesEnd; ++nodesIt)
+		attributesCount += (*nodesIt).GetAttributes().GetSize();
+
+	Graph::EdgeList::ConstIterator edgesIt = edges.Begin();
+	Graph::EdgeList::ConstIterator edgesEnd = edges.End();
+	for (; edgesIt && edgesIt != edgesEnd; ++edgesIt)
+		attributesCount += (*edgesIt).GetAttributes().GetSize();
+
+	// Every string has a slot: the first one is the name of the graph, then the names of the nodes
+	// and then the names and values of the attributes
+	int slotsCount = 1 + nodesCount + attributesCount * 2;
+
+	BinaryGraphFormat::NodeRecord* nodeRecords = (BinaryGraphFormat::NodeRecord*)malloc(sizeof(BinaryGraphFormat::NodeRecord) * (nodesCount > 0 ? nodesCount : 1));
+	BinaryGraphFormat::EdgeRecord* edgeRecords = (BinaryGraphFormat::EdgeRecord*)malloc(sizeof(BinaryGraphFormat::EdgeRecord) * (edgesCount > 0 ? edgesCount : 1));
+	BinaryGraphFormat::AttributeRecord* attributeRecords = (BinaryGraphFormat::AttributeRecord*)malloc(sizeof(BinaryGraphFormat::AttributeRecord) * (attributesCount > 0 ? attributesCount : 1));
+	StringSlot* slots = (StringSlot*)malloc(sizeof(StringSlot) * slotsCount);
+
+	int attributeIndex = 0;
+	int slotIndex = 0;
+
+	slots[slotIndex]._string = &graph.GetName();
+	slots[slotIndex]._slot = slotIndex;
+	slotIndex++;
+
+	// Fill the table of the nodes. To find the index of the nodes of an edge sort the nodes by address
+	NodeAddress* nodeAddresses = (NodeAddress*)malloc(sizeof(NodeAddress) * (nodesCount > 0 ? nodesCount : 1));
+
+	nodesIt = nodes.Begin();
+	for (int index = 0; nodesIt && nodesIt != nodesEnd; index++, ++nodesIt)
+	{
+		const Node& node = *nodesIt;
+		BinaryGraphFormat::NodeRecord& record = nodeRecords[index];
+
+		record._flags = node.EncloseNameInDoubleQuotes() ? BinaryGraphFormat::s_flagEncloseNameInDoubleQuotes : 0;
+		record._firstAttribute = (uint32_t)attributeIndex;
+		record._attributesCount = (uint32_t)node.GetAttributes().GetSize();
+
+		slots[slotIndex]._string = &node.GetName();
+		slots[slotIndex]._slot = slotIndex;
+		slotIndex++;
+
+		node.GetAttributes().ForEach(AttributesCollector(attributeRecords, slots, attributeIndex, slotIndex));
+
+		nodeAddresses[index]._node = &node;
+		nodeAddresses[index]._index = index;
+	}
+
+	std::sort(nodeAddresses, nodeAddresses + nodesCount);
+
+	// Fill the table of the edges
+	edgesIt = edges.Begin();
+	for (int index = 0; edgesIt && edgesIt != edgesEnd; index++, ++edgesIt)
+	{
+		const Edge& edge = *edgesIt;
+		BinaryGraphFormat::EdgeRecord& record = edgeRecords[index];
+
+		NodeAddress startNode = { edge.GetStartNode(), -1 };
+		NodeAddress endNode = { edge.GetEndNode(), -1 };
+
+		record._startNode = (uint32_t)std::lower_bound(nodeAddresses, nodeAddresses + nodesCount, startNode)->_index;
+		record._endNode = (uint32_t)std::lower_bound(nodeAddresses, nodeAddresses + nodesCount, endNode)->_index;
+		record._firstAttribute = (uint32_t)attributeIndex;
+		record._attributesCount = (uint32_t)edge.GetAttributes().GetSize();
+
+		edge.GetAttributes().ForEach(AttributesCollector(attributeRecords, slots, attributeIndex, slotIndex));
+	}
+
+	free(nodeAddresses);
+
+	// Sort the strings by content and give the same offset to equal strings
+	StringSlot* sortedSlots = (StringSlot*)malloc(sizeof(StringSlot) * slotsCount);
+	uint32_t* offsets = (uint32_t*)malloc(sizeof(uint32_t) * slotsCount);
+
+	std::copy(slots, slots + slotsCount, sortedSlots);
+	std::sort(sortedSlots, sortedSlots + slotsCount, StringSlotComparator());
+
+	uint32_t stringsBlobSize = 0;
+	for (int index = 0; index < slotsCount; index++)
+	{
+		if (index > 0 && *sortedSlots[index]._string == *sortedSlots[index - 1]._string)
+			offsets[sortedSlots[index]._slot] = offsets[sortedSlots[index - 1]._slot];
+		else
+		{
+			offsets[sortedSlots[index]._slot] = stringsBlobSize;
+			stringsBlobSize += (uint32_t)sortedSlots[index]._string->length();
+		}
+	}
+
+	// Now that the offsets are known complete the records, visiting the slots in the same order they were collected:
+	// the name of every node is followed by its attributes and then come the attributes of the edges
+	slotIndex = 1;
+	attributeIndex = 0;
+
+	for (int index = 0; index < nodesCount; index++)
+	{
+		nodeRecords[index]._nameOffset = offsets[slotIndex];
+		nodeRecords[index]._nameLength = (uint32_t)slots[slotIndex]._string->length();
+		slotIndex++;
+
+		for (uint32_t attribute = 0; attribute < nodeRecords[index]._attributesCount; attribute++, attributeIndex++, slotIndex += 2)
+			SetAttributeStrings(attributeRecords[attributeIndex], slots + slotIndex, offsets + slotIndex);
+	}
+
+	for (; attributeIndex < attributesCount; attributeIndex++, slotIndex += 2)
+		SetAttributeStrings(attributeRecords[attributeIndex], slots + slotIndex, offsets + slotIndex);
+
+	// Write the header
+	BinaryGraphFormat::Header header;
+	header._magic = BinaryGraphFormat::s_magic;
+	header._byteOrderMark = BinaryGraphFormat::s_byteOrderMark;
+	header._version = BinaryGraphFormat::s_version;
+	header._flags = 0;
+	if (graph.GetGraphType() == Graph::GT_Directed)
+		header._flags |= BinaryGraphFormat::s_graphFlagDirected;
+	if (graph.EncloseNameInDoubleQuotes())
+		header._flags |= BinaryGraphFormat::s_graphFlagEncloseNameInDoubleQuotes;
+	header._nodesCount = (uint32_t)nodesCount;
+	header._edgesCount = (uint32_t)edgesCount;
+	header._attributesCount = (uint32_t)attributesCount;
+	header._stringsBlobSize = stringsBlobSize;
+	header._nameOffset = offsets[0];
+	header._nameLength = (uint32_t)graph.GetName().length();
+
+	output.write((const char*)&header, sizeof(header));
+
+	// Write the tables
+	output.write((const char*)nodeRecords, sizeof(BinaryGraphFormat::NodeRecord) * nodesCount);
+	output.write((const char*)edgeRecords, sizeof(BinaryGraphFormat::EdgeRecord) * edgesCount);
+	output.write((const char*)attributeRecords, sizeof(BinaryGraphFormat::AttributeRecord) * attributesCount);
+
+	// Write the blob of the strings, writing only the first occurrence of every string
+	for (int index = 0; index < slotsCount; index++)
+	{
+		if (index == 0 || *sortedSlots[index]._string != *sortedSlots[index - 1]._string)
+			output.write(sortedSlots[index]._string->data(), sortedSlots[index]._string->length());
+	}
+
+	free(offsets);
+	free(sortedSlots);
+	free(slots);
+	free(attributeRecords);
+	free(edgeRecords);
+	free(nodeRecords);
+
+	return !output.fail();
+}
+
+/** Writes the given graph to the file at the given path */
+bool BinaryGraphWriter::WriteFile(const Graph& graph, const std::string& filePath)
+{
+	std::ofstream file(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open())
+	{
+		std::cerr << "BinaryGraphWriter error [WriteFile]: cannot open the file " << filePath << std::endl;
+		return false;
+	}
+
+	return Write(graph, file);
+}
@@ -0,0 +1,188 @@
+#include "DeltaWriter.h"
+
+/** Utility function that writes a name enclosing it between double quotes if needed. The double quotes inside an enclosed name are escaped like DotParser expects */
+static inline void WriteName(OutputBuffer& output, const std::string& name, bool encloseNameInDoubleQuotes)
+{
+	if (encloseNameInDoubleQuotes == false)
+	{
+		output.Append(name);
+		return;
+	}
+
+	output.Append('"');
+
+	size_t start = 0;
+	size_t quote = name.find('"');
+
+	for (; quote != std::string::npos; start = quote + 1, quote = name.find('"', start))
+	{
+		output.Append(name.data() + start, quote - start);
+		output.Append("\\\"");
+	}
+
+	output.Append(name.data() + start, name.length() - start);
+	output.Append('"');
+}
+
+/** Utility function that writes the attributes list of a graph element, if it has any, and ends the statement */
+static void WriteAttributesAndEndStatement(OutputBuffer& output, const GraphElement& element)
+{
+	if (element.HasAttributes())
+	{
+		output.Append(" [");
+
+		const GraphElement::AttributeList& attributes = element.GetAttributes();
+		GraphElement::AttributeList::ConstIterator it = attributes.Begin();
+		GraphElement::AttributeList::ConstIterator end = attributes.End();
+
+		for (int index = 0; it && it != end; index++, ++it)
+		{
+			if (index > 0)
+				output.Append(", ");
+
+			WriteName(output, (*it)._name, (*it)._encloseNameInDoubleQuotes);
+			output.Append('=');
+			WriteName(output, (*it)._value, (*it)._encloseValueInDoubleQuotes);
+		}
+
+		output.Append(']');
+	}
+
+	output.Append(";\n");
+}
+
+/** Writes the changes to the given stream using the given format */
+bool DeltaWriter::Write(const Graph& graph, std::ostream& output, DeltaFormat format)
+{
+	// Cannot write a graph if it is not valid or if the output stream is not valid
+	if (!output || graph.GetGraphType() == Graph::GT_NotValid)
+		return false;
+
+	OutputBuffer buffer;
+	buffer.SetOutput(&output);
+
+	return Write(graph, buffer, format) && buffer.Flush();
+}
+
+/** Appends the changes to the given buffer using the given format, without flushing it */
+bool DeltaWriter::Write(const Graph& graph, OutputBuffer& output, DeltaFormat format)
+{
+	const Node* root = GetRoot(graph);
+
+	// Cannot write the changes if the graph is not valid or it wasn't solved
+	if (graph.GetGraphType() == Graph::GT_NotValid || root == nullptr)
+		return false;
+
+	bool directedGraph = graph.GetGraphType() == Graph::GT_Directed;
+
+	Graph::NodeList::ConstIterator nodesIt = graph.GetNodes().Begin();
+	Graph::NodeList::ConstIterator nodesEnd = graph.GetNodes().End();
+	Graph::EdgeList::ConstIterator edgesIt = graph.GetEdges().Begin();
+	Graph::EdgeList::ConstIterator edgesEnd = graph.GetEdges().End();
+
+	if (format == DF_Lines)
+	{
+		int addedEdgesCount = 0;
+		for (; edgesIt && edgesIt != edgesEnd; ++edgesIt)
+		{
+			if ((*edgesIt).IsAddedBySolver())
+				addedEdgesCount++;
+		}
+
+		output.Append("root ");
+		WriteName(output, root->GetName(), root->EncloseNameInDoubleQuotes());
+		output.Append(' ').AppendInteger(addedEdgesCount).Append('\n');
+
+		edgesIt = graph.GetEdges().Begin();
+		for (; edgesIt && edgesIt != edgesEnd; ++edgesIt)
+		{
+			const Edge& edge = *edgesIt;
+
+			if (edge.IsAddedBySolver())
+			{
+				output.Append("added ");
+				WriteName(output, edge.GetStartNode()->GetName(), edge.GetStartNode()->EncloseNameInDoubleQuotes());
+				output.Append(' ');
+				WriteName(output, edge.GetEndNode()->GetName(), edge.GetEndNode()->EncloseNameInDoubleQuotes());
+				output.Append('\n');
+			}
+		}
+
+		for (; nodesIt && nodesIt != nodesEnd; ++nodesIt)
+		{
+			const Node& node = *nodesIt;
+			const Edge* edgeForBestPath = node.GetEdgeForBestPath();
+
+			if (&node == root || node.GetDistanceFromRoot() < 0 || edgeForBestPath == nullptr)
+				continue;
+
+			// In undirected graphs the node can be both the start and the end node of its edge
+			const Node* parent = (edgeForBestPath->GetEndNode() == &node) ? edgeForBestPath->GetStartNode() : edgeForBestPath->GetEndNode();
+
+			output.Append("path ");
+			WriteName(output, node.GetName(), node.EncloseNameInDoubleQuotes());
+			output.Append(' ');
+			WriteName(output, parent->GetName(), parent->EncloseNameInDoubleQuotes());
+			output.Append(' ').AppendInteger(node.GetDistanceFromRoot()).Append('\n');
+		}
+	}
+	else
+	{
+		// Write the graph declaration
+		output.Append(directedGraph ? "digraph " : "graph ", directedGraph ? 8 : 6);
+		WriteName(output, graph.GetName(), graph.EncloseNameInDoubleQuotes());
+		output.Append(" {\n");
+
+		// The nodes reached from the root are the ones labeled with their distance (the root with the number of added edges)
+		for (; nodesIt && nodesIt != nodesEnd; ++nodesIt)
+		{
+			const Node& node = *nodesIt;
+
+			if (node.GetDistanceFromRoot() >= 0)
+			{
+				WriteName(output, node.GetName(), node.EncloseNameInDoubleQuotes());
+				WriteAttributesAndEndStatement(output, node);
+			}
+		}
+
+		// The edges added by the solver and the ones used by the best paths
+		for (; edgesIt && edgesIt != edgesEnd; ++edgesIt)
+		{
+			const Edge& edge = *edgesIt;
+
+			if (edge.IsAddedBySolver() || IsEdgeForBestPath(edge))
+			{
+				WriteName(output, edge.GetStartNode()->GetName(), edge.GetStartNode()->EncloseNameInDoubleQuotes());
+				output.Append(directedGraph ? " -> " : " -- ", 4);
+				WriteName(output, edge.GetEndNode()->GetName(), edge.GetEndNode()->EncloseNameInDoubleQuotes());
+				WriteAttributesAndEndStatement(output, edge);
+			}
+		}
+
+		// Close the graph
+		output.Append('}');
+	}
+
+	return true;
+}
+
+/** Returns the root chosen by the solver, the node with distance 0 from the root, or nullptr if the graph was not solved */
+const Node* DeltaWriter::GetRoot(const Graph& graph)
+{
+	Graph::NodeList::ConstIterator it = graph.GetNodes().Begin();
+	Graph::NodeList::ConstIterator end = graph.GetNodes().End();
+
+	for (; it && it != end; ++it)
+	{
+		if ((*it).GetDistanceFromRoot() == 0)
+			return &(*it);
+	}
+
+	return nullptr;
+}
+
+/** Returns true if the given edge is the edge of the best path of one of its nodes */
+bool DeltaWriter::IsEdgeForBestPath(const Edge& edge)
+{
+	return edge.GetEndNode()->GetEdgeForBestPath() == &edge || edge.GetStartNode()->GetEdgeForBestPath() == &edge;
+}
\ No newline at end of file
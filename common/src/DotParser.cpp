@@ -1,6 +1,8 @@
 #include "DotParser.h"
 
 #include <cctype>
+#include <cstdlib>
+#include <utility>
 
 /**
 * Utility function to test if a character is alphabetical.
@@ -22,35 +24,149 @@ static bool IsDigit(int c)
 	return (c >= 48 && c <= 57);
 }
 
-/** Utility struct to hold a function operator to be used by ParseAttributeList */
-struct AddAttribute
+/**
+* Utility function used by ParseEdgeList to add an edge to the pending graph.
+* The end node is added to the pending nodes and its position is returned so that it can be used as the start node of the next edge
+*/
+static int AddPendingEdge(DotParser::PendingGraph& pendingGraph, int startNodePosition, const std::string& endNodeId, bool endNodeIdBetweenDoubleQuotes)
 {
-	AddAttribute(const std::string& attributeName, const std::string& attributeValue, bool encloseNameInDoubleQuotes, bool encloseValueInDoubleQuotes)
-		: _name(attributeName)
-		, _value(attributeValue)
-		, _encloseNameInDoubleQuotes(encloseNameInDoubleQuotes)
-		, _encloseValueInDoubleQuotes(encloseValueInDoubleQuotes)
-	{ }
-
-	inline bool operator()(GraphElement* element, int index, bool lastElement)
-	{
-		if (element != nullptr)
-			element->SetAttribute(_name, _value, _encloseNameInDoubleQuotes, _encloseValueInDoubleQuotes);
-		return true;
-	}
+	int endNodePosition = pendingGraph.AddNode(endNodeId, endNodeIdBetweenDoubleQuotes);
+
+	pendingGraph.AddEdge(startNodePosition, endNodePosition);
+
+	return endNodePosition;
+}
+
+/**
+* Utility function used by PendingGraph to make sure an array can store one more element.
+* The elements are moved to the new array so that the strings they contain aren't copied
+*/
+template <typename T>
+static void GrowPendingArray(T*& elements, int elementsCount, int& capacity)
+{
+	if (elementsCount < capacity)
+		return;
+
+	int newCapacity = (capacity > 0) ? capacity * 2 : 64;
+	T* newElements = new T[newCapacity];
+
+	for (int index = 0; index < elementsCount; index++)
+		newElements[index] = std::move(elements[index]);
+
+	delete[] elements;
+
+	elements = newElements;
+	capacity = newCapacity;
+}
+
+/** Default constructor */
+DotParser::PendingGraph::PendingGraph()
+	: _graphType(Graph::GT_NotValid)
+	, _named(false)
+	, _encloseNameInDoubleQuotes(false)
+	, _nodes(nullptr)
+	, _nodesCount(0)
+	, _nodesCapacity(0)
+	, _edges(nullptr)
+	, _edgesCount(0)
+	, _edgesCapacity(0)
+	, _attributes(nullptr)
+	, _attributesCount(0)
+	, _attributesCapacity(0)
+{
+}
+
+/** Destructor */
+DotParser::PendingGraph::~PendingGraph()
+{
+	delete[] _nodes;
+	delete[] _edges;
+	delete[] _attributes;
+}
+
+/** Removes all the elements keeping the arrays */
+void DotParser::PendingGraph::Clear()
+{
+	_graphType = Graph::GT_NotValid;
+	_named = false;
+	_encloseNameInDoubleQuotes = false;
+	_nodesCount = 0;
+	_edgesCount = 0;
+	_attributesCount = 0;
+}
 
-	std::string _name;
-	std::string _value;
-	bool _encloseNameInDoubleQuotes;
-	bool _encloseValueInDoubleQuotes;
-};
+/** Adds a node and returns its position */
+int DotParser::PendingGraph::AddNode(const std::string& name, bool encloseNameInDoubleQuotes)
+{
+	GrowPendingArray(_nodes, _nodesCount, _nodesCapacity);
+
+	// Assign the name instead of constructing a new definition so that the memory of the previous name is reused
+	Graph::NodeDefinition& node = _nodes[_nodesCount];
+	node._name = name;
+	node._encloseNameInDoubleQuotes = encloseNameInDoubleQuotes;
+
+	return _nodesCount++;
+}
+
+/** Adds an edge between the nodes at the given positions and returns its position */
+int DotParser::PendingGraph::AddEdge(int startNodePosition, int endNodePosition)
+{
+	GrowPendingArray(_edges, _edgesCount, _edgesCapacity);
+
+	_edges[_edgesCount] = Graph::EdgeDefinition(startNodePosition, endNodePosition);
+
+	return _edgesCount++;
+}
+
+/** Adds an attribute of the node or of the edge at the given position */
+void DotParser::PendingGraph::AddAttribute(int target, bool targetIsEdge, const GraphElement::Attribute& attribute)
+{
+	GrowPendingArray(_attributes, _attributesCount, _attributesCapacity);
+
+	PendingAttribute& pendingAttribute = _attributes[_attributesCount++];
+	pendingAttribute._target = target;
+	pendingAttribute._targetIsEdge = targetIsEdge;
+	pendingAttribute._attribute = attribute;
+}
 
 bool DotParser::Parse(Graph& resultGraph, const std::string& dotDefinition)
 {
-	const char* dotDefinitionData = dotDefinition.data();
+	int parseIndex = 0;
+	PendingGraph pendingGraph;
+
+	return Parse(resultGraph, dotDefinition, parseIndex, pendingGraph);
+}
+
+/**
+* Parses the graph that starts at parseIndex inside dotDefinition, which can contain many graphs one after the other.
+* When the function returns parseIndex is after the closing bracket of the parsed graph.
+* pendingGraph is cleared and used to store the elements found, so that its lists can be reused for many graphs
+*/
+bool DotParser::Parse(Graph& resultGraph, const std::string& dotDefinition, int& parseIndex, PendingGraph& pendingGraph)
+{
+	if (ParseElements(dotDefinition, parseIndex, pendingGraph) == false)
+		return false;
+
+	// Add all the nodes and edges that were found to the graph
+	return BuildGraph(resultGraph, pendingGraph);
+}
+
+/**
+* Parses the graph that starts at parseIndex inside dotDefinition like Parse, storing its elements inside pendingGraph without building any graph.
+* The elements can be read before the graph is built with BuildGraph, like ASDProjectSolverCache does to compute its key
+*/
+bool DotParser::ParseElements(const std::string& dotDefinition, int& parseIndex, PendingGraph& pendingGraph)
+{
+	// The pending elements are cleared keeping their arrays to reuse them
+	pendingGraph.Clear();
+
 	int dotDefinitionDataLength = (int)dotDefinition.length();
 
-	int parseIndex = 0;
+	if (parseIndex < 0 || parseIndex > dotDefinitionDataLength)
+		return false;
+
+	const char* dotDefinitionData = dotDefinition.data() + parseIndex;
+
 	int lineNumber = 0;
 	int columnNumber = 0;
 	std::string tmpStr;
@@ -71,9 +187,9 @@ bool DotParser::Parse(Graph& resultGraph, const std::string& dotDefinition)
 	}
 
 	if (tk == TOK_Graph)
-		resultGraph.SetGraphType(Graph::GT_Simple);
+		pendingGraph._graphType = Graph::GT_Simple;
 	else if (tk == TOK_Digraph)
-		resultGraph.SetGraphType(Graph::GT_Directed);
+		pendingGraph._graphType = Graph::GT_Directed;
 	else
 		return false;
 
@@ -86,13 +202,178 @@ bool DotParser::Parse(Graph& resultGraph, const std::string& dotDefinition)
 		return false;
 	}
 	if (tk == TOK_Id)
-		resultGraph.SetName(tmpStr, enclosedInDoubleQuotes);
+	{
+		pendingGraph._named = true;
+		pendingGraph._name = tmpStr;
+		pendingGraph._encloseNameInDoubleQuotes = enclosedInDoubleQuotes;
+	}
 	// If the token wasn't an ID then it must be an open bracket otherwise we have an error
 	else if (tk != TOK_OpenBracket)
 		return false;
 
 	// Proceed reading the statement lists of the DOT graph
-	return ParseStatementList(resultGraph, tk == TOK_OpenBracket, parseIndex, dotDefinitionData, dotDefinitionDataLength, lineNumber, columnNumber);
+	return ParseStatementList(pendingGraph._graphType, pendingGraph, tk == TOK_OpenBracket, parseIndex, dotDefinitionData, dotDefinitionDataLength, lineNumber, columnNumber);
+}
+
+/**
+* Skips the spaces and the comments starting from parseIndex inside dotDefinition
+* Returns true if something else follows, which should be another graph
+*/
+bool DotParser::HasMoreGraphs(const std::string& dotDefinition, int& parseIndex)
+{
+	int dotDefinitionDataLength = (int)dotDefinition.length();
+
+	if (parseIndex < 0 || parseIndex >= dotDefinitionDataLength)
+		return false;
+
+	const char* dotDefinitionData = dotDefinition.data() + parseIndex;
+	int lineNumber = 0;
+	int columnNumber = 0;
+	std::string tmpStr;
+	bool enclosedInDoubleQuotes = false;
+
+	while (true)
+	{
+		RemoveSpaces(parseIndex, dotDefinitionData, dotDefinitionDataLength, lineNumber, columnNumber);
+
+		if (parseIndex >= dotDefinitionDataLength)
+			return false;
+
+		// Parse a token using local values so that parseIndex is moved only after the comments
+		int localParseIndex = parseIndex;
+		const char* localDotDefinitionData = dotDefinitionData;
+
+		if (ParseToken(tmpStr, enclosedInDoubleQuotes, localParseIndex, localDotDefinitionData, dotDefinitionDataLength, lineNumber, columnNumber) != TOK_Comment)
+			return true;
+
+		parseIndex = localParseIndex;
+		dotDefinitionData = localDotDefinitionData;
+	}
+}
+
+/**
+* Finds the end of the graph that starts at parseIndex inside dotDefinition without parsing it, looking for the bracket
+* that closes the first open one while skipping comments and IDs enclosed between double quotes.
+* Returns the position after the closing bracket or -1 if the graph isn't closed
+*/
+int DotParser::FindGraphEnd(const std::string& dotDefinition, int parseIndex)
+{
+	const char* dotDefinitionData = dotDefinition.data();
+	int dotDefinitionDataLength = (int)dotDefinition.length();
+	int openBrackets = 0;
+
+	for (int index = parseIndex; index >= 0 && index < dotDefinitionDataLength; index++)
+	{
+		char c = dotDefinitionData[index];
+
+		// Skip the IDs enclosed between double quotes. Only a double quote can be escaped
+		if (c == '\"')
+		{
+			for (index++; index < dotDefinitionDataLength && dotDefinitionData[index] != '\"'; index++)
+			{
+				if (dotDefinitionData[index] == '\\' && (index + 1) < dotDefinitionDataLength && dotDefinitionData[index + 1] == '\"')
+					index++;
+			}
+		}
+		// Skip the comments
+		else if (c == '/' && (index + 1) < dotDefinitionDataLength && dotDefinitionData[index + 1] == '/')
+		{
+			while (index < dotDefinitionDataLength && dotDefinitionData[index] != '\n')
+				index++;
+		}
+		else if (c == '/' && (index + 1) < dotDefinitionDataLength && dotDefinitionData[index + 1] == '*')
+		{
+			index += 2;
+			while ((index + 1) < dotDefinitionDataLength && (dotDefinitionData[index] != '*' || dotDefinitionData[index + 1] != '/'))
+				index++;
+			index++;
+		}
+		else if (c == '{')
+			openBrackets++;
+		else if (c == '}' && --openBrackets == 0)
+			return index + 1;
+	}
+
+	return -1;
+}
+
+/** Adds the elements found by ParseElements to the given graph, setting its type and name. Returns false if the elements aren't a valid graph */
+bool DotParser::BuildGraph(Graph& graph, const PendingGraph& pendingGraph)
+{
+	graph.SetGraphType(pendingGraph._graphType);
+
+	if (pendingGraph._named)
+		graph.SetName(pendingGraph._name, pendingGraph._encloseNameInDoubleQuotes);
+
+	int nodesCount = pendingGraph._nodesCount;
+	int edgesCount = pendingGraph._edgesCount;
+
+	// Add all the nodes at once. The nodes found more than once are added only the first time.
+	// nodesIndices converts the nodes of the edges from their position inside the pending nodes to their index inside the graph
+	int* nodesIndices = (int*)malloc(sizeof(int) * (nodesCount > 0 ? nodesCount : 1));
+
+	if (graph.AddNodes(pendingGraph._nodes, nodesCount, nodesIndices) == false)
+	{
+		free(nodesIndices);
+		return false;
+	}
+
+	Graph::EdgeDefinition* edges = (Graph::EdgeDefinition*)malloc(sizeof(Graph::EdgeDefinition) * (edgesCount > 0 ? edgesCount : 1));
+
+	for (int index = 0; index < edgesCount; index++)
+		edges[index] = Graph::EdgeDefinition(nodesIndices[pendingGraph._edges[index]._startNodeIndex], nodesIndices[pendingGraph._edges[index]._endNodeIndex]);
+
+	// Add all the edges at once
+	Edge** addedEdges = (Edge**)malloc(sizeof(Edge*) * (edgesCount > 0 ? edgesCount : 1));
+	int addedEdgesCount = graph.AddEdges(edges, edgesCount, addedEdges);
+
+	free(edges);
+
+	if (addedEdgesCount < 0)
+	{
+		free(addedEdges);
+		free(nodesIndices);
+		return false;
+	}
+
+	// The same edge cannot be declared twice
+	if (addedEdgesCount != edgesCount)
+	{
+		std::cerr << "ERROR: an edge with the same nodes was declared more than once" << std::endl;
+		free(addedEdges);
+		free(nodesIndices);
+		return false;
+	}
+
+	// Set the attributes to the nodes and edges, in the same order they were found
+	if (pendingGraph._attributesCount > 0)
+	{
+		Node** nodes = (Node**)malloc(sizeof(Node*) * graph.GetNodes().GetSize());
+
+		graph.GetNodesArray(nodes);
+
+		for (int index = 0; index < pendingGraph._attributesCount; index++)
+		{
+			const PendingAttribute& pendingAttribute = pendingGraph._attributes[index];
+			const GraphElement::Attribute& attribute = pendingAttribute._attribute;
+
+			GraphElement* element = nullptr;
+
+			if (pendingAttribute._targetIsEdge)
+				element = addedEdges[pendingAttribute._target];
+			else
+				element = nodes[nodesIndices[pendingAttribute._target]];
+
+			element->SetAttribute(attribute._name, attribute._value, attribute._encloseNameInDoubleQuotes, attribute._encloseValueInDoubleQuotes);
+		}
+
+		free(nodes);
+	}
+
+	free(addedEdges);
+	free(nodesIndices);
+
+	return true;
 }
 
 bool DotParser::ParseID(std::string& id, bool& enclosedWithDoubleQuotes, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber)
@@ -163,6 +444,13 @@ bool DotParser::ParseID(std::string& id, bool& enclosedWithDoubleQuotes, int& pa
 						else
 							id += "\\";
 					}
+
+					// Inside a quoted ID the next character is checked from the start, since it can be another escape, a whitespace or the closing double quote
+					if (enclosedWithDoubleQuotes)
+					{
+						parsingFirstChar = false;
+						continue;
+					}
 				}
 				// If the character is a double quote and we have found it here we are sure
 				// that it wasn't esacaped (the if before would have got that) so we need to do some checks
@@ -200,7 +488,9 @@ bool DotParser::ParseID(std::string& id, bool& enclosedWithDoubleQuotes, int& pa
 						else
 							columnNumber++;
 
-						return true;
+						// The ID goes on until the closing double quote
+						parsingFirstChar = false;
+						continue;
 					}
 					// Otherwise the space means that the ID is finished
 					// This convers also the case if we are parsing a numerid ID
@@ -219,6 +509,9 @@ bool DotParser::ParseID(std::string& id, bool& enclosedWithDoubleQuotes, int& pa
 						dotDefinition++;
 
 						columnNumber++;
+
+						parsingFirstChar = false;
+						continue;
 					}
 					else
 					{
@@ -279,6 +572,16 @@ bool DotParser::ParseID(std::string& id, bool& enclosedWithDoubleQuotes, int& pa
 
 					columnNumber++;
 				}
+				// Any other character is part of an ID enclosed between double quotes
+				else if (enclosedWithDoubleQuotes)
+				{
+					id += *dotDefinition;
+
+					parseIndex++;
+					dotDefinition++;
+
+					columnNumber++;
+				}
 				// We have found a character not valid for the ID
 				else
 					return false;
@@ -292,7 +595,7 @@ bool DotParser::ParseID(std::string& id, bool& enclosedWithDoubleQuotes, int& pa
 	return false;
 }
 
-bool DotParser::ParseStatementList(Graph& graph, bool bracketAlreadyFound, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber)
+bool DotParser::ParseStatementList(Graph::GraphType graphType, PendingGraph& pendingGraph, bool bracketAlreadyFound, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber)
 {
 	Token tk = TOK_NotValid;
 	std::string tmpStr = "";
@@ -335,7 +638,7 @@ bool DotParser::ParseStatementList(Graph& graph, bool bracketAlreadyFound, int&
 			}
 
 			// Now we have to parse the attribute list, which could also be empty
-			if (ParseAttributesList(nullptr, nullptr, parseIndex, dotDefinition, dotDefinitionLength, lineNumber, columnNumber) == false)
+			if (ParseAttributesList(nullptr, false, 0, 0, parseIndex, dotDefinition, dotDefinitionLength, lineNumber, columnNumber) == false)
 				return false;
 		}
 		// We have found a valid ID so we could be reading an edge or a node declaration
@@ -348,44 +651,36 @@ bool DotParser::ParseStatementList(Graph& graph, bool bracketAlreadyFound, int&
 			// Parse the next token to understand if we are looking at an edge or node declaration
 			tk = ParseToken(tmpStr, enclosedInDoubleQuotes, parseIndex, dotDefinition, dotDefinitionLength, lineNumber, columnNumber);
 
-			// We've read a node declaration which has no attributes so add it to the graph
+			// We've read a node declaration which has no attributes so add it to the pending nodes
 			if (tk == TOK_Semicolon)
-			{
-				// Make sure the node is added to the graph successfully
-				if (graph.AddNode(objectID, objectIDBetweenDoubleQuotes) == nullptr)
-					return false;
-			}
+				pendingGraph.AddNode(objectID, objectIDBetweenDoubleQuotes);
 			// We've read a node declaration which has some attributes so add
-			// the node to the graph and read the attributes to it
+			// the node to the pending nodes and read the attributes to it
 			else if (tk == TOK_OpenSquareBracket)
 			{
-				Node* node = graph.AddNode(objectID, objectIDBetweenDoubleQuotes);
-
-				// Make sure the node is added to the graph successfully
-				if (node == nullptr)
-					return false;
+				int nodePosition = pendingGraph.AddNode(objectID, objectIDBetweenDoubleQuotes);
 
 				// Parse the list of attributes and add them to the node
-				if (ParseAttributesList(node, nullptr, parseIndex, dotDefinition, dotDefinitionLength, lineNumber, columnNumber) == false)
+				if (ParseAttributesList(&pendingGraph, false, nodePosition, 1, parseIndex, dotDefinition, dotDefinitionLength, lineNumber, columnNumber) == false)
 					return false;
 			}
 			// We have found an edge declaration
 			else if (tk == TOK_SimpleEdgeSymbol || tk == TOK_DirectedEdgeSymbol)
 			{
 				// Make sure the edge declaration is consistent with the graph type
-				if (tk == TOK_SimpleEdgeSymbol && graph.GetGraphType() != Graph::GT_Simple)
+				if (tk == TOK_SimpleEdgeSymbol && graphType != Graph::GT_Simple)
 				{
 					std::cerr << "ERROR: found simple edge (--) on a non-simple graph [" << (lineNumber + 1) << ", " << (columnNumber + 1) << "]" << std::endl;
 					return false;
 				}
-				else if (tk == TOK_DirectedEdgeSymbol && graph.GetGraphType() != Graph::GT_Directed)
+				else if (tk == TOK_DirectedEdgeSymbol && graphType != Graph::GT_Directed)
 				{
 					std::cerr << "ERROR: found directed edge (->) on a non-directed graph [" << (lineNumber + 1) << ", " << (columnNumber + 1) << "]" << std::endl;
 					return false;
 				}
 
 				// Parse the edge list and add it to the graph
-				if (ParseEdgeList(graph, objectID, objectIDBetweenDoubleQuotes, parseIndex, dotDefinition, dotDefinitionLength, lineNumber, columnNumber) == false)
+				if (ParseEdgeList(graphType, pendingGraph, objectID, objectIDBetweenDoubleQuotes, parseIndex, dotDefinition, dotDefinitionLength, lineNumber, columnNumber) == false)
 					return false;
 			}
 			// Might have found an expression like ID = ID
@@ -710,7 +1005,7 @@ DotParser::Token DotParser::ParseToken(std::string& result, bool& resultEnclosed
 	return TOK_NotValid;
 }
 
-void DotParser::ReadUntilSpaces(std::string& result, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber)
+void DotParser::ReadUntilSpaces(std::string& result, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& /*lineNumber*/, int& columnNumber)
 {
 	result = "";
 
@@ -803,7 +1098,7 @@ bool DotParser::ReadComment(std::string& result, bool singleLine, int& parseInde
 	}
 }
 
-bool DotParser::ParseAttributesList(GraphElement* singleElement, List<GraphElement*>* elements, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber)
+bool DotParser::ParseAttributesList(PendingGraph* pendingGraph, bool targetsAreEdges, int firstTarget, int targetsCount, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber)
 {
 	Token tk = TOK_NotValid;
 	
@@ -845,11 +1140,14 @@ bool DotParser::ParseAttributesList(GraphElement* singleElement, List<GraphEleme
 				// Now there must be another ID which is the value of the attribute
 				if (ParseToken(attributeValue, attributeValueDoubleQuotes, parseIndex, dotDefinition, dotDefinitionLength, lineNumber, columnNumber) == TOK_Id)
 				{
-					// We have all the components to add the attribute
-					if (elements != nullptr)
-						elements->ForEach(AddAttribute(attributeName, attributeValue, attributeNameDoubleQuotes, attributeValueDoubleQuotes));
-					else if(singleElement != nullptr)
-						singleElement->SetAttribute(attributeName, attributeValue, attributeNameDoubleQuotes, attributeValueDoubleQuotes);
+					// We have all the components to add the attribute to all the targets
+					if (pendingGraph != nullptr)
+					{
+						GraphElement::Attribute attribute(attributeName, attributeValue, attributeNameDoubleQuotes, attributeValueDoubleQuotes);
+
+						for (int target = firstTarget; target < firstTarget + targetsCount; target++)
+							pendingGraph->AddAttribute(target, targetsAreEdges, attribute);
+					}
 
 					if (foundAnAttribute == false)
 						foundAnAttribute = true;
@@ -871,7 +1169,7 @@ bool DotParser::ParseAttributesList(GraphElement* singleElement, List<GraphEleme
 	return false;
 }
 
-bool DotParser::ParseEdgeList(Graph& graph, const std::string& firstNodeId, bool firstNodeIdBetweenDoubleQuotes, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber)
+bool DotParser::ParseEdgeList(Graph::GraphType graphType, PendingGraph& pendingGraph, const std::string& firstNodeId, bool firstNodeIdBetweenDoubleQuotes, int& parseIndex, const char*& dotDefinition, int dotDefinitionLength, int& lineNumber, int& columnNumber)
 {
 	Token tk = TOK_NotValid;
 	std::string tmpStr = "";
@@ -881,7 +1179,9 @@ bool DotParser::ParseEdgeList(Graph& graph, const std::string& firstNodeId, bool
 	bool nodeId_1_doubleQuotes = firstNodeIdBetweenDoubleQuotes;
 	bool nodeId_2_doubleQuotes = false;
 
-	List<GraphElement*> addedEdges;
+	// Position of the first edge of the list and of the current start node inside the pending edges and nodes
+	int firstEdgePosition = pendingGraph._edgesCount;
+	int nodePosition_1 = pendingGraph.AddNode(nodeId_1, nodeId_1_doubleQuotes);
 
 	// First check if there is at least one valid edge declaration
 	if (parseIndex < dotDefinitionLength)
@@ -892,13 +1192,7 @@ bool DotParser::ParseEdgeList(Graph& graph, const std::string& firstNodeId, bool
 		if (tk == TOK_Id)
 		{
 			// We have found a valid ID which is the second node ID so we can add the edge
-			Edge* edge = graph.AddEdge(nodeId_1, nodeId_2, nodeId_1_doubleQuotes, nodeId_2_doubleQuotes);
-
-			// If the edge has not been created there is an error
-			if (edge == nullptr)
-				return false;
-
-			addedEdges.Add(edge);
+			nodePosition_1 = AddPendingEdge(pendingGraph, nodePosition_1, nodeId_2, nodeId_2_doubleQuotes);
 		}
 		else
 		{
@@ -925,12 +1219,12 @@ bool DotParser::ParseEdgeList(Graph& graph, const std::string& firstNodeId, bool
 		else if (tk == TOK_SimpleEdgeSymbol || tk == TOK_DirectedEdgeSymbol)
 		{
 			// Make sure the edge declaration is consistent with the graph type
-			if (tk == TOK_SimpleEdgeSymbol && graph.GetGraphType() != Graph::GT_Simple)
+			if (tk == TOK_SimpleEdgeSymbol && graphType != Graph::GT_Simple)
 			{
 				std::cerr << "ERROR: found simple edge (--) on a non-simple graph [" << (lineNumber + 1) << ", " << (columnNumber + 1) << "]" << std::endl;
 				return false;
 			}
-			else if (tk == TOK_DirectedEdgeSymbol && graph.GetGraphType() != Graph::GT_Directed)
+			else if (tk == TOK_DirectedEdgeSymbol && graphType != Graph::GT_Directed)
 			{
 				std::cerr << "ERROR: found directed edge (->) on a non-directed graph [" << (lineNumber + 1) << ", " << (columnNumber + 1) << "]" << std::endl;
 				return false;
@@ -940,13 +1234,7 @@ bool DotParser::ParseEdgeList(Graph& graph, const std::string& firstNodeId, bool
 			if (ParseToken(nodeId_2, nodeId_2_doubleQuotes, parseIndex, dotDefinition, dotDefinitionLength, lineNumber, columnNumber) == TOK_Id)
 			{
 				// We have found a valid ID which is the second node ID so we can add the edge
-				Edge* edge = graph.AddEdge(nodeId_1, nodeId_2, nodeId_1_doubleQuotes, nodeId_2_doubleQuotes);
-
-				// If the edge has not been created there is an error
-				if (edge == nullptr)
-					return false;
-
-				addedEdges.Add(edge);
+				nodePosition_1 = AddPendingEdge(pendingGraph, nodePosition_1, nodeId_2, nodeId_2_doubleQuotes);
 			}
 			else
 			{
@@ -957,7 +1245,7 @@ bool DotParser::ParseEdgeList(Graph& graph, const std::string& firstNodeId, bool
 		// If we have found an open square bracket then the attribute list of the declared edge[s] has started
 		// so the edge declarations are finisched
 		else if (tk == TOK_OpenSquareBracket)
-			return ParseAttributesList(nullptr, &addedEdges, parseIndex, dotDefinition, dotDefinitionLength, lineNumber, columnNumber);
+			return ParseAttributesList(&pendingGraph, true, firstEdgePosition, pendingGraph._edgesCount - firstEdgePosition, parseIndex, dotDefinition, dotDefinitionLength, lineNumber, columnNumber);
 		// Found an unexpected token
 		else
 			return false;
@@ -1,42 +1,61 @@
 #include "DotWriter.h"
 
+#include <thread>
+#include <cstdlib>
+
+/** Utility function that writes a name enclosing it between double quotes if needed. The double quotes inside an enclosed name are escaped like DotParser expects */
+static inline void WriteName(OutputBuffer& output, const std::string& name, bool encloseNameInDoubleQuotes)
+{
+	if (encloseNameInDoubleQuotes == false)
+	{
+		output.Append(name);
+		return;
+	}
+
+	output.Append('"');
+
+	size_t start = 0;
+	size_t quote = name.find('"');
+
+	for (; quote != std::string::npos; start = quote + 1, quote = name.find('"', start))
+	{
+		output.Append(name.data() + start, quote - start);
+		output.Append("\\\"");
+	}
+
+	output.Append(name.data() + start, name.length() - start);
+	output.Append('"');
+}
+
 struct AttributesWriter
 {
-	AttributesWriter(std::ostream* output)
+	AttributesWriter(OutputBuffer* output)
 		: _output(output)
 	{ }
 
 	bool operator()(const GraphElement::Attribute& attribute, int index, bool lastElement)
 	{
 		// Write the attribute name
-		if (attribute._encloseNameInDoubleQuotes)
-			(*_output) << "\"";
-		(*_output) << attribute._name;
-		if (attribute._encloseNameInDoubleQuotes)
-			(*_output) << "\"";
+		WriteName(*_output, attribute._name, attribute._encloseNameInDoubleQuotes);
 
-		(*_output) << "=";
+		_output->Append('=');
 
 		// Write the attribute value
-		if (attribute._encloseValueInDoubleQuotes)
-			(*_output) << "\"";
-		(*_output) << attribute._value;
-		if (attribute._encloseValueInDoubleQuotes)
-			(*_output) << "\"";
+		WriteName(*_output, attribute._value, attribute._encloseValueInDoubleQuotes);
 
 		// Add a coma if this is not the last element
 		if (lastElement == false)
-			(*_output) << ", ";
+			_output->Append(", ");
 
 		return true;
 	}
 
-	std::ostream* _output;
+	OutputBuffer* _output;
 };
 
 struct NodesWriter
 {
-	NodesWriter(std::ostream* output)
+	NodesWriter(OutputBuffer* output)
 		: _output(output)
 	{ }
 
@@ -47,33 +66,29 @@ struct NodesWriter
 		if(node.HasAdjacentNodes() == false || node.HasAttributes())
 		{
 			// Write the node name
-			if (node.EncloseNameInDoubleQuotes())
-				(*_output) << "\"";
-			(*_output) << node.GetName();
-			if (node.EncloseNameInDoubleQuotes())
-				(*_output) << "\"";
+			WriteName(*_output, node.GetName(), node.EncloseNameInDoubleQuotes());
 
 			if (node.HasAttributes() == false)
-				(*_output) << ";" << std::endl;
+				_output->Append(";\n");
 			else
 			{
-				(*_output) << " [";
+				_output->Append(" [");
 
 				node.GetAttributes().ForEach(AttributesWriter(_output));
 
-				(*_output) << "];" << std::endl;
+				_output->Append("];\n");
 			}
 		}
 
 		return true;
 	}
 
-	std::ostream* _output;
+	OutputBuffer* _output;
 };
 
 struct EdgesWriter
 {
-	EdgesWriter(std::ostream* output, const std::string& edgeSymbol)
+	EdgesWriter(OutputBuffer* output, const char* edgeSymbol)
 		: _output(output)
 		, _edgeSymbol(edgeSymbol)
 	{ }
@@ -85,62 +100,88 @@ struct EdgesWriter
 		const Node* endNode = edge.GetEndNode();
 
 		// Write the start node name
-		if (startNode->EncloseNameInDoubleQuotes())
-			(*_output) << "\"";
-		(*_output) << startNode->GetName();
-		if (startNode->EncloseNameInDoubleQuotes())
-			(*_output) << "\"";
+		WriteName(*_output, startNode->GetName(), startNode->EncloseNameInDoubleQuotes());
 
-		// Write the connection symbol
-		(*_output) << _edgeSymbol;
+		// Write the connection symbol (both the symbols have the same length)
+		_output->Append(_edgeSymbol, 4);
 
 		// Write the end node name
-		if (endNode->EncloseNameInDoubleQuotes())
-			(*_output) << "\"";
-		(*_output) << endNode->GetName();
-		if (endNode->EncloseNameInDoubleQuotes())
-			(*_output) << "\"";
+		WriteName(*_output, endNode->GetName(), endNode->EncloseNameInDoubleQuotes());
 
 		if (edge.HasAttributes() == false)
-			(*_output) << ";" << std::endl;
+			_output->Append(";\n");
 		else
 		{
-			(*_output) << " [";
+			_output->Append(" [");
 
 			edge.GetAttributes().ForEach(AttributesWriter(_output));
 
-			(*_output) << "];" << std::endl;
+			_output->Append("];\n");
 		}
 
 		return true;
 	}
 
-	std::ostream* _output;
-	std::string _edgeSymbol;
+	OutputBuffer* _output;
+	const char* _edgeSymbol;
 };
 
+/**
+* Utility function used by the threads of WriteParallel. Formats the elements in the range [first..last) of the sequence
+* made of all the nodes followed by all the edges, as the sequential writer would do
+*/
+static void WriteElementsRange(const Node* const* nodes, int nodesCount, const Edge* const* edges, int first, int last, const char* edgeSymbol, OutputBuffer* output)
+{
+	NodesWriter nodesWriter(output);
+	EdgesWriter edgesWriter(output, edgeSymbol);
+
+	for (int index = first; index < last && index < nodesCount; index++)
+		nodesWriter(*nodes[index], index, false);
+
+	for (int index = (first > nodesCount ? first : nodesCount); index < last; index++)
+		edgesWriter(*edges[index - nodesCount], index - nodesCount, false);
+}
+
 bool DotWriter::Write(const Graph& graph, std::ostream& output)
+{
+	OutputBuffer buffer;
+
+	return Write(graph, output, buffer);
+}
+
+bool DotWriter::Write(const Graph& graph, std::ostream& output, OutputBuffer& buffer)
 {
 	// Cannot write a graph if it is not valid or if the output stream is not valid
 	if (!output || graph.GetGraphType() == Graph::GT_NotValid)
 		return false;
 
+	buffer.SetOutput(&output);
+
+	bool result = Write(graph, buffer) && buffer.Flush();
+
+	// Make sure the buffer doesn't keep a reference to the stream
+	buffer.SetOutput(nullptr);
+
+	return result;
+}
+
+bool DotWriter::Write(const Graph& graph, OutputBuffer& output)
+{
+	// Cannot write a graph if it is not valid
+	if (graph.GetGraphType() == Graph::GT_NotValid)
+		return false;
+
 	bool directedGraph = graph.GetGraphType() == Graph::GT_Directed;
 
 	// Write the graph declaration
 	if (directedGraph)
-		output << "digraph ";
+		output.Append("digraph ");
 	else
-		output << "graph ";
+		output.Append("graph ");
 
 	// Write the graph name
-	if (graph.EncloseNameInDoubleQuotes())
-		output << "\"";
-	output << graph.GetName();
-
-	if (graph.EncloseNameInDoubleQuotes())
-		output << "\"";
-	output << " {" << std::endl;
+	WriteName(output, graph.GetName(), graph.EncloseNameInDoubleQuotes());
+	output.Append(" {\n");
 
 	// First write all the nodes
 	graph.GetNodes().ForEach(NodesWriter(&output));
@@ -149,7 +190,93 @@ bool DotWriter::Write(const Graph& graph, std::ostream& output)
 	graph.GetEdges().ForEach(EdgesWriter(&output, directedGraph ? " -> " : " -- "));
 
 	// Close the graph
-	output << "}";
+	output.Append('}');
 
 	return true;
+}
+
+bool DotWriter::WriteParallel(const Graph& graph, std::ostream& output, int threadsCount)
+{
+	OutputBuffer buffer;
+
+	return WriteParallel(graph, output, buffer, threadsCount);
+}
+
+bool DotWriter::WriteParallel(const Graph& graph, std::ostream& output, OutputBuffer& buffer, int threadsCount)
+{
+	// Cannot write a graph if it is not valid or if the output stream is not valid
+	if (!output || graph.GetGraphType() == Graph::GT_NotValid)
+		return false;
+
+	int nodesCount = graph.GetNodes().GetSize();
+	int edgesCount = graph.GetEdges().GetSize();
+	int elementsCount = nodesCount + edgesCount;
+
+	// Don't start threads that would format less than s_minimumElementsPerThread elements
+	if (threadsCount > elementsCount / s_minimumElementsPerThread)
+		threadsCount = elementsCount / s_minimumElementsPerThread;
+
+	if (threadsCount <= 1)
+		return Write(graph, output, buffer);
+
+	bool directedGraph = graph.GetGraphType() == Graph::GT_Directed;
+	const char* edgeSymbol = directedGraph ? " -> " : " -- ";
+
+	// The lists can be visited only sequentially, so take the addresses of the elements to split them into ranges
+	const Node** nodes = (const Node**)malloc(sizeof(const Node*) * (nodesCount > 0 ? nodesCount : 1));
+	const Edge** edges = (const Edge**)malloc(sizeof(const Edge*) * (edgesCount > 0 ? edgesCount : 1));
+
+	Graph::NodeList::ConstIterator nodesIt = graph.GetNodes().Begin();
+	Graph::NodeList::ConstIterator nodesEnd = graph.GetNodes().End();
+	for (int index = 0; nodesIt && nodesIt != nodesEnd; index++, ++nodesIt)
+		nodes[index] = &(*nodesIt);
+
+	Graph::EdgeList::ConstIterator edgesIt = graph.GetEdges().Begin();
+	Graph::EdgeList::ConstIterator edgesEnd = graph.GetEdges().End();
+	for (int index = 0; edgesIt && edgesIt != edgesEnd; index++, ++edgesIt)
+		edges[index] = &(*edgesIt);
+
+	// Every thread formats a contiguous range of elements inside its own buffer, which has no output stream so it keeps
+	// everything in memory. The first range is formatted by this thread
+	OutputBuffer* threadBuffers = new OutputBuffer[threadsCount];
+	std::thread* threads = new std::thread[threadsCount];
+
+	for (int i = 1; i < threadsCount; i++)
+	{
+		int first = (int)(((long long)elementsCount * i) / threadsCount);
+		int last = (int)(((long long)elementsCount * (i + 1)) / threadsCount);
+
+		threads[i] = std::thread(WriteElementsRange, nodes, nodesCount, edges, first, last, edgeSymbol, &threadBuffers[i]);
+	}
+
+	WriteElementsRange(nodes, nodesCount, edges, 0, elementsCount / threadsCount, edgeSymbol, &threadBuffers[0]);
+
+	for (int i = 1; i < threadsCount; i++)
+		threads[i].join();
+
+	// Write the graph declaration and then the buffers in the same order of the ranges
+	buffer.SetOutput(&output);
+
+	buffer.Append(directedGraph ? "digraph " : "graph ", directedGraph ? 8 : 6);
+	WriteName(buffer, graph.GetName(), graph.EncloseNameInDoubleQuotes());
+	buffer.Append(" {\n");
+	buffer.Flush();
+
+	for (int i = 0; i < threadsCount; i++)
+		output.write(threadBuffers[i].GetData(), threadBuffers[i].GetSize());
+
+	// Close the graph
+	buffer.Append('}');
+
+	bool result = buffer.Flush();
+
+	// Make sure the buffer doesn't keep a reference to the stream
+	buffer.SetOutput(nullptr);
+
+	delete[] threads;
+	delete[] threadBuffers;
+	free(edges);
+	free(nodes);
+
+	return result;
 }
\ No newline at end of file
@@ -0,0 +1,512 @@
+#include "DynamicBestPaths.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+/** Comparator used to sort the indices of the nodes by their distance */
+struct DynamicBestPathsDistanceComparator
+{
+	DynamicBestPathsDistanceComparator(const int* distances)
+		: _distances(distances)
+	{ }
+
+	inline bool operator()(int lhs, int rhs) const
+	{
+		return _distances[lhs] < _distances[rhs];
+	}
+
+	const int* _distances;
+};
+
+/** Returns the node of the edge that isn't the given one */
+static inline Node* GetOtherNode(Edge* edge, const Node* node)
+{
+	return edge->GetStartNode() == node ? edge->GetEndNode() : edge->GetStartNode();
+}
+
+/** Default constructor */
+DynamicBestPaths::DynamicBestPaths()
+	: _graph(nullptr)
+	, _root(nullptr)
+	, _nodesCount(0)
+	, _nodesCapacity(0)
+	, _nodes(nullptr)
+	, _nodesAddresses(nullptr)
+	, _nodesAddressesCount(0)
+	, _entrantEdges(nullptr)
+	, _exitingEdges(nullptr)
+	, _marks(nullptr)
+	, _distances(nullptr)
+	, _edges(nullptr)
+	, _queue(nullptr)
+	, _affectedNodes(nullptr)
+	, _sortedNodes(nullptr)
+	, _updatedNodesCount(0)
+{ }
+
+/** Destructor */
+DynamicBestPaths::~DynamicBestPaths()
+{
+	free(_nodes);
+	free(_nodesAddresses);
+	free(_marks);
+	free(_distances);
+	free(_edges);
+	free(_queue);
+	free(_affectedNodes);
+	free(_sortedNodes);
+
+	delete[] _entrantEdges;
+	delete[] _exitingEdges;
+}
+
+/**
+* Computes the best paths of the given graph from the given root with Graph::ComputeBestPathsFromRoot and keeps them up to date from now on.
+* If the graph was solved from the same root the paths are the same it already has.
+* Returns false if the root isn't a node of the graph
+*/
+bool DynamicBestPaths::Attach(Graph& graph, Node* root)
+{
+	Detach();
+
+	_graph = &graph;
+	AddNewNodes();
+
+	if (root == nullptr || GetNodeIndex(root) == -1)
+	{
+		std::cerr << "DynamicBestPaths error [Attach]: the root isn't a node of the graph" << std::endl;
+		Detach();
+		return false;
+	}
+
+	_root = root;
+
+	// Build the lists of the edges of every node
+	Graph::EdgeList::Iterator it = graph._edges.Begin();
+	Graph::EdgeList::Iterator end = graph._edges.End();
+
+	for (; it && it != end; ++it)
+	{
+		Edge* edge = &(*it);
+
+		int startNodeIndex = GetNodeIndex(edge->GetStartNode());
+		int endNodeIndex = GetNodeIndex(edge->GetEndNode());
+
+		_exitingEdges[startNodeIndex].Add(edge);
+		_entrantEdges[endNodeIndex].Add(edge);
+
+		if (graph.GetGraphType() != Graph::GT_Directed && startNodeIndex != endNodeIndex)
+		{
+			_exitingEdges[endNodeIndex].Add(edge);
+			_entrantEdges[startNodeIndex].Add(edge);
+		}
+	}
+
+	// Forget the best edges of a previous computation, which could have been removed from the graph
+	for (int nodeIndex = 0; nodeIndex < _nodesCount; nodeIndex++)
+		_nodes[nodeIndex]->SetEdgeForBestPath(nullptr);
+
+	graph.ComputeBestPathsFromRoot(root, true);
+
+	return true;
+}
+
+/** Stops keeping the best paths of the attached graph up to date */
+void DynamicBestPaths::Detach()
+{
+	for (int nodeIndex = 0; nodeIndex < _nodesCount; nodeIndex++)
+	{
+		_entrantEdges[nodeIndex].Clear();
+		_exitingEdges[nodeIndex].Clear();
+	}
+
+	_graph = nullptr;
+	_root = nullptr;
+	_nodesCount = 0;
+	_nodesAddressesCount = 0;
+	_updatedNodesCount = 0;
+}
+
+/**
+* Adds an edge to the attached graph, like Graph::AddEdge does, and updates the best paths of the nodes that it brings closer to the root.
+* Returns the new edge or nullptr if it can't be added
+*/
+Edge* DynamicBestPaths::AddEdge(Node* startNode, Node* endNode)
+{
+	if (_graph == nullptr)
+	{
+		std::cerr << "DynamicBestPaths error [AddEdge]: no graph is attached" << std::endl;
+		return nullptr;
+	}
+
+	AddNewNodes();
+
+	int startNodeIndex = GetNodeIndex(startNode);
+	int endNodeIndex = GetNodeIndex(endNode);
+
+	if (startNodeIndex == -1 || endNodeIndex == -1)
+	{
+		std::cerr << "DynamicBestPaths error [AddEdge]: the nodes of the edge aren't nodes of the graph" << std::endl;
+		return nullptr;
+	}
+
+	Edge* edge = _graph->AddEdge(startNode, endNode);
+
+	if (edge == nullptr)
+		return nullptr;
+
+	_updatedNodesCount = 0;
+
+	_exitingEdges[startNodeIndex].Add(edge);
+	_entrantEdges[endNodeIndex].Add(edge);
+
+	InsertBestPaths(edge, startNodeIndex, endNodeIndex);
+
+	// If the graph is not directed the edge can be walked in both the directions
+	if (_graph->GetGraphType() != Graph::GT_Directed && startNodeIndex != endNodeIndex)
+	{
+		_exitingEdges[endNodeIndex].Add(edge);
+		_entrantEdges[startNodeIndex].Add(edge);
+
+		InsertBestPaths(edge, endNodeIndex, startNodeIndex);
+	}
+
+	return edge;
+}
+
+/**
+* Removes the given edge from the attached graph and updates the best paths that passed through it.
+* Returns false if the edge isn't an edge of the graph
+*/
+bool DynamicBestPaths::RemoveEdge(Edge* edge)
+{
+	if (_graph == nullptr)
+	{
+		std::cerr << "DynamicBestPaths error [RemoveEdge]: no graph is attached" << std::endl;
+		return false;
+	}
+
+	AddNewNodes();
+
+	int startNodeIndex = edge != nullptr ? GetNodeIndex(edge->GetStartNode()) : -1;
+	int endNodeIndex = edge != nullptr ? GetNodeIndex(edge->GetEndNode()) : -1;
+
+	if (startNodeIndex == -1 || endNodeIndex == -1 || _exitingEdges[startNodeIndex].Find(edge) == -1)
+	{
+		std::cerr << "DynamicBestPaths error [RemoveEdge]: the edge isn't an edge of the graph" << std::endl;
+		return false;
+	}
+
+	_updatedNodesCount = 0;
+
+	_exitingEdges[startNodeIndex].Remove(edge);
+	_entrantEdges[endNodeIndex].Remove(edge);
+
+	bool directed = _graph->GetGraphType() == Graph::GT_Directed;
+
+	if (directed == false && startNodeIndex != endNodeIndex)
+	{
+		_exitingEdges[endNodeIndex].Remove(edge);
+		_entrantEdges[startNodeIndex].Remove(edge);
+	}
+
+	// Only the node that reached the root through the edge, and its subtree, can change their best paths
+	if (_nodes[endNodeIndex]->GetEdgeForBestPath() == edge)
+		RemoveBestPaths(endNodeIndex);
+	else if (directed == false && _nodes[startNodeIndex]->GetEdgeForBestPath() == edge)
+		RemoveBestPaths(startNodeIndex);
+
+	_graph->RemoveEdge(edge);
+
+	return true;
+}
+
+/** Relaxes the given edge that goes from the node 'startNodeIndex' and updates the nodes that get closer to the root, in breadth-first order */
+void DynamicBestPaths::InsertBestPaths(Edge* edge, int startNodeIndex, int endNodeIndex)
+{
+	int startDistance = _nodes[startNodeIndex]->GetDistanceFromRoot();
+	int endDistance = _nodes[endNodeIndex]->GetDistanceFromRoot();
+
+	if (startDistance == -1 || (endDistance != -1 && endDistance <= startDistance + 1))
+		return;
+
+	SetBestPath(endNodeIndex, edge, startDistance + 1);
+
+	// Every node is reached first with its new distance, so it is added to the queue at most once
+	int queueBegin = 0;
+	int queueEnd = 0;
+
+	_queue[queueEnd++] = endNodeIndex;
+
+	while (queueBegin < queueEnd)
+	{
+		int nodeIndex = _queue[queueBegin++];
+		Node* node = _nodes[nodeIndex];
+		int distance = node->GetDistanceFromRoot() + 1;
+
+		Graph::EdgePointersList::Iterator it = _exitingEdges[nodeIndex].Begin();
+		Graph::EdgePointersList::Iterator end = _exitingEdges[nodeIndex].End();
+
+		for (; it && it != end; ++it)
+		{
+			Node* adjacentNode = GetOtherNode(*it, node);
+			int adjacentDistance = adjacentNode->GetDistanceFromRoot();
+
+			if (adjacentDistance == -1 || distance < adjacentDistance)
+			{
+				int adjacentNodeIndex = GetNodeIndex(adjacentNode);
+
+				SetBestPath(adjacentNodeIndex, *it, distance);
+				_queue[queueEnd++] = adjacentNodeIndex;
+			}
+		}
+	}
+}
+
+/** Updates the best paths of the subtree of the given node, whose best edge was removed */
+void DynamicBestPaths::RemoveBestPaths(int nodeIndex)
+{
+	int affectedNodesCount = 0;
+	int queueBegin = 0;
+	int queueEnd = 0;
+
+	// Visit the subtree in breadth-first order, so by increasing distance. A node that has another entrant edge from a node
+	// that isn't affected and is one step closer to the root keeps its distance, and so does its subtree
+	_queue[queueEnd++] = nodeIndex;
+
+	while (queueBegin < queueEnd)
+	{
+		int currentNodeIndex = _queue[queueBegin++];
+		Node* node = _nodes[currentNodeIndex];
+		int distance = node->GetDistanceFromRoot();
+
+		Edge* sameDistanceEdge = nullptr;
+
+		Graph::EdgePointersList::Iterator it = _entrantEdges[currentNodeIndex].Begin();
+		Graph::EdgePointersList::Iterator end = _entrantEdges[currentNodeIndex].End();
+
+		for (; it && it != end && sameDistanceEdge == nullptr; ++it)
+		{
+			Node* entrantNode = GetOtherNode(*it, node);
+
+			if (entrantNode->GetDistanceFromRoot() != -1 && entrantNode->GetDistanceFromRoot() + 1 == distance && _marks[GetNodeIndex(entrantNode)] == 0)
+				sameDistanceEdge = *it;
+		}
+
+		if (sameDistanceEdge != nullptr)
+		{
+			SetBestPath(currentNodeIndex, sameDistanceEdge, distance);
+			continue;
+		}
+
+		_marks[currentNodeIndex] = 1;
+		_affectedNodes[affectedNodesCount++] = currentNodeIndex;
+
+		// The children of the node are the adjacent nodes whose best edge comes from it
+		it = _exitingEdges[currentNodeIndex].Begin();
+		end = _exitingEdges[currentNodeIndex].End();
+
+		for (; it && it != end; ++it)
+		{
+			Node* adjacentNode = GetOtherNode(*it, node);
+
+			if (adjacentNode->GetEdgeForBestPath() == *it)
+				_queue[queueEnd++] = GetNodeIndex(adjacentNode);
+		}
+	}
+
+	// Every affected node starts from the best of its entrant edges that come from nodes that aren't affected
+	int sortedNodesCount = 0;
+
+	for (int i = 0; i < affectedNodesCount; i++)
+	{
+		int affectedNodeIndex = _affectedNodes[i];
+		Node* node = _nodes[affectedNodeIndex];
+
+		_distances[affectedNodeIndex] = -1;
+		_edges[affectedNodeIndex] = nullptr;
+
+		Graph::EdgePointersList::Iterator it = _entrantEdges[affectedNodeIndex].Begin();
+		Graph::EdgePointersList::Iterator end = _entrantEdges[affectedNodeIndex].End();
+
+		for (; it && it != end; ++it)
+		{
+			Node* entrantNode = GetOtherNode(*it, node);
+			int entrantDistance = entrantNode->GetDistanceFromRoot();
+
+			if (entrantDistance != -1 && _marks[GetNodeIndex(entrantNode)] == 0 && (_distances[affectedNodeIndex] == -1 || entrantDistance + 1 < _distances[affectedNodeIndex]))
+			{
+				_distances[affectedNodeIndex] = entrantDistance + 1;
+				_edges[affectedNodeIndex] = *it;
+			}
+		}
+
+		if (_distances[affectedNodeIndex] != -1)
+			_sortedNodes[sortedNodesCount++] = affectedNodeIndex;
+	}
+
+	std::sort(_sortedNodes, _sortedNodes + sortedNodesCount, DynamicBestPathsDistanceComparator(_distances));
+
+	// Set the best paths by increasing distance, merging the sorted nodes with the queue of the nodes reached from the affected nodes.
+	// With edges of weight 1 the queue is already sorted, so every node gets its final distance the first time it is taken
+	int sortedNodesIndex = 0;
+
+	queueBegin = 0;
+	queueEnd = 0;
+
+	while (queueBegin < queueEnd || sortedNodesIndex < sortedNodesCount)
+	{
+		int currentNodeIndex;
+
+		if (queueBegin < queueEnd && (sortedNodesIndex == sortedNodesCount || _distances[_queue[queueBegin]] <= _distances[_sortedNodes[sortedNodesIndex]]))
+			currentNodeIndex = _queue[queueBegin++];
+		else
+			currentNodeIndex = _sortedNodes[sortedNodesIndex++];
+
+		if (_marks[currentNodeIndex] != 1)
+			continue;
+
+		_marks[currentNodeIndex] = 2;
+
+		Node* node = _nodes[currentNodeIndex];
+		int distance = _distances[currentNodeIndex] + 1;
+
+		SetBestPath(currentNodeIndex, _edges[currentNodeIndex], _distances[currentNodeIndex]);
+
+		Graph::EdgePointersList::Iterator it = _exitingEdges[currentNodeIndex].Begin();
+		Graph::EdgePointersList::Iterator end = _exitingEdges[currentNodeIndex].End();
+
+		for (; it && it != end; ++it)
+		{
+			int adjacentNodeIndex = GetNodeIndex(GetOtherNode(*it, node));
+
+			if (_marks[adjacentNodeIndex] == 1 && (_distances[adjacentNodeIndex] == -1 || distance < _distances[adjacentNodeIndex]))
+			{
+				_distances[adjacentNodeIndex] = distance;
+				_edges[adjacentNodeIndex] = *it;
+				_queue[queueEnd++] = adjacentNodeIndex;
+			}
+		}
+	}
+
+	// The affected nodes that weren't reached can't be reached from the root anymore
+	for (int i = 0; i < affectedNodesCount; i++)
+	{
+		if (_marks[_affectedNodes[i]] == 1)
+			SetBestPath(_affectedNodes[i], nullptr, -1);
+
+		_marks[_affectedNodes[i]] = 0;
+	}
+}
+
+/** Sets the best edge and the distance of the given node, moving the dashed style to the new edge and updating the label of the node */
+void DynamicBestPaths::SetBestPath(int nodeIndex, Edge* edge, int distance)
+{
+	Node* node = _nodes[nodeIndex];
+	Edge* bestEdge = node->GetEdgeForBestPath();
+
+	if (bestEdge == edge && node->GetDistanceFromRoot() == distance)
+		return;
+
+	if (bestEdge != edge)
+	{
+		if (bestEdge != nullptr)
+			bestEdge->RemoveAttribute("style");
+
+		if (edge != nullptr)
+			edge->SetAttribute("style", "dashed", false, false);
+
+		node->SetEdgeForBestPath(edge);
+	}
+
+	node->SetDistanceFromRoot(distance);
+
+	if (distance != -1)
+		node->SetAttribute("label", "d(" + _root->GetName() + "," + node->GetName() + " = " + std::to_string(distance) + ")", false, true);
+	else
+		node->RemoveAttribute("label");
+
+	_updatedNodesCount++;
+}
+
+/** Adds the nodes that were added to the graph after the last call to this method */
+void DynamicBestPaths::AddNewNodes()
+{
+	int nodesCount = _graph->GetNodes().GetSize();
+
+	if (nodesCount == _nodesCount)
+		return;
+
+	Reserve(nodesCount);
+
+	_graph->GetNodesArray(_nodes);
+
+	for (; _nodesCount < nodesCount; _nodesCount++)
+	{
+		_entrantEdges[_nodesCount].Clear();
+		_exitingEdges[_nodesCount].Clear();
+		_marks[_nodesCount] = 0;
+	}
+}
+
+/** Returns the index of the given node or -1 if it isn't a node of the graph */
+int DynamicBestPaths::GetNodeIndex(const Node* node)
+{
+	// Sort the nodes by address the first time an index is needed after the nodes have changed
+	if (_nodesAddressesCount != _nodesCount)
+	{
+		for (int nodeIndex = 0; nodeIndex < _nodesCount; nodeIndex++)
+		{
+			_nodesAddresses[nodeIndex]._node = _nodes[nodeIndex];
+			_nodesAddresses[nodeIndex]._nodeIndex = nodeIndex;
+		}
+
+		std::sort(_nodesAddresses, _nodesAddresses + _nodesCount);
+
+		_nodesAddressesCount = _nodesCount;
+	}
+
+	NodeAddress entry = { node, -1 };
+	NodeAddress* found = std::lower_bound(_nodesAddresses, _nodesAddresses + _nodesCount, entry);
+
+	if (found == _nodesAddresses + _nodesCount || found->_node != node)
+		return -1;
+
+	return found->_nodeIndex;
+}
+
+/** Makes sure the arrays of the nodes can store the given number of nodes */
+void DynamicBestPaths::Reserve(int nodesCount)
+{
+	if (nodesCount <= _nodesCapacity)
+		return;
+
+	int capacity = std::max(nodesCount, _nodesCapacity * 2);
+
+	_nodes = (Node**)realloc(_nodes, sizeof(Node*) * capacity);
+	_nodesAddresses = (NodeAddress*)realloc(_nodesAddresses, sizeof(NodeAddress) * capacity);
+	_marks = (unsigned char*)realloc(_marks, sizeof(unsigned char) * capacity);
+	_distances = (int*)realloc(_distances, sizeof(int) * capacity);
+	_edges = (Edge**)realloc(_edges, sizeof(Edge*) * capacity);
+	_queue = (int*)realloc(_queue, sizeof(int) * capacity);
+	_affectedNodes = (int*)realloc(_affectedNodes, sizeof(int) * capacity);
+	_sortedNodes = (int*)realloc(_sortedNodes, sizeof(int) * capacity);
+
+	// Move the lists of edges to the new arrays
+	Graph::EdgePointersList* entrantEdges = new Graph::EdgePointersList[capacity];
+	Graph::EdgePointersList* exitingEdges = new Graph::EdgePointersList[capacity];
+
+	for (int nodeIndex = 0; nodeIndex < _nodesCount; nodeIndex++)
+	{
+		entrantEdges[nodeIndex] = std::move(_entrantEdges[nodeIndex]);
+		exitingEdges[nodeIndex] = std::move(_exitingEdges[nodeIndex]);
+	}
+
+	delete[] _entrantEdges;
+	delete[] _exitingEdges;
+
+	_entrantEdges = entrantEdges;
+	_exitingEdges = exitingEdges;
+
+	_nodesCapacity = capacity;
+}
\ No newline at end of file
@@ -1,4 +1,29 @@
 #include "Graph.h"
+#include "MemoryAccounting.h"
+
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+
+/** Allocates a scratch array of the algorithms run by the solver, counted by MemoryAccounting. It must be released with FreeScratch */
+static inline void* AllocateScratch(size_t bytes)
+{
+	return MemoryAccounting::CountedMalloc(MemoryAccounting::MC_SolverScratch, bytes);
+}
+
+/** Allocates a scratch array of the algorithms run by the solver set to 0, counted by MemoryAccounting. It must be released with FreeScratch */
+static inline void* AllocateZeroedScratch(size_t count, size_t size)
+{
+	return MemoryAccounting::CountedCalloc(MemoryAccounting::MC_SolverScratch, count, size);
+}
+
+/** Releases a scratch array allocated by AllocateScratch or AllocateZeroedScratch */
+static inline void FreeScratch(void* memory)
+{
+	MemoryAccounting::CountedFree(MemoryAccounting::MC_SolverScratch, memory);
+}
 
 /**
 * Comparator used by Graph::AddEdge to check if an edge with the
@@ -74,6 +99,79 @@ struct NodeComparator
 	std::string _name;
 };
 
+/** Entry used by the bulk construction methods to sort the names of the nodes */
+struct NodeNameEntry
+{
+	/** Name of the node */
+	const std::string* _name;
+
+	/** Position of the name inside the batch. It's negative for the nodes already inside the graph */
+	int _order;
+
+	/** Index of the node inside the list of nodes of the graph (valid only for the nodes already inside the graph) */
+	int _nodeIndex;
+};
+
+/** Comparator used to sort the NodeNameEntry by name first and then by order */
+struct NodeNameEntryComparator
+{
+	inline bool operator()(const NodeNameEntry& lhs, const NodeNameEntry& rhs) const
+	{
+		int comparison = lhs._name->compare(*rhs._name);
+
+		if (comparison != 0)
+			return comparison < 0;
+		return lhs._order < rhs._order;
+	}
+};
+
+/** Entry used by the bulk construction methods to sort the edges by their nodes */
+struct EdgeEntry
+{
+	/** Start node of the edge (for non directed graphs it is the node with the lowest address) */
+	const Node* _startNode;
+
+	/** End node of the edge (for non directed graphs it is the node with the highest address) */
+	const Node* _endNode;
+
+	/** Position of the edge inside the batch. It's negative for the edges already inside the graph */
+	int _order;
+};
+
+/** Comparator used to sort the EdgeEntry by start node, end node and order */
+struct EdgeEntryComparator
+{
+	inline bool operator()(const EdgeEntry& lhs, const EdgeEntry& rhs) const
+	{
+		std::less<const Node*> less;
+
+		if (lhs._startNode != rhs._startNode)
+			return less(lhs._startNode, rhs._startNode);
+		if (lhs._endNode != rhs._endNode)
+			return less(lhs._endNode, rhs._endNode);
+		return lhs._order < rhs._order;
+	}
+};
+
+/** Entry used by Graph::Copy to find the index of a node from its address */
+struct NodeAddressEntry
+{
+	/** Address of the node */
+	const Node* _node;
+
+	/** Index of the node inside the list of nodes of the graph */
+	int _nodeIndex;
+};
+
+/** Comparator used to sort and search the NodeAddressEntry by address */
+struct NodeAddressEntryComparator
+{
+	inline bool operator()(const NodeAddressEntry& lhs, const NodeAddressEntry& rhs) const
+	{
+		return std::less<const Node*>()(lhs._node, rhs._node);
+	}
+};
+
 /** Default constructor */
 Graph::Graph()
 	: _graphType(GT_NotValid)
@@ -150,28 +248,62 @@ void Graph::Copy(const Graph& src)
 	_edges.Clear();
 	_nodes.Clear();
 	
+	int nodesCount = src._nodes.GetSize();
+	int edgesCount = src._edges.GetSize();
+
+	Reserve(nodesCount, edgesCount);
+
 	// Add all the nodes
 	NodeList::ConstIterator nodesIt = src._nodes.Begin();
 	NodeList::ConstIterator nodesEnd = src._nodes.End();
 	for (; nodesIt && nodesIt != nodesEnd; ++nodesIt)
 	{
-		Node node = Node((*nodesIt).GetName(), (*nodesIt).EncloseNameInDoubleQuotes());
+		Node node = Node((*nodesIt)._name, (*nodesIt).EncloseNameInDoubleQuotes());
 		node.CopyAttributes(*nodesIt);
 
 		_nodes.Add(node);
 	}
 
+	if (nodesCount == 0)
+		return;
+
+	// Sort the nodes of the source graph by their address so that the nodes of an edge can be found
+	// with a binary search instead of looking for their names inside the list of nodes
+	Node** nodes = (Node**)malloc(sizeof(Node*) * nodesCount);
+	NodeAddressEntry* sourceNodes = (NodeAddressEntry*)malloc(sizeof(NodeAddressEntry) * nodesCount);
+
+	GetNodesArray(nodes);
+
+	nodesIt = src._nodes.Begin();
+	for (int index = 0; nodesIt && nodesIt != nodesEnd; index++, ++nodesIt)
+	{
+		sourceNodes[index]._node = &(*nodesIt);
+		sourceNodes[index]._nodeIndex = index;
+
+		// The adjacency lists will have the same size of the source ones
+		nodes[index]->ReserveAdjacentNodes((*nodesIt).GetAdjacentNodes().GetSize());
+	}
+
+	std::sort(sourceNodes, sourceNodes + nodesCount, NodeAddressEntryComparator());
+
 	// Add all the edges
 	EdgeList::ConstIterator edgesIt = src._edges.Begin();
 	EdgeList::ConstIterator edgesEnd = src._edges.End();
 	for (; edgesIt && edgesIt != edgesEnd; ++edgesIt)
 	{
-		const std::string& startNodeName = (*edgesIt).GetStartNode()->GetName();
-		const std::string& endNodeName = (*edgesIt).GetEndNode()->GetName();
+		NodeAddressEntry startEntry = { (*edgesIt).GetStartNode(), -1 };
+		NodeAddressEntry endEntry = { (*edgesIt).GetEndNode(), -1 };
+
+		int startNodeIndex = std::lower_bound(sourceNodes, sourceNodes + nodesCount, startEntry, NodeAddressEntryComparator())->_nodeIndex;
+		int endNodeIndex = std::lower_bound(sourceNodes, sourceNodes + nodesCount, endEntry, NodeAddressEntryComparator())->_nodeIndex;
 
-		Edge* addedEdge = AddEdgeNoCheck(startNodeName, endNodeName);
+		Edge* addedEdge = AddEdgeNoCheck(nodes[startNodeIndex], nodes[endNodeIndex]);
 		addedEdge->CopyAttributes(*edgesIt);
+		addedEdge->SetAddedBySolver((*edgesIt).IsAddedBySolver());
 	}
+
+	free(sourceNodes);
+	free(nodes);
 }
 
 /**
@@ -273,33 +405,507 @@ Edge* Graph::AddEdge(const std::string& startNodeName, const std::string& endNod
 }
 
 /**
-* Adds a new edge without doing any check. (Utility for the copy operator and constructor)
+* Adds a new edge without doing any check. (Utility for the copy operator and constructor and the bulk construction methods)
 * Returns a pointer to the new edge.
 */
-Edge* Graph::AddEdgeNoCheck(const std::string& startNodeName, const std::string& endNodeName)
+Edge* Graph::AddEdgeNoCheck(Node* startNode, Node* endNode)
 {
-	// Searche the nodes inside the ones already present
-	Node* startNode = GetNode(startNodeName);
-	Node* endNode = GetNode(endNodeName);
-
 	// Create the new edge and add it to the list of edges of the graph
 	_edges.Add(Edge(startNode, endNode));
 
 	// If the graph is directed add the end node to the adjacency list of the start node
-	if (_graphType == GT_Directed)
-		startNode->AddAdjacentNode(endNode);
+	startNode->AddAdjacentNodeNoCheck(endNode);
+
 	// If the graph is not directed then both the nodes can be reached through one or the other
-	// so add both to the adjacency list of the other one
-	else
-	{
-		startNode->AddAdjacentNode(endNode);
-		endNode->AddAdjacentNode(startNode);
-	}
+	// so add both to the adjacency list of the other one (only once if the edge is a loop)
+	if (_graphType != GT_Directed && startNode != endNode)
+		endNode->AddAdjacentNodeNoCheck(startNode);
 
 	// Return the last edge inside the list which is the one which has been added
 	return &_edges.Back();
 }
 
+/**
+* Adds a new node without checking if a node with the same name already exists. (Utility for the readers that load graphs known to be valid)
+* Returns a pointer to the new node.
+*/
+Node* Graph::AddNodeNoCheck(const std::string& name, bool encloseNodeNameInDoubleQuotes)
+{
+	_nodes.Add(Node(name, encloseNodeNameInDoubleQuotes));
+
+	// Returns the last node inside the list which is the one that has been just added
+	return &_nodes.Back();
+}
+
+/**
+* Fills the given array with the pointers to the nodes of this graph, in the same order of the list of nodes
+* so that a node can be found by its index without looping through the list. The array must contain at least GetNodes().GetSize() elements
+*/
+void Graph::GetNodesArray(Node** nodes)
+{
+	NodeList::Iterator it = _nodes.Begin();
+	NodeList::Iterator end = _nodes.End();
+
+	for (int index = 0; it && it != end; index++, it++)
+		nodes[index] = &(*it);
+}
+
+/** Returns the number of bytes allocated by the given string outside of the string object */
+static long long GetStringHeapBytes(const std::string& value)
+{
+	static const size_t s_localCapacity = std::string().capacity();
+	return (value.capacity() > s_localCapacity) ? (long long)value.capacity() + 1 : 0;
+}
+
+/** Adds the memory of the given attributes to the given footprint */
+static void AddAttributesFootprint(const GraphElement::AttributeList& attributes, Graph::MemoryFootprint& footprint)
+{
+	footprint._attributesBytes += (long long)attributes.GetSize() * GraphElement::AttributeList::GetItemSize();
+	footprint._freeListSlackBytes += (long long)(attributes.GetCapacity() - attributes.GetSize()) * GraphElement::AttributeList::GetItemSize();
+
+	GraphElement::AttributeList::ConstIterator it = attributes.Begin();
+	GraphElement::AttributeList::ConstIterator end = attributes.End();
+
+	for (; it && it != end; ++it)
+		footprint._attributesBytes += GetStringHeapBytes((*it)._name) + GetStringHeapBytes((*it)._value);
+}
+
+/**
+* Returns the memory used by this graph, computed from the number of items of its lists and from the lengths of its strings.
+* The memory of a string is counted only if it doesn't fit inside the string object, and the overhead of the heap isn't counted
+*/
+Graph::MemoryFootprint Graph::GetMemoryFootprint() const
+{
+	MemoryFootprint footprint;
+
+	footprint._graphBytes = sizeof(Graph) + GetStringHeapBytes(_name);
+
+	// The items of the lists of nodes and edges contain the objects, so the lists of attributes and of adjacent nodes are counted only for their items
+	footprint._nodesBytes = (long long)_nodes.GetSize() * NodeList::GetItemSize();
+	footprint._edgesBytes = (long long)_edges.GetSize() * EdgeList::GetItemSize();
+	footprint._freeListSlackBytes = (long long)(_nodes.GetCapacity() - _nodes.GetSize()) * NodeList::GetItemSize() + (long long)(_edges.GetCapacity() - _edges.GetSize()) * EdgeList::GetItemSize();
+
+	NodeList::ConstIterator nodesIt = _nodes.Begin();
+	NodeList::ConstIterator nodesEnd = _nodes.End();
+
+	for (; nodesIt && nodesIt != nodesEnd; ++nodesIt)
+	{
+		const Node& node = *nodesIt;
+		const List<Node*>& adjacentNodes = node.GetAdjacentNodes();
+
+		footprint._nodesBytes += GetStringHeapBytes(node.GetName());
+		footprint._adjacencyBytes += (long long)adjacentNodes.GetSize() * List<Node*>::GetItemSize();
+		footprint._freeListSlackBytes += (long long)(adjacentNodes.GetCapacity() - adjacentNodes.GetSize()) * List<Node*>::GetItemSize();
+		AddAttributesFootprint(node.GetAttributes(), footprint);
+	}
+
+	EdgeList::ConstIterator edgesIt = _edges.Begin();
+	EdgeList::ConstIterator edgesEnd = _edges.End();
+
+	for (; edgesIt && edgesIt != edgesEnd; ++edgesIt)
+		AddAttributesFootprint((*edgesIt).GetAttributes(), footprint);
+
+	return footprint;
+}
+
+/**
+* Removes all the nodes and the edges and resets the name and the type of the graph.
+* The memory allocated for the nodes and the edges is kept to reuse it for the next graph stored inside this one
+*/
+Graph& Graph::Clear()
+{
+	_edges.Clear();
+	_nodes.Clear();
+	_name = "";
+	_encloseNameInDoubleQuotes = false;
+	_graphType = GT_NotValid;
+
+	return *this;
+}
+
+/**
+* Makes sure the graph can store the given number of nodes and edges without allocating more memory.
+* Use this before adding a big amount of nodes and edges to the graph
+* nodesCount: the total number of nodes that the graph will contain
+* edgesCount: the total number of edges that the graph will contain
+*/
+Graph& Graph::Reserve(int nodesCount, int edgesCount)
+{
+	_nodes.Reserve(nodesCount);
+	_edges.Reserve(edgesCount);
+
+	return *this;
+}
+
+/**
+* Adds a batch of nodes to the graph. Names which are already used by a node of the graph or that are repeated
+* inside the batch don't create new nodes. The new nodes are added in the order of the first occurrence of their name.
+* The result is the same of calling AddNode for every definition but the names are looked up all at once.
+* nodes: the definitions of the nodes to add
+* nodesIndices: if not nullptr, it's filled with the index inside the list of nodes of the graph of every given definition
+* Returns false if one of the names is empty, in which case nothing is added
+*/
+bool Graph::AddNodes(const NodeDefinitionList& nodes, List<int>* nodesIndices)
+{
+	int definitionsCount = nodes.GetSize();
+
+	if (nodesIndices != nullptr)
+		nodesIndices->Clear(definitionsCount);
+
+	if (definitionsCount == 0)
+		return true;
+
+	// Store the definitions inside an array so that they can be accessed by their position
+	const NodeDefinition** definitions = (const NodeDefinition**)malloc(sizeof(const NodeDefinition*) * definitionsCount);
+	int* resultIndices = (nodesIndices != nullptr) ? (int*)malloc(sizeof(int) * definitionsCount) : nullptr;
+
+	NodeDefinitionList::ConstIterator definitionsIt = nodes.Begin();
+	NodeDefinitionList::ConstIterator definitionsEnd = nodes.End();
+	for (int index = 0; definitionsIt && definitionsIt != definitionsEnd; index++, ++definitionsIt)
+		definitions[index] = &(*definitionsIt);
+
+	bool result = AddNodeDefinitions(definitions, definitionsCount, resultIndices);
+
+	if (result && nodesIndices != nullptr)
+	{
+		for (int index = 0; index < definitionsCount; index++)
+			nodesIndices->Add(resultIndices[index]);
+	}
+
+	free(resultIndices);
+	free(definitions);
+
+	return result;
+}
+
+/**
+* Adds a batch of nodes stored inside an array, like the other AddNodes does
+* nodes: the definitions of the nodes to add
+* nodesCount: the number of definitions
+* nodesIndices: if not nullptr, it's an array of nodesCount elements filled with the index inside the list of nodes of the graph of every given definition
+* Returns false if one of the names is empty, in which case nothing is added
+*/
+bool Graph::AddNodes(const NodeDefinition* nodes, int nodesCount, int* nodesIndices)
+{
+	if (nodesCount <= 0)
+		return true;
+
+	const NodeDefinition** definitions = (const NodeDefinition**)malloc(sizeof(const NodeDefinition*) * nodesCount);
+
+	for (int index = 0; index < nodesCount; index++)
+		definitions[index] = &nodes[index];
+
+	bool result = AddNodeDefinitions(definitions, nodesCount, nodesIndices);
+
+	free(definitions);
+
+	return result;
+}
+
+/** Adds the batch of nodes given by the pointers to their definitions. Used by both the AddNodes methods */
+bool Graph::AddNodeDefinitions(const NodeDefinition** definitions, int definitionsCount, int* nodesIndices)
+{
+	int existingNodesCount = _nodes.GetSize();
+
+	for (int index = 0; index < definitionsCount; index++)
+	{
+		if (definitions[index]->_name.empty())
+		{
+			std::cerr << "Graph error [AddNodes]: adding a node without name" << std::endl;
+			return false;
+		}
+	}
+
+	// Put the names of the nodes of the graph and the ones of the batch together and sort them.
+	// The nodes of the graph have a negative order so they come before the ones of the batch with the same name
+	int entriesCount = existingNodesCount + definitionsCount;
+	NodeNameEntry* entries = (NodeNameEntry*)malloc(sizeof(NodeNameEntry) * entriesCount);
+
+	NodeList::Iterator nodesIt = _nodes.Begin();
+	NodeList::Iterator nodesEnd = _nodes.End();
+	for (int index = 0; nodesIt && nodesIt != nodesEnd; index++, nodesIt++)
+	{
+		entries[index]._name = &(*nodesIt)._name;
+		entries[index]._order = index - existingNodesCount;
+		entries[index]._nodeIndex = index;
+	}
+
+	for (int index = 0; index < definitionsCount; index++)
+	{
+		entries[existingNodesCount + index]._name = &definitions[index]->_name;
+		entries[existingNodesCount + index]._order = index;
+		entries[existingNodesCount + index]._nodeIndex = -1;
+	}
+
+	std::sort(entries, entries + entriesCount, NodeNameEntryComparator());
+
+	// For every definition find the index of the node it refers to if the node already exists,
+	// otherwise the position of the first definition with the same name, which is the one that creates the node
+	int* resultIndices = (int*)malloc(sizeof(int) * definitionsCount);
+	int* firstOccurrences = (int*)malloc(sizeof(int) * definitionsCount);
+
+	for (int groupStart = 0; groupStart < entriesCount;)
+	{
+		const NodeNameEntry& first = entries[groupStart];
+
+		int groupEnd = groupStart;
+		for (; groupEnd < entriesCount && *entries[groupEnd]._name == *first._name; groupEnd++)
+		{
+			int order = entries[groupEnd]._order;
+
+			if (order < 0)
+				continue;
+
+			if (first._order < 0)
+			{
+				resultIndices[order] = first._nodeIndex;
+				firstOccurrences[order] = -1;
+			}
+			else
+				firstOccurrences[order] = first._order;
+		}
+
+		groupStart = groupEnd;
+	}
+
+	// Create the new nodes in the order of their first occurrence
+	_nodes.Reserve(existingNodesCount + definitionsCount);
+
+	for (int index = 0; index < definitionsCount; index++)
+	{
+		if (firstOccurrences[index] == index)
+		{
+			resultIndices[index] = _nodes.GetSize();
+			_nodes.Add(Node(definitions[index]->_name, definitions[index]->_encloseNameInDoubleQuotes));
+		}
+		else if (firstOccurrences[index] >= 0)
+			resultIndices[index] = resultIndices[firstOccurrences[index]];
+
+		if (nodesIndices != nullptr)
+			nodesIndices[index] = resultIndices[index];
+	}
+
+	free(firstOccurrences);
+	free(resultIndices);
+	free(entries);
+
+	return true;
+}
+
+/**
+* Adds a batch of edges to the graph given the indices of their nodes.
+* The duplicated edges (both inside the batch and with the edges already inside the graph) are removed all at once
+* and the adjacency lists of the nodes are built in one pass. The edges are added in the same order of the batch,
+* so the result is the same of calling AddEdge for every definition.
+* edges: the definitions of the edges to add
+* addedEdges: if not nullptr, it's filled with the pointer to the edge created for every given definition (nullptr if it was a duplicate)
+* Returns the number of added edges or -1 if one of the indices is not valid, in which case nothing is added
+*/
+int Graph::AddEdges(const EdgeDefinitionList& edges, EdgePointersList* addedEdges)
+{
+	int definitionsCount = edges.GetSize();
+
+	if (addedEdges != nullptr)
+		addedEdges->Clear(definitionsCount);
+
+	if (definitionsCount == 0)
+		return 0;
+
+	// Store the definitions inside an array and add them like the definitions of an array
+	EdgeDefinition* definitions = (EdgeDefinition*)malloc(sizeof(EdgeDefinition) * definitionsCount);
+	Edge** resultEdges = (addedEdges != nullptr) ? (Edge**)malloc(sizeof(Edge*) * definitionsCount) : nullptr;
+
+	EdgeDefinitionList::ConstIterator definitionsIt = edges.Begin();
+	EdgeDefinitionList::ConstIterator definitionsEnd = edges.End();
+	for (int index = 0; definitionsIt && definitionsIt != definitionsEnd; index++, ++definitionsIt)
+		definitions[index] = *definitionsIt;
+
+	int result = AddEdges(definitions, definitionsCount, resultEdges);
+
+	if (result >= 0 && addedEdges != nullptr)
+	{
+		for (int index = 0; index < definitionsCount; index++)
+			addedEdges->Add(resultEdges[index]);
+	}
+
+	free(resultEdges);
+	free(definitions);
+
+	return result;
+}
+
+/**
+* Adds a batch of edges stored inside an array given the indices of their nodes, like the other AddEdges does
+* edges: the definitions of the edges to add
+* edgesCount: the number of definitions
+* addedEdges: if not nullptr, it's an array of edgesCount elements filled with the pointer to the edge created for every given definition (nullptr if it was a duplicate)
+* Returns the number of added edges or -1 if one of the indices is not valid, in which case nothing is added
+*/
+int Graph::AddEdges(const EdgeDefinition* edges, int edgesCount, Edge** addedEdges)
+{
+	int definitionsCount = edgesCount;
+	int existingEdgesCount = _edges.GetSize();
+	int nodesCount = _nodes.GetSize();
+
+	if (definitionsCount <= 0)
+		return 0;
+
+	// Make sure all the indices are valid before adding anything
+	for (int index = 0; index < definitionsCount; index++)
+	{
+		const EdgeDefinition& definition = edges[index];
+
+		if (definition._startNodeIndex < 0 || definition._startNodeIndex >= nodesCount || definition._endNodeIndex < 0 || definition._endNodeIndex >= nodesCount)
+		{
+			std::cerr << "Graph error [AddEdges]: adding an edge with an invalid start or end node index" << std::endl;
+			return -1;
+		}
+	}
+
+	Node** nodes = (Node**)malloc(sizeof(Node*) * nodesCount);
+	GetNodesArray(nodes);
+
+	// Put the edges of the graph and the ones of the batch together and sort them by their nodes.
+	// The edges of the graph have a negative order so they come before the ones of the batch with the same nodes
+	int entriesCount = existingEdgesCount + definitionsCount;
+	EdgeEntry* entries = (EdgeEntry*)malloc(sizeof(EdgeEntry) * entriesCount);
+	std::less<const Node*> less;
+
+	EdgeList::Iterator edgesIt = _edges.Begin();
+	EdgeList::Iterator edgesEnd = _edges.End();
+	for (int index = 0; edgesIt && edgesIt != edgesEnd; index++, edgesIt++)
+	{
+		entries[index]._startNode = (*edgesIt).GetStartNode();
+		entries[index]._endNode = (*edgesIt).GetEndNode();
+		entries[index]._order = index - existingEdgesCount;
+	}
+
+	for (int index = 0; index < definitionsCount; index++)
+	{
+		entries[existingEdgesCount + index]._startNode = nodes[edges[index]._startNodeIndex];
+		entries[existingEdgesCount + index]._endNode = nodes[edges[index]._endNodeIndex];
+		entries[existingEdgesCount + index]._order = index;
+	}
+
+	// If the graph is not directed the start and end node can be swapped so sort them by address
+	if (_graphType != GT_Directed)
+	{
+		for (int index = 0; index < entriesCount; index++)
+		{
+			if (less(entries[index]._endNode, entries[index]._startNode))
+				std::swap(entries[index]._startNode, entries[index]._endNode);
+		}
+	}
+
+	std::sort(entries, entries + entriesCount, EdgeEntryComparator());
+
+	// Only the first edge of every group of equal edges is kept, and only if it isn't already inside the graph
+	bool* isEdgeToAdd = (bool*)malloc(sizeof(bool) * definitionsCount);
+	memset(isEdgeToAdd, 0, sizeof(bool) * definitionsCount);
+
+	int edgesToAddCount = 0;
+	for (int index = 0; index < entriesCount; index++)
+	{
+		bool isFirstOfGroup = index == 0 || entries[index]._startNode != entries[index - 1]._startNode || entries[index]._endNode != entries[index - 1]._endNode;
+
+		if (isFirstOfGroup && entries[index]._order >= 0)
+		{
+			isEdgeToAdd[entries[index]._order] = true;
+			edgesToAddCount++;
+		}
+	}
+
+	// Count how many adjacent nodes every node will get to allocate their adjacency lists at once
+	int* adjacentNodesCount = (int*)malloc(sizeof(int) * nodesCount);
+	memset(adjacentNodesCount, 0, sizeof(int) * nodesCount);
+
+	for (int index = 0; index < definitionsCount; index++)
+	{
+		if (isEdgeToAdd[index] == false)
+			continue;
+
+		adjacentNodesCount[edges[index]._startNodeIndex]++;
+
+		if (_graphType != GT_Directed && edges[index]._startNodeIndex != edges[index]._endNodeIndex)
+			adjacentNodesCount[edges[index]._endNodeIndex]++;
+	}
+
+	for (int index = 0; index < nodesCount; index++)
+	{
+		if (adjacentNodesCount[index] > 0)
+			nodes[index]->ReserveAdjacentNodes(nodes[index]->GetAdjacentNodes().GetSize() + adjacentNodesCount[index]);
+	}
+
+	// Add the edges in the same order of the batch
+	_edges.Reserve(existingEdgesCount + edgesToAddCount);
+
+	for (int index = 0; index < definitionsCount; index++)
+	{
+		Edge* addedEdge = nullptr;
+
+		if (isEdgeToAdd[index])
+			addedEdge = AddEdgeNoCheck(nodes[edges[index]._startNodeIndex], nodes[edges[index]._endNodeIndex]);
+
+		if (addedEdges != nullptr)
+			addedEdges[index] = addedEdge;
+	}
+
+	free(adjacentNodesCount);
+	free(isEdgeToAdd);
+	free(entries);
+	free(nodes);
+
+	return edgesToAddCount;
+}
+
+/**
+* Adds a batch of edges to the graph given the names of their nodes.
+* The nodes that don't exist are added in the order of the first occurrence of their name, like AddNodes does.
+* The edges are then added like the other AddEdges does.
+* edges: the definitions of the edges to add
+* addedEdges: if not nullptr, it's filled with the pointer to the edge created for every given definition (nullptr if it was a duplicate)
+* Returns the number of added edges or -1 if one of the names is empty, in which case nothing is added
+*/
+int Graph::AddEdges(const NamedEdgeDefinitionList& edges, EdgePointersList* addedEdges)
+{
+	int definitionsCount = edges.GetSize();
+
+	// Put the start and end nodes of all the edges inside one batch, in the same order AddEdge would add them
+	NodeDefinitionList nodes(definitionsCount * 2);
+
+	NamedEdgeDefinitionList::ConstIterator definitionsIt = edges.Begin();
+	NamedEdgeDefinitionList::ConstIterator definitionsEnd = edges.End();
+	for (; definitionsIt && definitionsIt != definitionsEnd; ++definitionsIt)
+	{
+		nodes.Add((*definitionsIt)._startNode);
+		nodes.Add((*definitionsIt)._endNode);
+	}
+
+	List<int> nodesIndices(definitionsCount * 2);
+
+	if (AddNodes(nodes, &nodesIndices) == false)
+	{
+		if (addedEdges != nullptr)
+			addedEdges->Clear();
+		return -1;
+	}
+
+	// Now that all the nodes exist the edges can be added by index
+	EdgeDefinitionList indexedEdges(definitionsCount);
+
+	List<int>::Iterator indicesIt = nodesIndices.Begin();
+	List<int>::Iterator indicesEnd = nodesIndices.End();
+	while (indicesIt && indicesIt != indicesEnd)
+	{
+		int startNodeIndex = *(indicesIt++);
+		int endNodeIndex = *(indicesIt++);
+
+		indexedEdges.Add(EdgeDefinition(startNodeIndex, endNodeIndex));
+	}
+
+	return AddEdges(indexedEdges, addedEdges);
+}
+
 /** Removes the edge at the given index from the edges of the graph */
 Graph& Graph::RemoveEdge(int edgeIndex)
 {
@@ -748,6 +1354,386 @@ Graph::NodePointersList Graph::GetNonEntrantNodes()
 	return result;
 }
 
+/**
+* Finds the strongly connected components of this graph with an iterative version of the Tarjan algorithm, which visits every node and edge once.
+* If the graph is not directed the components are the connected components.
+* nodesComponents: filled with the index of the component of every node, in the order of the list of nodes. The array must contain at least GetNodes().GetSize() elements.
+*                  The components are numbered in the order of their first node inside the list of nodes
+* condensation: if not nullptr, it's filled with the condensation of this graph: a directed graph with one node for every component, in the order
+*               of the indices of the components and named like their first node, and one edge for every pair of components connected by an edge of this graph
+* Returns the number of components
+*/
+int Graph::ComputeStronglyConnectedComponents(int* nodesComponents, Graph* condensation) const
+{
+	int nodesCount = _nodes.GetSize();
+	int edgesCount = _edges.GetSize();
+	int adjacenciesCount = _graphType == GT_Directed ? edgesCount : edgesCount * 2;
+
+	if (condensation != nullptr)
+		condensation->Clear().SetName(_name, _encloseNameInDoubleQuotes).SetGraphType(GT_Directed);
+
+	if (nodesCount <= 0)
+		return 0;
+
+	// Sort the nodes by their address so that the nodes of an edge can be found with a binary search
+	const Node** nodes = (const Node**)AllocateScratch(sizeof(Node*) * nodesCount);
+	NodeAddressEntry* nodesAddresses = (NodeAddressEntry*)AllocateScratch(sizeof(NodeAddressEntry) * nodesCount);
+
+	NodeList::ConstIterator nodesIt = _nodes.Begin();
+	NodeList::ConstIterator nodesEnd = _nodes.End();
+	for (int index = 0; nodesIt && nodesIt != nodesEnd; index++, ++nodesIt)
+	{
+		nodes[index] = &(*nodesIt);
+		nodesAddresses[index]._node = &(*nodesIt);
+		nodesAddresses[index]._nodeIndex = index;
+	}
+
+	std::sort(nodesAddresses, nodesAddresses + nodesCount, NodeAddressEntryComparator());
+
+	// Build the adjacency of every node as a range of an array of indices: the nodes adjacent to the node i are
+	// the ones between adjacentNodes[adjacencyBegin[i]] and adjacentNodes[adjacencyBegin[i + 1]]
+	int* edgesNodes = (int*)AllocateScratch(sizeof(int) * 2 * (edgesCount > 0 ? edgesCount : 1));
+	int* adjacencyBegin = (int*)AllocateZeroedScratch(nodesCount + 1, sizeof(int));
+	int* adjacentNodes = (int*)AllocateScratch(sizeof(int) * (adjacenciesCount > 0 ? adjacenciesCount : 1));
+
+	EdgeList::ConstIterator edgesIt = _edges.Begin();
+	EdgeList::ConstIterator edgesEnd = _edges.End();
+	for (int edgeIndex = 0; edgesIt && edgesIt != edgesEnd; edgeIndex++, ++edgesIt)
+	{
+		NodeAddressEntry startEntry = { (*edgesIt).GetStartNode(), -1 };
+		NodeAddressEntry endEntry = { (*edgesIt).GetEndNode(), -1 };
+
+		edgesNodes[edgeIndex * 2] = std::lower_bound(nodesAddresses, nodesAddresses + nodesCount, startEntry, NodeAddressEntryComparator())->_nodeIndex;
+		edgesNodes[edgeIndex * 2 + 1] = std::lower_bound(nodesAddresses, nodesAddresses + nodesCount, endEntry, NodeAddressEntryComparator())->_nodeIndex;
+
+		adjacencyBegin[edgesNodes[edgeIndex * 2] + 1]++;
+		if (_graphType != GT_Directed)
+			adjacencyBegin[edgesNodes[edgeIndex * 2 + 1] + 1]++;
+	}
+
+	for (int nodeIndex = 0; nodeIndex < nodesCount; nodeIndex++)
+		adjacencyBegin[nodeIndex + 1] += adjacencyBegin[nodeIndex];
+
+	// Use the components array as the position where the next adjacent node of every node is written
+	memcpy(nodesComponents, adjacencyBegin, sizeof(int) * nodesCount);
+
+	for (int edgeIndex = 0; edgeIndex < edgesCount; edgeIndex++)
+	{
+		adjacentNodes[nodesComponents[edgesNodes[edgeIndex * 2]]++] = edgesNodes[edgeIndex * 2 + 1];
+		if (_graphType != GT_Directed)
+			adjacentNodes[nodesComponents[edgesNodes[edgeIndex * 2 + 1]]++] = edgesNodes[edgeIndex * 2];
+	}
+
+	// Tarjan algorithm. The recursion is replaced by a stack of the visited nodes, each one with the position of the next adjacent node to visit
+	int* visitIndices = (int*)AllocateScratch(sizeof(int) * nodesCount);
+	int* lowLinks = (int*)AllocateScratch(sizeof(int) * nodesCount);
+	int* componentsStack = (int*)AllocateScratch(sizeof(int) * nodesCount);
+	int* visitStack = (int*)AllocateScratch(sizeof(int) * nodesCount);
+	int* nextAdjacencies = (int*)AllocateScratch(sizeof(int) * nodesCount);
+	unsigned char* onComponentsStack = (unsigned char*)AllocateZeroedScratch(nodesCount, sizeof(unsigned char));
+
+	for (int nodeIndex = 0; nodeIndex < nodesCount; nodeIndex++)
+		visitIndices[nodeIndex] = -1;
+
+	int visitedNodesCount = 0;
+	int componentsCount = 0;
+	int componentsStackSize = 0;
+
+	for (int startNodeIndex = 0; startNodeIndex < nodesCount; startNodeIndex++)
+	{
+		if (visitIndices[startNodeIndex] != -1)
+			continue;
+
+		int visitStackSize = 0;
+
+		visitIndices[startNodeIndex] = lowLinks[startNodeIndex] = visitedNodesCount++;
+		nextAdjacencies[startNodeIndex] = adjacencyBegin[startNodeIndex];
+		componentsStack[componentsStackSize++] = startNodeIndex;
+		onComponentsStack[startNodeIndex] = 1;
+		visitStack[visitStackSize++] = startNodeIndex;
+
+		while (visitStackSize > 0)
+		{
+			int nodeIndex = visitStack[visitStackSize - 1];
+
+			// Visit the next adjacent node
+			if (nextAdjacencies[nodeIndex] < adjacencyBegin[nodeIndex + 1])
+			{
+				int adjacentNodeIndex = adjacentNodes[nextAdjacencies[nodeIndex]++];
+
+				if (visitIndices[adjacentNodeIndex] == -1)
+				{
+					visitIndices[adjacentNodeIndex] = lowLinks[adjacentNodeIndex] = visitedNodesCount++;
+					nextAdjacencies[adjacentNodeIndex] = adjacencyBegin[adjacentNodeIndex];
+					componentsStack[componentsStackSize++] = adjacentNodeIndex;
+					onComponentsStack[adjacentNodeIndex] = 1;
+					visitStack[visitStackSize++] = adjacentNodeIndex;
+				}
+				else if (onComponentsStack[adjacentNodeIndex])
+					lowLinks[nodeIndex] = std::min(lowLinks[nodeIndex], visitIndices[adjacentNodeIndex]);
+
+				continue;
+			}
+
+			// All the adjacent nodes were visited: go back to the previous node
+			visitStackSize--;
+
+			if (visitStackSize > 0)
+			{
+				int previousNodeIndex = visitStack[visitStackSize - 1];
+				lowLinks[previousNodeIndex] = std::min(lowLinks[previousNodeIndex], lowLinks[nodeIndex]);
+			}
+
+			// If the node is the first visited node of its component, the component is made of the nodes above it inside the stack
+			if (lowLinks[nodeIndex] == visitIndices[nodeIndex])
+			{
+				int componentNodeIndex;
+
+				do
+				{
+					componentNodeIndex = componentsStack[--componentsStackSize];
+					onComponentsStack[componentNodeIndex] = 0;
+					nodesComponents[componentNodeIndex] = componentsCount;
+				} while (componentNodeIndex != nodeIndex);
+
+				componentsCount++;
+			}
+		}
+	}
+
+	// Number the components in the order of their first node. visitIndices is reused as the new index of every component
+	for (int componentIndex = 0; componentIndex < componentsCount; componentIndex++)
+		visitIndices[componentIndex] = -1;
+
+	int numberedComponentsCount = 0;
+	NodeDefinitionList componentsNodes;
+
+	for (int nodeIndex = 0; nodeIndex < nodesCount; nodeIndex++)
+	{
+		int& componentIndex = visitIndices[nodesComponents[nodeIndex]];
+
+		if (componentIndex == -1)
+		{
+			componentIndex = numberedComponentsCount++;
+
+			if (condensation != nullptr)
+				componentsNodes.Add(NodeDefinition(nodes[nodeIndex]->GetName(), nodes[nodeIndex]->EncloseNameInDoubleQuotes()));
+		}
+
+		nodesComponents[nodeIndex] = componentIndex;
+	}
+
+	// The edges between different components become the edges of the condensation, which removes the duplicates
+	if (condensation != nullptr)
+	{
+		condensation->AddNodes(componentsNodes);
+
+		EdgeDefinitionList componentsEdges;
+
+		for (int edgeIndex = 0; edgeIndex < edgesCount; edgeIndex++)
+		{
+			int startComponentIndex = nodesComponents[edgesNodes[edgeIndex * 2]];
+			int endComponentIndex = nodesComponents[edgesNodes[edgeIndex * 2 + 1]];
+
+			if (startComponentIndex != endComponentIndex)
+				componentsEdges.Add(EdgeDefinition(startComponentIndex, endComponentIndex));
+		}
+
+		condensation->AddEdges(componentsEdges);
+	}
+
+	FreeScratch(nodes);
+	FreeScratch(nodesAddresses);
+	FreeScratch(edgesNodes);
+	FreeScratch(adjacencyBegin);
+	FreeScratch(adjacentNodes);
+	FreeScratch(visitIndices);
+	FreeScratch(lowLinks);
+	FreeScratch(componentsStack);
+	FreeScratch(visitStack);
+	FreeScratch(nextAdjacencies);
+	FreeScratch(onComponentsStack);
+
+	return componentsCount;
+}
+
+/**
+* Finds the edges of this directed acyclic graph that belong to its transitive reduction: an edge a->c is redundant if c can be reached from a through
+* another path, like a->b->c, so removing it doesn't change the nodes reached from any node. The nodes reached from every node are kept as bitsets,
+* computed in reverse topological order for a range of the nodes at a time so that the memory used stays bounded.
+* redundantEdges: filled with 1 for the redundant edges and 0 for the other ones, in the order of the list of edges. The array must contain at least GetEdges().GetSize() elements
+* Returns the number of redundant edges or -1 if the graph isn't directed or contains cycles
+*/
+int Graph::ComputeTransitiveReduction(unsigned char* redundantEdges) const
+{
+	int nodesCount = _nodes.GetSize();
+	int edgesCount = _edges.GetSize();
+
+	if (_graphType != GT_Directed)
+		return -1;
+
+	if (edgesCount > 0)
+		memset(redundantEdges, 0, sizeof(unsigned char) * edgesCount);
+
+	if (nodesCount <= 0 || edgesCount <= 0)
+		return 0;
+
+	// Sort the nodes by their address so that the nodes of an edge can be found with a binary search
+	NodeAddressEntry* nodesAddresses = (NodeAddressEntry*)AllocateScratch(sizeof(NodeAddressEntry) * nodesCount);
+
+	NodeList::ConstIterator nodesIt = _nodes.Begin();
+	NodeList::ConstIterator nodesEnd = _nodes.End();
+	for (int index = 0; nodesIt && nodesIt != nodesEnd; index++, ++nodesIt)
+	{
+		nodesAddresses[index]._node = &(*nodesIt);
+		nodesAddresses[index]._nodeIndex = index;
+	}
+
+	std::sort(nodesAddresses, nodesAddresses + nodesCount, NodeAddressEntryComparator());
+
+	// Build the exiting edges of every node as a range of an array of edge indices: the edges that leave the node i are
+	// the ones between exitingEdges[exitingEdgesBegin[i]] and exitingEdges[exitingEdgesBegin[i + 1]]
+	int* edgesEndNodes = (int*)AllocateScratch(sizeof(int) * edgesCount);
+	int* edgesStartNodes = (int*)AllocateScratch(sizeof(int) * edgesCount);
+	int* exitingEdgesBegin = (int*)AllocateZeroedScratch(nodesCount + 1, sizeof(int));
+	int* exitingEdges = (int*)AllocateScratch(sizeof(int) * edgesCount);
+	int* entrantEdgesCounts = (int*)AllocateZeroedScratch(nodesCount, sizeof(int));
+
+	EdgeList::ConstIterator edgesIt = _edges.Begin();
+	EdgeList::ConstIterator edgesEnd = _edges.End();
+	for (int edgeIndex = 0; edgesIt && edgesIt != edgesEnd; edgeIndex++, ++edgesIt)
+	{
+		NodeAddressEntry startEntry = { (*edgesIt).GetStartNode(), -1 };
+		NodeAddressEntry endEntry = { (*edgesIt).GetEndNode(), -1 };
+
+		edgesStartNodes[edgeIndex] = std::lower_bound(nodesAddresses, nodesAddresses + nodesCount, startEntry, NodeAddressEntryComparator())->_nodeIndex;
+		edgesEndNodes[edgeIndex] = std::lower_bound(nodesAddresses, nodesAddresses + nodesCount, endEntry, NodeAddressEntryComparator())->_nodeIndex;
+
+		exitingEdgesBegin[edgesStartNodes[edgeIndex] + 1]++;
+		entrantEdgesCounts[edgesEndNodes[edgeIndex]]++;
+	}
+
+	for (int nodeIndex = 0; nodeIndex < nodesCount; nodeIndex++)
+		exitingEdgesBegin[nodeIndex + 1] += exitingEdgesBegin[nodeIndex];
+
+	// Use the topological ranks array as the position where the next exiting edge of every node is written
+	int* ranks = (int*)AllocateScratch(sizeof(int) * nodesCount);
+
+	memcpy(ranks, exitingEdgesBegin, sizeof(int) * nodesCount);
+
+	for (int edgeIndex = 0; edgeIndex < edgesCount; edgeIndex++)
+		exitingEdges[ranks[edgesStartNodes[edgeIndex]]++] = edgeIndex;
+
+	// Sort the nodes in topological order removing the nodes without entrant edges one at a time (Kahn algorithm)
+	int* sortedNodes = (int*)AllocateScratch(sizeof(int) * nodesCount);
+	int sortedNodesCount = 0;
+
+	for (int nodeIndex = 0; nodeIndex < nodesCount; nodeIndex++)
+	{
+		if (entrantEdgesCounts[nodeIndex] == 0)
+			sortedNodes[sortedNodesCount++] = nodeIndex;
+	}
+
+	for (int i = 0; i < sortedNodesCount; i++)
+	{
+		int nodeIndex = sortedNodes[i];
+
+		ranks[nodeIndex] = i;
+
+		for (int j = exitingEdgesBegin[nodeIndex]; j < exitingEdgesBegin[nodeIndex + 1]; j++)
+		{
+			if (--entrantEdgesCounts[edgesEndNodes[exitingEdges[j]]] == 0)
+				sortedNodes[sortedNodesCount++] = edgesEndNodes[exitingEdges[j]];
+		}
+	}
+
+	int redundantEdgesCount = 0;
+
+	// If some nodes couldn't be sorted the graph contains a cycle
+	if (sortedNodesCount < nodesCount)
+		redundantEdgesCount = -1;
+	else
+	{
+		// The bits of the nodes with ranks between firstRank and firstRank + wordsCount * 64 are computed at the same time, keeping the bitsets at most about 32 MB
+		int wordsCount = (int)((32 * 1024 * 1024 / sizeof(uint64_t)) / nodesCount);
+
+		if (wordsCount < 1)
+			wordsCount = 1;
+		if (wordsCount > (nodesCount + 63) / 64)
+			wordsCount = (nodesCount + 63) / 64;
+
+		// The nodes reached from every node through at least one edge, by rank, and the nodes reached from the children of the current node
+		uint64_t* reachedNodes = (uint64_t*)AllocateScratch(sizeof(uint64_t) * wordsCount * nodesCount);
+		uint64_t* childrenReachedNodes = (uint64_t*)AllocateScratch(sizeof(uint64_t) * wordsCount);
+
+		for (int firstRank = 0; firstRank < nodesCount; firstRank += wordsCount * 64)
+		{
+			int lastRank = firstRank + wordsCount * 64;
+
+			if (lastRank > nodesCount)
+				lastRank = nodesCount;
+
+			// The nodes after the range can't reach the nodes of the range, so the sweep starts from the last node of the range
+			for (int rank = lastRank - 1; rank >= 0; rank--)
+			{
+				int nodeIndex = sortedNodes[rank];
+
+				memset(childrenReachedNodes, 0, sizeof(uint64_t) * wordsCount);
+
+				for (int j = exitingEdgesBegin[nodeIndex]; j < exitingEdgesBegin[nodeIndex + 1]; j++)
+				{
+					int childRank = ranks[edgesEndNodes[exitingEdges[j]]];
+
+					if (childRank >= lastRank)
+						continue;
+
+					const uint64_t* childReachedNodes = reachedNodes + (size_t)childRank * wordsCount;
+
+					for (int word = 0; word < wordsCount; word++)
+						childrenReachedNodes[word] |= childReachedNodes[word];
+				}
+
+				// An edge is redundant if its end node is reached from one of the children of its start node
+				uint64_t* nodeReachedNodes = reachedNodes + (size_t)rank * wordsCount;
+
+				memcpy(nodeReachedNodes, childrenReachedNodes, sizeof(uint64_t) * wordsCount);
+
+				for (int j = exitingEdgesBegin[nodeIndex]; j < exitingEdgesBegin[nodeIndex + 1]; j++)
+				{
+					int childRank = ranks[edgesEndNodes[exitingEdges[j]]];
+
+					if (childRank < firstRank || childRank >= lastRank)
+						continue;
+
+					int bit = childRank - firstRank;
+
+					if ((childrenReachedNodes[bit / 64] & ((uint64_t)1 << (bit % 64))) != 0)
+					{
+						redundantEdges[exitingEdges[j]] = 1;
+						redundantEdgesCount++;
+					}
+
+					nodeReachedNodes[bit / 64] |= (uint64_t)1 << (bit % 64);
+				}
+			}
+		}
+
+		FreeScratch(reachedNodes);
+		FreeScratch(childrenReachedNodes);
+	}
+
+	FreeScratch(nodesAddresses);
+	FreeScratch(edgesEndNodes);
+	FreeScratch(edgesStartNodes);
+	FreeScratch(exitingEdgesBegin);
+	FreeScratch(exitingEdges);
+	FreeScratch(entrantEdgesCounts);
+	FreeScratch(ranks);
+	FreeScratch(sortedNodes);
+
+	return redundantEdgesCount;
+}
+
 /**
 * Given a node as root, computes the best paths that connects the root to all the nodes that it can reach. Works event if there is a cycle
 * root: the node which is to be used as root
@@ -0,0 +1,144 @@
+#include "MemoryAccounting.h"
+
+#include <cstdlib>
+#include <cstring>
+
+/** The counters of every category */
+struct MemoryAccountingCounters
+{
+	std::atomic<long long> _allocationsCount;
+	std::atomic<long long> _deallocationsCount;
+	std::atomic<long long> _allocatedBytes;
+	std::atomic<long long> _currentBytes;
+	std::atomic<long long> _peakBytes;
+};
+
+static MemoryAccountingCounters s_counters[MemoryAccounting::MC_Count];
+
+/**
+* Header stored before the memory returned by CountedMalloc, so that CountedFree knows its size.
+* The size is negative if the allocation wasn't counted, because the counters were disabled. The union keeps the memory aligned like malloc does
+*/
+union MemoryAccountingHeader
+{
+	long long _bytes;
+	std::max_align_t _alignment;
+};
+
+std::atomic<bool> MemoryAccounting::_enabled(false);
+
+/** Sets to 0 the counters of all the categories */
+void MemoryAccounting::Reset()
+{
+	for (int category = 0; category < MC_Count; category++)
+	{
+		s_counters[category]._allocationsCount.store(0, std::memory_order_relaxed);
+		s_counters[category]._deallocationsCount.store(0, std::memory_order_relaxed);
+		s_counters[category]._allocatedBytes.store(0, std::memory_order_relaxed);
+		s_counters[category]._currentBytes.store(0, std::memory_order_relaxed);
+		s_counters[category]._peakBytes.store(0, std::memory_order_relaxed);
+	}
+}
+
+/** Copies the counters of the given category into 'counters' */
+void MemoryAccounting::GetCounters(Category category, Counters& counters)
+{
+	counters._allocationsCount = s_counters[category]._allocationsCount.load(std::memory_order_relaxed);
+	counters._deallocationsCount = s_counters[category]._deallocationsCount.load(std::memory_order_relaxed);
+	counters._allocatedBytes = s_counters[category]._allocatedBytes.load(std::memory_order_relaxed);
+	counters._currentBytes = s_counters[category]._currentBytes.load(std::memory_order_relaxed);
+	counters._peakBytes = s_counters[category]._peakBytes.load(std::memory_order_relaxed);
+}
+
+/** Returns the name of the given category */
+const char* MemoryAccounting::GetCategoryName(Category category)
+{
+	switch (category)
+	{
+	case MC_ListItems:
+		return "list items";
+	case MC_SolverScratch:
+		return "solver scratch";
+	case MC_Heap:
+		return "heap";
+	case MC_Count:
+		break;
+	}
+
+	return "";
+}
+
+/** Counts an allocation of the given number of bytes, if the counters are enabled */
+void MemoryAccounting::AddAllocation(Category category, size_t bytes)
+{
+	if (!IsEnabled())
+		return;
+
+	MemoryAccountingCounters& counters = s_counters[category];
+
+	counters._allocationsCount.fetch_add(1, std::memory_order_relaxed);
+	counters._allocatedBytes.fetch_add((long long)bytes, std::memory_order_relaxed);
+
+	long long currentBytes = counters._currentBytes.fetch_add((long long)bytes, std::memory_order_relaxed) + (long long)bytes;
+	long long peakBytes = counters._peakBytes.load(std::memory_order_relaxed);
+
+	// Another thread can raise the peak at the same time
+	while (currentBytes > peakBytes && !counters._peakBytes.compare_exchange_weak(peakBytes, currentBytes, std::memory_order_relaxed))
+	{ }
+}
+
+/** Counts the release of an allocation of the given number of bytes, if the counters are enabled */
+void MemoryAccounting::AddDeallocation(Category category, size_t bytes)
+{
+	if (!IsEnabled())
+		return;
+
+	s_counters[category]._deallocationsCount.fetch_add(1, std::memory_order_relaxed);
+	s_counters[category]._currentBytes.fetch_sub((long long)bytes, std::memory_order_relaxed);
+}
+
+/**
+* Allocates memory like malloc and counts it in the given category. The memory must be released with CountedFree.
+* Returns nullptr if the memory can't be allocated
+*/
+void* MemoryAccounting::CountedMalloc(Category category, size_t bytes)
+{
+	MemoryAccountingHeader* header = (MemoryAccountingHeader*)malloc(sizeof(MemoryAccountingHeader) + bytes);
+
+	if (header == nullptr)
+		return nullptr;
+
+	bool counted = IsEnabled();
+	header->_bytes = counted ? (long long)bytes : -(long long)bytes - 1;
+
+	if (counted)
+		AddAllocation(category, bytes);
+
+	return header + 1;
+}
+
+/** Allocates memory set to 0 like calloc and counts it in the given category. The memory must be released with CountedFree */
+void* MemoryAccounting::CountedCalloc(Category category, size_t count, size_t size)
+{
+	void* memory = CountedMalloc(category, count * size);
+
+	if (memory != nullptr)
+		memset(memory, 0, count * size);
+
+	return memory;
+}
+
+/** Releases the memory allocated by CountedMalloc or CountedCalloc. It does nothing if memory is nullptr */
+void MemoryAccounting::CountedFree(Category category, void* memory)
+{
+	if (memory == nullptr)
+		return;
+
+	MemoryAccountingHeader* header = ((MemoryAccountingHeader*)memory) - 1;
+
+	// Only the allocations that were counted are subtracted
+	if (header->_bytes >= 0)
+		AddDeallocation(category, (size_t)header->_bytes);
+
+	free(header);
+}
\ No newline at end of file
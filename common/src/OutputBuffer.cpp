@@ -0,0 +1,98 @@
+#include "OutputBuffer.h"
+
+#include <cstdlib>
+
+/** Default constructor */
+OutputBuffer::OutputBuffer(size_t capacity)
+	: _output(nullptr)
+	, _data(nullptr)
+	, _size(0)
+	, _capacity(capacity > 0 ? capacity : s_defaultCapacity)
+{
+	_data = (char*)malloc(_capacity);
+}
+
+/** Destructor. Doesn't flush the buffer since the output stream could be already destroyed */
+OutputBuffer::~OutputBuffer()
+{
+	free(_data);
+}
+
+/**
+* Writes all the data inside the buffer to the output stream. Returns false if the output stream failed
+* Does nothing if there isn't an output stream
+*/
+bool OutputBuffer::Flush()
+{
+	if (_output == nullptr)
+		return true;
+
+	if (_size > 0)
+		_output->write(_data, _size);
+
+	_size = 0;
+
+	return !_output->fail();
+}
+
+/** Appends the given integer as decimal text */
+OutputBuffer& OutputBuffer::AppendInteger(long long value)
+{
+	// Enough for the 19 digits and the sign of a 64 bit value
+	char digits[20];
+	int digitsStart = sizeof(digits);
+
+	// Work with the negative value so that the minimum value doesn't overflow
+	bool negative = value < 0;
+	if (negative == false)
+		value = -value;
+
+	do
+	{
+		digits[--digitsStart] = (char)('0' - (value % 10));
+		value /= 10;
+	} while (value != 0);
+
+	if (negative)
+		digits[--digitsStart] = '-';
+
+	return Append(digits + digitsStart, sizeof(digits) - digitsStart);
+}
+
+/** Appends data that doesn't fit into the free space of the buffer */
+OutputBuffer& OutputBuffer::AppendLarge(const char* data, size_t length)
+{
+	MakeRoom(length);
+
+	// If the data still doesn't fit write it directly instead of splitting it
+	if (length > _capacity - _size)
+		_output->write(data, length);
+	else
+	{
+		memcpy(_data + _size, data, length);
+		_size += length;
+	}
+
+	return *this;
+}
+
+/** Makes room for the given number of bytes flushing the buffer or, if there isn't an output stream, growing it */
+void OutputBuffer::MakeRoom(size_t length)
+{
+	if (_output != nullptr)
+	{
+		Flush();
+		return;
+	}
+
+	if (length <= _capacity - _size)
+		return;
+
+	// Grow at least by doubling the capacity to append in amortized constant time
+	size_t capacity = _capacity * 2;
+	if (capacity < _size + length)
+		capacity = _size + length;
+
+	_data = (char*)realloc(_data, capacity);
+	_capacity = capacity;
+}
\ No newline at end of file
@@ -2,7 +2,7 @@
 #include <cmath>
 
 /** Initialize the seed to be used if the user doesn't call SetSeed */
-double RandomGenerator::s_seed = 62413904;
+thread_local double RandomGenerator::s_seed = 62413904;
 
 /** Gets a new randon number in the range [0..1] */
 double RandomGenerator::GetRandom()
@@ -30,4 +30,23 @@ double RandomGenerator::GetRandom()
 double RandomGenerator::GetRandom(double min, double max)
 {
 	return (max - min + 1) * GetRandom() + min;
+}
+
+/**
+* Returns the seed of the index-th sequence derived from the given seed. The derived seeds are scattered over the whole range
+* of the generator, so that the sequences of consecutive indices are unrelated, and they depend only on the seed and on the index
+*/
+double RandomGenerator::DeriveSeed(double seed, long long index)
+{
+	static const unsigned long long m = 2147483647;
+
+	// The seed and the index are mixed with the finalizer of SplitMix64
+	unsigned long long mixed = (unsigned long long)(long long)seed + 0x9E3779B97F4A7C15ULL * (unsigned long long)(index + 1);
+
+	mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+	mixed = mixed ^ (mixed >> 31);
+
+	// The valid seeds are in the range [1..m-1]
+	return (double)(1 + mixed % (m - 1));
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "RandomGraphGenerator.h"
 #include "RandomGenerator.h"
 
+#include <cstdlib>
+
 /**
 * Creates a new random directed graph that doesn't contain any cycle
 * numberOfNodes: the number of nodes that will be contained inside the graph
@@ -11,26 +13,42 @@ bool RandomGraphGenerator::CreateRandomGraph(int numberOfNodes, double edgeChanc
 {
 	result.SetGraphType(Graph::GT_Directed);
 
-	Graph::NodePointersList addedNodes(numberOfNodes);
+	if (numberOfNodes <= 0)
+		return true;
+
+	// Add all the nodes in one batch
+	Graph::NodeDefinitionList nodes(numberOfNodes);
 
 	for (int i = 0; i < numberOfNodes; i++)
-		addedNodes.Add(result.AddNode(std::to_string(i), false));
+		nodes.Add(Graph::NodeDefinition(std::to_string(i), false));
 
-	Graph::NodePointersList::Iterator outerIt = addedNodes.Begin();
-	Graph::NodePointersList::Iterator end = addedNodes.End();
+	List<int> nodesIndices(numberOfNodes);
 
-	for (; outerIt && outerIt != end; ++outerIt)
-	{
-		Graph::NodePointersList::Iterator innerIt = outerIt + 1;
+	if (result.AddNodes(nodes, &nodesIndices) == false)
+		return false;
+
+	// Store the indices inside an array to access them by position
+	int* addedNodes = (int*)malloc(sizeof(int) * numberOfNodes);
 
-		for (; innerIt && innerIt != end; ++innerIt)
+	List<int>::Iterator indicesIt = nodesIndices.Begin();
+	List<int>::Iterator indicesEnd = nodesIndices.End();
+	for (int i = 0; indicesIt && indicesIt != indicesEnd; i++, indicesIt++)
+		addedNodes[i] = *indicesIt;
+
+	// Collect the edges and add them all at once. Use the expected number of edges as starting size of the batch
+	int expectedEdges = (int)(((double)numberOfNodes * (double)(numberOfNodes - 1) / 2.0) * edgeChance);
+	Graph::EdgeDefinitionList edges(expectedEdges > 0 ? expectedEdges : 0);
+
+	for (int outer = 0; outer < numberOfNodes; outer++)
+	{
+		for (int inner = outer + 1; inner < numberOfNodes; inner++)
 		{
 			if (RandomGenerator::GetRandom() < edgeChance)
-			{
-				result.AddEdge(*outerIt, *innerIt);
-			}
+				edges.Add(Graph::EdgeDefinition(addedNodes[outer], addedNodes[inner]));
 		}
 	}
 
-	return true;
+	free(addedNodes);
+
+	return result.AddEdges(edges) >= 0;
 }
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Graph.h"
+#include "ASDProjectSolverCache.h"
+
+#include <string>
+#include <iostream>
+
+/**
+* Generator of DOT definitions used to measure the parser and the writer on the styles of the files they meet: bare or quoted IDs,
+* many attributes, comments between the statements, chained edges (a -> b -> c) and lines ending with CRLF.
+* A corpus is a directed acyclic graph where every node has an edge to EdgesPerNode nodes that follow it. Every node is declared
+* by its own statement, so that also the nodes without edges are part of the graph, and the corpus knows the number of nodes,
+* edges and attributes that the parser has to find.
+*/
+class ASDProjectDotCorpus
+{
+public:
+	/** The number of edges that start from every node, when there are enough following nodes */
+	static const int EdgesPerNode = 4;
+
+	/** The style of a corpus */
+	struct Style
+	{
+		/** Default constructor: bare IDs, no attributes, no comments, one edge per statement, LF lines */
+		Style();
+
+		/** If true the IDs of the nodes are enclosed in double quotes and contain spaces */
+		bool _quotedIds;
+
+		/** The number of attributes of every node and of every edge. Half of the values are enclosed in double quotes */
+		int _attributesCount;
+
+		/** If true a line comment precedes every node and a block comment every edge statement */
+		bool _comments;
+
+		/** The maximum number of edges of an edge statement. 1 writes every edge in its own statement, more writes chains like a -> b -> c */
+		int _chainLength;
+
+		/** If true the lines end with CRLF instead of LF */
+		bool _crlf;
+	};
+
+	/** The numbers of elements of a corpus */
+	struct Counts
+	{
+		/** Default constructor */
+		Counts() : _nodesCount(0), _edgesCount(0), _attributesCount(0) { }
+
+		/** Returns true if the counts are the same */
+		bool operator==(const Counts& rhs) const { return _nodesCount == rhs._nodesCount && _edgesCount == rhs._edgesCount && _attributesCount == rhs._attributesCount; }
+
+		int _nodesCount;
+		int _edgesCount;
+
+		/** The attributes of all the nodes and of all the edges */
+		int _attributesCount;
+	};
+
+	/** The number of predefined styles */
+	static const int StylesCount = 7;
+
+public:
+	/** Returns the name of the predefined style with the given index, from 0 to StylesCount - 1 */
+	static const char* GetStyleName(int styleIndex);
+
+	/**
+	* Finds the predefined style with the given name: "bare", "quoted", "attributes", "comments", "chained", "crlf"
+	* or "mixed", which has all the features. Returns false if there is none
+	*/
+	static bool GetStyle(const std::string& name, Style& style);
+
+	/** Generates the DOT definition of the corpus with the given style and number of nodes, and the numbers of its elements */
+	static void Generate(const Style& style, int nodesCount, std::string& dotDefinition, Counts& counts);
+
+	/** Returns the numbers of nodes, edges and attributes of the given graph */
+	static Counts GetCounts(const Graph& graph);
+
+	/**
+	* Checks that the parsed graph is the corpus and that it survives a round trip: the graph is written, the text is parsed again and the second graph
+	* must have the same counts and must be written to the same text. Writes the reason to 'messages' and returns false if the check fails
+	*/
+	static bool CheckRoundTrip(const Graph& parsedGraph, const Counts& expectedCounts, std::ostream& messages);
+
+	/**
+	* Checks that ASDProjectSolverCache gives the same result of ASDProjectSolver: the parsed graph, a copy with the nodes in the reverse order and the two graphs
+	* without their edges, whose roots are chosen by the order of the nodes, are solved without the cache and then twice in a row with the same cache, so that
+	* the graphs with the same key share their entry and the second time the result comes from the cache. Writes the reason to 'messages' and returns false if a result is different
+	*/
+	static bool CheckCachedSolutions(const Graph& parsedGraph, std::ostream& messages);
+
+private:
+	/** Returns the ID of the node with the given index, as written in the corpus */
+	static std::string GetNodeId(const Style& style, int nodeIndex);
+
+	/** Appends the attributes list of an element to the definition. Does nothing if the style has no attributes */
+	static void AppendAttributes(const Style& style, int elementIndex, std::string& dotDefinition);
+
+	/** Copies the graph into 'copy', with the nodes in the same or in the reverse order and with or without the edges, together with all the attributes */
+	static void CopyGraph(const Graph& graph, bool reverseNodes, bool copyEdges, Graph& copy);
+
+	/** Solves the graph, with the given cache or without a cache if it's nullptr, and returns the DOT definition of the result or the messages of the solver if it fails */
+	static std::string Solve(const Graph& graph, ASDProjectSolverCache* cache);
+};
\ No newline at end of file
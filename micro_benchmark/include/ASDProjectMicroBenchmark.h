@@ -0,0 +1,212 @@
+#pragma once
+
+#include "Graph.h"
+#include "ASDProjectDotCorpus.h"
+
+#include <string>
+#include <iostream>
+#include <chrono>
+
+/**
+* Microbenchmarks of the primitives the solver is built on: the operations of List, the construction and the lookups of Graph,
+* its traversals, its copy and the DOT parser and writer. Every benchmark is run on a given size (the number of elements of the list
+* or of nodes of the graph) and the graph ones on a given shape, and reports the time of one operation and the throughput, so that a
+* change of the data structures shows which primitive got slower.
+* Every benchmark repeats its operation until it has been measured for at least the minimum time. The preparation of a run (for
+* example emptying the graph before adding the nodes) isn't measured.
+* The DOT benchmarks measure the parser and the writer on the generated corpora of ASDProjectDotCorpus, counting also the edges parsed per second
+* and the allocations of a parse, and check that every corpus survives a round trip through the parser and the writer.
+*/
+class ASDProjectMicroBenchmark
+{
+public:
+	/** The shapes of the graphs. All of them are directed and acyclic */
+	enum GraphShape
+	{
+		/** Every node has edges to RandomDegree random nodes that follow it */
+		GS_Random,
+
+		/** Every node has an edge to the next one */
+		GS_Chain,
+
+		/** The first node has an edge to every other node */
+		GS_Star,
+
+		/** The nodes are divided in layers of about sqrt(nodes) nodes and every node has edges to LayeredDegree nodes of the next layer */
+		GS_Layered,
+
+		GS_Count
+	};
+
+	/** The number of edges of every node of the random and of the layered shapes */
+	static const int RandomDegree = 4;
+	static const int LayeredDegree = 3;
+
+	/** The result of a benchmark on a size and a shape */
+	struct Result
+	{
+		/** Default constructor */
+		Result();
+
+		/** The name of the benchmark, the name of the shape of the graph ("-" for the lists) and the size */
+		std::string _benchmarkName;
+		std::string _shapeName;
+		int _size;
+
+		/** The number of measured runs and the number of operations of every run */
+		int _runsCount;
+		long long _operationsCount;
+
+		/** The mean time of one operation, in nanoseconds */
+		double _nanosecondsPerOperation;
+
+		/** The throughput in the unit of the benchmark: operations, elements of the graph (nodes and edges) or megabytes per second */
+		double _throughput;
+		std::string _throughputUnit;
+
+		/** The edges processed per second by the DOT benchmarks, 0 for the other ones */
+		double _edgesPerSecond;
+
+		/** The number of heap allocations and the allocated bytes of one operation, -1 if they weren't counted */
+		long long _allocationsCount;
+		long long _allocatedBytes;
+	};
+
+	typedef List<Result> ResultList;
+
+public:
+	/**
+	* Constructor
+	* minimumTime: the minimum time, in seconds, that every benchmark is measured for
+	* filter: if not empty, only the benchmarks whose name contains it are run
+	*/
+	ASDProjectMicroBenchmark(double minimumTime = 0.2, const std::string& filter = "");
+
+public:
+	/** Returns the name of the given shape */
+	static const char* GetShapeName(GraphShape shape);
+
+	/** Finds the shape with the given name. Returns false if there is none */
+	static bool GetShapeFromName(const std::string& name, GraphShape& shape);
+
+	/** Fills 'edges' with the edges of a graph of the given shape and number of nodes. The random shape uses RandomGenerator */
+	static void GetShapeEdges(GraphShape shape, int nodesCount, Graph::EdgeDefinitionList& edges);
+
+	/**
+	* Builds a directed graph of the given shape with the nodes "N0".."N<nodesCount-1>". Returns false if it can't be built
+	* edges: if not nullptr, it's filled with the edges of the graph, in the order they were added
+	*/
+	static bool BuildGraph(GraphShape shape, int nodesCount, Graph& graph, Graph::EdgeDefinitionList* edges = nullptr);
+
+	/** Runs the benchmarks of List (Add, Remove, GetAt, Find) on a list of integers with the given number of elements */
+	void RunListBenchmarks(int size);
+
+	/**
+	* Runs the benchmarks of Graph (AddNode, AddEdge, GetNode by name, IsCyclic, GetUnreachableNodesCount, GetNonEntrantNodes and the copy)
+	* and of DotParser::Parse and DotWriter::Write on a graph of the given shape and number of nodes
+	*/
+	void RunGraphBenchmarks(GraphShape shape, int size);
+
+	/**
+	* Runs the benchmarks of DotParser::Parse and DotWriter::Write on the corpus with the given predefined style of ASDProjectDotCorpus and number of nodes.
+	* The parsed graph is checked against the corpus, must survive a round trip through the writer and the parser and must have the same result with
+	* and without ASDProjectSolverCache (up to 256 nodes): if it doesn't, the reason is written to 'messages', nothing is measured and false is returned
+	*/
+	bool RunDotBenchmarks(const std::string& styleName, int size, std::ostream& messages);
+
+	/** Returns the results of the benchmarks run so far */
+	const ResultList& GetResults() const { return _results; }
+
+	/** Writes the results as CSV, with one line for every benchmark after a header line with the names of the columns */
+	bool WriteCsv(std::ostream& output) const;
+
+	/** Writes the results as CSV to the file at the given path */
+	bool WriteFile(const std::string& filePath) const;
+
+	/** Loads the results written by WriteCsv */
+	bool LoadCsv(const std::string& filePath);
+
+	/**
+	* Compares every result with the result of the baseline with the same benchmark, shape and size, writing the result to 'output'.
+	* A result is a regression if its time per operation is greater than the one of the baseline by more than 'threshold' (a fraction of the time of the baseline).
+	* Returns the number of regressions
+	*/
+	int CompareWithBaseline(const ASDProjectMicroBenchmark& baseline, double threshold, std::ostream& output) const;
+
+	/** Returns the monotonic wall time, in seconds */
+	static double GetTime() { return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+private:
+	/** Returns true if the benchmark with the given name has to be run */
+	bool IsSelected(const std::string& benchmarkName) const { return _filter.empty() || benchmarkName.find(_filter) != std::string::npos; }
+
+	/**
+	* Measures the given benchmark and adds its result. The benchmark must have the methods Setup, which prepares a run and isn't measured,
+	* and Run, which runs 'operationsCount' operations, and the member _checksum, where it accumulates the results of the operations so
+	* that the compiler can't skip them.
+	* units: the number of units of the throughput processed by a run, for example the number of bytes parsed. If 0 the throughput is in operations
+	* throughputUnit: the name of the unit of the throughput
+	* Returns false if the benchmark isn't selected
+	*/
+	template<typename Benchmark> bool Measure(const std::string& benchmarkName, const std::string& shapeName, int size, Benchmark& benchmark, long long operationsCount, double units = 0.0, const char* throughputUnit = "ops/s")
+	{
+		if (!IsSelected(benchmarkName))
+			return false;
+
+		// An unmeasured run warms up the caches and the allocator
+		benchmark.Setup();
+		benchmark.Run();
+
+		double totalTime = 0.0;
+		int runsCount = 0;
+
+		while (totalTime < _minimumTime || runsCount < MinimumRunsCount)
+		{
+			benchmark.Setup();
+
+			double t0 = GetTime();
+			benchmark.Run();
+			double t1 = GetTime();
+
+			totalTime += t1 - t0;
+			runsCount++;
+		}
+
+		_sink = _sink + benchmark._checksum;
+
+		double runTime = totalTime / runsCount;
+
+		Result result;
+		result._benchmarkName = benchmarkName;
+		result._shapeName = shapeName;
+		result._size = size;
+		result._runsCount = runsCount;
+		result._operationsCount = operationsCount;
+		result._nanosecondsPerOperation = (operationsCount > 0) ? runTime * 1e9 / operationsCount : 0.0;
+		result._throughput = (runTime > 0.0) ? ((units > 0.0) ? units : (double)operationsCount) / runTime : 0.0;
+		result._throughputUnit = throughputUnit;
+
+		_results.Add(result);
+
+		return true;
+	}
+
+private:
+	/** The minimum number of measured runs of every benchmark */
+	static const int MinimumRunsCount = 3;
+
+	/** The minimum time, in seconds, that every benchmark is measured for */
+	double _minimumTime;
+
+	/** If not empty, only the benchmarks whose name contains it are run */
+	std::string _filter;
+
+	/** The results of the benchmarks */
+	ResultList _results;
+
+	/** Accumulates the checksums of the benchmarks so that their operations can't be optimized away */
+	volatile long long _sink;
+};
+
+template<> struct ContainerElementDefaultValue<ASDProjectMicroBenchmark::GraphShape> { static ASDProjectMicroBenchmark::GraphShape Value() { return ASDProjectMicroBenchmark::GS_Random; } };
+template<> struct ContainerElementDefaultValue<ASDProjectMicroBenchmark::Result> { static ASDProjectMicroBenchmark::Result Value() { return ASDProjectMicroBenchmark::Result(); } };
\ No newline at end of file
@@ -0,0 +1,357 @@
+#include "ASDProjectDotCorpus.h"
+#include "DotParser.h"
+#include "DotWriter.h"
+#include "OutputBuffer.h"
+#include "ASDProjectSolver.h"
+
+#include <sstream>
+#include <cstdlib>
+
+/** The names of the predefined styles, in the order of their indices */
+static const char* s_dotCorpusStyleNames[ASDProjectDotCorpus::StylesCount] = { "bare", "quoted", "attributes", "comments", "chained", "crlf", "mixed" };
+
+/** The number of attributes of the styles with attributes and the number of edges of the chains of the chained styles */
+static const int s_dotCorpusAttributesCount = 3;
+static const int s_dotCorpusChainLength = 4;
+
+/** Returns the distance between the nodes of the k-th edge of every node. The distances are different, so the edges are never repeated */
+static inline int GetDotCorpusEdgeDistance(int nodesCount, int k)
+{
+	return 1 + k * (1 + nodesCount / (ASDProjectDotCorpus::EdgesPerNode * 8));
+}
+
+/** Default constructor: bare IDs, no attributes, no comments, one edge per statement, LF lines */
+ASDProjectDotCorpus::Style::Style()
+	: _quotedIds(false)
+	, _attributesCount(0)
+	, _comments(false)
+	, _chainLength(1)
+	, _crlf(false)
+{ }
+
+/** Returns the name of the predefined style with the given index, from 0 to StylesCount - 1 */
+const char* ASDProjectDotCorpus::GetStyleName(int styleIndex)
+{
+	return (styleIndex >= 0 && styleIndex < StylesCount) ? s_dotCorpusStyleNames[styleIndex] : "";
+}
+
+/**
+* Finds the predefined style with the given name: "bare", "quoted", "attributes", "comments", "chained", "crlf"
+* or "mixed", which has all the features. Returns false if there is none
+*/
+bool ASDProjectDotCorpus::GetStyle(const std::string& name, Style& style)
+{
+	bool mixed = (name == "mixed");
+
+	style = Style();
+
+	if (name == "bare")
+		return true;
+
+	if (mixed || name == "quoted")
+		style._quotedIds = true;
+
+	if (mixed || name == "attributes")
+		style._attributesCount = s_dotCorpusAttributesCount;
+
+	if (mixed || name == "comments")
+		style._comments = true;
+
+	if (mixed || name == "chained")
+		style._chainLength = s_dotCorpusChainLength;
+
+	if (mixed || name == "crlf")
+		style._crlf = true;
+
+	return mixed || style._quotedIds || style._attributesCount > 0 || style._comments || style._chainLength > 1 || style._crlf;
+}
+
+/** Generates the DOT definition of the corpus with the given style and number of nodes, and the numbers of its elements */
+void ASDProjectDotCorpus::Generate(const Style& style, int nodesCount, std::string& dotDefinition, Counts& counts)
+{
+	const char* newLine = style._crlf ? "\r\n" : "\n";
+	int chainLength = (style._chainLength > 1) ? style._chainLength : 1;
+
+	dotDefinition.clear();
+	counts = Counts();
+
+	if (style._comments)
+		dotDefinition.append("// Corpus of ").append(std::to_string(nodesCount)).append(" nodes").append(newLine);
+
+	dotDefinition.append("digraph corpus {").append(newLine);
+
+	for (int i = 0; i < nodesCount; i++)
+	{
+		if (style._comments)
+			dotDefinition.append("\t// Node ").append(std::to_string(i)).append(newLine);
+
+		dotDefinition.append("\t").append(GetNodeId(style, i));
+		AppendAttributes(style, i, dotDefinition);
+		dotDefinition.append(";").append(newLine);
+
+		counts._nodesCount++;
+		counts._attributesCount += style._attributesCount;
+	}
+
+	// The edges with the same distance form paths i -> i + distance -> i + 2 * distance ..., which are split in chains of at most chainLength edges.
+	// Without chains the edges are written grouped by their start node, like the writer does
+	int edgeIndex = 0;
+
+	if (chainLength == 1)
+	{
+		for (int i = 0; i < nodesCount; i++)
+		{
+			for (int k = 0; k < EdgesPerNode && i + GetDotCorpusEdgeDistance(nodesCount, k) < nodesCount; k++, edgeIndex++)
+			{
+				if (style._comments)
+					dotDefinition.append("\t/* Edge ").append(std::to_string(edgeIndex)).append(" */").append(newLine);
+
+				dotDefinition.append("\t").append(GetNodeId(style, i)).append(" -> ").append(GetNodeId(style, i + GetDotCorpusEdgeDistance(nodesCount, k)));
+				AppendAttributes(style, edgeIndex, dotDefinition);
+				dotDefinition.append(";").append(newLine);
+			}
+		}
+	}
+	else
+	{
+		for (int k = 0; k < EdgesPerNode; k++)
+		{
+			int distance = GetDotCorpusEdgeDistance(nodesCount, k);
+
+			for (int first = 0; first < distance && first + distance < nodesCount; first++)
+			{
+				for (int start = first; start + distance < nodesCount; start += chainLength * distance)
+				{
+					int chainEdges = 0;
+
+					if (style._comments)
+						dotDefinition.append("\t/* Chain from ").append(std::to_string(start)).append(" */").append(newLine);
+
+					dotDefinition.append("\t").append(GetNodeId(style, start));
+
+					for (int node = start + distance; node < nodesCount && chainEdges < chainLength; node += distance, chainEdges++)
+						dotDefinition.append(" -> ").append(GetNodeId(style, node));
+
+					AppendAttributes(style, edgeIndex, dotDefinition);
+					dotDefinition.append(";").append(newLine);
+
+					edgeIndex += chainEdges;
+				}
+			}
+		}
+	}
+
+	counts._edgesCount = edgeIndex;
+	counts._attributesCount += edgeIndex * style._attributesCount;
+
+	dotDefinition.append("}").append(newLine);
+}
+
+/** Returns the numbers of nodes, edges and attributes of the given graph */
+ASDProjectDotCorpus::Counts ASDProjectDotCorpus::GetCounts(const Graph& graph)
+{
+	Counts counts;
+	counts._nodesCount = graph.GetNodes().GetSize();
+	counts._edgesCount = graph.GetEdges().GetSize();
+
+	Graph::NodeList::ConstIterator nodesIt = graph.GetNodes().Begin();
+	Graph::NodeList::ConstIterator nodesEnd = graph.GetNodes().End();
+
+	for (; nodesIt && nodesIt != nodesEnd; ++nodesIt)
+		counts._attributesCount += (*nodesIt).GetAttributes().GetSize();
+
+	Graph::EdgeList::ConstIterator edgesIt = graph.GetEdges().Begin();
+	Graph::EdgeList::ConstIterator edgesEnd = graph.GetEdges().End();
+
+	for (; edgesIt && edgesIt != edgesEnd; ++edgesIt)
+		counts._attributesCount += (*edgesIt).GetAttributes().GetSize();
+
+	return counts;
+}
+
+/**
+* Checks that the parsed graph is the corpus and that it survives a round trip: the graph is written, the text is parsed again and the second graph
+* must have the same counts and must be written to the same text. Writes the reason to 'messages' and returns false if the check fails
+*/
+bool ASDProjectDotCorpus::CheckRoundTrip(const Graph& parsedGraph, const Counts& expectedCounts, std::ostream& messages)
+{
+	Counts parsedCounts = GetCounts(parsedGraph);
+
+	if (!(parsedCounts == expectedCounts))
+	{
+		messages << "the parsed graph has " << parsedCounts._nodesCount << " nodes, " << parsedCounts._edgesCount << " edges and " << parsedCounts._attributesCount
+			<< " attributes instead of " << expectedCounts._nodesCount << ", " << expectedCounts._edgesCount << " and " << expectedCounts._attributesCount << std::endl;
+		return false;
+	}
+
+	OutputBuffer writtenBuffer;
+
+	if (!DotWriter::Write(parsedGraph, writtenBuffer))
+	{
+		messages << "the parsed graph cannot be written" << std::endl;
+		return false;
+	}
+
+	std::string writtenDefinition(writtenBuffer.GetData(), writtenBuffer.GetSize());
+	Graph reparsedGraph;
+
+	if (!DotParser::Parse(reparsedGraph, writtenDefinition))
+	{
+		messages << "the written graph cannot be parsed" << std::endl;
+		return false;
+	}
+
+	if (!(GetCounts(reparsedGraph) == expectedCounts))
+	{
+		messages << "the written graph has different numbers of nodes, edges or attributes once parsed" << std::endl;
+		return false;
+	}
+
+	OutputBuffer rewrittenBuffer;
+	DotWriter::Write(reparsedGraph, rewrittenBuffer);
+
+	if (rewrittenBuffer.GetSize() != writtenBuffer.GetSize() || std::string(rewrittenBuffer.GetData(), rewrittenBuffer.GetSize()) != writtenDefinition)
+	{
+		messages << "the written graph is written differently once parsed" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+* Checks that ASDProjectSolverCache gives the same result of ASDProjectSolver: the parsed graph, a copy with the nodes in the reverse order and the two graphs
+* without their edges, whose roots are chosen by the order of the nodes, are solved without the cache and then twice in a row with the same cache, so that
+* the graphs with the same key share their entry and the second time the result comes from the cache. Writes the reason to 'messages' and returns false if a result is different
+*/
+bool ASDProjectDotCorpus::CheckCachedSolutions(const Graph& parsedGraph, std::ostream& messages)
+{
+	static const int graphsCount = 4;
+	static const char* graphNames[graphsCount] = { "the graph", "the graph with the nodes in the reverse order", "the graph without edges", "the graph without edges with the nodes in the reverse order" };
+
+	Graph graphs[graphsCount];
+	std::string solutions[graphsCount];
+
+	for (int i = 0; i < graphsCount; i++)
+	{
+		CopyGraph(parsedGraph, i % 2 == 1, i < 2, graphs[i]);
+		solutions[i] = Solve(graphs[i], nullptr);
+	}
+
+	// The graphs have the same nodes: the reversed graphs use the entry of the others only when the solver broke no tie by the order of the nodes
+	ASDProjectSolverCache cache;
+
+	for (int i = 0; i < graphsCount; i++)
+	{
+		for (int pass = 0; pass < 2; pass++)
+		{
+			long long hitsCount = cache.GetHitsCount();
+
+			if (Solve(graphs[i], &cache) != solutions[i])
+			{
+				messages << "the " << (pass == 0 ? "first" : "cached") << " result of " << graphNames[i] << " is different from the one of the solver" << std::endl;
+				return false;
+			}
+
+			if (pass == 1 && cache.GetHitsCount() != hitsCount + 1)
+			{
+				messages << "the cache didn't find the result of " << graphNames[i] << " the second time" << std::endl;
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/** Returns the ID of the node with the given index, as written in the corpus */
+std::string ASDProjectDotCorpus::GetNodeId(const Style& style, int nodeIndex)
+{
+	return style._quotedIds ? "\"Node " + std::to_string(nodeIndex) + "\"" : "N" + std::to_string(nodeIndex);
+}
+
+/** Appends the attributes list of an element to the definition. Does nothing if the style has no attributes */
+void ASDProjectDotCorpus::AppendAttributes(const Style& style, int elementIndex, std::string& dotDefinition)
+{
+	if (style._attributesCount <= 0)
+		return;
+
+	dotDefinition.append(" [");
+
+	for (int i = 0; i < style._attributesCount; i++)
+	{
+		if (i > 0)
+			dotDefinition.append(", ");
+
+		dotDefinition.append("attr").append(std::to_string(i)).append("=");
+
+		if (i % 2 == 0)
+			dotDefinition.append("v").append(std::to_string(elementIndex));
+		else
+			dotDefinition.append("\"Value ").append(std::to_string(elementIndex)).append(" of attribute ").append(std::to_string(i)).append("\"");
+	}
+
+	dotDefinition.append("]");
+}
+
+/** Copies the graph into 'copy', with the nodes in the same or in the reverse order and with or without the edges, together with all the attributes */
+void ASDProjectDotCorpus::CopyGraph(const Graph& graph, bool reverseNodes, bool copyEdges, Graph& copy)
+{
+	int nodesCount = graph.GetNodes().GetSize();
+	const Node** nodes = (const Node**)malloc(sizeof(Node*) * (nodesCount > 0 ? nodesCount : 1));
+
+	Graph::NodeList::ConstIterator nodesIt = graph.GetNodes().Begin();
+	Graph::NodeList::ConstIterator nodesEnd = graph.GetNodes().End();
+
+	for (int i = 0; nodesIt && nodesIt != nodesEnd; i++, ++nodesIt)
+		nodes[reverseNodes ? nodesCount - 1 - i : i] = &(*nodesIt);
+
+	copy = Graph();
+	copy.SetGraphType(graph.GetGraphType());
+	copy.SetName(graph.GetName(), graph.EncloseNameInDoubleQuotes());
+
+	for (int i = 0; i < nodesCount; i++)
+	{
+		Node* node = copy.AddNode(nodes[i]->GetName(), nodes[i]->EncloseNameInDoubleQuotes());
+
+		GraphElement::AttributeList::ConstIterator it = nodes[i]->GetAttributes().Begin();
+		GraphElement::AttributeList::ConstIterator end = nodes[i]->GetAttributes().End();
+
+		for (; node != nullptr && it && it != end; ++it)
+			node->SetAttribute((*it)._name, (*it)._value, (*it)._encloseNameInDoubleQuotes, (*it)._encloseValueInDoubleQuotes);
+	}
+
+	free(nodes);
+
+	Graph::EdgeList::ConstIterator edgesIt = graph.GetEdges().Begin();
+	Graph::EdgeList::ConstIterator edgesEnd = graph.GetEdges().End();
+
+	for (; copyEdges && edgesIt && edgesIt != edgesEnd; ++edgesIt)
+	{
+		const Edge& edge = *edgesIt;
+		Edge* copiedEdge = copy.AddEdge(edge.GetStartNode()->GetName(), edge.GetEndNode()->GetName(), edge.GetStartNode()->EncloseNameInDoubleQuotes(), edge.GetEndNode()->EncloseNameInDoubleQuotes());
+
+		GraphElement::AttributeList::ConstIterator it = edge.GetAttributes().Begin();
+		GraphElement::AttributeList::ConstIterator end = edge.GetAttributes().End();
+
+		for (; copiedEdge != nullptr && it && it != end; ++it)
+			copiedEdge->SetAttribute((*it)._name, (*it)._value, (*it)._encloseNameInDoubleQuotes, (*it)._encloseValueInDoubleQuotes);
+	}
+}
+
+/** Solves the graph, with the given cache or without a cache if it's nullptr, and returns the DOT definition of the result or the messages of the solver if it fails */
+std::string ASDProjectDotCorpus::Solve(const Graph& graph, ASDProjectSolverCache* cache)
+{
+	Graph result;
+	std::ostringstream messages;
+
+	bool solved = (cache != nullptr) ? cache->ProcessData(graph, result, messages) : ASDProjectSolver::ProcessData(graph, result, messages);
+
+	if (!solved)
+		return "Not solved: " + messages.str();
+
+	OutputBuffer buffer;
+	DotWriter::Write(result, buffer);
+
+	return std::string(buffer.GetData(), buffer.GetSize());
+}
\ No newline at end of file
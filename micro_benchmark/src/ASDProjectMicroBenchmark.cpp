@@ -0,0 +1,743 @@
+#include "ASDProjectMicroBenchmark.h"
+#include "RandomGenerator.h"
+#include "DotParser.h"
+#include "DotWriter.h"
+#include "OutputBuffer.h"
+#include "MemoryAccounting.h"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+
+/** The names of the columns of the CSV files, and the ones of the files written before the DOT benchmarks, which are the first ones */
+static const char* s_microBenchmarkColumns = "benchmark,shape,size,runs,operations,ns_per_op,throughput,unit,edges_per_s,allocations,allocated_bytes";
+static const char* s_microBenchmarkBaseColumns = "benchmark,shape,size,runs,operations,ns_per_op,throughput,unit";
+
+/** The numbers of columns of the CSV files */
+static const int s_microBenchmarkColumnsCount = 11;
+static const int s_microBenchmarkBaseColumnsCount = 8;
+
+/** The number of lookups made by every run of the benchmarks that access the elements in a scattered order */
+static const int s_lookupsCount = 1000;
+static const int s_findsCount = 100;
+
+/** A prime used to visit the indices in a scattered order */
+static const int s_scatterPrime = 7919;
+
+/** The maximum number of nodes of the corpora checked with the solver cache, which solves every corpus twelve times */
+static const int s_maximumCacheCheckNodesCount = 256;
+
+/** Returns the index of the i-th lookup on 'count' elements, visiting them in a scattered order */
+static inline int GetScatteredIndex(int i, int count)
+{
+	return (int)(((long long)i * s_scatterPrime) % count);
+}
+
+/** Adds the elements 0..size-1 to a new list */
+struct MicroBenchmarkListAdd
+{
+	MicroBenchmarkListAdd(int size) : _size(size), _checksum(0) { }
+
+	void Setup() { _list = List<int>(); }
+
+	void Run()
+	{
+		for (int i = 0; i < _size; i++)
+			_list.Add(i);
+
+		_checksum += _list.GetSize();
+	}
+
+	int _size;
+	List<int> _list;
+	long long _checksum;
+};
+
+/** Removes all the elements of a list, from the first one, so that the time is the one of unlinking the items and not of finding them */
+struct MicroBenchmarkListRemove
+{
+	MicroBenchmarkListRemove(int size) : _size(size), _checksum(0) { }
+
+	void Setup()
+	{
+		_list = List<int>();
+
+		for (int i = 0; i < _size; i++)
+			_list.Add(i);
+	}
+
+	void Run()
+	{
+		for (int i = 0; i < _size; i++)
+			_list.Remove(i);
+
+		_checksum += _list.GetSize();
+	}
+
+	int _size;
+	List<int> _list;
+	long long _checksum;
+};
+
+/** Reads the elements of a list at scattered indices */
+struct MicroBenchmarkListGetAt
+{
+	MicroBenchmarkListGetAt(const List<int>& list) : _list(list), _checksum(0) { }
+
+	void Setup() { }
+
+	void Run()
+	{
+		int size = _list.GetSize();
+
+		for (int i = 0; i < s_lookupsCount; i++)
+			_checksum += _list.GetAt(GetScatteredIndex(i, size));
+	}
+
+	const List<int>& _list;
+	long long _checksum;
+};
+
+/** Finds scattered elements of a list by value */
+struct MicroBenchmarkListFind
+{
+	MicroBenchmarkListFind(const List<int>& list) : _list(list), _checksum(0) { }
+
+	void Setup() { }
+
+	void Run()
+	{
+		int size = _list.GetSize();
+
+		for (int i = 0; i < s_findsCount; i++)
+			_checksum += _list.Find(GetScatteredIndex(i, size));
+	}
+
+	const List<int>& _list;
+	long long _checksum;
+};
+
+/** Adds the nodes to an empty graph one at a time */
+struct MicroBenchmarkAddNode
+{
+	MicroBenchmarkAddNode(const std::string* names, int count) : _names(names), _count(count), _checksum(0) { }
+
+	void Setup() { _graph = Graph("benchmark", false, Graph::GT_Directed); }
+
+	void Run()
+	{
+		for (int i = 0; i < _count; i++)
+			_checksum += (_graph.AddNode(_names[i], false) != nullptr);
+	}
+
+	const std::string* _names;
+	int _count;
+	Graph _graph;
+	long long _checksum;
+};
+
+/** Adds the edges one at a time to a copy of a graph that contains only the nodes */
+struct MicroBenchmarkAddEdge
+{
+	MicroBenchmarkAddEdge(const Graph& nodesGraph, const Graph::EdgeDefinitionList& edges)
+		: _nodesGraph(nodesGraph)
+		, _edges(edges)
+		, _nodes((Node**)malloc(sizeof(Node*) * (nodesGraph.GetNodes().GetSize() > 0 ? nodesGraph.GetNodes().GetSize() : 1)))
+		, _checksum(0)
+	{ }
+
+	~MicroBenchmarkAddEdge() { free(_nodes); }
+
+	void Setup()
+	{
+		_graph = _nodesGraph;
+		_graph.GetNodesArray(_nodes);
+	}
+
+	void Run()
+	{
+		Graph::EdgeDefinitionList::ConstIterator it = _edges.Begin();
+		Graph::EdgeDefinitionList::ConstIterator end = _edges.End();
+
+		for (; it && it != end; ++it)
+			_checksum += (_graph.AddEdge(_nodes[(*it)._startNodeIndex], _nodes[(*it)._endNodeIndex]) != nullptr);
+	}
+
+	const Graph& _nodesGraph;
+	const Graph::EdgeDefinitionList& _edges;
+	Graph _graph;
+	Node** _nodes;
+	long long _checksum;
+};
+
+/** Looks up scattered nodes by name */
+struct MicroBenchmarkGetNode
+{
+	MicroBenchmarkGetNode(const Graph& graph, const std::string* names, int count) : _graph(graph), _names(names), _count(count), _checksum(0) { }
+
+	void Setup() { }
+
+	void Run()
+	{
+		for (int i = 0; i < s_lookupsCount; i++)
+			_checksum += (_graph.GetNode(_names[GetScatteredIndex(i, _count)]) != nullptr);
+	}
+
+	const Graph& _graph;
+	const std::string* _names;
+	int _count;
+	long long _checksum;
+};
+
+/** Checks if the graph contains cycles */
+struct MicroBenchmarkIsCyclic
+{
+	MicroBenchmarkIsCyclic(Graph& graph) : _graph(graph), _checksum(0) { }
+
+	void Setup() { }
+
+	void Run() { _checksum += _graph.IsCyclic(true, false); }
+
+	Graph& _graph;
+	long long _checksum;
+};
+
+/** Counts the nodes that the first node can't reach */
+struct MicroBenchmarkUnreachableNodes
+{
+	MicroBenchmarkUnreachableNodes(Graph& graph) : _graph(graph), _root(graph.GetNode(0)), _checksum(0) { }
+
+	void Setup() { }
+
+	void Run() { _checksum += _graph.GetUnreachableNodesCount(_root, true, false); }
+
+	Graph& _graph;
+	Node* _root;
+	long long _checksum;
+};
+
+/** Finds the nodes without entrant edges */
+struct MicroBenchmarkNonEntrantNodes
+{
+	MicroBenchmarkNonEntrantNodes(Graph& graph) : _graph(graph), _checksum(0) { }
+
+	void Setup() { }
+
+	void Run() { _checksum += _graph.GetNonEntrantNodes().GetSize(); }
+
+	Graph& _graph;
+	long long _checksum;
+};
+
+/** Copies the graph into an empty graph */
+struct MicroBenchmarkCopy
+{
+	MicroBenchmarkCopy(const Graph& graph) : _graph(graph), _checksum(0) { }
+
+	void Setup() { _copy = Graph(); }
+
+	void Run()
+	{
+		_copy = _graph;
+		_checksum += _copy.GetEdges().GetSize();
+	}
+
+	const Graph& _graph;
+	Graph _copy;
+	long long _checksum;
+};
+
+/** Parses the DOT definition of the graph into an empty graph */
+struct MicroBenchmarkParse
+{
+	MicroBenchmarkParse(const std::string& dotDefinition) : _dotDefinition(dotDefinition), _checksum(0) { }
+
+	void Setup() { _graph = Graph(); }
+
+	void Run()
+	{
+		DotParser::Parse(_graph, _dotDefinition);
+		_checksum += _graph.GetEdges().GetSize();
+	}
+
+	const std::string& _dotDefinition;
+	Graph _graph;
+	long long _checksum;
+};
+
+/** Writes the DOT definition of the graph into a memory buffer, reused by all the runs */
+struct MicroBenchmarkWrite
+{
+	MicroBenchmarkWrite(const Graph& graph) : _graph(graph), _checksum(0) { }
+
+	void Setup() { _buffer.Clear(); }
+
+	void Run()
+	{
+		DotWriter::Write(_graph, _buffer);
+		_checksum += _buffer.GetSize();
+	}
+
+	const Graph& _graph;
+	OutputBuffer _buffer;
+	long long _checksum;
+};
+
+/** Default constructor */
+ASDProjectMicroBenchmark::Result::Result()
+	: _benchmarkName("")
+	, _shapeName("")
+	, _size(0)
+	, _runsCount(0)
+	, _operationsCount(0)
+	, _nanosecondsPerOperation(0.0)
+	, _throughput(0.0)
+	, _throughputUnit("")
+	, _edgesPerSecond(0.0)
+	, _allocationsCount(-1)
+	, _allocatedBytes(-1)
+{ }
+
+/**
+* Constructor
+* minimumTime: the minimum time, in seconds, that every benchmark is measured for
+* filter: if not empty, only the benchmarks whose name contains it are run
+*/
+ASDProjectMicroBenchmark::ASDProjectMicroBenchmark(double minimumTime, const std::string& filter)
+	: _minimumTime(minimumTime)
+	, _filter(filter)
+	, _sink(0)
+{ }
+
+/** Returns the name of the given shape */
+const char* ASDProjectMicroBenchmark::GetShapeName(GraphShape shape)
+{
+	switch (shape)
+	{
+	case GS_Random:
+		return "random";
+	case GS_Chain:
+		return "chain";
+	case GS_Star:
+		return "star";
+	case GS_Layered:
+		return "layered";
+	case GS_Count:
+		break;
+	}
+
+	return "";
+}
+
+/** Finds the shape with the given name. Returns false if there is none */
+bool ASDProjectMicroBenchmark::GetShapeFromName(const std::string& name, GraphShape& shape)
+{
+	for (int i = 0; i < GS_Count; i++)
+	{
+		if (name == GetShapeName((GraphShape)i))
+		{
+			shape = (GraphShape)i;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/** Fills 'edges' with the edges of a graph of the given shape and number of nodes. The random shape uses RandomGenerator */
+void ASDProjectMicroBenchmark::GetShapeEdges(GraphShape shape, int nodesCount, Graph::EdgeDefinitionList& edges)
+{
+	edges.Clear();
+
+	switch (shape)
+	{
+	case GS_Random:
+		// Every following node is divided in RandomDegree slots and one random node of every slot is chosen, so that the edges are never repeated
+		for (int i = 0; i < nodesCount - 1; i++)
+		{
+			int followingNodes = nodesCount - i - 1;
+			int degree = (followingNodes < RandomDegree) ? followingNodes : RandomDegree;
+
+			for (int slot = 0; slot < degree; slot++)
+			{
+				int slotBegin = slot * followingNodes / degree;
+				int slotSize = (slot + 1) * followingNodes / degree - slotBegin;
+				int offset = (int)(RandomGenerator::GetRandom() * slotSize);
+
+				edges.Add(Graph::EdgeDefinition(i, i + 1 + slotBegin + (offset < slotSize ? offset : slotSize - 1)));
+			}
+		}
+		break;
+
+	case GS_Chain:
+		for (int i = 0; i < nodesCount - 1; i++)
+			edges.Add(Graph::EdgeDefinition(i, i + 1));
+		break;
+
+	case GS_Star:
+		for (int i = 1; i < nodesCount; i++)
+			edges.Add(Graph::EdgeDefinition(0, i));
+		break;
+
+	case GS_Layered:
+	{
+		int layerSize = (int)sqrt((double)nodesCount);
+		layerSize = (layerSize > 0) ? layerSize : 1;
+		int degree = (layerSize < LayeredDegree) ? layerSize : LayeredDegree;
+
+		for (int i = 0; i + layerSize < nodesCount; i++)
+		{
+			int nextLayerBegin = (i / layerSize + 1) * layerSize;
+			int nextLayerSize = (nodesCount - nextLayerBegin < layerSize) ? nodesCount - nextLayerBegin : layerSize;
+
+			for (int j = 0; j < degree && j < nextLayerSize; j++)
+				edges.Add(Graph::EdgeDefinition(i, nextLayerBegin + (i % layerSize + j) % nextLayerSize));
+		}
+		break;
+	}
+
+	case GS_Count:
+		break;
+	}
+}
+
+/**
+* Builds a directed graph of the given shape with the nodes "N0".."N<nodesCount-1>". Returns false if it can't be built
+* edges: if not nullptr, it's filled with the edges of the graph, in the order they were added
+*/
+bool ASDProjectMicroBenchmark::BuildGraph(GraphShape shape, int nodesCount, Graph& graph, Graph::EdgeDefinitionList* edges)
+{
+	graph = Graph(GetShapeName(shape), false, Graph::GT_Directed);
+
+	Graph::NodeDefinitionList nodes;
+
+	for (int i = 0; i < nodesCount; i++)
+		nodes.Add(Graph::NodeDefinition("N" + std::to_string(i)));
+
+	Graph::EdgeDefinitionList shapeEdges;
+	GetShapeEdges(shape, nodesCount, shapeEdges);
+
+	if (edges != nullptr)
+		*edges = shapeEdges;
+
+	return graph.AddNodes(nodes) && graph.AddEdges(shapeEdges) >= 0;
+}
+
+/** Runs the benchmarks of List (Add, Remove, GetAt, Find) on a list of integers with the given number of elements */
+void ASDProjectMicroBenchmark::RunListBenchmarks(int size)
+{
+	if (size <= 0)
+		return;
+
+	List<int> list;
+
+	for (int i = 0; i < size; i++)
+		list.Add(i);
+
+	MicroBenchmarkListAdd add(size);
+	Measure("List::Add", "-", size, add, size);
+
+	MicroBenchmarkListRemove remove(size);
+	Measure("List::Remove", "-", size, remove, size);
+
+	MicroBenchmarkListGetAt getAt(list);
+	Measure("List::GetAt", "-", size, getAt, s_lookupsCount);
+
+	MicroBenchmarkListFind find(list);
+	Measure("List::Find", "-", size, find, s_findsCount);
+}
+
+/**
+* Runs the benchmarks of Graph (AddNode, AddEdge, GetNode by name, IsCyclic, GetUnreachableNodesCount, GetNonEntrantNodes and the copy)
+* and of DotParser::Parse and DotWriter::Write on a graph of the given shape and number of nodes
+*/
+void ASDProjectMicroBenchmark::RunGraphBenchmarks(GraphShape shape, int size)
+{
+	if (size <= 0)
+		return;
+
+	const char* shapeName = GetShapeName(shape);
+
+	Graph graph;
+	Graph::EdgeDefinitionList edges;
+
+	if (!BuildGraph(shape, size, graph, &edges))
+	{
+		std::cerr << "ASDProjectMicroBenchmark error [RunGraphBenchmarks]: cannot build the " << shapeName << " graph with " << size << " nodes" << std::endl;
+		return;
+	}
+
+	// The names of the nodes and a graph with only the nodes, where the edges are added again one at a time
+	std::string* names = new std::string[size];
+	Node** nodes = (Node**)malloc(sizeof(Node*) * size);
+	Graph nodesGraph(shapeName, false, Graph::GT_Directed);
+
+	Graph::NodeDefinitionList nodesDefinitions;
+
+	graph.GetNodesArray(nodes);
+
+	for (int i = 0; i < size; i++)
+	{
+		names[i] = nodes[i]->GetName();
+		nodesDefinitions.Add(Graph::NodeDefinition(names[i]));
+	}
+
+	nodesGraph.AddNodes(nodesDefinitions);
+	free(nodes);
+
+	double elements = (double)graph.GetNodes().GetSize() + graph.GetEdges().GetSize();
+
+	MicroBenchmarkAddNode addNode(names, size);
+	Measure("Graph::AddNode", shapeName, size, addNode, size);
+
+	MicroBenchmarkAddEdge addEdge(nodesGraph, edges);
+	Measure("Graph::AddEdge", shapeName, size, addEdge, edges.GetSize());
+
+	MicroBenchmarkGetNode getNode(graph, names, size);
+	Measure("Graph::GetNode", shapeName, size, getNode, s_lookupsCount);
+
+	MicroBenchmarkIsCyclic isCyclic(graph);
+	Measure("Graph::IsCyclic", shapeName, size, isCyclic, 1, elements, "elements/s");
+
+	MicroBenchmarkUnreachableNodes unreachableNodes(graph);
+	Measure("Graph::GetUnreachableNodesCount", shapeName, size, unreachableNodes, 1, elements, "elements/s");
+
+	MicroBenchmarkNonEntrantNodes nonEntrantNodes(graph);
+	Measure("Graph::GetNonEntrantNodes", shapeName, size, nonEntrantNodes, 1, elements, "elements/s");
+
+	MicroBenchmarkCopy copy(graph);
+	Measure("Graph::Copy", shapeName, size, copy, 1, elements, "elements/s");
+
+	// The DOT definition is written once to be parsed, and its size gives the throughput of the parser and of the writer
+	OutputBuffer dotBuffer;
+	DotWriter::Write(graph, dotBuffer);
+	std::string dotDefinition(dotBuffer.GetData(), dotBuffer.GetSize());
+	double megabytes = dotDefinition.size() / 1e6;
+
+	MicroBenchmarkParse parse(dotDefinition);
+	Measure("DotParser::Parse", shapeName, size, parse, 1, megabytes, "MB/s");
+
+	MicroBenchmarkWrite write(graph);
+	Measure("DotWriter::Write", shapeName, size, write, 1, megabytes, "MB/s");
+
+	delete[] names;
+}
+
+/**
+* Runs the benchmarks of DotParser::Parse and DotWriter::Write on the corpus with the given predefined style of ASDProjectDotCorpus and number of nodes.
+* The parsed graph is checked against the corpus, must survive a round trip through the writer and the parser and must have the same result with
+* and without ASDProjectSolverCache (up to 256 nodes): if it doesn't, the reason is written to 'messages', nothing is measured and false is returned
+*/
+bool ASDProjectMicroBenchmark::RunDotBenchmarks(const std::string& styleName, int size, std::ostream& messages)
+{
+	ASDProjectDotCorpus::Style style;
+
+	if (size <= 0 || !ASDProjectDotCorpus::GetStyle(styleName, style))
+	{
+		messages << "ASDProjectMicroBenchmark error [RunDotBenchmarks]: invalid corpus " << styleName << " with " << size << " nodes" << std::endl;
+		return false;
+	}
+
+	std::string dotDefinition;
+	ASDProjectDotCorpus::Counts counts;
+	ASDProjectDotCorpus::Generate(style, size, dotDefinition, counts);
+
+	// An unmeasured parse counts the allocations, from the empty graph to the parsed one, and gives the graph checked by the round trip
+	Graph graph;
+	MemoryAccounting::Counters heapCounters;
+
+	MemoryAccounting::Reset();
+	MemoryAccounting::SetEnabled(true);
+	bool parsed = DotParser::Parse(graph, dotDefinition);
+	MemoryAccounting::SetEnabled(false);
+	MemoryAccounting::GetCounters(MemoryAccounting::MC_Heap, heapCounters);
+
+	std::ostringstream roundTripMessages;
+
+	if (!parsed || !ASDProjectDotCorpus::CheckRoundTrip(graph, counts, roundTripMessages))
+	{
+		messages << "ASDProjectMicroBenchmark error [RunDotBenchmarks]: the " << styleName << " corpus with " << size << " nodes failed the round trip: "
+			<< (parsed ? roundTripMessages.str() : "it cannot be parsed\n");
+		return false;
+	}
+
+	std::ostringstream cacheMessages;
+
+	if (size <= s_maximumCacheCheckNodesCount && !ASDProjectDotCorpus::CheckCachedSolutions(graph, cacheMessages))
+	{
+		messages << "ASDProjectMicroBenchmark error [RunDotBenchmarks]: the " << styleName << " corpus with " << size << " nodes failed the cache check: " << cacheMessages.str();
+		return false;
+	}
+
+	MicroBenchmarkParse parse(dotDefinition);
+
+	if (Measure("DotParser::Parse", styleName, size, parse, 1, dotDefinition.size() / 1e6, "MB/s"))
+	{
+		Result& result = _results.GetAt(_results.GetSize() - 1);
+		result._edgesPerSecond = (result._nanosecondsPerOperation > 0.0) ? counts._edgesCount * 1e9 / result._nanosecondsPerOperation : 0.0;
+		result._allocationsCount = heapCounters._allocationsCount;
+		result._allocatedBytes = heapCounters._allocatedBytes;
+	}
+
+	// The writer doesn't write the comments and the CRLF lines of the corpus, so its throughput is computed on the size of its own output
+	OutputBuffer dotBuffer;
+	DotWriter::Write(graph, dotBuffer);
+
+	MicroBenchmarkWrite write(graph);
+
+	if (Measure("DotWriter::Write", styleName, size, write, 1, dotBuffer.GetSize() / 1e6, "MB/s"))
+	{
+		Result& result = _results.GetAt(_results.GetSize() - 1);
+		result._edgesPerSecond = (result._nanosecondsPerOperation > 0.0) ? counts._edgesCount * 1e9 / result._nanosecondsPerOperation : 0.0;
+	}
+
+	return true;
+}
+
+/** Writes the results as CSV, with one line for every benchmark after a header line with the names of the columns */
+bool ASDProjectMicroBenchmark::WriteCsv(std::ostream& output) const
+{
+	output << std::setprecision(9) << s_microBenchmarkColumns << std::endl;
+
+	ResultList::ConstIterator it = _results.Begin();
+	ResultList::ConstIterator end = _results.End();
+
+	for (; it && it != end; ++it)
+	{
+		const Result& result = *it;
+
+		output << result._benchmarkName << "," << result._shapeName << "," << result._size << "," << result._runsCount << "," << result._operationsCount << ","
+			<< result._nanosecondsPerOperation << "," << result._throughput << "," << result._throughputUnit << ","
+			<< result._edgesPerSecond << "," << result._allocationsCount << "," << result._allocatedBytes << std::endl;
+	}
+
+	return output.good();
+}
+
+/** Writes the results as CSV to the file at the given path */
+bool ASDProjectMicroBenchmark::WriteFile(const std::string& filePath) const
+{
+	std::ofstream outputFile(filePath);
+
+	if (!outputFile.is_open())
+	{
+		std::cerr << "ASDProjectMicroBenchmark error [WriteFile]: cannot open the file " << filePath << std::endl;
+		return false;
+	}
+
+	bool result = WriteCsv(outputFile);
+	outputFile.close();
+
+	return result;
+}
+
+/** Loads the results written by WriteCsv */
+bool ASDProjectMicroBenchmark::LoadCsv(const std::string& filePath)
+{
+	std::ifstream inputFile(filePath);
+
+	if (!inputFile.is_open())
+	{
+		std::cerr << "ASDProjectMicroBenchmark error [LoadCsv]: cannot open the file " << filePath << std::endl;
+		return false;
+	}
+
+	std::string line;
+
+	if (!std::getline(inputFile, line) || (line != s_microBenchmarkColumns && line != s_microBenchmarkBaseColumns))
+	{
+		std::cerr << "ASDProjectMicroBenchmark error [LoadCsv]: the file " << filePath << " isn't a report of the microbenchmarks" << std::endl;
+		return false;
+	}
+
+	_results.Clear();
+
+	while (std::getline(inputFile, line))
+	{
+		if (line.empty())
+			continue;
+
+		std::istringstream lineStream(line);
+		std::string fields[s_microBenchmarkColumnsCount];
+		int fieldsCount = 0;
+
+		while (fieldsCount < s_microBenchmarkColumnsCount && std::getline(lineStream, fields[fieldsCount], ','))
+			fieldsCount++;
+
+		if (fieldsCount != s_microBenchmarkBaseColumnsCount && fieldsCount != s_microBenchmarkColumnsCount)
+		{
+			std::cerr << "ASDProjectMicroBenchmark error [LoadCsv]: invalid line \"" << line << "\" in the file " << filePath << std::endl;
+			return false;
+		}
+
+		Result result;
+		result._benchmarkName = fields[0];
+		result._shapeName = fields[1];
+		result._size = atoi(fields[2].c_str());
+		result._runsCount = atoi(fields[3].c_str());
+		result._operationsCount = atoll(fields[4].c_str());
+		result._nanosecondsPerOperation = atof(fields[5].c_str());
+		result._throughput = atof(fields[6].c_str());
+		result._throughputUnit = fields[7];
+
+		if (fieldsCount == s_microBenchmarkColumnsCount)
+		{
+			result._edgesPerSecond = atof(fields[8].c_str());
+			result._allocationsCount = atoll(fields[9].c_str());
+			result._allocatedBytes = atoll(fields[10].c_str());
+		}
+
+		_results.Add(result);
+	}
+
+	return true;
+}
+
+/**
+* Compares every result with the result of the baseline with the same benchmark, shape and size, writing the result to 'output'.
+* A result is a regression if its time per operation is greater than the one of the baseline by more than 'threshold' (a fraction of the time of the baseline).
+* Returns the number of regressions
+*/
+int ASDProjectMicroBenchmark::CompareWithBaseline(const ASDProjectMicroBenchmark& baseline, double threshold, std::ostream& output) const
+{
+	int regressionsCount = 0;
+	int comparedCount = 0;
+
+	ResultList::ConstIterator it = _results.Begin();
+	ResultList::ConstIterator end = _results.End();
+
+	for (; it && it != end; ++it)
+	{
+		const Result& result = *it;
+		const Result* baselineResult = nullptr;
+
+		ResultList::ConstIterator baselineIt = baseline._results.Begin();
+		ResultList::ConstIterator baselineEnd = baseline._results.End();
+
+		for (; baselineIt && baselineIt != baselineEnd && baselineResult == nullptr; ++baselineIt)
+		{
+			if ((*baselineIt)._benchmarkName == result._benchmarkName && (*baselineIt)._shapeName == result._shapeName && (*baselineIt)._size == result._size)
+				baselineResult = &(*baselineIt);
+		}
+
+		if (baselineResult == nullptr || baselineResult->_nanosecondsPerOperation <= 0.0)
+			continue;
+
+		comparedCount++;
+
+		double change = (result._nanosecondsPerOperation - baselineResult->_nanosecondsPerOperation) / baselineResult->_nanosecondsPerOperation;
+
+		if (change > threshold)
+		{
+			regressionsCount++;
+			output << "Regression: " << result._benchmarkName << " (" << result._shapeName << ", " << result._size << ") " << baselineResult->_nanosecondsPerOperation
+				<< " -> " << result._nanosecondsPerOperation << " ns/op (+" << (change * 100.0) << "%)" << std::endl;
+		}
+	}
+
+	output << regressionsCount << " regressions found comparing " << comparedCount << " benchmarks with the baseline" << std::endl;
+
+	return regressionsCount;
+}
\ No newline at end of file
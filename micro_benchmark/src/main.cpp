@@ -0,0 +1,318 @@
+#include "ASDProjectMicroBenchmark.h"
+#include "RandomGenerator.h"
+
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+
+typedef List<int> SizesList;
+typedef List<ASDProjectMicroBenchmark::GraphShape> ShapesList;
+typedef List<std::string> StylesList;
+
+void PrintUsage();
+bool ParseArgs(int argc, char *argv[], bool& dotMode, SizesList& sizes, ShapesList& shapes, StylesList& styles, double& minimumTime, std::string& filter, double& seed, std::string& csvReportPath, std::string& baselinePath, double& regressionThreshold);
+bool ParseSizes(const std::string& value, SizesList& sizes);
+bool ParseShapes(const std::string& value, ShapesList& shapes);
+bool ParseStyles(const std::string& value, StylesList& styles);
+void PrintResults(const ASDProjectMicroBenchmark::ResultList& results, int firstResult);
+
+int main(int argc, char *argv[])
+{
+	bool dotMode = false;
+	SizesList sizes;
+	ShapesList shapes;
+	StylesList styles;
+	double minimumTime = 0.2;
+	std::string filter = "";
+	double seed = 0;
+	std::string csvReportPath = "";
+	std::string baselinePath = "";
+	double regressionThreshold = 10.0;
+
+	if (!ParseArgs(argc, argv, dotMode, sizes, shapes, styles, minimumTime, filter, seed, csvReportPath, baselinePath, regressionThreshold))
+	{
+		PrintUsage();
+		return -1;
+	}
+
+	// The baseline is loaded before the measurements so that a wrong path is found immediately
+	ASDProjectMicroBenchmark baseline;
+
+	if (!baselinePath.empty() && !baseline.LoadCsv(baselinePath))
+		return -1;
+
+	// The random graphs are the same on every run unless a seed is given
+	if (seed > 0)
+		RandomGenerator::SetSeed(seed);
+
+	ASDProjectMicroBenchmark benchmark(minimumTime, filter);
+
+	std::cout << std::left << std::setw(34) << "Benchmark" << std::setw(10) << (dotMode ? "Style" : "Shape") << std::right << std::setw(10) << "Size" << std::setw(16) << "ns/op" << std::setw(18) << "Throughput" << std::endl;
+
+	bool roundTripsPassed = true;
+
+	SizesList::Iterator sizesIt = sizes.Begin();
+	SizesList::Iterator sizesEnd = sizes.End();
+
+	for (; sizesIt && sizesIt != sizesEnd; ++sizesIt)
+	{
+		int firstResult = benchmark.GetResults().GetSize();
+
+		if (dotMode)
+		{
+			StylesList::Iterator stylesIt = styles.Begin();
+			StylesList::Iterator stylesEnd = styles.End();
+
+			for (; stylesIt && stylesIt != stylesEnd; ++stylesIt)
+			{
+				firstResult = benchmark.GetResults().GetSize();
+				roundTripsPassed = benchmark.RunDotBenchmarks(*stylesIt, *sizesIt, std::cerr) && roundTripsPassed;
+				PrintResults(benchmark.GetResults(), firstResult);
+			}
+
+			continue;
+		}
+
+		benchmark.RunListBenchmarks(*sizesIt);
+		PrintResults(benchmark.GetResults(), firstResult);
+
+		ShapesList::Iterator shapesIt = shapes.Begin();
+		ShapesList::Iterator shapesEnd = shapes.End();
+
+		for (; shapesIt && shapesIt != shapesEnd; ++shapesIt)
+		{
+			firstResult = benchmark.GetResults().GetSize();
+			benchmark.RunGraphBenchmarks(*shapesIt, *sizesIt);
+			PrintResults(benchmark.GetResults(), firstResult);
+		}
+	}
+
+	std::cout << std::endl;
+
+	if (!csvReportPath.empty())
+		benchmark.WriteFile(csvReportPath);
+
+	if (!roundTripsPassed)
+		return -1;
+
+	// The exit code tells the scripts that a regression was found
+	if (!baselinePath.empty() && benchmark.CompareWithBaseline(baseline, regressionThreshold / 100.0, std::cout) > 0)
+		return 1;
+
+	return 0;
+}
+
+void PrintUsage()
+{
+	std::cout
+		<< "USAGE:" << std::endl
+		<< "micro_benchmark[.exe] [-mode primitives|dot] [-sizes Size[,Size...]] [-shapes all|Shape[,Shape...]] [-styles all|Style[,Style...]] [-mintime Seconds] [-filter Name] [-seed Seed] [-csv FilePath] [-baseline CsvFilePath] [-threshold Percentage]" << std::endl << std::endl
+		<< "Parameters:" << std::endl
+		<< "\t-mode: primitives measures List, Graph, the parser and the writer on the graphs of the given shapes. dot measures the parser and the writer on generated DOT corpora of the given styles, "
+		<< "counting also the edges per second and the allocations of a parse, and checks that every corpus survives a round trip through the parser and the writer and, up to 256 nodes, that the solver cache gives the same results of the solver. Default primitives" << std::endl
+		<< "\t-sizes: the numbers of elements of the lists and of nodes of the graphs and of the corpora. Default 100,1000" << std::endl
+		<< "\t-shapes: the shapes of the graphs: random, chain, star, layered. Default all" << std::endl
+		<< "\t-styles: the styles of the DOT corpora: bare, quoted (quoted IDs), attributes (3 attributes per node and edge), comments, chained (a -> b -> c edges), crlf (CRLF lines), mixed (all of them). Default all" << std::endl
+		<< "\t-mintime: the minimum time, in seconds, that every benchmark is measured for. Default 0.2" << std::endl
+		<< "\t-filter: only the benchmarks whose name contains this text are run (for example Graph::AddEdge or List::)" << std::endl
+		<< "\t-seed: the seed of the random graphs. By default the random graphs are the same on every run" << std::endl
+		<< "\t-csv: the file where the results are saved as CSV. It can be used as the baseline of a later run" << std::endl
+		<< "\t-baseline: a CSV file saved with -csv. Every benchmark is compared with the one of the baseline with the same shape and size, and the exit code is 1 if one of them is slower" << std::endl
+		<< "\t-threshold: the minimum slowdown of the time per operation, expressed in percentage, to be reported as a regression. Default 10" << std::endl
+		<< "The exit code is -1 if a corpus fails the round trip or the cache check" << std::endl;
+}
+
+bool ParseArgs(
+	int argc,
+	char *argv[],
+	bool& dotMode,
+	SizesList& sizes,
+	ShapesList& shapes,
+	StylesList& styles,
+	double& minimumTime,
+	std::string& filter,
+	double& seed,
+	std::string& csvReportPath,
+	std::string& baselinePath,
+	double& regressionThreshold)
+{
+	// Every option needs a value
+	if (argc % 2 == 0)
+		return false;
+
+	dotMode = false;
+	sizes.Clear();
+	shapes.Clear();
+	styles.Clear();
+	minimumTime = 0.2;
+	filter = "";
+	seed = 0;
+	csvReportPath = "";
+	baselinePath = "";
+	regressionThreshold = 10.0;
+
+	// Loop adding always 2 (option + value)
+	for (int i = 1; (i + 1) < argc; i += 2)
+	{
+		std::string strOption = argv[i];
+		std::string strValue = argv[i + 1];
+
+		// If the value starts with a '-' then it is an option
+		if (strValue.empty() || strValue[0] == '-')
+			return false;
+
+		if (strOption == "-mode")
+		{
+			if (strValue != "primitives" && strValue != "dot")
+				return false;
+
+			dotMode = (strValue == "dot");
+		}
+		else if (strOption == "-sizes")
+		{
+			if (!ParseSizes(strValue, sizes))
+				return false;
+		}
+		else if (strOption == "-shapes")
+		{
+			if (!ParseShapes(strValue, shapes))
+				return false;
+		}
+		else if (strOption == "-styles")
+		{
+			if (!ParseStyles(strValue, styles))
+				return false;
+		}
+		else if (strOption == "-mintime")
+			minimumTime = atof(strValue.c_str());
+		else if (strOption == "-filter")
+			filter = strValue;
+		else if (strOption == "-seed")
+			seed = atof(strValue.c_str());
+		else if (strOption == "-csv")
+			csvReportPath = strValue;
+		else if (strOption == "-baseline")
+			baselinePath = strValue;
+		else if (strOption == "-threshold")
+			regressionThreshold = atof(strValue.c_str());
+		else
+			return false;
+	}
+
+	if (sizes.GetSize() == 0)
+		sizes.Add(100).Add(1000);
+
+	if (shapes.GetSize() == 0)
+		ParseShapes("all", shapes);
+
+	if (styles.GetSize() == 0)
+		ParseStyles("all", styles);
+
+	return minimumTime > 0.0;
+}
+
+/** Parses a list of sizes separated by commas. Returns false if one of them isn't a positive number */
+bool ParseSizes(const std::string& value, SizesList& sizes)
+{
+	std::istringstream stream(value);
+	std::string size;
+
+	sizes.Clear();
+
+	while (std::getline(stream, size, ','))
+	{
+		int parsedSize = atoi(size.c_str());
+
+		if (parsedSize <= 0)
+			return false;
+
+		sizes.Add(parsedSize);
+	}
+
+	return sizes.GetSize() > 0;
+}
+
+/** Parses a list of names of shapes separated by commas, or "all". Returns false if one of the names isn't valid */
+bool ParseShapes(const std::string& value, ShapesList& shapes)
+{
+	shapes.Clear();
+
+	if (value == "all")
+	{
+		for (int shape = 0; shape < ASDProjectMicroBenchmark::GS_Count; shape++)
+			shapes.Add((ASDProjectMicroBenchmark::GraphShape)shape);
+
+		return true;
+	}
+
+	std::istringstream stream(value);
+	std::string name;
+
+	while (std::getline(stream, name, ','))
+	{
+		ASDProjectMicroBenchmark::GraphShape shape;
+
+		if (!ASDProjectMicroBenchmark::GetShapeFromName(name, shape))
+			return false;
+
+		shapes.Add(shape);
+	}
+
+	return shapes.GetSize() > 0;
+}
+
+/** Parses a list of names of styles of the DOT corpora separated by commas, or "all". Returns false if one of the names isn't valid */
+bool ParseStyles(const std::string& value, StylesList& styles)
+{
+	styles.Clear();
+
+	if (value == "all")
+	{
+		for (int style = 0; style < ASDProjectDotCorpus::StylesCount; style++)
+			styles.Add(ASDProjectDotCorpus::GetStyleName(style));
+
+		return true;
+	}
+
+	std::istringstream stream(value);
+	std::string name;
+
+	while (std::getline(stream, name, ','))
+	{
+		ASDProjectDotCorpus::Style style;
+
+		if (!ASDProjectDotCorpus::GetStyle(name, style))
+			return false;
+
+		styles.Add(name);
+	}
+
+	return styles.GetSize() > 0;
+}
+
+/** Writes a line for every result starting from the given one */
+void PrintResults(const ASDProjectMicroBenchmark::ResultList& results, int firstResult)
+{
+	if (firstResult >= results.GetSize())
+		return;
+
+	ASDProjectMicroBenchmark::ResultList::ConstIterator it = results.Begin() + firstResult;
+	ASDProjectMicroBenchmark::ResultList::ConstIterator end = results.End();
+
+	for (; it && it != end; ++it)
+	{
+		const ASDProjectMicroBenchmark::Result& result = *it;
+
+		std::cout << std::left << std::setw(34) << result._benchmarkName << std::setw(10) << result._shapeName << std::right << std::setw(10) << result._size
+			<< std::fixed << std::setprecision(1) << std::setw(16) << result._nanosecondsPerOperation
+			<< std::setprecision(result._throughput < 100.0 ? 2 : 0) << std::setw(18) << result._throughput << " " << result._throughputUnit;
+
+		if (result._edgesPerSecond > 0.0)
+			std::cout << std::setprecision(0) << std::setw(14) << result._edgesPerSecond << " edges/s";
+
+		if (result._allocationsCount >= 0)
+			std::cout << std::setw(10) << result._allocationsCount << " allocations (" << result._allocatedBytes << " bytes)";
+
+		std::cout << std::defaultfloat << std::setprecision(6) << std::endl;
+	}
+}
\ No newline at end of file
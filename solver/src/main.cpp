@@ -1,13 +1,210 @@
 #include "ASDProjectSolver.h"
+#include "ASDProjectBatchSolver.h"
+#include "ASDProjectSolverServer.h"
+#include "ASDProjectSolverCache.h"
 #include "Graph.h"
 #include "DotWriter.h"
+#include "BinaryGraphWriter.h"
+#include "DeltaWriter.h"
+
+#include <cstdlib>
+#include <thread>
+#include <csignal>
+
+void PrintUsage();
+
+/** The server that is running, stopped by the termination signals */
+static ASDProjectSolverServer* s_runningServer = nullptr;
+
+static void StopServer(int /*signalNumber*/)
+{
+	if (s_runningServer != nullptr)
+		s_runningServer->Stop();
+}
 
 int main(int argc, char *argv[])
 {
 	Graph graph;
-	
-	if(ASDProjectSolver::ProcessData(graph, argc, argv))
-		DotWriter::Write(graph, std::cout);
+
+	// Remove the options from the arguments so that the first one is still the input file
+	std::string outputFormat = "dot";
+	std::string outputFolderPath = "";
+	std::string socketPath = "";
+	std::string cacheFolderPath = "";
+	int cacheEntriesCount = -1;
+	int requestTimeoutMilliseconds = ASDProjectSolverServer::s_defaultRequestTimeoutMilliseconds;
+	int writerThreadsCount = 1;
+	int batchThreadsCount = 1;
+	bool batchMode = false;
+	int solverOptions = ASDProjectSolver::O_None;
+	char** arguments = (char**)malloc(sizeof(char*) * (argc + 1));
+	int argumentsCount = 0;
+
+	for (int i = 0; i < argc; i++)
+	{
+		std::string strOption = argv[i];
+
+		if (strOption == "-of" && (i + 1) < argc)
+		{
+			outputFormat = argv[++i];
+
+			if (outputFormat != "dot" && outputFormat != "binary" && outputFormat != "delta" && outputFormat != "delta-dot")
+			{
+				PrintUsage();
+				free(arguments);
+				return -1;
+			}
+		}
+		else if (strOption == "-wt" && (i + 1) < argc)
+		{
+			// Values lower than 1 use all the cores of the machine
+			writerThreadsCount = atoi(argv[++i]);
+			if (writerThreadsCount < 1)
+				writerThreadsCount = (int)std::thread::hardware_concurrency();
+		}
+		else if (strOption == "-j" && (i + 1) < argc)
+		{
+			// Values lower than 1 use all the cores of the machine
+			batchThreadsCount = atoi(argv[++i]);
+			if (batchThreadsCount < 1)
+				batchThreadsCount = (int)std::thread::hardware_concurrency();
+		}
+		else if (strOption == "-od" && (i + 1) < argc)
+			outputFolderPath = argv[++i];
+		else if (strOption == "-daemon" && (i + 1) < argc)
+			socketPath = argv[++i];
+		else if (strOption == "-timeout" && (i + 1) < argc)
+			requestTimeoutMilliseconds = atoi(argv[++i]);
+		else if (strOption == "-cache" && (i + 1) < argc)
+			cacheEntriesCount = atoi(argv[++i]);
+		else if (strOption == "-cache-dir" && (i + 1) < argc)
+			cacheFolderPath = argv[++i];
+		else if (strOption == "-batch")
+			batchMode = true;
+		else if (strOption == "-scc")
+			solverOptions |= ASDProjectSolver::O_CondenseCycles;
+		else if (strOption == "-pc")
+			solverOptions |= ASDProjectSolver::O_ParallelComponents;
+		else if (strOption == "-tr")
+			solverOptions |= ASDProjectSolver::O_ReduceTransitiveEdges;
+		else
+			arguments[argumentsCount++] = argv[i];
+	}
+
+	arguments[argumentsCount] = nullptr;
+
+	ASDProjectBatchSolver::OutputFormat batchOutputFormat = ASDProjectBatchSolver::OF_Dot;
+	if (outputFormat == "binary")
+		batchOutputFormat = ASDProjectBatchSolver::OF_Binary;
+	else if (outputFormat == "delta")
+		batchOutputFormat = ASDProjectBatchSolver::OF_Delta;
+	else if (outputFormat == "delta-dot")
+		batchOutputFormat = ASDProjectBatchSolver::OF_DeltaDot;
+
+	// The cache is used only if it was asked for. Values lower than 1 keep all the entries in memory
+	ASDProjectSolverCache* cache = nullptr;
+	if (cacheEntriesCount >= 0 || cacheFolderPath.empty() == false)
+		cache = new ASDProjectSolverCache(cacheEntriesCount, cacheFolderPath, solverOptions);
+
+	if (socketPath.empty() == false)
+	{
+		ASDProjectSolverServer server(batchThreadsCount, batchOutputFormat);
+		server.SetCache(cache);
+		server.SetSolverOptions(solverOptions);
+		server.SetRequestTimeout(requestTimeoutMilliseconds);
+
+		s_runningServer = &server;
+		signal(SIGINT, StopServer);
+		signal(SIGTERM, StopServer);
+
+		bool result = server.Run(socketPath);
+
+		s_runningServer = nullptr;
+		free(arguments);
+		delete cache;
+
+		if (result)
+			std::cerr << server.GetStatsText();
+
+		return result ? 0 : 1;
+	}
+
+	if (batchMode)
+	{
+		ASDProjectBatchSolver batchSolver(batchOutputFormat, outputFolderPath, batchThreadsCount);
+		batchSolver.SetCache(cache);
+		batchSolver.SetSolverOptions(solverOptions);
+
+		// Without input files the graphs are read from the standard input
+		if (argumentsCount > 1)
+		{
+			ASDProjectBatchSolver::PathsList inputFilesPaths;
+			for (int i = 1; i < argumentsCount; i++)
+				inputFilesPaths.Add(arguments[i]);
+
+			batchSolver.SolveFiles(inputFilesPaths, std::cout);
+		}
+		else
+			batchSolver.SolveStream(std::cin, std::cout);
+
+		free(arguments);
+		delete cache;
+
+		return batchSolver.GetFailedJobsCount() > 0 ? 1 : 0;
+	}
+
+	bool solved = false;
+
+	if (cache != nullptr)
+	{
+		// The key is computed from the content, so a graph found inside the cache isn't built twice
+		std::string inputFileContent = ASDProjectSolver::GetInputFileContent(argumentsCount, arguments);
+		int parseIndex = 0;
+		DotParser::PendingGraph pendingGraph;
+		Graph inputGraph;
+		bool validInputGraph = false;
+
+		solved = cache->ProcessData(inputFileContent, parseIndex, pendingGraph, inputGraph, graph, std::cout, validInputGraph);
+	}
+	else
+		solved = ASDProjectSolver::ProcessData(graph, argumentsCount, arguments, solverOptions);
+
+	if (solved)
+	{
+		if (outputFormat == "binary")
+			BinaryGraphWriter::Write(graph, std::cout);
+		else if (outputFormat == "delta")
+			DeltaWriter::Write(graph, std::cout, DeltaWriter::DF_Lines);
+		else if (outputFormat == "delta-dot")
+			DeltaWriter::Write(graph, std::cout, DeltaWriter::DF_Dot);
+		else
+			DotWriter::WriteParallel(graph, std::cout, writerThreadsCount);
+	}
+
+	free(arguments);
+	delete cache;
 
 	return 0;
+}
+
+void PrintUsage()
+{
+	std::cerr
+		<< "USAGE:" << std::endl
+		<< "solver[.exe] [InputFile] [-of dot|binary|delta|delta-dot] [-wt WriterThreadsCount] [-cache MaxEntries] [-cache-dir CacheFolderPath] [-scc] [-pc] [-tr]" << std::endl
+		<< "solver[.exe] -batch [InputFile ...] [-od OutputFolderPath] [-of dot|binary|delta|delta-dot] [-j ThreadsCount] [-cache MaxEntries] [-cache-dir CacheFolderPath] [-scc] [-pc] [-tr]" << std::endl
+		<< "solver[.exe] -daemon SocketPath [-of dot|binary|delta|delta-dot] [-j ThreadsCount] [-timeout Milliseconds] [-cache MaxEntries] [-cache-dir CacheFolderPath] [-scc] [-pc] [-tr]" << std::endl << std::endl
+		<< "Parameters:" << std::endl
+		<< "\t-of: the format of the result (default dot)" << std::endl
+		<< "\t-wt: the number of threads used to write a DOT result (< 1: one for each core)" << std::endl
+		<< "\t-batch: solve all the given files or, if no file is given, all the DOT graphs written one after the other on the standard input" << std::endl
+		<< "\t-od: in batch mode, the folder where the result of every graph is written to its own file. If not given the results are written to the standard output, each followed by a new line, in the same order of the inputs" << std::endl
+		<< "\t-j: in batch and daemon mode, the number of threads that solve the graphs (< 1: one for each core)" << std::endl
+		<< "\t-daemon: keep running and solve the graphs sent to the Unix domain socket with the given path, until SIGINT or SIGTERM is received. The latency statistics are written to the standard error at the end" << std::endl
+		<< "\t-timeout: in daemon mode, the time given to a request to arrive, from its first byte to the end of its payload. When it expires the connection is closed and the request counts as failed (< 1: no limit, default " << ASDProjectSolverServer::s_defaultRequestTimeoutMilliseconds << ")" << std::endl
+		<< "\t-cache: keep the results of the solved graphs in memory, up to the given number of graphs (< 1: no limit), and reuse them for the same graphs: same nodes and edges, in any order and with any attributes, unless the solver broke a tie by the order of the nodes, in which case the nodes must be in the same order. The results don't change" << std::endl
+		<< "\t-cache-dir: like -cache, but the results are also stored inside the given folder so that they can be reused by the next runs" << std::endl
+		<< "\t-scc: solve the directed graphs that contain cycles condensing every strongly connected component into one node, instead of rejecting them. The root is the first node of its component and the added edges go to the first node of the other components" << std::endl
+		<< "\t-pc: evaluate the candidate roots of the weakly connected components of a graph on one thread for each core. The result doesn't change" << std::endl
+		<< "\t-tr: compute which nodes are reached on the transitive reduction of the graph, without the edges implied by other paths. The result doesn't change" << std::endl;
 }
\ No newline at end of file
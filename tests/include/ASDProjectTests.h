@@ -0,0 +1,30 @@
+#pragma once
+
+#include <iostream>
+
+/**
+* Tests of the solvers and of the parser. Every test returns true if it passed,
+* otherwise the reason of the failure is written to 'messages'
+*/
+class ASDProjectTests
+{
+public:
+	/**
+	* Checks that ASDProjectIncrementalSolver gives the same results of ASDProjectSolver::ProcessData on random directed and undirected
+	* graphs after batches of random edge insertions and removals, and on the undirected graphs with more than one component
+	*/
+	static bool RunIncrementalSolverTest(std::ostream& messages);
+
+	/**
+	* Checks that the IDs enclosed between double quotes go on until the closing double quote, including the whitespaces and the escaped double quotes,
+	* that a quoted ID that isn't closed is rejected and that the quoted IDs survive a round trip through the writer and the parser
+	*/
+	static bool RunDotParserTest(std::ostream& messages);
+
+	/**
+	* Checks that ASDProjectSolverCache gives the same results of ASDProjectSolver::ProcessData for random graphs with their statements in random orders,
+	* given as DOT or binary graphs and with the cycles condensed or not, that a graph whose result has no ties broken by the order of the nodes uses the entry of the same graph in another order
+	* and that a graph whose root is chosen by the order of the nodes doesn't
+	*/
+	static bool RunSolverCacheTest(std::ostream& messages);
+};
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "ASDProjectTests.h"
+#include "DotParser.h"
+#include "DotWriter.h"
+
+#include <sstream>
+#include <string>
+
+/** Checks that the node at the given index of the graph has the given name and is enclosed between double quotes */
+static bool CheckQuotedNode(Node** nodes, int nodeIndex, const std::string& name, std::ostream& messages)
+{
+	if (nodes[nodeIndex]->GetName() == name && nodes[nodeIndex]->EncloseNameInDoubleQuotes())
+		return true;
+
+	messages << "DotParser::Parse read the quoted ID [" << nodes[nodeIndex]->GetName() << "] instead of [" << name << "]" << std::endl;
+	return false;
+}
+
+/**
+* Checks that the IDs enclosed between double quotes go on until the closing double quote, including the whitespaces and the escaped double quotes,
+* that a quoted ID that isn't closed is rejected and that the quoted IDs survive a round trip through the writer and the parser
+*/
+bool ASDProjectTests::RunDotParserTest(std::ostream& messages)
+{
+	std::string dotDefinition =
+		"digraph G {\n"
+		"\t\"Node 1\" -> \"Node  2\";\n"
+		"\t\"say \\\"hi\\\"\" [label=\"a \\\"quoted\\\" value\", tooltip=\"two\nlines\"];\n"
+		"\t\"Node 1\" -> \"say \\\"hi\\\"\";\n"
+		"}";
+
+	Graph graph;
+
+	if (DotParser::Parse(graph, dotDefinition) == false)
+	{
+		messages << "DotParser::Parse rejected quoted IDs with whitespaces and escaped double quotes" << std::endl;
+		return false;
+	}
+
+	if (graph.GetNodes().GetSize() != 3 || graph.GetEdges().GetSize() != 2)
+	{
+		messages << "DotParser::Parse read " << graph.GetNodes().GetSize() << " nodes and " << graph.GetEdges().GetSize() << " edges instead of 3 nodes and 2 edges" << std::endl;
+		return false;
+	}
+
+	Node* nodes[3];
+	graph.GetNodesArray(nodes);
+
+	if (CheckQuotedNode(nodes, 0, "Node 1", messages) == false || CheckQuotedNode(nodes, 1, "Node  2", messages) == false || CheckQuotedNode(nodes, 2, "say \"hi\"", messages) == false)
+		return false;
+
+	if (nodes[2]->GetAttribute("label", "") != "a \"quoted\" value" || nodes[2]->GetAttribute("tooltip", "") != "two\nlines")
+	{
+		messages << "DotParser::Parse read the quoted attribute values [" << nodes[2]->GetAttribute("label", "") << "] and [" << nodes[2]->GetAttribute("tooltip", "") << "]" << std::endl;
+		return false;
+	}
+
+	// A quoted ID that isn't closed runs until the end of the definition
+	Graph unclosedGraph;
+
+	if (DotParser::Parse(unclosedGraph, "digraph G { \"a b -> c; }"))
+	{
+		messages << "DotParser::Parse accepted a quoted ID that isn't closed" << std::endl;
+		return false;
+	}
+
+	// The written graph is parsed into the same graph
+	std::ostringstream written;
+	DotWriter::Write(graph, written);
+
+	Graph parsedGraph;
+
+	if (DotParser::Parse(parsedGraph, written.str()) == false)
+	{
+		messages << "DotParser::Parse rejected the graph written by DotWriter:" << std::endl << written.str() << std::endl;
+		return false;
+	}
+
+	std::ostringstream rewritten;
+	DotWriter::Write(parsedGraph, rewritten);
+
+	if (rewritten.str() != written.str())
+	{
+		messages << "The graph with quoted IDs changed after a round trip through DotWriter and DotParser:" << std::endl << written.str() << std::endl << rewritten.str() << std::endl;
+		return false;
+	}
+
+	return true;
+}
\ No newline at end of file
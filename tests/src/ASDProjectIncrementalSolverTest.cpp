@@ -0,0 +1,225 @@
+#include "ASDProjectTests.h"
+#include "ASDProjectIncrementalSolver.h"
+#include "ASDProjectSolver.h"
+#include "DotWriter.h"
+#include "RandomGenerator.h"
+
+#include <sstream>
+#include <string>
+
+/** The number of random graphs checked for every type of graph, the number of batches of changes applied to each of them and the most changes of a batch */
+static const int s_incrementalSolverGraphsCount = 300;
+static const int s_incrementalSolverBatchesCount = 6;
+static const int s_incrementalSolverMaximumChangesCount = 4;
+
+/** Returns a random integer inside the range [0..count) */
+static int GetRandomIndex(int count)
+{
+	int index = (int)(RandomGenerator::GetRandom() * count);
+	return (index < count) ? index : count - 1;
+}
+
+/** Returns the name of the node with the given number */
+static std::string GetNodeName(int nodeNumber)
+{
+	return "n" + std::to_string(nodeNumber);
+}
+
+/** Returns the text compared between the solvers: the error messages or the DOT definition of the solution */
+static std::string DescribeSolution(bool solved, const Graph& result, const std::string& messages)
+{
+	std::ostringstream description;
+
+	if (solved)
+		DotWriter::Write(result, description);
+	else
+		description << "Not solved: " << messages;
+
+	return description.str();
+}
+
+/** Returns the description of the solution of ASDProjectSolver::ProcessData for the given graph */
+static std::string GetExpectedSolution(const Graph& graph)
+{
+	Graph result;
+	std::ostringstream messages;
+
+	bool solved = ASDProjectSolver::ProcessData(graph, result, messages);
+
+	return DescribeSolution(solved, result, messages.str());
+}
+
+/**
+* Creates a random graph of the given type. The edges of the directed graphs go from a node to a following one, so they don't close a cycle,
+* while the undirected graphs get an edge only once in a while, since the solver rejects them when they have one
+*/
+static void CreateRandomGraph(bool directed, Graph& graph)
+{
+	graph.Clear();
+	graph.SetName("G", false);
+	graph.SetGraphType(directed ? Graph::GT_Directed : Graph::GT_Simple);
+
+	int nodesCount = 1 + GetRandomIndex(10);
+	double edgeChance = directed ? RandomGenerator::GetRandom() * 0.4 : 0.02;
+
+	for (int i = 0; i < nodesCount; i++)
+		graph.AddNode(GetNodeName(i), false);
+
+	for (int i = 0; i < nodesCount; i++)
+	{
+		for (int j = i + 1; j < nodesCount; j++)
+		{
+			if (RandomGenerator::GetRandom() < edgeChance)
+				graph.AddEdge(GetNodeName(i), GetNodeName(j), false, false);
+		}
+	}
+}
+
+/**
+* Creates a random batch of changes of the given graph: the removal of an edge of the graph or the insertion of an edge, which can have a new node.
+* Most of the inserted edges of a directed graph go from a node to a following one, but some of them go backward and can close a cycle
+*/
+static void CreateRandomChanges(const Graph& graph, ASDProjectIncrementalSolver::EdgeChangeList& changes)
+{
+	changes.Clear();
+
+	int changesCount = 1 + GetRandomIndex(s_incrementalSolverMaximumChangesCount);
+	int nodesCount = graph.GetNodes().GetSize();
+	int edgesCount = graph.GetEdges().GetSize();
+
+	for (int i = 0; i < changesCount; i++)
+	{
+		if (edgesCount > 0 && RandomGenerator::GetRandom() < 0.4)
+		{
+			Graph::EdgeList::ConstIterator edgesIt = graph.GetEdges().Begin();
+			for (int edgeIndex = GetRandomIndex(edgesCount); edgeIndex > 0; edgeIndex--)
+				++edgesIt;
+
+			const Edge* edge = &(*edgesIt);
+
+			Graph::NamedEdgeDefinition definition(Graph::NodeDefinition(edge->GetStartNode()->GetName()), Graph::NodeDefinition(edge->GetEndNode()->GetName()));
+			changes.Add(ASDProjectIncrementalSolver::EdgeChange(definition, ASDProjectIncrementalSolver::ECT_Remove));
+		}
+		else
+		{
+			// The nodes are numbered in the order they were added, so a new node gets the number that follows the others
+			int startNodeNumber = GetRandomIndex(nodesCount);
+			int endNodeNumber = GetRandomIndex(nodesCount + 1);
+
+			if (startNodeNumber > endNodeNumber && RandomGenerator::GetRandom() < 0.8)
+				std::swap(startNodeNumber, endNodeNumber);
+
+			if (startNodeNumber == endNodeNumber)
+				continue;
+
+			Graph::NamedEdgeDefinition definition(Graph::NodeDefinition(GetNodeName(startNodeNumber)), Graph::NodeDefinition(GetNodeName(endNodeNumber)));
+			changes.Add(ASDProjectIncrementalSolver::EdgeChange(definition, ASDProjectIncrementalSolver::ECT_Insert));
+		}
+	}
+}
+
+/** Compares the result of the incremental solver with the one of ASDProjectSolver for the current graph of the incremental solver */
+static bool CheckSolution(const ASDProjectIncrementalSolver& solver, bool solved, const Graph& result, const std::string& solverMessages, const char* step, std::ostream& messages)
+{
+	std::string expected = GetExpectedSolution(solver.GetGraph());
+	std::string actual = DescribeSolution(solved, result, solverMessages);
+
+	if (actual == expected)
+		return true;
+
+	messages << "ASDProjectIncrementalSolver::" << step << " doesn't give the result of ASDProjectSolver for the graph" << std::endl;
+	DotWriter::Write(solver.GetGraph(), messages);
+	messages << std::endl << "Expected:" << std::endl << expected << std::endl << "Result:" << std::endl << actual << std::endl;
+
+	return false;
+}
+
+/** Solves the given graph and applies the changes to it, checking every result. Returns false at the first result that is different */
+static bool CheckChanges(const Graph& graph, int batchesCount, std::ostream& messages)
+{
+	ASDProjectIncrementalSolver solver;
+	ASDProjectIncrementalSolver::EdgeChangeList changes;
+	Graph result;
+	std::ostringstream solverMessages;
+
+	bool solved = solver.Solve(graph, result, solverMessages);
+
+	if (CheckSolution(solver, solved, result, solverMessages.str(), "Solve", messages) == false)
+		return false;
+
+	for (int batch = 0; batch < batchesCount; batch++)
+	{
+		CreateRandomChanges(solver.GetGraph(), changes);
+
+		solverMessages.str("");
+		solved = solver.Update(changes, result, solverMessages);
+
+		if (CheckSolution(solver, solved, result, solverMessages.str(), "Update", messages) == false)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+* Checks that ASDProjectIncrementalSolver gives the same results of ASDProjectSolver::ProcessData on random directed and undirected
+* graphs after batches of random edge insertions and removals, and on the undirected graphs with more than one component
+*/
+bool ASDProjectTests::RunIncrementalSolverTest(std::ostream& messages)
+{
+	RandomGenerator::SetSeed(62413904);
+
+	// An undirected graph without edges and with more than one node has more than one component, so it has no root.
+	// It still has none after an edge between two of its nodes is inserted and removed
+	Graph edgelessGraph("G", false, Graph::GT_Simple);
+	edgelessGraph.AddNode("a", false);
+	edgelessGraph.AddNode("b", false);
+	edgelessGraph.AddNode("c", false);
+
+	ASDProjectIncrementalSolver solver;
+	ASDProjectIncrementalSolver::EdgeChangeList changes;
+	Graph result;
+	std::ostringstream solverMessages;
+
+	bool solved = solver.Solve(edgelessGraph, result, solverMessages);
+
+	if (solved)
+	{
+		messages << "ASDProjectIncrementalSolver::Solve solved an undirected graph with more than one component" << std::endl;
+		return false;
+	}
+
+	if (CheckSolution(solver, solved, result, solverMessages.str(), "Solve", messages) == false)
+		return false;
+
+	changes.Add(ASDProjectIncrementalSolver::EdgeChange(Graph::NamedEdgeDefinition(Graph::NodeDefinition("a"), Graph::NodeDefinition("b")), ASDProjectIncrementalSolver::ECT_Insert));
+	changes.Add(ASDProjectIncrementalSolver::EdgeChange(Graph::NamedEdgeDefinition(Graph::NodeDefinition("a"), Graph::NodeDefinition("b")), ASDProjectIncrementalSolver::ECT_Remove));
+
+	solverMessages.str("");
+	solved = solver.Update(changes, result, solverMessages);
+
+	if (solved)
+	{
+		messages << "ASDProjectIncrementalSolver::Update solved an undirected graph with more than one component" << std::endl;
+		return false;
+	}
+
+	if (CheckSolution(solver, solved, result, solverMessages.str(), "Update", messages) == false)
+		return false;
+
+	// Random graphs of both types, changed by random batches of insertions and removals
+	Graph graph;
+
+	for (int type = 0; type < 2; type++)
+	{
+		for (int i = 0; i < s_incrementalSolverGraphsCount; i++)
+		{
+			CreateRandomGraph(type == 0, graph);
+
+			if (CheckChanges(graph, s_incrementalSolverBatchesCount, messages) == false)
+				return false;
+		}
+	}
+
+	return true;
+}
\ No newline at end of file
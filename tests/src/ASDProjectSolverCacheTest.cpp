@@ -0,0 +1,205 @@
+#include "ASDProjectTests.h"
+#include "ASDProjectSolverCache.h"
+#include "ASDProjectSolver.h"
+#include "BinaryGraphWriter.h"
+#include "DotParser.h"
+#include "DotWriter.h"
+#include "RandomGenerator.h"
+
+#include <sstream>
+#include <string>
+#include <algorithm>
+
+/** The number of random graphs checked and the number of orders of the statements of each of them */
+static const int s_solverCacheGraphsCount = 300;
+static const int s_solverCacheOrdersCount = 4;
+
+/** Returns a random integer inside the range [0..count) */
+static int GetRandomIndex(int count)
+{
+	int index = (int)(RandomGenerator::GetRandom() * count);
+	return (index < count) ? index : count - 1;
+}
+
+/** Shuffles the given statements */
+static void ShuffleStatements(std::string* statements, int statementsCount)
+{
+	for (int i = statementsCount - 1; i > 0; i--)
+		std::swap(statements[i], statements[GetRandomIndex(i + 1)]);
+}
+
+/** Returns the text compared between the solver and the cache: the error messages or the DOT definition of the solution */
+static std::string DescribeSolution(bool solved, const Graph& result, const std::string& messages)
+{
+	std::ostringstream description;
+
+	if (solved)
+		DotWriter::Write(result, description);
+	else
+		description << "Not solved: " << messages;
+
+	return description.str();
+}
+
+/**
+* Solves the DOT or binary graph contained inside data with the cache and checks that the result is the one of ASDProjectSolver::ProcessData with the
+* options of the cache. hit is set to true if the result was found inside the cache
+*/
+static bool CheckCachedSolution(ASDProjectSolverCache& cache, int options, const std::string& data, bool& hit, std::ostream& messages)
+{
+	Graph graph;
+	Graph expectedResult;
+	std::ostringstream expectedMessages;
+
+	bool expectedSolved = ASDProjectSolver::LoadInputGraph(graph, data) && ASDProjectSolver::ProcessData(graph, expectedResult, expectedMessages, options);
+	std::string expected = DescribeSolution(expectedSolved, expectedResult, expectedMessages.str());
+
+	int parseIndex = 0;
+	DotParser::PendingGraph pendingGraph;
+	Graph inputGraph;
+	Graph result;
+	std::ostringstream solverMessages;
+	bool validInputGraph = false;
+	long long hitsCount = cache.GetHitsCount();
+
+	bool solved = cache.ProcessData(data, parseIndex, pendingGraph, inputGraph, result, solverMessages, validInputGraph);
+	std::string actual = DescribeSolution(solved, result, solverMessages.str());
+
+	hit = cache.GetHitsCount() > hitsCount;
+
+	if (validInputGraph && actual == expected)
+		return true;
+
+	messages << "ASDProjectSolverCache::ProcessData doesn't give the result of ASDProjectSolver for the graph" << std::endl;
+	DotWriter::Write(graph, messages);
+	messages << std::endl << "Expected:" << std::endl << expected << std::endl << "Result" << (hit ? " found inside the cache:" : ":") << std::endl << actual << std::endl;
+
+	return false;
+}
+
+/**
+* Creates the statements of a random graph with up to 10 nodes. The edges of the directed graphs follow a random order of the nodes, so they don't close a cycle
+* unless some edges go backward once in a while. A node is declared on its own only sometimes, unless it has no edges, and some statements have attributes
+*/
+static int CreateRandomStatements(bool directed, std::string* statements)
+{
+	int nodesCount = 1 + GetRandomIndex(10);
+	double edgeChance = directed ? RandomGenerator::GetRandom() * 0.4 : 0.05;
+
+	int ranks[10];
+	bool connected[10];
+
+	for (int i = 0; i < nodesCount; i++)
+	{
+		ranks[i] = i;
+		connected[i] = false;
+	}
+
+	for (int i = nodesCount - 1; i > 0; i--)
+		std::swap(ranks[i], ranks[GetRandomIndex(i + 1)]);
+
+	int statementsCount = 0;
+
+	for (int i = 0; i < nodesCount; i++)
+	{
+		for (int j = 0; j < nodesCount; j++)
+		{
+			bool backward = directed && ranks[i] > ranks[j] && RandomGenerator::GetRandom() < 0.03;
+
+			if (i == j || (ranks[i] > ranks[j] && backward == false) || (directed == false && i > j) || (backward == false && RandomGenerator::GetRandom() >= edgeChance))
+				continue;
+
+			statements[statementsCount++] = "n" + std::to_string(i) + (directed ? " -> n" : " -- n") + std::to_string(j) + (RandomGenerator::GetRandom() < 0.2 ? " [color=blue];" : ";");
+			connected[i] = true;
+			connected[j] = true;
+		}
+	}
+
+	for (int i = 0; i < nodesCount; i++)
+	{
+		if (connected[i] == false || RandomGenerator::GetRandom() < 0.5)
+			statements[statementsCount++] = "n" + std::to_string(i) + (RandomGenerator::GetRandom() < 0.2 ? " [label=\"Node " + std::to_string(i) + "\"];" : ";");
+	}
+
+	return statementsCount;
+}
+
+/** Returns the DOT definition of a graph with the given statements */
+static std::string GetDotDefinition(bool directed, const std::string* statements, int statementsCount)
+{
+	std::string dotDefinition = directed ? "digraph G {\n" : "graph G {\n";
+
+	for (int i = 0; i < statementsCount; i++)
+		dotDefinition.append(statements[i]).append("\n");
+
+	return dotDefinition.append("}");
+}
+
+/**
+* Checks that ASDProjectSolverCache gives the same results of ASDProjectSolver::ProcessData for random graphs with their statements in random orders,
+* given as DOT or binary graphs and with the cycles condensed or not, that a graph whose result has no ties broken by the order of the nodes uses the entry of the same graph in another order
+* and that a graph whose root is chosen by the order of the nodes doesn't
+*/
+bool ASDProjectTests::RunSolverCacheTest(std::ostream& messages)
+{
+	RandomGenerator::SetSeed(18240576);
+
+	ASDProjectSolverCache cache;
+	ASDProjectSolverCache condensingCache(0, "", ASDProjectSolver::O_CondenseCycles);
+	bool hit = false;
+
+	// A single root and no added edges: any order gives the same result
+	if (CheckCachedSolution(cache, ASDProjectSolver::O_None, "digraph G { c; b; a; a -> b; b -> c; }", hit, messages) == false ||
+		CheckCachedSolution(cache, ASDProjectSolver::O_None, "digraph G { b -> c; a -> b [color=blue]; }", hit, messages) == false)
+		return false;
+
+	if (hit == false)
+	{
+		messages << "ASDProjectSolverCache didn't use the result of the same graph with its statements in another order" << std::endl;
+		return false;
+	}
+
+	// Every node is a root that adds the same edges, so the first one is chosen
+	if (CheckCachedSolution(cache, ASDProjectSolver::O_None, "digraph G { a; b; c; }", hit, messages) == false || CheckCachedSolution(cache, ASDProjectSolver::O_None, "digraph G { c; b; a; }", hit, messages) == false)
+		return false;
+
+	if (hit)
+	{
+		messages << "ASDProjectSolverCache used the result of a graph whose root was chosen by the order of the nodes for its nodes in another order" << std::endl;
+		return false;
+	}
+
+	std::string statements[128];
+
+	for (int graphIndex = 0; graphIndex < s_solverCacheGraphsCount; graphIndex++)
+	{
+		bool directed = graphIndex % 4 != 3;
+		int statementsCount = CreateRandomStatements(directed, statements);
+
+		for (int order = 0; order < s_solverCacheOrdersCount; order++)
+		{
+			std::string dotDefinition = GetDotDefinition(directed, statements, statementsCount);
+
+			if (CheckCachedSolution(cache, ASDProjectSolver::O_None, dotDefinition, hit, messages) == false ||
+				CheckCachedSolution(condensingCache, ASDProjectSolver::O_CondenseCycles, dotDefinition, hit, messages) == false)
+				return false;
+
+			// The same graph as a binary graph
+			Graph graph;
+			std::ostringstream binaryGraph;
+
+			if (DotParser::Parse(graph, dotDefinition) == false || BinaryGraphWriter::Write(graph, binaryGraph) == false)
+			{
+				messages << "the graph cannot be written as a binary graph:" << std::endl << dotDefinition << std::endl;
+				return false;
+			}
+
+			if (CheckCachedSolution(cache, ASDProjectSolver::O_None, binaryGraph.str(), hit, messages) == false)
+				return false;
+
+			ShuffleStatements(statements, statementsCount);
+		}
+	}
+
+	return true;
+}
\ No newline at end of file
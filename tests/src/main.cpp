@@ -0,0 +1,62 @@
+#include "ASDProjectTests.h"
+
+#include <string>
+
+void PrintUsage();
+
+/** A test and the name used to run it */
+struct TestDefinition
+{
+	const char* _name;
+	bool (*_run)(std::ostream& messages);
+};
+
+static const TestDefinition s_tests[] =
+{
+	{ "IncrementalSolver", &ASDProjectTests::RunIncrementalSolverTest },
+	{ "DotParser", &ASDProjectTests::RunDotParserTest },
+	{ "SolverCache", &ASDProjectTests::RunSolverCacheTest }
+};
+
+static const int s_testsCount = sizeof(s_tests) / sizeof(s_tests[0]);
+
+int main(int argc, char *argv[])
+{
+	// Without arguments all the tests are run
+	std::string testName = (argc > 1) ? argv[1] : "";
+	bool testFound = false;
+	int failedTestsCount = 0;
+
+	for (int i = 0; i < s_testsCount; i++)
+	{
+		if (testName.empty() == false && testName != s_tests[i]._name)
+			continue;
+
+		testFound = true;
+
+		bool passed = s_tests[i]._run(std::cerr);
+		std::cout << s_tests[i]._name << (passed ? ": passed" : ": FAILED") << std::endl;
+
+		if (passed == false)
+			failedTestsCount++;
+	}
+
+	if (testFound == false)
+	{
+		PrintUsage();
+		return -1;
+	}
+
+	return failedTestsCount > 0 ? 1 : 0;
+}
+
+void PrintUsage()
+{
+	std::cerr
+		<< "USAGE:" << std::endl
+		<< "tests[.exe] [TestName]" << std::endl << std::endl
+		<< "Runs the given test or, if no test is given, all of them. The exit code is 1 if a test fails. Tests:" << std::endl;
+
+	for (int i = 0; i < s_testsCount; i++)
+		std::cerr << "\t" << s_tests[i]._name << std::endl;
+}
\ No newline at end of file
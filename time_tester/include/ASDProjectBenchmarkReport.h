@@ -0,0 +1,136 @@
+#pragma once
+
+#include "List.h"
+#include "ASDProjectTimeTester.h"
+
+#include <string>
+#include <iostream>
+
+/**
+* The results of a run of the time tester, one entry for every tested graph, written as JSON or CSV so that the runs can be
+* checked by scripts without parsing the console output.
+* A report written as CSV can be loaded as the baseline of a later run: a graph whose mean time is greater than the one of
+* the baseline by more than the threshold, and by more than the difference explained by the error of the two means, is a regression.
+*/
+class ASDProjectBenchmarkReport
+{
+public:
+	/** The result of a graph */
+	struct Entry
+	{
+		/** Default constructor */
+		Entry();
+
+		/** The name of the graph and its number of nodes and edges */
+		std::string _graphName;
+		int _nodesCount;
+		int _edgesCount;
+
+		/** The seed that generates the graph, or a negative value if the graph was loaded from a file */
+		double _seed;
+
+		/** The number of samples (each one the average time of many runs) and the total number of runs of the solver */
+		int _samplesCount;
+		int _repetitionsCount;
+
+		/** The mean and the standard deviation of the samples, in seconds */
+		double _meanTime;
+		double _standardDeviation;
+
+		/** Half width of the confidence interval of the mean, in seconds */
+		double _confidenceInterval;
+
+		/** The median, the 5th and the 95th percentiles of the samples, in seconds */
+		double _median;
+		double _lowPercentile;
+		double _highPercentile;
+
+		/** The number of samples rejected as outliers */
+		int _rejectedSamplesCount;
+
+		/** The average CPU time, in seconds, or a negative value if it wasn't measured */
+		double _cpuTime;
+
+		/** The peak resident memory of the process after the graph was measured, in bytes (0 if unknown) */
+		long long _peakMemory;
+
+		/** True if the performance counters were read, and the mean of every counter on one run of the solver (negative if the counter isn't available) */
+		bool _hasCounters;
+		double _counters[ASDProjectPerformanceCounters::PC_Count];
+
+		/** True if the times of the phases were measured, and their statistics (with the counters of every phase if _hasCounters is true) */
+		bool _hasPhaseTimes;
+		ASDProjectTimeTester::PhaseTimes _phaseTimes;
+
+		/** True if the memory of a run of the solver was measured, and the memory used by the graphs and allocated by the run */
+		bool _hasMemoryUsage;
+		ASDProjectTimeTester::MemoryUsage _memoryUsage;
+	};
+
+	typedef List<Entry> EntryList;
+
+public:
+	/**
+	* Constructor
+	* timerName: the name of the clock used to measure the times
+	* distribution: the normal distribution value used for the confidence intervals
+	*/
+	ASDProjectBenchmarkReport(const std::string& timerName = "", double distribution = 1.96);
+
+	/** Adds the result of a graph */
+	void AddEntry(const Entry& entry) { _entries.Add(entry); }
+
+	/** Returns the results of the graphs */
+	const EntryList& GetEntries() const { return _entries; }
+
+	/** Writes the report as a JSON object */
+	bool WriteJson(std::ostream& output) const;
+
+	/**
+	* Writes the report as CSV, with one line for every graph after a header line with the names of the columns.
+	* The phases and the breakdown of the memory of the graphs are written only as JSON
+	*/
+	bool WriteCsv(std::ostream& output) const;
+
+	/** Writes the report to the file at the given path, as JSON or CSV */
+	bool WriteFile(const std::string& filePath, bool json) const;
+
+	/** Loads the entries of a report written by WriteCsv. The columns are found by name so they can be in any order. The memory of the runs isn't loaded */
+	bool LoadCsv(const std::string& filePath);
+
+	/**
+	* Compares every entry with the entry of the baseline with the same graph name and number of nodes and edges, writing the result to 'output'.
+	* An entry is a regression if its mean is greater than the mean of the baseline by more than 'threshold' (a fraction of the mean of the baseline)
+	* and the difference divided by its standard error is greater than 'distribution'.
+	* Returns the number of regressions
+	*/
+	int CompareWithBaseline(const ASDProjectBenchmarkReport& baseline, double distribution, double threshold, std::ostream& output) const;
+
+private:
+	/** Writes a string as a JSON string, escaping the special characters */
+	static void WriteJsonString(std::ostream& output, const std::string& value);
+
+	/** Writes the performance counters as a JSON object, or null if they weren't read. The unavailable counters (negative) are null */
+	static void WriteJsonCounters(std::ostream& output, bool hasCounters, const double* counters);
+
+	/** Writes the breakdown of the memory used by a graph as a JSON object */
+	static void WriteJsonFootprint(std::ostream& output, const Graph::MemoryFootprint& footprint);
+
+	/** Writes a string as a CSV field, enclosing it in double quotes if needed */
+	static void WriteCsvField(std::ostream& output, const std::string& value);
+
+	/** Splits a CSV line into its fields. Returns the number of fields */
+	static int SplitCsvLine(const std::string& line, std::string* fields, int maxFieldsCount);
+
+private:
+	/** The name of the clock used to measure the times */
+	std::string _timerName;
+
+	/** The normal distribution value used for the confidence intervals */
+	double _distribution;
+
+	/** The results of the graphs */
+	EntryList _entries;
+};
+
+template<> struct ContainerElementDefaultValue<ASDProjectBenchmarkReport::Entry> { static ASDProjectBenchmarkReport::Entry Value() { return ASDProjectBenchmarkReport::Entry(); } };
\ No newline at end of file
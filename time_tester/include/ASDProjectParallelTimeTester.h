@@ -0,0 +1,207 @@
+#pragma once
+
+#include "Graph.h"
+#include "ASDProjectTimeTester.h"
+#include "ASDProjectPerformanceCounters.h"
+
+#include <string>
+#include <iostream>
+#include <mutex>
+
+/**
+* Measures many independent graphs at the same time, each one with ASDProjectTimeTester on its own thread.
+* Every thread can be pinned to its own CPU, so that the scheduler doesn't move the measurements between the CPUs, and opens its own
+* performance counters. A random graph is generated by the thread that measures it from the seed of its task: the seeds are derived
+* from the index of the graph (see RandomGenerator::DeriveSeed), so the graphs are the same whatever the number of threads.
+* The measurements are stored by graph, so that they are merged in the order of the graphs once all the threads have finished.
+* The memory isn't measured here, since the allocations of all the threads are counted together.
+*/
+class ASDProjectParallelTimeTester
+{
+public:
+	/** A graph to measure: a DOT or binary graph file, or a random graph */
+	struct GraphTask
+	{
+		/** Default constructor */
+		GraphTask()
+			: _graphName("")
+			, _inputFilePath("")
+			, _numberOfNodes(0)
+			, _edgeChance(0.0)
+			, _seed(-1.0)
+		{ }
+
+		/** The name of the graph */
+		std::string _graphName;
+
+		/** The path of the graph file. If empty a random graph is generated */
+		std::string _inputFilePath;
+
+		/** The number of nodes and the chance of adding an edge (in the range [0..1]) of the random graph */
+		int _numberOfNodes;
+		double _edgeChance;
+
+		/** The seed of the random graph. If negative the graph continues the sequence of RandomGenerator of the calling thread */
+		double _seed;
+	};
+
+	/** The parameters of the measurements, the same of ASDProjectTimeTester::ComputeAlgorithmTime and ASDProjectTimeTester::MeasureAlgorithmTime */
+	struct Settings
+	{
+		/** Default constructor */
+		Settings()
+			: _classicEngine(false)
+			, _iterations(7)
+			, _distribution(1.96)
+			, _minimumTime(0.0)
+			, _delta(0.2)
+			, _measureCpuTime(false)
+			, _measurePhases(false)
+			, _readCounters(false)
+		{ }
+
+		/** True to measure with ComputeAlgorithmTime, false with MeasureAlgorithmTime */
+		bool _classicEngine;
+
+		/** The runs of ComputeAlgorithmTime for every sample, the normal distribution, the minimum time and the maximum error */
+		int _iterations;
+		double _distribution;
+		double _minimumTime;
+		double _delta;
+
+		/** The options of MeasureAlgorithmTime */
+		ASDProjectTimeTester::MeasurementOptions _measurementOptions;
+
+		/** True to measure the CPU time, the times of the phases of the solver and the performance counters */
+		bool _measureCpuTime;
+		bool _measurePhases;
+		bool _readCounters;
+	};
+
+	/** The measurement of a graph */
+	struct GraphMeasurement
+	{
+		/** Default constructor */
+		GraphMeasurement();
+
+		/** True if the graph was loaded or generated and measured */
+		bool _valid;
+
+		/** The seed the random graph was generated from, -1 for the graph files */
+		double _seed;
+
+		/** The number of nodes and of edges of the graph */
+		int _nodesCount;
+		int _edgesCount;
+
+		/** The mean time and the mean CPU time of a run of the solver, in seconds */
+		double _time;
+		double _cpuTime;
+
+		/** The times of the phases of the solver, if measured */
+		ASDProjectTimeTester::PhaseTimes _phaseTimes;
+
+		/** The statistics of the samples. The performance counters that weren't available are -1, in the statistics and in the times of the phases */
+		ASDProjectTimeTester::TimeStatistics _statistics;
+
+		/** True if the performance counters were read */
+		bool _countersRead;
+
+		/** The index of the thread that measured the graph and the CPU it was pinned to (-1 if it wasn't pinned) */
+		int _threadIndex;
+		int _cpu;
+	};
+
+private:
+	/** The state of a thread */
+	struct Worker
+	{
+		/** Default constructor */
+		Worker()
+			: _cpu(-1)
+			, _countersOpened(false)
+		{ }
+
+		/** The CPU the thread is pinned to, or -1 */
+		int _cpu;
+
+		/** The performance counters of the thread, which count only the events of the thread that opened them */
+		ASDProjectPerformanceCounters _performanceCounters;
+		bool _countersOpened;
+	};
+
+public:
+	/**
+	* Constructor
+	* threadsCount: the number of threads that measure the graphs
+	* pinThreads: if true every thread is pinned to its own CPU, among the ones the process is allowed to run on (where supported)
+	*/
+	ASDProjectParallelTimeTester(int threadsCount, bool pinThreads = true);
+
+	/** Destructor */
+	~ASDProjectParallelTimeTester();
+
+private:
+	/** The tester can't be copied */
+	ASDProjectParallelTimeTester(const ASDProjectParallelTimeTester& src);
+	ASDProjectParallelTimeTester& operator=(const ASDProjectParallelTimeTester& src);
+
+public:
+	/**
+	* Measures the given graphs using all the threads and fills 'measurements', which must contain tasksCount elements, in the order of the tasks.
+	* A line is written to 'progress' when a graph is measured. Returns the number of graphs that were measured
+	*/
+	int MeasureGraphs(const GraphTask* tasks, int tasksCount, const Settings& settings, GraphMeasurement* measurements, std::ostream& progress);
+
+	/** Returns the number of threads */
+	int GetThreadsCount() const { return _workersCount; }
+
+	/** Returns the number of CPUs the threads are pinned to, 0 if they aren't pinned */
+	int GetPinnedCpusCount() const { return _pinnedCpusCount; }
+
+	/**
+	* Loads or generates the graph of the given task. The random graph is generated with the RandomGenerator of the calling thread
+	* seed: set to the seed the random graph was generated from, -1 for the graph files
+	*/
+	static bool PrepareGraph(const GraphTask& task, Graph& graph, double& seed);
+
+	/** Loads the DOT or binary graph file at the given path */
+	static bool LoadGraph(const std::string& filePath, Graph& graph);
+
+	/**
+	* Measures the given graph on the calling thread and fills the times, the statistics and the sizes of 'measurement'
+	* performanceCounters: the open counters of the calling thread read during the measurement, or nullptr
+	*/
+	static void MeasureGraph(const Graph& graph, const Settings& settings, ASDProjectPerformanceCounters* performanceCounters, GraphMeasurement& measurement);
+
+private:
+	/** Loop of a thread: pins the thread, opens its counters and measures the graphs until there are none left */
+	void RunWorker(int workerIndex);
+
+	/** Returns the index of the next graph to measure, or -1 if there are none left */
+	int GetNextTask();
+
+private:
+	/** The state of every thread */
+	Worker* _workers;
+	int _workersCount;
+
+	/** The number of CPUs the threads are pinned to, 0 if they aren't pinned */
+	int _pinnedCpusCount;
+
+	/** The graphs of the current call to MeasureGraphs, their measurements and the settings */
+	const GraphTask* _tasks;
+	int _tasksCount;
+	GraphMeasurement* _measurements;
+	const Settings* _settings;
+
+	/** The number of graphs given to the threads and of the graphs measured */
+	int _startedTasksCount;
+	int _completedTasksCount;
+
+	/** The stream of the progress lines */
+	std::ostream* _progress;
+
+	/** Protects the counts of the graphs and the progress stream */
+	std::mutex _tasksMutex;
+};
\ No newline at end of file
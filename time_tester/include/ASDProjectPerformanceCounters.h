@@ -0,0 +1,80 @@
+#pragma once
+
+#include "ASDProjectSolverProfiler.h"
+
+#include <string>
+
+/**
+* Hardware performance counters of the process, read with perf_event_open on Linux.
+* Every counter is opened on its own, so a counter that the CPU or the kernel doesn't support (or that perf_event_paranoid forbids)
+* is only marked as unavailable while the other ones keep working. Only the user space events are counted, and the threads created
+* after Open are counted too. When the kernel multiplexes the counters their values are scaled by the time they were running.
+* On the other systems no counter is available.
+*/
+class ASDProjectPerformanceCounters
+{
+public:
+	/** The counters */
+	enum Counter
+	{
+		/** CPU cycles */
+		PC_Cycles,
+
+		/** Retired instructions */
+		PC_Instructions,
+
+		/** Read misses of the L1 data cache */
+		PC_L1DataMisses,
+
+		/** Misses of the last level cache */
+		PC_LastLevelCacheMisses,
+
+		/** Mispredicted branches */
+		PC_BranchMisses,
+
+		PC_Count
+	};
+
+public:
+	/** Default constructor */
+	ASDProjectPerformanceCounters();
+
+	/** Destructor */
+	~ASDProjectPerformanceCounters();
+
+private:
+	/** The counters can't be copied */
+	ASDProjectPerformanceCounters(const ASDProjectPerformanceCounters& src);
+	ASDProjectPerformanceCounters& operator=(const ASDProjectPerformanceCounters& src);
+
+public:
+	/**
+	* Opens and starts all the counters. Returns false if none of them is available, setting 'error' to the reason
+	*/
+	bool Open(std::string& error);
+
+	/** Closes all the counters */
+	void Close();
+
+	/** Returns true if the given counter is available */
+	bool IsAvailable(Counter counter) const { return _descriptors[counter] >= 0; }
+
+	/** Returns true if at least one counter is available */
+	bool IsAnyAvailable() const;
+
+	/** Returns the name of the given counter, used in the reports */
+	static const char* GetCounterName(Counter counter);
+
+	/** Stores the current values of the counters into 'values', which must contain PC_Count elements. The unavailable counters are 0 */
+	void Read(long long* values) const;
+
+	/**
+	* Reader of the counters for ASDProjectSolverProfiler::SetCountersReader. 'context' is the instance to read.
+	* Fills the first PC_Count elements of 'values'
+	*/
+	static void ReadCounters(void* context, long long* values);
+
+private:
+	/** The file descriptors of the counters, -1 if a counter isn't available */
+	int _descriptors[PC_Count];
+};
\ No newline at end of file
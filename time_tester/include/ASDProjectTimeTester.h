@@ -1,12 +1,129 @@
 #pragma once
 
 #include "Graph.h"
+#include "ASDProjectSolverProfiler.h"
+#include "ASDProjectPerformanceCounters.h"
+#include "MemoryAccounting.h"
 
 class ASDProjectTimeTester
 {
 public:
+	/** The clocks that can be used to measure the times */
+	enum TimerType
+	{
+		/** Monotonic wall time of std::chrono::steady_clock */
+		TT_SteadyClock,
+
+		/** Monotonic wall time of clock_gettime(CLOCK_MONOTONIC). Where it isn't available std::chrono::steady_clock is used */
+		TT_Monotonic,
+
+		/** CPU time of the process given by clock(), with the coarse granularity of CLOCKS_PER_SEC */
+		TT_Clock
+	};
+
+	/** Statistics of the time of every phase of the solver over the samples of a measurement. The times are 0 if the solver was compiled without ASD_PROFILE_SOLVER */
+	struct PhaseTimes
+	{
+		/** The mean and the standard deviation of the time that every phase takes on one run of the solver, in seconds */
+		double _means[ASDProjectSolverProfiler::P_Count];
+		double _standardDeviations[ASDProjectSolverProfiler::P_Count];
+
+		/** The mean increment of every performance counter inside every phase on one run of the solver (see SetPerformanceCounters) */
+		double _counters[ASDProjectSolverProfiler::P_Count][ASDProjectPerformanceCounters::PC_Count];
+	};
+
+	/** Statistics of the samples of a measurement, besides their mean */
+	struct TimeStatistics
+	{
+		/** The number of samples and the total number of runs of the solver that were timed to compute them */
+		int _samplesCount;
+		int _repetitionsCount;
+
+		/** The standard deviation of the samples, in seconds */
+		double _standardDeviation;
+
+		/** Half width of the confidence interval of the mean (za * s / sqrt(samples)), in seconds */
+		double _confidenceInterval;
+
+		/** The median, the 5th and the 95th percentiles, the minimum and the maximum of the samples, in seconds */
+		double _median;
+		double _lowPercentile;
+		double _highPercentile;
+		double _minimum;
+		double _maximum;
+
+		/** The number of samples rejected as outliers. They are included in _samplesCount but not in the other statistics */
+		int _rejectedSamplesCount;
+
+		/** True if the performance counters were read, and the mean increment of every counter on one run of the solver (see SetPerformanceCounters) */
+		bool _hasCounters;
+		double _counters[ASDProjectPerformanceCounters::PC_Count];
+	};
+
+	/** The memory used by one run of the solver (see MeasureMemoryUsage) */
+	struct MemoryUsage
+	{
+		/** The memory used by the input graph and by the result */
+		Graph::MemoryFootprint _inputFootprint;
+		Graph::MemoryFootprint _resultFootprint;
+
+		/**
+		* The allocations made during the run, for every category of MemoryAccounting. The current bytes are the ones still allocated
+		* when the run ended, mostly by the result
+		*/
+		MemoryAccounting::Counters _counters[MemoryAccounting::MC_Count];
+
+		/** The peak resident memory, in bytes, and true if it's the peak of the run only and not of the whole process */
+		long long _peakResidentBytes;
+		bool _peakResidentOfRun;
+	};
+
+	/** The parameters of MeasureAlgorithmTime */
+	struct MeasurementOptions
+	{
+		/** Default constructor */
+		MeasurementOptions()
+			: _warmupRunsCount(1)
+			, _minimumSamplesCount(7)
+			, _maximumSamplesCount(1000)
+			, _outliersThreshold(3.5)
+		{ }
+
+		/** The number of runs of the solver, not measured, made before the samples to warm up the caches and to estimate the time of a run */
+		int _warmupRunsCount;
+
+		/** The number of samples collected before checking the error and the maximum number of samples */
+		int _minimumSamplesCount;
+		int _maximumSamplesCount;
+
+		/** A sample is an outlier if its distance from the median is greater than this number of (normalized) median absolute deviations. 0 keeps all the samples */
+		double _outliersThreshold;
+	};
+
+	/** Sets the clock used by GetTime and by all the measurements. The default is TT_SteadyClock */
+	static void SetTimerType(TimerType timerType) { _timerType = timerType; }
+
+	/** Returns the clock used by GetTime and by all the measurements */
+	static TimerType GetTimerType() { return _timerType; }
+
+	/** Returns the name of the given clock, used in the reports */
+	static const char* GetTimerTypeName(TimerType timerType);
+
+	/**
+	* Sets the performance counters read by MeasureAlgorithmTime around the runs of the solver, and inside its phases when their times are measured,
+	* or nullptr to read no counter. The counters must be open and must stay valid while they are set.
+	* They are set for the calling thread only, since every thread measuring the solver reads the counters it opened
+	*/
+	static void SetPerformanceCounters(ASDProjectPerformanceCounters* performanceCounters) { _performanceCounters = performanceCounters; }
+
 	/**
-	* Returns a double precision floating point time value.
+	* If true GetCpuTime measures the CPU time of the calling thread instead of the one of the process, so that the measurements made
+	* at the same time by more threads don't add up. Where the CPU time of a thread can't be read the one of the process is used. Default false
+	*/
+	static void SetThreadCpuTime(bool threadCpuTime) { _threadCpuTime = threadCpuTime; }
+
+	/**
+	* Returns a double precision floating point time value, measured with the clock set by SetTimerType.
 	* You can use this like this to know how many seconds passed between two GetTime() calls:
 	*	double t0 = GetTime(); 
 	*	...
@@ -17,6 +134,25 @@ public:
 	*/
 	static double GetTime();
 
+	/**
+	* Returns the CPU time used by the process, in seconds. It's measured with clock_gettime(CLOCK_PROCESS_CPUTIME_ID)
+	* where available, otherwise with clock(). Unlike the wall time it adds the time of all the threads.
+	* After SetThreadCpuTime(true) it's the CPU time of the calling thread, measured with clock_gettime(CLOCK_THREAD_CPUTIME_ID)
+	*/
+	static double GetCpuTime();
+
+	/**
+	* Fills 'cpus' with the indices of the CPUs that the process is allowed to run on, at most maximumCpusCount of them, and returns their number.
+	* Returns 0 where they can't be read (only Linux is supported)
+	*/
+	static int GetAvailableCpus(int* cpus, int maximumCpusCount);
+
+	/** Binds the calling thread to the CPU with the given index, so that it isn't moved by the scheduler. Returns false where it isn't supported (only Linux is) */
+	static bool PinCurrentThread(int cpu);
+
+	/** Returns the peak resident memory of the process, in bytes, or 0 where it can't be read */
+	static long long GetPeakMemory();
+
 	/** Returns the granularity of the system (the minimum measurable time span) */
 	static double GetGranularity();
 
@@ -41,8 +177,11 @@ public:
 	/**
 	* Computes the average time that the algorithm takes to give a result,
 	* stripping away the time needed to prepare the input
+	* cpuTime: if not nullptr, it's set to the average CPU time measured during the same runs
+	* phaseTimes: if not nullptr, it's filled with the average time of every phase of the solver during the same runs. It must contain ASDProjectSolverProfiler::P_Count elements
+	* repetitionsCount: if not nullptr, it's set to the number of runs of the solver that were timed
 	*/
-	static double ComputeAverageCleanTime(const Graph& inputGraph, double minimumTime);
+	static double ComputeAverageCleanTime(const Graph& inputGraph, double minimumTime, double* cpuTime = nullptr, double* phaseTimes = nullptr, int* repetitionsCount = nullptr);
 
 	/**
 	* Computes the time needed to run the algorithm given
@@ -51,6 +190,76 @@ public:
 	* za: normal distribution
 	* minimumTime: the minimun time that the system needs to give a valid result
 	* delta: maximum error from the expected result
+	* cpuTime: if not nullptr, it's set to the average CPU time measured during the same runs. Only the time of the chosen clock is used to check the error
+	* phaseTimes: if not nullptr, it's filled with the mean and the standard deviation of the time of every phase of the solver over the samples
+	* statistics: if not nullptr, it's filled with the number of samples, their standard deviation and the confidence interval of the result
+	*/
+	static double ComputeAlgorithmTime(const Graph& inputGraph, int n, double za, double minimumTime, double delta, double* cpuTime = nullptr, PhaseTimes* phaseTimes = nullptr, TimeStatistics* statistics = nullptr);
+
+	/**
+	* Computes the time needed to run the algorithm given, calibrating the number of runs of every sample only once.
+	* After the warmup runs the number of runs needed to measure at least minimumTime is chosen from the time of a warmup run, and the time of the
+	* preparation is measured once. Then one sample at a time is collected until the confidence interval of the mean of the samples that aren't
+	* outliers is smaller than delta (or the maximum number of samples is reached). Returns the mean of the samples that aren't outliers
+	* inputGraph: the input graph
+	* za: normal distribution
+	* minimumTime: the minimun time that the system needs to give a valid result
+	* delta: maximum error from the expected result
+	* options: the number of warmup runs and of samples and the threshold of the outliers
+	* cpuTime: if not nullptr, it's set to the average CPU time of the samples that aren't outliers
+	* phaseTimes: if not nullptr, it's filled with the mean and the standard deviation of the time of every phase of the solver over the samples that aren't outliers
+	* statistics: if not nullptr, it's filled with the statistics of the samples, including the median and the percentiles, and with the mean of the performance counters
+	*/
+	static double MeasureAlgorithmTime(const Graph& inputGraph, double za, double minimumTime, double delta, const MeasurementOptions& options, double* cpuTime = nullptr, PhaseTimes* phaseTimes = nullptr, TimeStatistics* statistics = nullptr);
+
+	/**
+	* Runs the solver once on the given graph, not timed, counting its allocations with MemoryAccounting, and fills 'usage'.
+	* Where the peak resident memory can be reset (Linux) it's the peak of the run, otherwise it's the peak of the process up to the end of the run
+	*/
+	static void MeasureMemoryUsage(const Graph& inputGraph, MemoryUsage& usage);
+
+	/**
+	* Fits the power law y = a * x^exponent to the given points with a least squares line on log(x) and log(y), so that the exponent is the empirical
+	* complexity of a measured time. The points with a value that isn't positive are ignored.
+	* rSquared: the coefficient of determination of the fit on the logarithms
+	* Returns false if less than two points with different x can be used
+	*/
+	static bool FitPowerLaw(const double* x, const double* y, int count, double& exponent, double& rSquared);
+
+	/**
+	* Fits the power law y = a * x1^exponent1 * x2^exponent2 to the given points with a least squares plane on the logarithms,
+	* used to separate the effect of the nodes and of the edges when both change. The points with a value that isn't positive are ignored.
+	* Returns false if less than three points can be used or if log(x1) and log(x2) are collinear
+	*/
+	static bool FitPowerLaw(const double* x1, const double* x2, const double* y, int count, double& exponent1, double& exponent2, double& rSquared);
+
+private:
+	/**
+	* Marks with 1 the samples that aren't outliers, the ones whose distance from the median is at most 'threshold' times the
+	* median absolute deviation scaled to the standard deviation of a normal distribution. sortBuffer must contain 'count' elements.
+	* Returns the number of samples that aren't outliers
 	*/
-	static double ComputeAlgorithmTime(const Graph& inputGraph, int n, double za, double minimumTime, double delta);
+	static int MarkValidSamples(const double* samples, int count, double threshold, unsigned char* validSamples, double* sortBuffer);
+
+	/** Sets the median, the percentiles, the minimum and the maximum of the statistics from the valid samples */
+	static void ComputeOrderStatistics(const double* samples, int count, const unsigned char* validSamples, double* sortBuffer, TimeStatistics& statistics);
+
+	/** Returns the given percentile (in the range [0..1]) of the sorted values, interpolating between the two nearest values */
+	static double GetPercentile(const double* sortedValues, int count, double percentile);
+
+	/** Resets the peak resident memory of the process to the current resident memory. Returns false where it isn't supported */
+	static bool ResetPeakResidentMemory();
+
+	/** Returns the peak resident memory of the process since the last call to ResetPeakResidentMemory, in bytes, or 0 where it can't be read */
+	static long long GetPeakResidentMemory();
+
+private:
+	/** The clock used by GetTime */
+	static TimerType _timerType;
+
+	/** The performance counters read by MeasureAlgorithmTime in every thread, or nullptr */
+	static thread_local ASDProjectPerformanceCounters* _performanceCounters;
+
+	/** True if GetCpuTime measures the CPU time of the calling thread */
+	static bool _threadCpuTime;
 };
\ No newline at end of file
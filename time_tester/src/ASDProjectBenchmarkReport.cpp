@@ -0,0 +1,535 @@
+#include "ASDProjectBenchmarkReport.h"
+
+#include <fstream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+/** The columns of the CSV reports, in the order they are written */
+enum BenchmarkReportColumn
+{
+	BRC_Graph,
+	BRC_Nodes,
+	BRC_Edges,
+	BRC_Seed,
+	BRC_Samples,
+	BRC_Repetitions,
+	BRC_Mean,
+	BRC_StandardDeviation,
+	BRC_ConfidenceInterval,
+	BRC_Median,
+	BRC_LowPercentile,
+	BRC_HighPercentile,
+	BRC_Outliers,
+	BRC_CpuTime,
+	BRC_PeakMemory,
+	BRC_Cycles,
+	BRC_Instructions,
+	BRC_L1DataMisses,
+	BRC_LastLevelCacheMisses,
+	BRC_BranchMisses,
+	BRC_GraphBytes,
+	BRC_ResultBytes,
+	BRC_HeapAllocations,
+	BRC_HeapBytes,
+	BRC_HeapPeak,
+	BRC_ListItemsPeak,
+	BRC_ScratchAllocations,
+	BRC_ScratchPeak,
+	BRC_RunPeakMemory,
+	BRC_Count
+};
+
+/** The names of the columns of the CSV reports, also used as the names of the fields of the JSON reports */
+static const char* s_columnsNames[BRC_Count] = { "graph", "nodes", "edges", "seed", "samples", "repetitions", "mean", "stddev", "ci", "median", "p5", "p95", "outliers", "cpu_time", "peak_memory", "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses",
+	"graph_bytes", "result_bytes", "heap_allocations", "heap_bytes", "heap_peak", "list_items_peak", "scratch_allocations", "scratch_peak", "run_peak_memory" };
+
+/** Default constructor */
+ASDProjectBenchmarkReport::Entry::Entry()
+	: _graphName("")
+	, _nodesCount(0)
+	, _edgesCount(0)
+	, _seed(-1.0)
+	, _samplesCount(0)
+	, _repetitionsCount(0)
+	, _meanTime(0.0)
+	, _standardDeviation(0.0)
+	, _confidenceInterval(0.0)
+	, _median(0.0)
+	, _lowPercentile(0.0)
+	, _highPercentile(0.0)
+	, _rejectedSamplesCount(0)
+	, _cpuTime(-1.0)
+	, _peakMemory(0)
+	, _hasCounters(false)
+	, _hasPhaseTimes(false)
+	, _hasMemoryUsage(false)
+	, _memoryUsage()
+{
+	memset(_counters, 0, sizeof(_counters));
+	memset(&_phaseTimes, 0, sizeof(_phaseTimes));
+}
+
+/**
+* Constructor
+* timerName: the name of the clock used to measure the times
+* distribution: the normal distribution value used for the confidence intervals
+*/
+ASDProjectBenchmarkReport::ASDProjectBenchmarkReport(const std::string& timerName, double distribution)
+	: _timerName(timerName)
+	, _distribution(distribution)
+{ }
+
+/** Writes the report as a JSON object */
+bool ASDProjectBenchmarkReport::WriteJson(std::ostream& output) const
+{
+	output << std::setprecision(9);
+	output << "{" << std::endl << "\t\"timer\": ";
+	WriteJsonString(output, _timerName);
+	output << "," << std::endl << "\t\"distribution\": " << _distribution << "," << std::endl << "\t\"graphs\": [";
+
+	EntryList::ConstIterator it = _entries.Begin();
+	EntryList::ConstIterator end = _entries.End();
+
+	for (bool first = true; it && it != end; first = false, ++it)
+	{
+		const Entry& entry = *it;
+
+		output << (first ? "" : ",") << std::endl << "\t\t{ \"" << s_columnsNames[BRC_Graph] << "\": ";
+		WriteJsonString(output, entry._graphName);
+		output << ", \"" << s_columnsNames[BRC_Nodes] << "\": " << entry._nodesCount
+			<< ", \"" << s_columnsNames[BRC_Edges] << "\": " << entry._edgesCount
+			<< ", \"" << s_columnsNames[BRC_Seed] << "\": ";
+
+		if (entry._seed >= 0.0)
+			output << (long long)entry._seed;
+		else
+			output << "null";
+
+		output << ", \"" << s_columnsNames[BRC_Samples] << "\": " << entry._samplesCount
+			<< ", \"" << s_columnsNames[BRC_Repetitions] << "\": " << entry._repetitionsCount
+			<< ", \"" << s_columnsNames[BRC_Mean] << "\": " << entry._meanTime
+			<< ", \"" << s_columnsNames[BRC_StandardDeviation] << "\": " << entry._standardDeviation
+			<< ", \"" << s_columnsNames[BRC_ConfidenceInterval] << "\": [" << (entry._meanTime - entry._confidenceInterval) << ", " << (entry._meanTime + entry._confidenceInterval) << "]"
+			<< ", \"" << s_columnsNames[BRC_Median] << "\": " << entry._median
+			<< ", \"" << s_columnsNames[BRC_LowPercentile] << "\": " << entry._lowPercentile
+			<< ", \"" << s_columnsNames[BRC_HighPercentile] << "\": " << entry._highPercentile
+			<< ", \"" << s_columnsNames[BRC_Outliers] << "\": " << entry._rejectedSamplesCount
+			<< ", \"" << s_columnsNames[BRC_CpuTime] << "\": ";
+
+		if (entry._cpuTime >= 0.0)
+			output << entry._cpuTime;
+		else
+			output << "null";
+
+		output << ", \"" << s_columnsNames[BRC_PeakMemory] << "\": " << entry._peakMemory << ", \"counters\": ";
+		WriteJsonCounters(output, entry._hasCounters, entry._counters);
+
+		if (entry._hasPhaseTimes)
+		{
+			output << ", \"phases\": [";
+
+			for (int phase = 0; phase < ASDProjectSolverProfiler::P_Count; phase++)
+			{
+				output << (phase > 0 ? "," : "") << std::endl << "\t\t\t{ \"phase\": ";
+				WriteJsonString(output, ASDProjectSolverProfiler::GetPhaseName((ASDProjectSolverProfiler::Phase)phase));
+				output << ", \"mean\": " << entry._phaseTimes._means[phase] << ", \"stddev\": " << entry._phaseTimes._standardDeviations[phase] << ", \"counters\": ";
+				WriteJsonCounters(output, entry._hasCounters, entry._phaseTimes._counters[phase]);
+				output << " }";
+			}
+
+			output << std::endl << "\t\t]";
+		}
+
+		if (entry._hasMemoryUsage)
+		{
+			const ASDProjectTimeTester::MemoryUsage& usage = entry._memoryUsage;
+
+			output << ", \"memory\": { \"input\": ";
+			WriteJsonFootprint(output, usage._inputFootprint);
+			output << ", \"result\": ";
+			WriteJsonFootprint(output, usage._resultFootprint);
+			output << ", \"allocations\": {";
+
+			for (int category = 0; category < MemoryAccounting::MC_Count; category++)
+			{
+				const MemoryAccounting::Counters& counters = usage._counters[category];
+
+				output << (category > 0 ? ", " : " ");
+				WriteJsonString(output, MemoryAccounting::GetCategoryName((MemoryAccounting::Category)category));
+				output << ": { \"count\": " << counters._allocationsCount << ", \"frees\": " << counters._deallocationsCount << ", \"bytes\": " << counters._allocatedBytes
+					<< ", \"retained\": " << counters._currentBytes << ", \"peak\": " << counters._peakBytes << " }";
+			}
+
+			output << " }, \"peak_rss\": " << usage._peakResidentBytes << ", \"peak_rss_of_run\": " << (usage._peakResidentOfRun ? "true" : "false") << " }";
+		}
+
+		output << " }";
+	}
+
+	output << std::endl << "\t]" << std::endl << "}" << std::endl;
+
+	return output.good();
+}
+
+/** Writes the report as CSV, with one line for every graph after a header line with the names of the columns. The phases are written only as JSON */
+bool ASDProjectBenchmarkReport::WriteCsv(std::ostream& output) const
+{
+	output << std::setprecision(9);
+
+	for (int column = 0; column < BRC_Count; column++)
+		output << (column > 0 ? "," : "") << s_columnsNames[column];
+
+	output << std::endl;
+
+	EntryList::ConstIterator it = _entries.Begin();
+	EntryList::ConstIterator end = _entries.End();
+
+	for (; it && it != end; ++it)
+	{
+		const Entry& entry = *it;
+
+		// The confidence interval is written as its half width, the input graphs have no seed and the CPU time is empty if it wasn't measured
+		WriteCsvField(output, entry._graphName);
+		output << "," << entry._nodesCount << "," << entry._edgesCount << ",";
+
+		if (entry._seed >= 0.0)
+			output << (long long)entry._seed;
+
+		output << "," << entry._samplesCount << "," << entry._repetitionsCount << "," << entry._meanTime << "," << entry._standardDeviation << "," << entry._confidenceInterval << ",";
+		output << entry._median << "," << entry._lowPercentile << "," << entry._highPercentile << "," << entry._rejectedSamplesCount << ",";
+
+		if (entry._cpuTime >= 0.0)
+			output << entry._cpuTime;
+
+		output << "," << entry._peakMemory;
+
+		for (int counter = 0; counter < ASDProjectPerformanceCounters::PC_Count; counter++)
+		{
+			output << ",";
+
+			if (entry._hasCounters && entry._counters[counter] >= 0.0)
+				output << entry._counters[counter];
+		}
+
+		// The memory columns are empty if the memory of the run wasn't measured
+		if (entry._hasMemoryUsage)
+		{
+			const ASDProjectTimeTester::MemoryUsage& usage = entry._memoryUsage;
+			const MemoryAccounting::Counters& heap = usage._counters[MemoryAccounting::MC_Heap];
+			const MemoryAccounting::Counters& scratch = usage._counters[MemoryAccounting::MC_SolverScratch];
+
+			output << "," << usage._inputFootprint.GetTotal() << "," << usage._resultFootprint.GetTotal() << "," << heap._allocationsCount << "," << heap._allocatedBytes << "," << heap._peakBytes;
+			output << "," << usage._counters[MemoryAccounting::MC_ListItems]._peakBytes << "," << scratch._allocationsCount << "," << scratch._peakBytes << "," << usage._peakResidentBytes;
+		}
+		else
+		{
+			for (int column = BRC_GraphBytes; column < BRC_Count; column++)
+				output << ",";
+		}
+
+		output << std::endl;
+	}
+
+	return output.good();
+}
+
+/** Writes the report to the file at the given path, as JSON or CSV */
+bool ASDProjectBenchmarkReport::WriteFile(const std::string& filePath, bool json) const
+{
+	std::ofstream outputFile(filePath);
+
+	if (!outputFile.is_open())
+	{
+		std::cerr << "ASDProjectBenchmarkReport error [WriteFile]: cannot open the file " << filePath << std::endl;
+		return false;
+	}
+
+	bool result = json ? WriteJson(outputFile) : WriteCsv(outputFile);
+	outputFile.close();
+
+	return result;
+}
+
+/** Loads the entries of a report written by WriteCsv. The columns are found by name so they can be in any order */
+bool ASDProjectBenchmarkReport::LoadCsv(const std::string& filePath)
+{
+	std::ifstream inputFile(filePath);
+
+	if (!inputFile.is_open())
+	{
+		std::cerr << "ASDProjectBenchmarkReport error [LoadCsv]: cannot open the file " << filePath << std::endl;
+		return false;
+	}
+
+	_entries.Clear();
+
+	// Find the position of every column inside the header
+	static const int maxFieldsCount = 64;
+	std::string fields[maxFieldsCount];
+	int columnsPositions[BRC_Count];
+	std::string line;
+
+	if (!std::getline(inputFile, line))
+	{
+		std::cerr << "ASDProjectBenchmarkReport error [LoadCsv]: the file " << filePath << " is empty" << std::endl;
+		return false;
+	}
+
+	int fieldsCount = SplitCsvLine(line, fields, maxFieldsCount);
+
+	for (int column = 0; column < BRC_Count; column++)
+	{
+		columnsPositions[column] = -1;
+
+		for (int i = 0; i < fieldsCount; i++)
+		{
+			if (fields[i] == s_columnsNames[column])
+				columnsPositions[column] = i;
+		}
+	}
+
+	if (columnsPositions[BRC_Graph] < 0 || columnsPositions[BRC_Mean] < 0 || columnsPositions[BRC_StandardDeviation] < 0 || columnsPositions[BRC_Samples] < 0)
+	{
+		std::cerr << "ASDProjectBenchmarkReport error [LoadCsv]: the file " << filePath << " doesn't contain the columns graph, samples, mean and stddev" << std::endl;
+		return false;
+	}
+
+	while (std::getline(inputFile, line))
+	{
+		if (line.empty() || line == "\r")
+			continue;
+
+		fieldsCount = SplitCsvLine(line, fields, maxFieldsCount);
+
+		// The missing columns are left empty
+		for (int i = fieldsCount; i < maxFieldsCount; i++)
+			fields[i].clear();
+
+		Entry entry;
+
+		entry._graphName = fields[columnsPositions[BRC_Graph]];
+		entry._nodesCount = (columnsPositions[BRC_Nodes] >= 0) ? atoi(fields[columnsPositions[BRC_Nodes]].c_str()) : 0;
+		entry._edgesCount = (columnsPositions[BRC_Edges] >= 0) ? atoi(fields[columnsPositions[BRC_Edges]].c_str()) : 0;
+		entry._seed = (columnsPositions[BRC_Seed] >= 0 && !fields[columnsPositions[BRC_Seed]].empty()) ? atof(fields[columnsPositions[BRC_Seed]].c_str()) : -1.0;
+		entry._samplesCount = atoi(fields[columnsPositions[BRC_Samples]].c_str());
+		entry._repetitionsCount = (columnsPositions[BRC_Repetitions] >= 0) ? atoi(fields[columnsPositions[BRC_Repetitions]].c_str()) : 0;
+		entry._meanTime = atof(fields[columnsPositions[BRC_Mean]].c_str());
+		entry._standardDeviation = atof(fields[columnsPositions[BRC_StandardDeviation]].c_str());
+		entry._confidenceInterval = (columnsPositions[BRC_ConfidenceInterval] >= 0) ? atof(fields[columnsPositions[BRC_ConfidenceInterval]].c_str()) : 0.0;
+		entry._median = (columnsPositions[BRC_Median] >= 0) ? atof(fields[columnsPositions[BRC_Median]].c_str()) : 0.0;
+		entry._lowPercentile = (columnsPositions[BRC_LowPercentile] >= 0) ? atof(fields[columnsPositions[BRC_LowPercentile]].c_str()) : 0.0;
+		entry._highPercentile = (columnsPositions[BRC_HighPercentile] >= 0) ? atof(fields[columnsPositions[BRC_HighPercentile]].c_str()) : 0.0;
+		entry._rejectedSamplesCount = (columnsPositions[BRC_Outliers] >= 0) ? atoi(fields[columnsPositions[BRC_Outliers]].c_str()) : 0;
+		entry._cpuTime = (columnsPositions[BRC_CpuTime] >= 0 && !fields[columnsPositions[BRC_CpuTime]].empty()) ? atof(fields[columnsPositions[BRC_CpuTime]].c_str()) : -1.0;
+		entry._peakMemory = (columnsPositions[BRC_PeakMemory] >= 0) ? atoll(fields[columnsPositions[BRC_PeakMemory]].c_str()) : 0;
+
+		// The counters are empty if they weren't read or aren't available
+		for (int counter = 0; counter < ASDProjectPerformanceCounters::PC_Count; counter++)
+		{
+			int position = columnsPositions[BRC_Cycles + counter];
+
+			entry._counters[counter] = -1.0;
+
+			if (position >= 0 && !fields[position].empty())
+			{
+				entry._counters[counter] = atof(fields[position].c_str());
+				entry._hasCounters = true;
+			}
+		}
+
+		_entries.Add(entry);
+	}
+
+	return true;
+}
+
+/**
+* Compares every entry with the entry of the baseline with the same graph name and number of nodes and edges, writing the result to 'output'.
+* An entry is a regression if its mean is greater than the mean of the baseline by more than 'threshold' (a fraction of the mean of the baseline)
+* and the difference divided by its standard error is greater than 'distribution'.
+* Returns the number of regressions
+*/
+int ASDProjectBenchmarkReport::CompareWithBaseline(const ASDProjectBenchmarkReport& baseline, double distribution, double threshold, std::ostream& output) const
+{
+	int regressionsCount = 0;
+	int comparedCount = 0;
+
+	EntryList::ConstIterator it = _entries.Begin();
+	EntryList::ConstIterator end = _entries.End();
+
+	for (; it && it != end; ++it)
+	{
+		const Entry& entry = *it;
+		const Entry* baselineEntry = nullptr;
+
+		EntryList::ConstIterator baselineIt = baseline._entries.Begin();
+		EntryList::ConstIterator baselineEnd = baseline._entries.End();
+
+		for (; baselineIt && baselineIt != baselineEnd && baselineEntry == nullptr; ++baselineIt)
+		{
+			if ((*baselineIt)._graphName == entry._graphName && (*baselineIt)._nodesCount == entry._nodesCount && (*baselineIt)._edgesCount == entry._edgesCount)
+				baselineEntry = &(*baselineIt);
+		}
+
+		if (baselineEntry == nullptr)
+		{
+			output << "The graph " << entry._graphName << " isn't in the baseline" << std::endl;
+			continue;
+		}
+
+		comparedCount++;
+
+		// Standard error of the difference of the two means (Welch), from the standard deviations and the number of samples
+		double variance = 0.0;
+
+		if (entry._samplesCount > 0)
+			variance += (entry._standardDeviation * entry._standardDeviation) / entry._samplesCount;
+		if (baselineEntry->_samplesCount > 0)
+			variance += (baselineEntry->_standardDeviation * baselineEntry->_standardDeviation) / baselineEntry->_samplesCount;
+
+		double difference = entry._meanTime - baselineEntry->_meanTime;
+		double relativeDifference = (baselineEntry->_meanTime > 0.0) ? (difference / baselineEntry->_meanTime) : 0.0;
+		double z = (variance > 0.0) ? (difference / sqrt(variance)) : (difference > 0.0 ? HUGE_VAL : (difference < 0.0 ? -HUGE_VAL : 0.0));
+
+		bool significant = (z > distribution || z < -distribution) && (relativeDifference > threshold || relativeDifference < -threshold);
+		const char* result = !significant ? "unchanged" : (difference > 0.0 ? "REGRESSION" : "improvement");
+
+		output << result << ": " << entry._graphName << " " << baselineEntry->_meanTime << " -> " << entry._meanTime << " seconds ("
+			<< std::showpos << std::fixed << std::setprecision(1) << (relativeDifference * 100.0) << "%, z = " << std::setprecision(2) << z
+			<< std::noshowpos << std::defaultfloat << std::setprecision(6) << ")" << std::endl;
+
+		if (significant && difference > 0.0)
+			regressionsCount++;
+	}
+
+	output << regressionsCount << " regressions found comparing " << comparedCount << " graphs with the baseline" << std::endl;
+
+	return regressionsCount;
+}
+
+/** Writes a string as a JSON string, escaping the special characters */
+void ASDProjectBenchmarkReport::WriteJsonString(std::ostream& output, const std::string& value)
+{
+	static const char* hexDigits = "0123456789abcdef";
+
+	output << '"';
+
+	for (size_t i = 0; i < value.length(); i++)
+	{
+		unsigned char c = (unsigned char)value[i];
+
+		if (c == '"' || c == '\\')
+			output << '\\' << c;
+		else if (c < 0x20)
+			output << "\\u00" << hexDigits[c >> 4] << hexDigits[c & 0x0F];
+		else
+			output << c;
+	}
+
+	output << '"';
+}
+
+/** Writes the performance counters as a JSON object, or null if they weren't read. The unavailable counters (negative) are null */
+void ASDProjectBenchmarkReport::WriteJsonCounters(std::ostream& output, bool hasCounters, const double* counters)
+{
+	if (!hasCounters)
+	{
+		output << "null";
+		return;
+	}
+
+	output << "{ ";
+
+	for (int counter = 0; counter < ASDProjectPerformanceCounters::PC_Count; counter++)
+	{
+		output << (counter > 0 ? ", \"" : "\"") << ASDProjectPerformanceCounters::GetCounterName((ASDProjectPerformanceCounters::Counter)counter) << "\": ";
+
+		if (counters[counter] >= 0.0)
+			output << counters[counter];
+		else
+			output << "null";
+	}
+
+	output << " }";
+}
+
+/** Writes the breakdown of the memory used by a graph as a JSON object */
+void ASDProjectBenchmarkReport::WriteJsonFootprint(std::ostream& output, const Graph::MemoryFootprint& footprint)
+{
+	output << "{ \"total\": " << footprint.GetTotal() << ", \"graph\": " << footprint._graphBytes << ", \"nodes\": " << footprint._nodesBytes << ", \"edges\": " << footprint._edgesBytes
+		<< ", \"adjacency\": " << footprint._adjacencyBytes << ", \"attributes\": " << footprint._attributesBytes << ", \"slack\": " << footprint._freeListSlackBytes << " }";
+}
+
+/** Writes a string as a CSV field, enclosing it in double quotes if needed */
+void ASDProjectBenchmarkReport::WriteCsvField(std::ostream& output, const std::string& value)
+{
+	if (value.find_first_of(",\"\r\n") == std::string::npos)
+	{
+		output << value;
+		return;
+	}
+
+	output << '"';
+
+	for (size_t i = 0; i < value.length(); i++)
+	{
+		if (value[i] == '"')
+			output << '"';
+
+		output << value[i];
+	}
+
+	output << '"';
+}
+
+/** Splits a CSV line into its fields. Returns the number of fields */
+int ASDProjectBenchmarkReport::SplitCsvLine(const std::string& line, std::string* fields, int maxFieldsCount)
+{
+	int fieldsCount = 0;
+	size_t length = line.length();
+
+	// Ignore the carriage return of the files written on Windows
+	if (length > 0 && line[length - 1] == '\r')
+		length--;
+
+	size_t i = 0;
+
+	while (fieldsCount < maxFieldsCount)
+	{
+		std::string& field = fields[fieldsCount++];
+		field.clear();
+
+		if (i < length && line[i] == '"')
+		{
+			// Quoted field: two double quotes are one double quote
+			for (i++; i < length; i++)
+			{
+				if (line[i] == '"')
+				{
+					if (i + 1 < length && line[i + 1] == '"')
+						i++;
+					else
+					{
+						i++;
+						break;
+					}
+				}
+
+				field += line[i];
+			}
+		}
+
+		for (; i < length && line[i] != ','; i++)
+			field += line[i];
+
+		if (i >= length)
+			break;
+
+		// Skip the comma
+		i++;
+	}
+
+	return fieldsCount;
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "MemoryAccounting.h"
+
+#include <new>
+#include <cstdlib>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+/*
+* Replacement of the global operator new and operator delete that counts every allocation of the time tester in the category
+* MemoryAccounting::MC_Heap while the counters are enabled, including the strings of the names and of the attributes.
+* With glibc the memory is allocated with malloc, like the default operator new does, and the counted size is the usable size of the block,
+* so the measured code sees the same allocator. Elsewhere MemoryAccounting::CountedMalloc stores the size before the block
+*/
+
+/** Allocates the given number of bytes, counting them if the counters are enabled. Returns nullptr if the memory can't be allocated */
+static void* AllocateHeapMemory(size_t bytes)
+{
+	// operator new must return a distinct pointer also for 0 bytes
+	if (bytes == 0)
+		bytes = 1;
+
+#ifdef __GLIBC__
+	void* memory = malloc(bytes);
+
+	if (memory != nullptr && MemoryAccounting::IsEnabled())
+		MemoryAccounting::AddAllocation(MemoryAccounting::MC_Heap, malloc_usable_size(memory));
+
+	return memory;
+#else
+	return MemoryAccounting::CountedMalloc(MemoryAccounting::MC_Heap, bytes);
+#endif
+}
+
+/** Allocates the given number of bytes like operator new does: calling the new handler until the memory is allocated or throwing std::bad_alloc */
+static void* AllocateHeapMemoryOrThrow(size_t bytes)
+{
+	void* memory = AllocateHeapMemory(bytes);
+
+	while (memory == nullptr)
+	{
+		std::new_handler handler = std::set_new_handler(nullptr);
+		std::set_new_handler(handler);
+
+		if (handler == nullptr)
+			throw std::bad_alloc();
+
+		handler();
+		memory = AllocateHeapMemory(bytes);
+	}
+
+	return memory;
+}
+
+/** Releases the memory allocated by AllocateHeapMemory, counting it if the counters are enabled */
+static void FreeHeapMemory(void* memory)
+{
+	if (memory == nullptr)
+		return;
+
+#ifdef __GLIBC__
+	if (MemoryAccounting::IsEnabled())
+		MemoryAccounting::AddDeallocation(MemoryAccounting::MC_Heap, malloc_usable_size(memory));
+
+	free(memory);
+#else
+	MemoryAccounting::CountedFree(MemoryAccounting::MC_Heap, memory);
+#endif
+}
+
+void* operator new(size_t bytes)
+{
+	return AllocateHeapMemoryOrThrow(bytes);
+}
+
+void* operator new[](size_t bytes)
+{
+	return AllocateHeapMemoryOrThrow(bytes);
+}
+
+void* operator new(size_t bytes, const std::nothrow_t&) noexcept
+{
+	try
+	{
+		return AllocateHeapMemoryOrThrow(bytes);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+void* operator new[](size_t bytes, const std::nothrow_t&) noexcept
+{
+	try
+	{
+		return AllocateHeapMemoryOrThrow(bytes);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+void operator delete(void* memory) noexcept
+{
+	FreeHeapMemory(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	FreeHeapMemory(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	FreeHeapMemory(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+	FreeHeapMemory(memory);
+}
\ No newline at end of file
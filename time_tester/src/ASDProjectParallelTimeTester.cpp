@@ -0,0 +1,235 @@
+#include "ASDProjectParallelTimeTester.h"
+#include "ASDProjectSolver.h"
+#include "RandomGenerator.h"
+#include "RandomGraphGenerator.h"
+#include "DotParser.h"
+#include "BinaryGraphReader.h"
+
+#include <fstream>
+#include <thread>
+#include <cstdlib>
+
+/** The maximum number of CPUs the threads can be pinned to */
+static const int s_maximumPinnedCpusCount = 1024;
+
+/** Default constructor */
+ASDProjectParallelTimeTester::GraphMeasurement::GraphMeasurement()
+	: _valid(false)
+	, _seed(-1.0)
+	, _nodesCount(0)
+	, _edgesCount(0)
+	, _time(0.0)
+	, _cpuTime(0.0)
+	, _phaseTimes()
+	, _statistics()
+	, _countersRead(false)
+	, _threadIndex(-1)
+	, _cpu(-1)
+{ }
+
+/**
+* Constructor
+* threadsCount: the number of threads that measure the graphs
+* pinThreads: if true every thread is pinned to its own CPU, among the ones the process is allowed to run on (where supported)
+*/
+ASDProjectParallelTimeTester::ASDProjectParallelTimeTester(int threadsCount, bool pinThreads)
+	: _workers(nullptr)
+	, _workersCount(threadsCount > 0 ? threadsCount : 1)
+	, _pinnedCpusCount(0)
+	, _tasks(nullptr)
+	, _tasksCount(0)
+	, _measurements(nullptr)
+	, _settings(nullptr)
+	, _startedTasksCount(0)
+	, _completedTasksCount(0)
+	, _progress(nullptr)
+{
+	_workers = new Worker[_workersCount];
+
+	if (!pinThreads)
+		return;
+
+	// The threads take the CPUs in order. If there are more threads than CPUs some of them share a CPU
+	int* cpus = (int*)malloc(sizeof(int) * s_maximumPinnedCpusCount);
+	_pinnedCpusCount = ASDProjectTimeTester::GetAvailableCpus(cpus, s_maximumPinnedCpusCount);
+
+	for (int i = 0; _pinnedCpusCount > 0 && i < _workersCount; i++)
+		_workers[i]._cpu = cpus[i % _pinnedCpusCount];
+
+	free(cpus);
+}
+
+/** Destructor */
+ASDProjectParallelTimeTester::~ASDProjectParallelTimeTester()
+{
+	delete[] _workers;
+}
+
+/**
+* Measures the given graphs using all the threads and fills 'measurements', which must contain tasksCount elements, in the order of the tasks.
+* A line is written to 'progress' when a graph is measured. Returns the number of graphs that were measured
+*/
+int ASDProjectParallelTimeTester::MeasureGraphs(const GraphTask* tasks, int tasksCount, const Settings& settings, GraphMeasurement* measurements, std::ostream& progress)
+{
+	_tasks = tasks;
+	_tasksCount = tasksCount;
+	_measurements = measurements;
+	_settings = &settings;
+	_startedTasksCount = 0;
+	_completedTasksCount = 0;
+	_progress = &progress;
+
+	// Every worker has its own thread, so that the calling thread isn't pinned
+	std::thread* threads = new std::thread[_workersCount];
+
+	for (int i = 0; i < _workersCount; i++)
+		threads[i] = std::thread(&ASDProjectParallelTimeTester::RunWorker, this, i);
+
+	for (int i = 0; i < _workersCount; i++)
+		threads[i].join();
+
+	delete[] threads;
+
+	int measuredCount = 0;
+
+	for (int i = 0; i < tasksCount; i++)
+		measuredCount += measurements[i]._valid ? 1 : 0;
+
+	_tasks = nullptr;
+	_measurements = nullptr;
+	_settings = nullptr;
+	_progress = nullptr;
+
+	return measuredCount;
+}
+
+/**
+* Loads or generates the graph of the given task. The random graph is generated with the RandomGenerator of the calling thread
+* seed: set to the seed the random graph was generated from, -1 for the graph files
+*/
+bool ASDProjectParallelTimeTester::PrepareGraph(const GraphTask& task, Graph& graph, double& seed)
+{
+	seed = -1.0;
+
+	if (!task._inputFilePath.empty())
+		return LoadGraph(task._inputFilePath, graph);
+
+	if (task._seed >= 0.0)
+		RandomGenerator::SetSeed(task._seed);
+
+	seed = RandomGenerator::GetSeed();
+
+	graph.SetName(task._graphName, false);
+
+	return RandomGraphGenerator::CreateRandomGraph(task._numberOfNodes, task._edgeChance, graph);
+}
+
+/** Loads the DOT or binary graph file at the given path */
+bool ASDProjectParallelTimeTester::LoadGraph(const std::string& filePath, Graph& graph)
+{
+	if (BinaryGraphReader::IsBinaryGraphFile(filePath))
+		return BinaryGraphReader::ReadFile(graph, filePath);
+
+	std::ifstream inputFile(filePath);
+	if (!inputFile.is_open())
+	{
+		std::cerr << "Cannot open the input graph " << filePath << std::endl;
+		return false;
+	}
+
+	return DotParser::Parse(graph, ASDProjectSolver::ReadFile(inputFile));
+}
+
+/**
+* Measures the given graph on the calling thread and fills the times, the statistics and the sizes of 'measurement'
+* performanceCounters: the open counters of the calling thread read during the measurement, or nullptr
+*/
+void ASDProjectParallelTimeTester::MeasureGraph(const Graph& graph, const Settings& settings, ASDProjectPerformanceCounters* performanceCounters, GraphMeasurement& measurement)
+{
+	// Only the robust engine reads the counters
+	bool readCounters = settings._readCounters && !settings._classicEngine && performanceCounters != nullptr;
+
+	ASDProjectTimeTester::SetPerformanceCounters(readCounters ? performanceCounters : nullptr);
+
+	double* cpuTime = settings._measureCpuTime ? &measurement._cpuTime : nullptr;
+	ASDProjectTimeTester::PhaseTimes* phaseTimes = settings._measurePhases ? &measurement._phaseTimes : nullptr;
+
+	if (settings._classicEngine)
+		measurement._time = ASDProjectTimeTester::ComputeAlgorithmTime(graph, settings._iterations, settings._distribution, settings._minimumTime, settings._delta, cpuTime, phaseTimes, &measurement._statistics);
+	else
+		measurement._time = ASDProjectTimeTester::MeasureAlgorithmTime(graph, settings._distribution, settings._minimumTime, settings._delta, settings._measurementOptions, cpuTime, phaseTimes, &measurement._statistics);
+
+	ASDProjectTimeTester::SetPerformanceCounters(nullptr);
+
+	measurement._nodesCount = graph.GetNodes().GetSize();
+	measurement._edgesCount = graph.GetEdges().GetSize();
+	measurement._countersRead = readCounters;
+
+	// The counters that aren't available are negative
+	for (int counter = 0; readCounters && counter < ASDProjectPerformanceCounters::PC_Count; counter++)
+	{
+		if (performanceCounters->IsAvailable((ASDProjectPerformanceCounters::Counter)counter))
+			continue;
+
+		measurement._statistics._counters[counter] = -1.0;
+
+		for (int phase = 0; settings._measurePhases && phase < ASDProjectSolverProfiler::P_Count; phase++)
+			measurement._phaseTimes._counters[phase][counter] = -1.0;
+	}
+}
+
+/** Loop of a thread: pins the thread, opens its counters and measures the graphs until there are none left */
+void ASDProjectParallelTimeTester::RunWorker(int workerIndex)
+{
+	Worker& worker = _workers[workerIndex];
+
+	if (worker._cpu >= 0 && !ASDProjectTimeTester::PinCurrentThread(worker._cpu))
+		worker._cpu = -1;
+
+	// The counters have to be opened by the thread they count
+	std::string countersError = "";
+	worker._countersOpened = _settings->_readCounters && worker._performanceCounters.Open(countersError);
+
+	int taskIndex = -1;
+
+	while ((taskIndex = GetNextTask()) >= 0)
+	{
+		const GraphTask& task = _tasks[taskIndex];
+		GraphMeasurement& measurement = _measurements[taskIndex];
+		Graph graph;
+
+		measurement = GraphMeasurement();
+		measurement._threadIndex = workerIndex;
+		measurement._cpu = worker._cpu;
+		measurement._valid = PrepareGraph(task, graph, measurement._seed);
+
+		if (measurement._valid)
+			MeasureGraph(graph, *_settings, worker._countersOpened ? &worker._performanceCounters : nullptr, measurement);
+
+		std::lock_guard<std::mutex> lock(_tasksMutex);
+
+		_completedTasksCount++;
+
+		*_progress << "[" << _completedTasksCount << "/" << _tasksCount << "] Graph " << task._graphName << (measurement._valid ? " measured" : " not valid") << " by thread " << workerIndex;
+		if (worker._cpu >= 0)
+			*_progress << " on CPU " << worker._cpu;
+		if (measurement._valid)
+			*_progress << ": " << measurement._time << " seconds";
+		*_progress << std::endl;
+	}
+
+	worker._performanceCounters.Close();
+	worker._countersOpened = false;
+}
+
+/** Returns the index of the next graph to measure, or -1 if there are none left */
+int ASDProjectParallelTimeTester::GetNextTask()
+{
+	std::lock_guard<std::mutex> lock(_tasksMutex);
+
+	if (_startedTasksCount >= _tasksCount)
+		return -1;
+
+	// The graphs are taken from the last one: the sweeps list the biggest graphs last, and starting from them keeps all the threads busy until the end
+	return _tasksCount - 1 - _startedTasksCount++;
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "ASDProjectPerformanceCounters.h"
+
+#include <cstring>
+#include <cerrno>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+/** Default constructor */
+ASDProjectPerformanceCounters::ASDProjectPerformanceCounters()
+{
+	for (int counter = 0; counter < PC_Count; counter++)
+		_descriptors[counter] = -1;
+}
+
+/** Destructor */
+ASDProjectPerformanceCounters::~ASDProjectPerformanceCounters()
+{
+	Close();
+}
+
+/**
+* Opens and starts all the counters. Returns false if none of them is available, setting 'error' to the reason
+*/
+bool ASDProjectPerformanceCounters::Open(std::string& error)
+{
+	Close();
+
+#ifdef __linux__
+	// The type and the configuration of the event of every counter
+	static const unsigned int types[PC_Count] = { PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE };
+	static const unsigned long long configs[PC_Count] =
+	{
+		PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+		PERF_COUNT_HW_CACHE_MISSES,
+		PERF_COUNT_HW_BRANCH_MISSES
+	};
+
+	int lastError = 0;
+
+	for (int counter = 0; counter < PC_Count; counter++)
+	{
+		perf_event_attr attributes;
+		memset(&attributes, 0, sizeof(attributes));
+
+		attributes.size = sizeof(attributes);
+		attributes.type = types[counter];
+		attributes.config = configs[counter];
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+		attributes.inherit = 1;
+		attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		// All the threads of this process on any CPU
+		_descriptors[counter] = (int)syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+
+		if (_descriptors[counter] < 0)
+			lastError = errno;
+	}
+
+	if (IsAnyAvailable())
+		return true;
+
+	error = std::string("perf_event_open failed: ") + strerror(lastError);
+
+	if (lastError == EACCES || lastError == EPERM)
+		error += " (check /proc/sys/kernel/perf_event_paranoid)";
+
+	return false;
+#else
+	error = "the performance counters are available only on Linux";
+	return false;
+#endif
+}
+
+/** Closes all the counters */
+void ASDProjectPerformanceCounters::Close()
+{
+	for (int counter = 0; counter < PC_Count; counter++)
+	{
+#ifdef __linux__
+		if (_descriptors[counter] >= 0)
+			close(_descriptors[counter]);
+#endif
+
+		_descriptors[counter] = -1;
+	}
+}
+
+/** Returns true if at least one counter is available */
+bool ASDProjectPerformanceCounters::IsAnyAvailable() const
+{
+	for (int counter = 0; counter < PC_Count; counter++)
+	{
+		if (_descriptors[counter] >= 0)
+			return true;
+	}
+
+	return false;
+}
+
+/** Returns the name of the given counter, used in the reports */
+const char* ASDProjectPerformanceCounters::GetCounterName(Counter counter)
+{
+	switch (counter)
+	{
+	case PC_Cycles:
+		return "cycles";
+	case PC_Instructions:
+		return "instructions";
+	case PC_L1DataMisses:
+		return "l1d_misses";
+	case PC_LastLevelCacheMisses:
+		return "llc_misses";
+	case PC_BranchMisses:
+		return "branch_misses";
+	case PC_Count:
+		break;
+	}
+
+	return "";
+}
+
+/** Stores the current values of the counters into 'values', which must contain PC_Count elements. The unavailable counters are 0 */
+void ASDProjectPerformanceCounters::Read(long long* values) const
+{
+	for (int counter = 0; counter < PC_Count; counter++)
+	{
+		values[counter] = 0;
+
+#ifdef __linux__
+		if (_descriptors[counter] < 0)
+			continue;
+
+		// The value, the time the counter was enabled and the time it was running
+		unsigned long long data[3];
+
+		if (read(_descriptors[counter], data, sizeof(data)) != (ssize_t)sizeof(data))
+			continue;
+
+		// Scale the value if the counter shared the hardware with other ones
+		if (data[2] > 0 && data[2] < data[1])
+			values[counter] = (long long)((double)data[0] * ((double)data[1] / (double)data[2]));
+		else
+			values[counter] = (long long)data[0];
+#endif
+	}
+}
+
+/**
+* Reader of the counters for ASDProjectSolverProfiler::SetCountersReader. 'context' is the instance to read.
+* Fills the first PC_Count elements of 'values'
+*/
+void ASDProjectPerformanceCounters::ReadCounters(void* context, long long* values)
+{
+	static_assert(PC_Count <= ASDProjectSolverProfiler::MaxCountersCount, "The profiler can't store all the performance counters");
+
+	((const ASDProjectPerformanceCounters*)context)->Read(values);
+
+	for (int counter = PC_Count; counter < ASDProjectSolverProfiler::MaxCountersCount; counter++)
+		values[counter] = 0;
+}
\ No newline at end of file
@@ -3,6 +3,41 @@
 
 #include <ctime>
 #include <cmath>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <time.h>
+#include <sys/resource.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+ASDProjectTimeTester::TimerType ASDProjectTimeTester::_timerType = ASDProjectTimeTester::TT_SteadyClock;
+thread_local ASDProjectPerformanceCounters* ASDProjectTimeTester::_performanceCounters = nullptr;
+bool ASDProjectTimeTester::_threadCpuTime = false;
+
+/** Returns the name of the given clock, used in the reports */
+const char* ASDProjectTimeTester::GetTimerTypeName(TimerType timerType)
+{
+	switch (timerType)
+	{
+	case TT_SteadyClock:
+		return "steady";
+	case TT_Monotonic:
+		return "monotonic";
+	case TT_Clock:
+		return "clock";
+	}
+
+	return "";
+}
 
 /**
 * Method that returns a double precision floating point time value.
@@ -16,9 +51,119 @@
 */
 double ASDProjectTimeTester::GetTime()
 {
+	switch (_timerType)
+	{
+	case TT_Clock:
+		return ((double)clock()) / CLOCKS_PER_SEC;
+
+#if !defined(_WIN32) && defined(CLOCK_MONOTONIC)
+	case TT_Monotonic:
+	{
+		timespec time;
+		clock_gettime(CLOCK_MONOTONIC, &time);
+
+		return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+	}
+#endif
+
+	default:
+		return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+}
+
+/**
+* Returns the CPU time used by the process, in seconds. It's measured with clock_gettime(CLOCK_PROCESS_CPUTIME_ID)
+* where available, otherwise with clock(). Unlike the wall time it adds the time of all the threads.
+* After SetThreadCpuTime(true) it's the CPU time of the calling thread, measured with clock_gettime(CLOCK_THREAD_CPUTIME_ID)
+*/
+double ASDProjectTimeTester::GetCpuTime()
+{
+#if !defined(_WIN32) && defined(CLOCK_THREAD_CPUTIME_ID)
+	if (_threadCpuTime)
+	{
+		timespec threadTime;
+
+		if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &threadTime) == 0)
+			return (double)threadTime.tv_sec + (double)threadTime.tv_nsec * 1e-9;
+	}
+#endif
+
+#if !defined(_WIN32) && defined(CLOCK_PROCESS_CPUTIME_ID)
+	timespec time;
+
+	if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) == 0)
+		return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+#endif
+
 	return ((double)clock()) / CLOCKS_PER_SEC;
 }
 
+/**
+* Fills 'cpus' with the indices of the CPUs that the process is allowed to run on, at most maximumCpusCount of them, and returns their number.
+* Returns 0 where they can't be read (only Linux is supported)
+*/
+int ASDProjectTimeTester::GetAvailableCpus(int* cpus, int maximumCpusCount)
+{
+	int cpusCount = 0;
+
+#ifdef __linux__
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+
+	if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+		return 0;
+
+	for (int cpu = 0; cpu < CPU_SETSIZE && cpusCount < maximumCpusCount; cpu++)
+	{
+		if (CPU_ISSET(cpu, &cpuSet))
+			cpus[cpusCount++] = cpu;
+	}
+#else
+	(void)cpus;
+	(void)maximumCpusCount;
+#endif
+
+	return cpusCount;
+}
+
+/** Binds the calling thread to the CPU with the given index, so that it isn't moved by the scheduler. Returns false where it isn't supported (only Linux is) */
+bool ASDProjectTimeTester::PinCurrentThread(int cpu)
+{
+#ifdef __linux__
+	if (cpu < 0 || cpu >= CPU_SETSIZE)
+		return false;
+
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	CPU_SET(cpu, &cpuSet);
+
+	return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+	(void)cpu;
+	return false;
+#endif
+}
+
+/** Returns the peak resident memory of the process, in bytes, or 0 where it can't be read */
+long long ASDProjectTimeTester::GetPeakMemory()
+{
+#ifndef _WIN32
+	rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+	{
+#ifdef __APPLE__
+		// ru_maxrss is in bytes on macOS and in kilobytes elsewhere
+		return (long long)usage.ru_maxrss;
+#else
+		return (long long)usage.ru_maxrss * 1024;
+#endif
+	}
+#endif
+
+	return 0;
+}
+
 /** Returns the granularity of the system (the minimum measurable time span) */
 double ASDProjectTimeTester::GetGranularity()
 {
@@ -144,24 +289,35 @@ int ASDProjectTimeTester::GetRepetitionsCountForWholeAlgorithm(const Graph& inpu
 /**
 * Computes the average time that the algorithm takes to give a result,
 * stripping away the time needed to prepare the input
+* cpuTime: if not nullptr, it's set to the average CPU time measured during the same runs
+* phaseTimes: if not nullptr, it's filled with the average time of every phase of the solver during the same runs. It must contain ASDProjectSolverProfiler::P_Count elements
+* repetitionsCount: if not nullptr, it's set to the number of runs of the solver that were timed
 */
-double ASDProjectTimeTester::ComputeAverageCleanTime(const Graph& inputGraph, double minimumTime)
+double ASDProjectTimeTester::ComputeAverageCleanTime(const Graph& inputGraph, double minimumTime, double* cpuTime, double* phaseTimes, int* repetitionsCount)
 {
 	int preparationRepetitions = GetRepetitionsCountForPreparation(inputGraph, minimumTime);
 	int algorithmRepetitions = GetRepetitionsCountForWholeAlgorithm(inputGraph, minimumTime);
 
 	double t0 = 0;
 	double t1 = 0;	
+	double c0 = 0;
+	double c1 = 0;
 	
 	// Compute the time to do the preparation
+	c0 = (cpuTime != nullptr) ? GetCpuTime() : 0.0;
 	t0 = GetTime();
 	for (int i = 0; i < preparationRepetitions; i++)
 		Graph tempResult = inputGraph;
 	t1 = GetTime();
+	c1 = (cpuTime != nullptr) ? GetCpuTime() : 0.0;
 
 	double preparationTime = t1 - t0;
+	double preparationCpuTime = c1 - c0;
 
 	// Compute the time to run the whole algorithm
+	ASDProjectSolverProfiler::Reset();
+
+	c0 = (cpuTime != nullptr) ? GetCpuTime() : 0.0;
 	t0 = GetTime();
 	for (int i = 0; i < algorithmRepetitions; i++)
 	{
@@ -169,8 +325,24 @@ double ASDProjectTimeTester::ComputeAverageCleanTime(const Graph& inputGraph, do
 		ASDProjectSolver::ProcessData(inputGraph, tempResult);
 	}
 	t1 = GetTime();
+	c1 = (cpuTime != nullptr) ? GetCpuTime() : 0.0;
 
 	double algorithmTime = t1 - t0;
+	double algorithmCpuTime = c1 - c0;
+
+	if (phaseTimes != nullptr)
+	{
+		ASDProjectSolverProfiler::GetPhaseTimes(phaseTimes);
+
+		for (int phase = 0; phase < ASDProjectSolverProfiler::P_Count; phase++)
+			phaseTimes[phase] /= algorithmRepetitions;
+	}
+
+	if (repetitionsCount != nullptr)
+		*repetitionsCount = algorithmRepetitions;
+
+	if (cpuTime != nullptr)
+		*cpuTime = (algorithmCpuTime / algorithmRepetitions) - (preparationCpuTime / preparationRepetitions);
 
 	// Return the average time to run just the algorithm, stripping away the preparation time
 	return (algorithmTime / algorithmRepetitions) - (preparationTime / preparationRepetitions);
@@ -183,32 +355,621 @@ double ASDProjectTimeTester::ComputeAverageCleanTime(const Graph& inputGraph, do
 * za: normal distribution
 * minimumTime: the minimun time that the system needs to give a valid result
 * delta: maximum error from the expected result
+* cpuTime: if not nullptr, it's set to the average CPU time measured during the same runs. Only the time of the chosen clock is used to check the error
+* phaseTimes: if not nullptr, it's filled with the mean and the standard deviation of the time of every phase of the solver over the samples
+* statistics: if not nullptr, it's filled with the number of samples, their standard deviation and the confidence interval of the result
 */
-double ASDProjectTimeTester::ComputeAlgorithmTime(const Graph& inputGraph, int n, double za, double minimumTime, double delta)
+double ASDProjectTimeTester::ComputeAlgorithmTime(const Graph& inputGraph, int n, double za, double minimumTime, double delta, double* cpuTime, PhaseTimes* phaseTimes, TimeStatistics* statistics)
 {
 	double result = 0;
 	double time = 0;
+	double totalCpuTime = 0;
 	double sumSquared = 0;
 	int iterationsCount = 0;
+	int repetitionsCount = 0;
+	double s = 0;
 	double localDelta = delta;
 
+	double samplePhaseTimes[ASDProjectSolverProfiler::P_Count] = { };
+	double phaseTimesSums[ASDProjectSolverProfiler::P_Count] = { };
+	double phaseTimesSumsSquared[ASDProjectSolverProfiler::P_Count] = { };
+
+	// The samples are kept only to compute the median and the percentiles
+	double* samples = nullptr;
+
 	do
 	{
+		if (statistics != nullptr)
+			samples = (double*)realloc(samples, sizeof(double) * (iterationsCount + n));
+
 		for (int i = 0; i < n; i++)
 		{
-			double m = ComputeAverageCleanTime(inputGraph, minimumTime);
+			double c = 0;
+			int r = 0;
+			double m = ComputeAverageCleanTime(inputGraph, minimumTime, (cpuTime != nullptr) ? &c : nullptr, (phaseTimes != nullptr) ? samplePhaseTimes : nullptr, &r);
 			time += m;
+			repetitionsCount += r;
+
+			if (samples != nullptr)
+				samples[iterationsCount + i] = m;
+			totalCpuTime += c;
 			sumSquared += (m * m);
+
+			for (int phase = 0; phase < ASDProjectSolverProfiler::P_Count; phase++)
+			{
+				phaseTimesSums[phase] += samplePhaseTimes[phase];
+				phaseTimesSumsSquared[phase] += samplePhaseTimes[phase] * samplePhaseTimes[phase];
+			}
 		}
 
 		iterationsCount += n;
 		result = time / ((double)iterationsCount);
 
-		double s = sqrt(sumSquared / ((double)iterationsCount) - (result * result));
+		double variance = sumSquared / ((double)iterationsCount) - (result * result);
+		s = (variance > 0.0) ? sqrt(variance) : 0.0;
 
 		localDelta = 1.0 / sqrt((double)iterationsCount) * za * s;
 
 	} while (localDelta >= delta);
 
+	if (cpuTime != nullptr)
+		*cpuTime = totalCpuTime / ((double)iterationsCount);
+
+	if (statistics != nullptr)
+	{
+		statistics->_samplesCount = iterationsCount;
+		statistics->_repetitionsCount = repetitionsCount;
+		statistics->_standardDeviation = s;
+		statistics->_confidenceInterval = localDelta;
+		statistics->_rejectedSamplesCount = 0;
+		statistics->_hasCounters = false;
+		memset(statistics->_counters, 0, sizeof(statistics->_counters));
+
+		// All the samples are valid
+		unsigned char* validSamples = (unsigned char*)malloc(sizeof(unsigned char) * iterationsCount);
+		double* sortBuffer = (double*)malloc(sizeof(double) * iterationsCount);
+
+		for (int i = 0; i < iterationsCount; i++)
+			validSamples[i] = 1;
+
+		ComputeOrderStatistics(samples, iterationsCount, validSamples, sortBuffer, *statistics);
+
+		free(validSamples);
+		free(sortBuffer);
+		free(samples);
+	}
+
+	if (phaseTimes != nullptr)
+	{
+		// The performance counters are read only by MeasureAlgorithmTime
+		memset(phaseTimes->_counters, 0, sizeof(phaseTimes->_counters));
+
+		for (int phase = 0; phase < ASDProjectSolverProfiler::P_Count; phase++)
+		{
+			double mean = phaseTimesSums[phase] / ((double)iterationsCount);
+			double variance = phaseTimesSumsSquared[phase] / ((double)iterationsCount) - (mean * mean);
+
+			phaseTimes->_means[phase] = mean;
+			phaseTimes->_standardDeviations[phase] = (variance > 0.0) ? sqrt(variance) : 0.0;
+		}
+	}
+
 	return result;
+}
+
+/**
+* Fits the power law y = a * x^exponent to the given points with a least squares line on log(x) and log(y), so that the exponent is the empirical
+* complexity of a measured time. The points with a value that isn't positive are ignored.
+* rSquared: the coefficient of determination of the fit on the logarithms
+* Returns false if less than two points with different x can be used
+*/
+bool ASDProjectTimeTester::FitPowerLaw(const double* x, const double* y, int count, double& exponent, double& rSquared)
+{
+	double sumX = 0;
+	double sumY = 0;
+	double sumXX = 0;
+	double sumXY = 0;
+	double sumYY = 0;
+	int pointsCount = 0;
+
+	for (int i = 0; i < count; i++)
+	{
+		if (x[i] <= 0.0 || y[i] <= 0.0)
+			continue;
+
+		double logX = log(x[i]);
+		double logY = log(y[i]);
+
+		sumX += logX;
+		sumY += logY;
+		sumXX += logX * logX;
+		sumXY += logX * logY;
+		sumYY += logY * logY;
+		pointsCount++;
+	}
+
+	if (pointsCount < 2)
+		return false;
+
+	// Centered sums of squares and products
+	double sxx = sumXX - sumX * sumX / pointsCount;
+	double sxy = sumXY - sumX * sumY / pointsCount;
+	double syy = sumYY - sumY * sumY / pointsCount;
+
+	if (sxx <= 1e-12)
+		return false;
+
+	exponent = sxy / sxx;
+	rSquared = (syy > 0.0) ? (sxy * sxy) / (sxx * syy) : 1.0;
+
+	return true;
+}
+
+/**
+* Fits the power law y = a * x1^exponent1 * x2^exponent2 to the given points with a least squares plane on the logarithms,
+* used to separate the effect of the nodes and of the edges when both change. The points with a value that isn't positive are ignored.
+* Returns false if less than three points can be used or if log(x1) and log(x2) are collinear
+*/
+bool ASDProjectTimeTester::FitPowerLaw(const double* x1, const double* x2, const double* y, int count, double& exponent1, double& exponent2, double& rSquared)
+{
+	double sum1 = 0;
+	double sum2 = 0;
+	double sumY = 0;
+	double sum11 = 0;
+	double sum22 = 0;
+	double sum12 = 0;
+	double sum1Y = 0;
+	double sum2Y = 0;
+	double sumYY = 0;
+	int pointsCount = 0;
+
+	for (int i = 0; i < count; i++)
+	{
+		if (x1[i] <= 0.0 || x2[i] <= 0.0 || y[i] <= 0.0)
+			continue;
+
+		double log1 = log(x1[i]);
+		double log2 = log(x2[i]);
+		double logY = log(y[i]);
+
+		sum1 += log1;
+		sum2 += log2;
+		sumY += logY;
+		sum11 += log1 * log1;
+		sum22 += log2 * log2;
+		sum12 += log1 * log2;
+		sum1Y += log1 * logY;
+		sum2Y += log2 * logY;
+		sumYY += logY * logY;
+		pointsCount++;
+	}
+
+	if (pointsCount < 3)
+		return false;
+
+	// Solve the normal equations on the centered sums with Cramer's rule
+	double s11 = sum11 - sum1 * sum1 / pointsCount;
+	double s22 = sum22 - sum2 * sum2 / pointsCount;
+	double s12 = sum12 - sum1 * sum2 / pointsCount;
+	double s1Y = sum1Y - sum1 * sumY / pointsCount;
+	double s2Y = sum2Y - sum2 * sumY / pointsCount;
+	double sYY = sumYY - sumY * sumY / pointsCount;
+	double determinant = s11 * s22 - s12 * s12;
+
+	// The points must not lie on a line of the (log(x1), log(x2)) plane
+	if (determinant <= 1e-9 * s11 * s22 || s11 <= 1e-12 || s22 <= 1e-12)
+		return false;
+
+	exponent1 = (s1Y * s22 - s2Y * s12) / determinant;
+	exponent2 = (s2Y * s11 - s1Y * s12) / determinant;
+	rSquared = (sYY > 0.0) ? (exponent1 * s1Y + exponent2 * s2Y) / sYY : 1.0;
+
+	return true;
+}
+
+/**
+* Computes the time needed to run the algorithm given, calibrating the number of runs of every sample only once.
+* After the warmup runs the number of runs needed to measure at least minimumTime is chosen from the time of a warmup run, and the time of the
+* preparation is measured once. Then one sample at a time is collected until the confidence interval of the mean of the samples that aren't
+* outliers is smaller than delta (or the maximum number of samples is reached). Returns the mean of the samples that aren't outliers
+* inputGraph: the input graph
+* za: normal distribution
+* minimumTime: the minimun time that the system needs to give a valid result
+* delta: maximum error from the expected result
+* options: the number of warmup runs and of samples and the threshold of the outliers
+* cpuTime: if not nullptr, it's set to the average CPU time of the samples that aren't outliers
+* phaseTimes: if not nullptr, it's filled with the mean and the standard deviation of the time of every phase of the solver over the samples that aren't outliers
+* statistics: if not nullptr, it's filled with the statistics of the samples, including the median and the percentiles, and with the mean of the performance counters
+*/
+double ASDProjectTimeTester::MeasureAlgorithmTime(const Graph& inputGraph, double za, double minimumTime, double delta, const MeasurementOptions& options, double* cpuTime, PhaseTimes* phaseTimes, TimeStatistics* statistics)
+{
+	int warmupRunsCount = (options._warmupRunsCount > 0) ? options._warmupRunsCount : 1;
+	int minimumSamplesCount = (options._minimumSamplesCount > 2) ? options._minimumSamplesCount : 2;
+	int maximumSamplesCount = (options._maximumSamplesCount > minimumSamplesCount) ? options._maximumSamplesCount : minimumSamplesCount;
+
+	// Warmup: the first runs fill the caches and the allocator and tell how long a run takes
+	double t0 = GetTime();
+	for (int i = 0; i < warmupRunsCount; i++)
+	{
+		Graph tempResult;
+		ASDProjectSolver::ProcessData(inputGraph, tempResult);
+	}
+	double t1 = GetTime();
+
+	double runTime = (t1 - t0) / warmupRunsCount;
+
+	// Calibrate only once. A run that takes at least minimumTime is a sample by itself, while the shorter ones are calibrated by
+	// GetRepetitionsCountForWholeAlgorithm, whose cost is only a few times minimumTime for them
+	int repetitions = (runTime < minimumTime) ? GetRepetitionsCountForWholeAlgorithm(inputGraph, minimumTime) : 1;
+
+	// The preparation (a copy of the graph) is much faster than the solver, so its time is measured once and subtracted from every sample
+	int preparationRepetitions = GetRepetitionsCountForPreparation(inputGraph, minimumTime);
+
+	static const int countersCount = ASDProjectPerformanceCounters::PC_Count;
+	long long counters0[ASDProjectSolverProfiler::MaxCountersCount] = { };
+	long long counters1[ASDProjectSolverProfiler::MaxCountersCount] = { };
+
+	if (_performanceCounters != nullptr)
+		_performanceCounters->Read(counters0);
+
+	double c0 = (cpuTime != nullptr) ? GetCpuTime() : 0.0;
+	t0 = GetTime();
+	for (int i = 0; i < preparationRepetitions; i++)
+		Graph tempResult = inputGraph;
+	t1 = GetTime();
+	double c1 = (cpuTime != nullptr) ? GetCpuTime() : 0.0;
+
+	if (_performanceCounters != nullptr)
+		_performanceCounters->Read(counters1);
+
+	double preparationTime = (t1 - t0) / preparationRepetitions;
+	double preparationCpuTime = (c1 - c0) / preparationRepetitions;
+	double preparationCounters[countersCount];
+
+	for (int counter = 0; counter < countersCount; counter++)
+		preparationCounters[counter] = (double)(counters1[counter] - counters0[counter]) / preparationRepetitions;
+
+	// The time, the CPU time and the time of the phases of every sample
+	double* samples = (double*)malloc(sizeof(double) * maximumSamplesCount);
+	double* cpuSamples = (double*)malloc(sizeof(double) * maximumSamplesCount);
+	double* phaseSamples = (phaseTimes != nullptr) ? (double*)malloc(sizeof(double) * maximumSamplesCount * ASDProjectSolverProfiler::P_Count) : nullptr;
+	double* counterSamples = (_performanceCounters != nullptr) ? (double*)malloc(sizeof(double) * maximumSamplesCount * countersCount) : nullptr;
+	double* phaseCounterSamples = (_performanceCounters != nullptr && phaseTimes != nullptr) ? (double*)malloc(sizeof(double) * maximumSamplesCount * ASDProjectSolverProfiler::P_Count * countersCount) : nullptr;
+	long long* phaseCounters = (phaseCounterSamples != nullptr) ? (long long*)malloc(sizeof(long long) * ASDProjectSolverProfiler::P_Count * ASDProjectSolverProfiler::MaxCountersCount) : nullptr;
+	unsigned char* validSamples = (unsigned char*)malloc(sizeof(unsigned char) * maximumSamplesCount);
+	double* sortBuffer = (double*)malloc(sizeof(double) * maximumSamplesCount);
+
+	int samplesCount = 0;
+	int validSamplesCount = 0;
+	double mean = 0;
+	double s = 0;
+	double localDelta = delta;
+
+	// The phases read the counters only while the samples are collected
+	if (phaseCounterSamples != nullptr)
+		ASDProjectSolverProfiler::SetCountersReader(ASDProjectPerformanceCounters::ReadCounters, _performanceCounters);
+
+	do
+	{
+		ASDProjectSolverProfiler::Reset();
+
+		if (counterSamples != nullptr)
+			_performanceCounters->Read(counters0);
+
+		c0 = (cpuTime != nullptr) ? GetCpuTime() : 0.0;
+		t0 = GetTime();
+		for (int i = 0; i < repetitions; i++)
+		{
+			Graph tempResult;
+			ASDProjectSolver::ProcessData(inputGraph, tempResult);
+		}
+		t1 = GetTime();
+		c1 = (cpuTime != nullptr) ? GetCpuTime() : 0.0;
+
+		if (counterSamples != nullptr)
+			_performanceCounters->Read(counters1);
+
+		samples[samplesCount] = (t1 - t0) / repetitions - preparationTime;
+		cpuSamples[samplesCount] = (c1 - c0) / repetitions - preparationCpuTime;
+
+		if (counterSamples != nullptr)
+		{
+			for (int counter = 0; counter < countersCount; counter++)
+				counterSamples[samplesCount * countersCount + counter] = (double)(counters1[counter] - counters0[counter]) / repetitions - preparationCounters[counter];
+		}
+
+		if (phaseCounterSamples != nullptr)
+		{
+			ASDProjectSolverProfiler::GetPhaseCounters(phaseCounters);
+
+			for (int phase = 0; phase < ASDProjectSolverProfiler::P_Count; phase++)
+			{
+				for (int counter = 0; counter < countersCount; counter++)
+					phaseCounterSamples[(samplesCount * ASDProjectSolverProfiler::P_Count + phase) * countersCount + counter] = (double)phaseCounters[phase * ASDProjectSolverProfiler::MaxCountersCount + counter] / repetitions;
+			}
+		}
+
+		if (phaseSamples != nullptr)
+		{
+			double* samplePhaseTimes = phaseSamples + samplesCount * ASDProjectSolverProfiler::P_Count;
+			ASDProjectSolverProfiler::GetPhaseTimes(samplePhaseTimes);
+
+			for (int phase = 0; phase < ASDProjectSolverProfiler::P_Count; phase++)
+				samplePhaseTimes[phase] /= repetitions;
+		}
+
+		samplesCount++;
+
+		if (samplesCount < minimumSamplesCount)
+			continue;
+
+		// The error is checked only on the samples that aren't outliers
+		validSamplesCount = MarkValidSamples(samples, samplesCount, options._outliersThreshold, validSamples, sortBuffer);
+
+		double sum = 0;
+		double sumSquared = 0;
+
+		for (int i = 0; i < samplesCount; i++)
+		{
+			if (validSamples[i])
+			{
+				sum += samples[i];
+				sumSquared += samples[i] * samples[i];
+			}
+		}
+
+		mean = sum / validSamplesCount;
+
+		double variance = sumSquared / validSamplesCount - (mean * mean);
+		s = (variance > 0.0) ? sqrt(variance) : 0.0;
+
+		localDelta = 1.0 / sqrt((double)validSamplesCount) * za * s;
+
+	} while (samplesCount < minimumSamplesCount || (localDelta >= delta && samplesCount < maximumSamplesCount));
+
+	if (phaseCounterSamples != nullptr)
+		ASDProjectSolverProfiler::SetCountersReader(nullptr, nullptr);
+
+	if (cpuTime != nullptr)
+	{
+		double totalCpuTime = 0;
+
+		for (int i = 0; i < samplesCount; i++)
+		{
+			if (validSamples[i])
+				totalCpuTime += cpuSamples[i];
+		}
+
+		*cpuTime = totalCpuTime / validSamplesCount;
+	}
+
+	if (phaseTimes != nullptr)
+	{
+		for (int phase = 0; phase < ASDProjectSolverProfiler::P_Count; phase++)
+		{
+			double sum = 0;
+			double sumSquared = 0;
+
+			for (int i = 0; i < samplesCount; i++)
+			{
+				if (validSamples[i])
+				{
+					double phaseTime = phaseSamples[i * ASDProjectSolverProfiler::P_Count + phase];
+					sum += phaseTime;
+					sumSquared += phaseTime * phaseTime;
+				}
+			}
+
+			double phaseMean = sum / validSamplesCount;
+			double variance = sumSquared / validSamplesCount - (phaseMean * phaseMean);
+
+			phaseTimes->_means[phase] = phaseMean;
+			phaseTimes->_standardDeviations[phase] = (variance > 0.0) ? sqrt(variance) : 0.0;
+
+			for (int counter = 0; counter < countersCount; counter++)
+			{
+				double counterSum = 0;
+
+				for (int i = 0; i < samplesCount && phaseCounterSamples != nullptr; i++)
+				{
+					if (validSamples[i])
+						counterSum += phaseCounterSamples[(i * ASDProjectSolverProfiler::P_Count + phase) * countersCount + counter];
+				}
+
+				phaseTimes->_counters[phase][counter] = counterSum / validSamplesCount;
+			}
+		}
+	}
+
+	if (statistics != nullptr)
+	{
+		statistics->_samplesCount = samplesCount;
+		statistics->_repetitionsCount = samplesCount * repetitions;
+		statistics->_standardDeviation = s;
+		statistics->_confidenceInterval = localDelta;
+		statistics->_rejectedSamplesCount = samplesCount - validSamplesCount;
+		statistics->_hasCounters = counterSamples != nullptr;
+
+		for (int counter = 0; counter < countersCount; counter++)
+		{
+			double counterSum = 0;
+
+			for (int i = 0; i < samplesCount && counterSamples != nullptr; i++)
+			{
+				if (validSamples[i])
+					counterSum += counterSamples[i * countersCount + counter];
+			}
+
+			statistics->_counters[counter] = counterSum / validSamplesCount;
+		}
+
+		ComputeOrderStatistics(samples, samplesCount, validSamples, sortBuffer, *statistics);
+	}
+
+	free(samples);
+	free(cpuSamples);
+	free(phaseSamples);
+	free(counterSamples);
+	free(phaseCounterSamples);
+	free(phaseCounters);
+	free(validSamples);
+	free(sortBuffer);
+
+	return mean;
+}
+
+/**
+* Runs the solver once on the given graph, not timed, counting its allocations with MemoryAccounting, and fills 'usage'.
+* Where the peak resident memory can be reset (Linux) it's the peak of the run, otherwise it's the peak of the process up to the end of the run
+*/
+void ASDProjectTimeTester::MeasureMemoryUsage(const Graph& inputGraph, MemoryUsage& usage)
+{
+	usage._inputFootprint = inputGraph.GetMemoryFootprint();
+	usage._peakResidentOfRun = ResetPeakResidentMemory();
+
+	{
+		Graph tempResult;
+
+		MemoryAccounting::Reset();
+		MemoryAccounting::SetEnabled(true);
+		ASDProjectSolver::ProcessData(inputGraph, tempResult);
+		MemoryAccounting::SetEnabled(false);
+
+		for (int category = 0; category < MemoryAccounting::MC_Count; category++)
+			MemoryAccounting::GetCounters((MemoryAccounting::Category)category, usage._counters[category]);
+
+		usage._resultFootprint = tempResult.GetMemoryFootprint();
+	}
+
+	usage._peakResidentBytes = usage._peakResidentOfRun ? GetPeakResidentMemory() : 0;
+
+	if (usage._peakResidentBytes <= 0)
+	{
+		usage._peakResidentBytes = GetPeakMemory();
+		usage._peakResidentOfRun = false;
+	}
+}
+
+/**
+* Marks with 1 the samples that aren't outliers, the ones whose distance from the median is at most 'threshold' times the
+* median absolute deviation scaled to the standard deviation of a normal distribution. sortBuffer must contain 'count' elements.
+* Returns the number of samples that aren't outliers
+*/
+int ASDProjectTimeTester::MarkValidSamples(const double* samples, int count, double threshold, unsigned char* validSamples, double* sortBuffer)
+{
+	for (int i = 0; i < count; i++)
+		validSamples[i] = 1;
+
+	if (threshold <= 0.0 || count < 3)
+		return count;
+
+	for (int i = 0; i < count; i++)
+		sortBuffer[i] = samples[i];
+
+	std::sort(sortBuffer, sortBuffer + count);
+	double median = GetPercentile(sortBuffer, count, 0.5);
+
+	for (int i = 0; i < count; i++)
+		sortBuffer[i] = fabs(samples[i] - median);
+
+	std::sort(sortBuffer, sortBuffer + count);
+
+	// 1.4826 makes the median absolute deviation of normally distributed samples equal to their standard deviation
+	double limit = threshold * 1.4826 * GetPercentile(sortBuffer, count, 0.5);
+
+	// If more than half of the samples are equal every sample is kept
+	if (limit <= 0.0)
+		return count;
+
+	int validSamplesCount = 0;
+
+	for (int i = 0; i < count; i++)
+	{
+		validSamples[i] = (fabs(samples[i] - median) <= limit) ? 1 : 0;
+		validSamplesCount += validSamples[i];
+	}
+
+	return validSamplesCount;
+}
+
+/** Sets the median, the percentiles, the minimum and the maximum of the statistics from the valid samples */
+void ASDProjectTimeTester::ComputeOrderStatistics(const double* samples, int count, const unsigned char* validSamples, double* sortBuffer, TimeStatistics& statistics)
+{
+	int validSamplesCount = 0;
+
+	for (int i = 0; i < count; i++)
+	{
+		if (validSamples[i])
+			sortBuffer[validSamplesCount++] = samples[i];
+	}
+
+	std::sort(sortBuffer, sortBuffer + validSamplesCount);
+
+	statistics._median = GetPercentile(sortBuffer, validSamplesCount, 0.5);
+	statistics._lowPercentile = GetPercentile(sortBuffer, validSamplesCount, 0.05);
+	statistics._highPercentile = GetPercentile(sortBuffer, validSamplesCount, 0.95);
+	statistics._minimum = (validSamplesCount > 0) ? sortBuffer[0] : 0.0;
+	statistics._maximum = (validSamplesCount > 0) ? sortBuffer[validSamplesCount - 1] : 0.0;
+}
+
+/** Returns the given percentile (in the range [0..1]) of the sorted values, interpolating between the two nearest values */
+double ASDProjectTimeTester::GetPercentile(const double* sortedValues, int count, double percentile)
+{
+	if (count <= 0)
+		return 0.0;
+
+	double position = percentile * (count - 1);
+	int lower = (int)floor(position);
+	int upper = (lower + 1 < count) ? lower + 1 : lower;
+	double fraction = position - lower;
+
+	return sortedValues[lower] + (sortedValues[upper] - sortedValues[lower]) * fraction;
+}
+
+/** Resets the peak resident memory of the process to the current resident memory. Returns false where it isn't supported */
+bool ASDProjectTimeTester::ResetPeakResidentMemory()
+{
+#ifdef __linux__
+	// Writing 5 to clear_refs resets the VmHWM of /proc/self/status (Linux 4.0 and later)
+	FILE* file = fopen("/proc/self/clear_refs", "w");
+
+	if (file == nullptr)
+		return false;
+
+	bool reset = fputs("5", file) >= 0;
+	reset = (fclose(file) == 0) && reset;
+
+	return reset;
+#else
+	return false;
+#endif
+}
+
+/** Returns the peak resident memory of the process since the last call to ResetPeakResidentMemory, in bytes, or 0 where it can't be read */
+long long ASDProjectTimeTester::GetPeakResidentMemory()
+{
+	long long peakBytes = 0;
+
+#ifdef __linux__
+	FILE* file = fopen("/proc/self/status", "r");
+
+	if (file == nullptr)
+		return 0;
+
+	char line[256];
+	long long kiloBytes = 0;
+
+	while (fgets(line, sizeof(line), file) != nullptr)
+	{
+		if (sscanf(line, "VmHWM: %lld kB", &kiloBytes) == 1)
+		{
+			peakBytes = kiloBytes * 1024;
+			break;
+		}
+	}
+
+	fclose(file);
+#endif
+
+	return peakBytes;
 }
\ No newline at end of file
@@ -1,35 +1,125 @@
 #include "Graph.h"
-#include "RandomGraphGenerator.h"
 #include "RandomGenerator.h"
 #include "ASDProjectSolver.h"
 #include "ASDProjectTimeTester.h"
+#include "ASDProjectBenchmarkReport.h"
+#include "ASDProjectParallelTimeTester.h"
 #include "DotWriter.h"
+#include "BinaryGraphWriter.h"
 
 #include <fstream>
 #include <ctime>
+#include <iomanip>
+#include <sstream>
+
+typedef List<std::string> PathsList;
+typedef List<int> RangeValuesList;
 
 void PrintUsage();
-bool ParseArgs(int argc, char *argv[], int& numberOfGraphs, int& numberOfNodes, int& edgeChance, double& seed, double& delta, int& iterations, double& distribution, std::string& generatedGraphsFolderPath, std::string& solutionGraphsFolderPath);
+bool ParseArgs(int argc, char *argv[], int& numberOfGraphs, RangeValuesList& numbersOfNodes, RangeValuesList& edgeChances, double& seed, double& delta, int& iterations, double& distribution, std::string& generatedGraphsFolderPath, std::string& solutionGraphsFolderPath, bool& binaryFormat, PathsList& inputGraphsPaths, ASDProjectTimeTester::TimerType& timerType, bool& measureCpuTime, bool& measurePhases, std::string& jsonReportPath, std::string& csvReportPath, std::string& baselinePath, double& regressionThreshold, bool& classicEngine, ASDProjectTimeTester::MeasurementOptions& measurementOptions, bool& readCounters, bool& measureMemory, int& threadsCount, bool& pinThreads);
+bool SaveGraph(const std::string& filePathWithoutExtension, const Graph& graph, bool binaryFormat);
+std::string GetGraphNameFromPath(const std::string& filePath);
+bool ParseRange(const std::string& value, RangeValuesList& values);
+int* GetRangeValues(const RangeValuesList& values);
+void PrintPhaseTimes(const ASDProjectTimeTester::PhaseTimes& phaseTimes, const ASDProjectPerformanceCounters* performanceCounters);
+void PrintCounters(const double* counters, const ASDProjectPerformanceCounters& performanceCounters);
+void PrintMemoryUsage(const ASDProjectTimeTester::MemoryUsage& usage);
+void PrintScaling(const int* numbersOfNodes, int numbersOfNodesCount, const int* edgeChances, int edgeChancesCount, const double* pointsNodes, const double* pointsEdges, const double* pointsTimes);
 
 int main(int argc, char *argv[])
 {
 	int numberOfGraphs = 1;
-	int numberOfNodes = 10;
-	int edgeChance = 15;
+	RangeValuesList numbersOfNodesList;
+	RangeValuesList edgeChancesList;
 	double seed = 0;
 	double delta = 0.2;
 	int iterations = 7;
 	double distribution = 1.96;
 	std::string generatedGraphsFolderPath = "";
 	std::string solutionGraphsFolderPath = "";
+	bool binaryFormat = false;
+	PathsList inputGraphsPaths;
+	ASDProjectTimeTester::TimerType timerType = ASDProjectTimeTester::TT_SteadyClock;
+	bool measureCpuTime = false;
+	bool measurePhases = false;
+	std::string jsonReportPath = "";
+	std::string csvReportPath = "";
+	std::string baselinePath = "";
+	double regressionThreshold = 5.0;
+	bool classicEngine = false;
+	ASDProjectTimeTester::MeasurementOptions measurementOptions;
+	bool readCounters = false;
+	bool measureMemory = false;
+	int threadsCount = 0;
+	bool pinThreads = true;
 
-	if (!ParseArgs(argc, argv, numberOfGraphs, numberOfNodes, edgeChance, seed, delta, iterations, distribution, generatedGraphsFolderPath, solutionGraphsFolderPath))
+	if (!ParseArgs(argc, argv, numberOfGraphs, numbersOfNodesList, edgeChancesList, seed, delta, iterations, distribution, generatedGraphsFolderPath, solutionGraphsFolderPath, binaryFormat, inputGraphsPaths, timerType, measureCpuTime, measurePhases, jsonReportPath, csvReportPath, baselinePath, regressionThreshold, classicEngine, measurementOptions, readCounters, measureMemory, threadsCount, pinThreads))
 	{
 		PrintUsage();
 		return -1;
 	}
 
-	double edgeChangePercentage = (double)edgeChance / 100.0;
+	// clock() measures the CPU time of the whole process, which adds the times of all the threads
+	if (threadsCount > 0 && timerType == ASDProjectTimeTester::TT_Clock)
+	{
+		std::cerr << "The clock timer can't be used with -threads: it measures the CPU time of all the threads together" << std::endl;
+		return -1;
+	}
+
+	if (measurePhases && !ASDProjectSolverProfiler::IsEnabled())
+	{
+		std::cerr << "The times of the phases can't be measured: the solver was compiled without ASD_PROFILE_SOLVER" << std::endl;
+		measurePhases = false;
+	}
+
+	// The measurements go on without the counters if none of them can be opened
+	ASDProjectPerformanceCounters performanceCounters;
+	std::string countersError = "";
+
+	if (readCounters && classicEngine)
+	{
+		std::cerr << "The performance counters are read only by the robust engine" << std::endl;
+		readCounters = false;
+	}
+
+	if (readCounters && !performanceCounters.Open(countersError))
+	{
+		std::cerr << "The performance counters are not available: " << countersError << std::endl;
+		readCounters = false;
+	}
+
+	for (int counter = 0; readCounters && counter < ASDProjectPerformanceCounters::PC_Count; counter++)
+	{
+		if (!performanceCounters.IsAvailable((ASDProjectPerformanceCounters::Counter)counter))
+			std::cerr << "The performance counter " << ASDProjectPerformanceCounters::GetCounterName((ASDProjectPerformanceCounters::Counter)counter) << " is not available" << std::endl;
+	}
+
+	ASDProjectTimeTester::SetTimerType(timerType);
+	ASDProjectTimeTester::SetThreadCpuTime(threadsCount > 0);
+	measurementOptions._minimumSamplesCount = iterations;
+
+	// The baseline is loaded before the measurements so that a wrong path is found immediately
+	ASDProjectBenchmarkReport baseline;
+
+	if (!baselinePath.empty() && !baseline.LoadCsv(baselinePath))
+		return -1;
+
+	ASDProjectBenchmarkReport report(ASDProjectTimeTester::GetTimerTypeName(timerType), distribution);
+
+	// Every combination of the number of nodes and of the edge chance is a point of the sweep, with numberOfGraphs graphs each
+	int* numbersOfNodes = GetRangeValues(numbersOfNodesList);
+	int* edgeChances = GetRangeValues(edgeChancesList);
+	int numbersOfNodesCount = numbersOfNodesList.GetSize();
+	int edgeChancesCount = edgeChancesList.GetSize();
+	int pointsCount = numbersOfNodesCount * edgeChancesCount;
+	bool sweep = pointsCount > 1;
+
+	// The average number of nodes, number of edges and time of the graphs of every point
+	double* pointsNodes = (double*)calloc(pointsCount > 0 ? pointsCount : 1, sizeof(double));
+	double* pointsEdges = (double*)calloc(pointsCount > 0 ? pointsCount : 1, sizeof(double));
+	double* pointsTimes = (double*)calloc(pointsCount > 0 ? pointsCount : 1, sizeof(double));
+	int* pointsGraphs = (int*)calloc(pointsCount > 0 ? pointsCount : 1, sizeof(int));
+
 	bool saveGeneratedGraphs = generatedGraphsFolderPath.empty() == false;
 	bool saveSolutionGraphs = solutionGraphsFolderPath.empty() == false;
 
@@ -41,51 +131,249 @@ int main(int argc, char *argv[])
 
 	double minimumTime = ASDProjectTimeTester::GetMinimumTime();
 	double totalTime = 0.0;
+	double totalCpuTime = 0.0;
+	int totalNodes = 0;
 	int totalEdges = 0;
+	int testedGraphs = 0;
 
 	if (seed < 0.0)
 		RandomGenerator::SetSeed((double)clock());
 	else if(seed > 0.0)
 		RandomGenerator::SetSeed(seed);
 
-	for (int i = 0; i < numberOfGraphs; i++)
+	// The input graphs are tested first and then the generated ones
+	int inputGraphsCount = inputGraphsPaths.GetSize();
+	int tasksCount = inputGraphsCount + numberOfGraphs * pointsCount;
+	ASDProjectParallelTimeTester::GraphTask* tasks = new ASDProjectParallelTimeTester::GraphTask[tasksCount > 0 ? tasksCount : 1];
+	ASDProjectParallelTimeTester::GraphMeasurement* measurements = new ASDProjectParallelTimeTester::GraphMeasurement[tasksCount > 0 ? tasksCount : 1];
+	int* tasksPoints = (int*)malloc(sizeof(int) * (tasksCount > 0 ? tasksCount : 1));
+
+	// The threads generate every graph from a seed derived from its index, so that the graphs don't depend on the number of threads.
+	// Without threads every graph continues the sequence of random numbers of the previous one, like the seeds of the older reports
+	double baseSeed = RandomGenerator::GetSeed();
+	PathsList::Iterator inputGraphsPathsIt = inputGraphsPaths.Begin();
+
+	for (int i = 0; i < tasksCount; i++)
+	{
+		ASDProjectParallelTimeTester::GraphTask& task = tasks[i];
+		tasksPoints[i] = -1;
+
+		if (i < inputGraphsCount)
+		{
+			task._graphName = GetGraphNameFromPath(*inputGraphsPathsIt);
+			task._inputFilePath = *inputGraphsPathsIt;
+			++inputGraphsPathsIt;
+		}
+		else
+		{
+			int graphIndex = i - inputGraphsCount;
+			int point = graphIndex / numberOfGraphs;
+
+			int numberOfNodes = numbersOfNodes[point / edgeChancesCount];
+			int edgeChance = edgeChances[point % edgeChancesCount];
+
+			// The name of a graph of a sweep tells its point, so that the reports of two sweeps can be compared
+			if (sweep)
+				task._graphName = "N" + std::to_string(numberOfNodes) + "_EC" + std::to_string(edgeChance) + "_G" + std::to_string(graphIndex % numberOfGraphs);
+			else
+				task._graphName = "G" + std::to_string(graphIndex);
+
+			task._numberOfNodes = numberOfNodes;
+			task._edgeChance = (double)edgeChance / 100.0;
+			task._seed = (threadsCount > 0) ? RandomGenerator::DeriveSeed(baseSeed, graphIndex) : -1.0;
+			tasksPoints[i] = point;
+		}
+	}
+
+	ASDProjectParallelTimeTester::Settings settings;
+	settings._classicEngine = classicEngine;
+	settings._iterations = iterations;
+	settings._distribution = distribution;
+	settings._minimumTime = minimumTime;
+	settings._delta = delta;
+	settings._measurementOptions = measurementOptions;
+	settings._measureCpuTime = measureCpuTime;
+	settings._measurePhases = measurePhases;
+	settings._readCounters = readCounters;
+
+	if (threadsCount > 0)
+	{
+		ASDProjectParallelTimeTester parallelTester(threadsCount, pinThreads);
+
+		std::cout << "Measuring " << tasksCount << " graphs with " << threadsCount << " threads";
+		if (parallelTester.GetPinnedCpusCount() > 0)
+			std::cout << " pinned to " << (parallelTester.GetPinnedCpusCount() < threadsCount ? parallelTester.GetPinnedCpusCount() : threadsCount) << " CPUs";
+		std::cout << std::endl;
+
+		if (parallelTester.GetPinnedCpusCount() > 0 && parallelTester.GetPinnedCpusCount() < threadsCount)
+			std::cerr << "There are more threads than CPUs: the threads that share a CPU slow each other down" << std::endl;
+
+		double wallTime0 = ASDProjectTimeTester::GetTime();
+		parallelTester.MeasureGraphs(tasks, tasksCount, settings, measurements, std::cout);
+		double wallTime1 = ASDProjectTimeTester::GetTime();
+
+		std::cout << "The graphs were measured in " << (wallTime1 - wallTime0) << " seconds" << std::endl << std::endl;
+	}
+
+	// The results are merged in the order of the graphs
+	for (int i = 0; i < tasksCount; i++)
 	{
-		std::string graphName = "G" + std::to_string(i);
-		
+		const ASDProjectParallelTimeTester::GraphTask& task = tasks[i];
+		ASDProjectParallelTimeTester::GraphMeasurement& measurement = measurements[i];
+		const std::string& graphName = task._graphName;
+		int point = tasksPoints[i];
+
 		Graph graph;
-		graph.SetName(graphName, false);
+		bool graphPrepared = false;
+
+		if (threadsCount == 0)
+		{
+			measurement._valid = ASDProjectParallelTimeTester::PrepareGraph(task, graph, measurement._seed);
+			graphPrepared = true;
+
+			if (measurement._valid)
+				ASDProjectParallelTimeTester::MeasureGraph(graph, settings, readCounters ? &performanceCounters : nullptr, measurement);
+		}
+
+		if (!measurement._valid)
+			continue;
 
-		if (RandomGraphGenerator::CreateRandomGraph(numberOfNodes, edgeChangePercentage, graph))
+		// A graph measured by a thread is generated again from its seed only if it's needed. Its memory is measured here,
+		// after all the threads have finished, since the allocations of all the threads would be counted together
+		if (!graphPrepared && (saveGeneratedGraphs || saveSolutionGraphs || measureMemory))
 		{
-			if (saveGeneratedGraphs)
-			{
-				std::ofstream outputFile(generatedGraphsFolderPath + graphName + ".dot");
-				if (outputFile.is_open())
-					DotWriter::Write(graph, outputFile);
-				outputFile.close();
-			}
+			double preparedSeed = -1.0;
+			graphPrepared = ASDProjectParallelTimeTester::PrepareGraph(task, graph, preparedSeed);
+		}
+
+		if (saveGeneratedGraphs && graphPrepared)
+			SaveGraph(generatedGraphsFolderPath + graphName, graph, binaryFormat);
 
-			double time = ASDProjectTimeTester::ComputeAlgorithmTime(graph, iterations, distribution, minimumTime, delta);
-			int edges = graph.GetEdges().GetSize();
+		const ASDProjectTimeTester::TimeStatistics& statistics = measurement._statistics;
+		double time = measurement._time;
+		double cpuTime = measurement._cpuTime;
+		int nodes = measurement._nodesCount;
+		int edges = measurement._edgesCount;
 
-			std::cout << "Time for the first graph (" << numberOfNodes << " nodes, " << edges << " edges): " << time << " seconds" << std::endl;
-			totalTime += time;
-			totalEdges += edges;
+		ASDProjectBenchmarkReport::Entry entry;
+		entry._graphName = graphName;
+		entry._nodesCount = nodes;
+		entry._edgesCount = edges;
+		entry._seed = measurement._seed;
+		entry._samplesCount = statistics._samplesCount;
+		entry._repetitionsCount = statistics._repetitionsCount;
+		entry._meanTime = time;
+		entry._standardDeviation = statistics._standardDeviation;
+		entry._confidenceInterval = statistics._confidenceInterval;
+		entry._median = statistics._median;
+		entry._lowPercentile = statistics._lowPercentile;
+		entry._highPercentile = statistics._highPercentile;
+		entry._rejectedSamplesCount = statistics._rejectedSamplesCount;
+		entry._cpuTime = measureCpuTime ? cpuTime : -1.0;
+		entry._peakMemory = ASDProjectTimeTester::GetPeakMemory();
+		entry._hasCounters = measurement._countersRead;
+		entry._hasPhaseTimes = measurePhases;
 
-			if (saveSolutionGraphs)
-			{
-				Graph result;
-				ASDProjectSolver::ProcessData(graph, result);
+		if (measurePhases)
+			entry._phaseTimes = measurement._phaseTimes;
 
-				std::ofstream outputFile(solutionGraphsFolderPath + "out_" + graphName + ".dot");
-				if (outputFile.is_open())
-					DotWriter::Write(result, outputFile);
-				outputFile.close();
-			}
+		for (int counter = 0; measurement._countersRead && counter < ASDProjectPerformanceCounters::PC_Count; counter++)
+			entry._counters[counter] = statistics._counters[counter];
+
+		// The memory is measured on a separate run, since the counters of the allocations slow the solver down
+		if (measureMemory && graphPrepared)
+		{
+			ASDProjectTimeTester::MeasureMemoryUsage(graph, entry._memoryUsage);
+			entry._hasMemoryUsage = true;
 		}
+
+		report.AddEntry(entry);
+
+		std::cout << "Time for the graph " << graphName << " (" << nodes << " nodes, " << edges << " edges): " << time << " seconds";
+		std::cout << " (median " << statistics._median << ", p5-p95 " << statistics._lowPercentile << " - " << statistics._highPercentile << ", " << statistics._samplesCount << " samples";
+		if (statistics._rejectedSamplesCount > 0)
+			std::cout << ", " << statistics._rejectedSamplesCount << " outliers";
+		std::cout << ")";
+		if (measureCpuTime)
+			std::cout << ", CPU time: " << cpuTime << " seconds";
+		std::cout << std::endl;
+
+		if (measurement._countersRead)
+			PrintCounters(statistics._counters, performanceCounters);
+
+		if (measurePhases)
+			PrintPhaseTimes(measurement._phaseTimes, measurement._countersRead ? &performanceCounters : nullptr);
+
+		if (entry._hasMemoryUsage)
+			PrintMemoryUsage(entry._memoryUsage);
+
+		totalTime += time;
+		totalCpuTime += cpuTime;
+		totalNodes += nodes;
+		totalEdges += edges;
+		testedGraphs++;
+
+		if (point >= 0)
+		{
+			pointsNodes[point] += nodes;
+			pointsEdges[point] += edges;
+			pointsTimes[point] += time;
+			pointsGraphs[point]++;
+		}
+
+		if (saveSolutionGraphs && graphPrepared)
+		{
+			Graph result;
+			ASDProjectSolver::ProcessData(graph, result);
+
+			SaveGraph(solutionGraphsFolderPath + "out_" + graphName, result, binaryFormat);
+		}
+	}
+
+	delete[] tasks;
+	delete[] measurements;
+	free(tasksPoints);
+
+	for (int point = 0; point < pointsCount; point++)
+	{
+		if (pointsGraphs[point] > 0)
+		{
+			pointsNodes[point] /= pointsGraphs[point];
+			pointsEdges[point] /= pointsGraphs[point];
+			pointsTimes[point] /= pointsGraphs[point];
+		}
+	}
+
+	if (sweep)
+		PrintScaling(numbersOfNodes, numbersOfNodesCount, edgeChances, edgeChancesCount, pointsNodes, pointsEdges, pointsTimes);
+
+	free(numbersOfNodes);
+	free(edgeChances);
+	free(pointsNodes);
+	free(pointsEdges);
+	free(pointsTimes);
+	free(pointsGraphs);
+
+	if (testedGraphs == 0)
+	{
+		std::cout << "No graph was tested" << std::endl;
+		return -1;
 	}
 
-	std::cout << std::endl << "Average execution time for the algorithm on graphs with " << numberOfNodes << " nodes and an average of " << (totalEdges / numberOfGraphs) << " edges is " << (totalTime / ((double)numberOfGraphs)) << " seconds" << std::endl << std::endl;
+	std::cout << std::endl << "Average execution time for the algorithm on graphs with an average of " << (totalNodes / testedGraphs) << " nodes and " << (totalEdges / testedGraphs) << " edges is " << (totalTime / ((double)testedGraphs)) << " seconds";
+	if (measureCpuTime)
+		std::cout << ", CPU time: " << (totalCpuTime / ((double)testedGraphs)) << " seconds";
+	std::cout << " (timer: " << ASDProjectTimeTester::GetTimerTypeName(timerType) << ", granularity: " << ASDProjectTimeTester::GetGranularity() << " seconds)" << std::endl << std::endl;
+
+	if (!jsonReportPath.empty())
+		report.WriteFile(jsonReportPath, true);
+
+	if (!csvReportPath.empty())
+		report.WriteFile(csvReportPath, false);
+
+	// The exit code tells the scripts that a regression was found
+	if (!baselinePath.empty() && report.CompareWithBaseline(baseline, distribution, regressionThreshold / 100.0, std::cout) > 0)
+		return 1;
 
 	return 0;
 }
@@ -94,45 +382,98 @@ void PrintUsage()
 {
 	std::cout
 		<< "USAGE:" << std::endl
-		<< "time_tester[.exe] -ng NumberOfGraphs -nn NumberOfNodes -ec EdgeChance [-seed Seed] [-delta Delta] [-it Iterations] [-nordist Distribution] [-g GeneratedGraphsFolderPath] [-s SolutionsGraphsFolderPath]" << std::endl << std::endl
+		<< "time_tester[.exe] (-ng NumberOfGraphs -nn NumberOfNodes|Range -ec EdgeChance|Range | -in InputGraphPath [-in InputGraphPath ...]) [-seed Seed] [-delta Delta] [-it Iterations] [-nordist Distribution] [-g GeneratedGraphsFolderPath] [-s SolutionsGraphsFolderPath] [-format dot|binary] [-timer steady|monotonic|clock] [-cputime on|off] [-phases on|off] [-json FilePath] [-csv FilePath] [-baseline CsvFilePath] [-threshold Percentage] [-engine robust|classic] [-warmup Runs] [-maxsamples Samples] [-outliers Threshold] [-counters on|off] [-memory on|off] [-threads Threads] [-pin on|off]" << std::endl << std::endl
 		<< "Parameters:" << std::endl
-		<< "\t-ng: the number of graphs to generate for the test" << std::endl
+		<< "\t-ng: the number of graphs to generate for the test (for every combination of -nn and -ec)" << std::endl
 		<< "\t-nn: the number of nodes for each generated graph" << std::endl
 		<< "\t-ec: the chance of adding an edge, expressed in percentage (in the range [0..100])" << std::endl
+		<< "\t     -nn and -ec accept a range to sweep: First:Last:Step for an arithmetic progression or First:Last:xFactor for a geometric one (e.g. -nn 100:1600:x2)." << std::endl
+		<< "\t     Every combination is tested and the exponents of the power laws that fit the time against the nodes and the edges are written at the end" << std::endl
 		<< "\t-seed: the seed used to generate the random graphs (< 0: use random seed; 0: use default seed; > 0: use given seed)" << std::endl
 		<< "\t-delta: maximum error threshold. When we find a measurement with an error below this number we treat it as valid" << std::endl
-		<< "\t-it: number of times to run the algorithm each time until enough data is collected for each graph" << std::endl
+		<< "\t-it: number of times to run the algorithm each time until enough data is collected for each graph (robust engine: the minimum number of samples)" << std::endl
 		<< "\t-nordist: normal distribution value" << std::endl
 		<< "\t-g: the folder where the generated graphs will be saved" << std::endl
-		<< "\t-s: the folder where the solution graphs will be saved" << std::endl;
+		<< "\t-s: the folder where the solution graphs will be saved" << std::endl
+		<< "\t-in: a DOT or binary graph file to test (can be given more than once). The input graphs are tested before the generated ones" << std::endl
+		<< "\t-format: the format used to save the generated and solution graphs (dot: DOT file with .dot extension; binary: binary graph file with .asdg extension)" << std::endl
+		<< "\t-timer: the clock used to measure the times (steady: std::chrono::steady_clock; monotonic: clock_gettime(CLOCK_MONOTONIC); clock: CPU time of clock(), the old default). Default steady" << std::endl
+		<< "\t-cputime: if on, the CPU time of the process is measured too and written beside the time of the chosen clock. Default off" << std::endl
+		<< "\t-phases: if on, the time of every phase of the solver is written after the time of every graph. The solver must be compiled with ASD_PROFILE_SOLVER (CMake option ASD_PROFILE_SOLVER=ON or make PROFILE=1). Default off" << std::endl
+		<< "\t-json: the file where the results of every graph (nodes, edges, seed, repetitions, mean, confidence interval, peak memory) are saved as JSON" << std::endl
+		<< "\t-csv: the file where the results of every graph are saved as CSV. It can be used as the baseline of a later run" << std::endl
+		<< "\t-baseline: a CSV file saved with -csv. Every graph is compared with the graph of the baseline with the same name, nodes and edges, and the exit code is 1 if one of them is slower" << std::endl
+		<< "\t-threshold: the minimum slowdown, expressed in percentage, of a statistically significant difference to be reported as a regression. Default 5" << std::endl
+		<< "\t-engine: robust calibrates the runs of a sample once after the warmup and rejects the outlier samples; classic recalibrates them for every sample by bisection. Default robust" << std::endl
+		<< "\t-warmup: the number of runs of the solver made before the samples by the robust engine. Default 1" << std::endl
+		<< "\t-maxsamples: the maximum number of samples collected by the robust engine. Default 1000" << std::endl
+		<< "\t-outliers: the robust engine rejects the samples further from the median than this number of median absolute deviations (0: keep all). Default 3.5" << std::endl
+		<< "\t-counters: if on, the hardware performance counters (cycles, instructions, L1 data and last level cache misses, branch misses) are read with perf_event_open around the runs of the solver" << std::endl
+		<< "\t           and inside every phase when -phases is on. Only the robust engine reads them, and the unavailable ones are skipped. Default off" << std::endl
+		<< "\t-memory: if on, the solver is run once more on every graph counting its allocations, and the memory used by the graph and by the result," << std::endl
+		<< "\t         the allocations and the peak resident memory of the run are reported. Default off" << std::endl
+		<< "\t-threads: the number of threads that measure different graphs at the same time (0: the graphs are measured one after the other by the main thread)." << std::endl
+		<< "\t          Every generated graph has its own seed derived from -seed and from its index, so the graphs are the same with any number of threads (but not the same of -threads 0)." << std::endl
+		<< "\t          The CPU time is the one of the thread, the memory is measured after all the threads have finished, and the clock timer can't be used. Default 0" << std::endl
+		<< "\t-pin: if on, every thread of -threads is pinned to its own CPU (Linux only). Default on" << std::endl;
 }
 
 bool ParseArgs(
 	int argc,
 	char *argv[],
 	int& numberOfGraphs,
-	int& numberOfNodes,
-	int& edgeChance,
+	RangeValuesList& numbersOfNodes,
+	RangeValuesList& edgeChances,
 	double& seed,
 	double& delta,
 	int& iterations,
 	double& distribution,
 	std::string& generatedGraphsFolderPath,
-	std::string& solutionGraphsFolderPath)
+	std::string& solutionGraphsFolderPath,
+	bool& binaryFormat,
+	PathsList& inputGraphsPaths,
+	ASDProjectTimeTester::TimerType& timerType,
+	bool& measureCpuTime,
+	bool& measurePhases,
+	std::string& jsonReportPath,
+	std::string& csvReportPath,
+	std::string& baselinePath,
+	double& regressionThreshold,
+	bool& classicEngine,
+	ASDProjectTimeTester::MeasurementOptions& measurementOptions,
+	bool& readCounters,
+	bool& measureMemory,
+	int& threadsCount,
+	bool& pinThreads)
 {
 	// An unsufficient number of arguments were given
-	if (argc < 7)
+	if (argc < 3)
 		return false;
 
 	numberOfGraphs = 1;
-	numberOfNodes = 10;
-	edgeChance = 15;
+	numbersOfNodes.Clear();
+	edgeChances.Clear();
 	seed = 0;
 	delta = 0.2;
 	iterations = 7;
 	distribution = 1.96;
 	generatedGraphsFolderPath = "";
 	solutionGraphsFolderPath = "";
+	binaryFormat = false;
+	inputGraphsPaths.Clear();
+	timerType = ASDProjectTimeTester::TT_SteadyClock;
+	measureCpuTime = false;
+	measurePhases = false;
+	jsonReportPath = "";
+	csvReportPath = "";
+	baselinePath = "";
+	regressionThreshold = 5.0;
+	classicEngine = false;
+	measurementOptions = ASDProjectTimeTester::MeasurementOptions();
+	readCounters = false;
+	measureMemory = false;
+	threadsCount = 0;
+	pinThreads = true;
 
 	bool foundNumberOfGraphs = false;
 	bool foundNumberOfNodes = false;
@@ -159,7 +500,9 @@ bool ParseArgs(
 			if (strValue[0] == '-')
 				return false;
 
-			numberOfNodes = atoi(strValue.c_str());
+			if (!ParseRange(strValue, numbersOfNodes))
+				return false;
+
 			foundNumberOfNodes = true;
 		}
 		else if (strOption == "-ec")
@@ -168,7 +511,9 @@ bool ParseArgs(
 			if (strValue[0] == '-')
 				return false;
 
-			edgeChance = atoi(strValue.c_str());
+			if (!ParseRange(strValue, edgeChances))
+				return false;
+
 			foundEdgeChance = true;
 		}
 		else if (strOption == "-seed")
@@ -195,7 +540,381 @@ bool ParseArgs(
 
 			solutionGraphsFolderPath = strValue;
 		}
+		else if (strOption == "-in")
+		{
+			// If the value starts with a '-' then it is an option
+			if (strValue[0] == '-')
+				return false;
+
+			inputGraphsPaths.Add(strValue);
+		}
+		else if (strOption == "-format")
+		{
+			if (strValue == "binary")
+				binaryFormat = true;
+			else if (strValue != "dot")
+				return false;
+		}
+		else if (strOption == "-timer")
+		{
+			if (strValue == "steady")
+				timerType = ASDProjectTimeTester::TT_SteadyClock;
+			else if (strValue == "monotonic")
+				timerType = ASDProjectTimeTester::TT_Monotonic;
+			else if (strValue == "clock")
+				timerType = ASDProjectTimeTester::TT_Clock;
+			else
+				return false;
+		}
+		else if (strOption == "-cputime")
+		{
+			if (strValue == "on")
+				measureCpuTime = true;
+			else if (strValue != "off")
+				return false;
+		}
+		else if (strOption == "-phases")
+		{
+			if (strValue == "on")
+				measurePhases = true;
+			else if (strValue != "off")
+				return false;
+		}
+		else if (strOption == "-json")
+		{
+			// If the value starts with a '-' then it is an option
+			if (strValue[0] == '-')
+				return false;
+
+			jsonReportPath = strValue;
+		}
+		else if (strOption == "-csv")
+		{
+			// If the value starts with a '-' then it is an option
+			if (strValue[0] == '-')
+				return false;
+
+			csvReportPath = strValue;
+		}
+		else if (strOption == "-baseline")
+		{
+			// If the value starts with a '-' then it is an option
+			if (strValue[0] == '-')
+				return false;
+
+			baselinePath = strValue;
+		}
+		else if (strOption == "-threshold")
+			regressionThreshold = atof(strValue.c_str());
+		else if (strOption == "-engine")
+		{
+			if (strValue == "classic")
+				classicEngine = true;
+			else if (strValue != "robust")
+				return false;
+		}
+		else if (strOption == "-warmup")
+			measurementOptions._warmupRunsCount = atoi(strValue.c_str());
+		else if (strOption == "-maxsamples")
+			measurementOptions._maximumSamplesCount = atoi(strValue.c_str());
+		else if (strOption == "-outliers")
+			measurementOptions._outliersThreshold = atof(strValue.c_str());
+		else if (strOption == "-counters")
+		{
+			if (strValue == "on")
+				readCounters = true;
+			else if (strValue != "off")
+				return false;
+		}
+		else if (strOption == "-memory")
+		{
+			if (strValue == "on")
+				measureMemory = true;
+			else if (strValue != "off")
+				return false;
+		}
+		else if (strOption == "-threads")
+		{
+			// If the value starts with a '-' then it is an option
+			if (strValue[0] == '-')
+				return false;
+
+			threadsCount = atoi(strValue.c_str());
+		}
+		else if (strOption == "-pin")
+		{
+			if (strValue == "off")
+				pinThreads = false;
+			else if (strValue != "on")
+				return false;
+		}
+	}
+
+	// Only the input graphs are tested if none of the options to generate the graphs is given
+	if (inputGraphsPaths.GetSize() > 0 && !foundNumberOfGraphs && !foundNumberOfNodes && !foundEdgeChance)
+	{
+		numberOfGraphs = 0;
+		return true;
 	}
 
 	return foundNumberOfGraphs && foundNumberOfNodes && foundEdgeChance;
+}
+
+/** Saves the graph at the given path adding the extension of the chosen format */
+bool SaveGraph(const std::string& filePathWithoutExtension, const Graph& graph, bool binaryFormat)
+{
+	if (binaryFormat)
+		return BinaryGraphWriter::WriteFile(graph, filePathWithoutExtension + ".asdg");
+
+	std::ofstream outputFile(filePathWithoutExtension + ".dot");
+	bool result = outputFile.is_open() && DotWriter::Write(graph, outputFile);
+	outputFile.close();
+
+	return result;
+}
+
+/** Returns the name of the file at the given path without the folders and the extension */
+std::string GetGraphNameFromPath(const std::string& filePath)
+{
+	size_t nameStart = filePath.find_last_of("/\\");
+	nameStart = (nameStart == std::string::npos) ? 0 : nameStart + 1;
+
+	size_t extensionStart = filePath.find_last_of('.');
+	if (extensionStart == std::string::npos || extensionStart < nameStart)
+		extensionStart = filePath.length();
+
+	return filePath.substr(nameStart, extensionStart - nameStart);
+}
+
+/**
+* Writes the table with the mean, the standard deviation and the share of the total time of every phase of the solver,
+* followed by the available performance counters of every phase if performanceCounters isn't nullptr
+*/
+void PrintPhaseTimes(const ASDProjectTimeTester::PhaseTimes& phaseTimes, const ASDProjectPerformanceCounters* performanceCounters)
+{
+	double totalTime = 0.0;
+
+	for (int phase = 0; phase < ASDProjectSolverProfiler::P_Count; phase++)
+		totalTime += phaseTimes._means[phase];
+
+	std::cout << "\t" << std::left << std::setw(24) << "Phase" << std::setw(16) << "Mean (s)" << std::setw(16) << "Std dev (s)" << std::setw(10) << "Share";
+
+	for (int counter = 0; performanceCounters != nullptr && counter < ASDProjectPerformanceCounters::PC_Count; counter++)
+	{
+		if (performanceCounters->IsAvailable((ASDProjectPerformanceCounters::Counter)counter))
+			std::cout << std::setw(16) << ASDProjectPerformanceCounters::GetCounterName((ASDProjectPerformanceCounters::Counter)counter);
+	}
+
+	std::cout << std::endl;
+
+	for (int phase = 0; phase < ASDProjectSolverProfiler::P_Count; phase++)
+	{
+		double share = (totalTime > 0.0) ? (phaseTimes._means[phase] / totalTime * 100.0) : 0.0;
+
+		// The share is padded as a whole, with its percent sign
+		std::ostringstream shareText;
+		shareText << std::fixed << std::setprecision(1) << share << "%";
+
+		std::cout << "\t" << std::setw(24) << ASDProjectSolverProfiler::GetPhaseName((ASDProjectSolverProfiler::Phase)phase)
+			<< std::setw(16) << phaseTimes._means[phase] << std::setw(16) << phaseTimes._standardDeviations[phase]
+			<< std::setw(10) << shareText.str() << std::fixed;
+
+		for (int counter = 0; performanceCounters != nullptr && counter < ASDProjectPerformanceCounters::PC_Count; counter++)
+		{
+			if (performanceCounters->IsAvailable((ASDProjectPerformanceCounters::Counter)counter))
+				std::cout << std::setprecision(0) << std::setw(16) << phaseTimes._counters[phase][counter];
+		}
+
+		std::cout << std::defaultfloat << std::setprecision(6) << std::endl;
+	}
+
+	std::cout << std::right << std::endl;
+}
+
+/**
+* Parses a single value or a range of values First:Last:Step (arithmetic progression) or First:Last:xFactor (geometric progression, rounded to integers)
+* The step defaults to 1. Returns false if the value isn't valid
+*/
+bool ParseRange(const std::string& value, RangeValuesList& values)
+{
+	values.Clear();
+
+	size_t firstSeparator = value.find(':');
+
+	if (firstSeparator == std::string::npos)
+	{
+		values.Add(atoi(value.c_str()));
+		return true;
+	}
+
+	size_t secondSeparator = value.find(':', firstSeparator + 1);
+
+	int first = atoi(value.substr(0, firstSeparator).c_str());
+	int last = atoi(value.substr(firstSeparator + 1, secondSeparator == std::string::npos ? std::string::npos : secondSeparator - firstSeparator - 1).c_str());
+	std::string step = (secondSeparator == std::string::npos) ? "1" : value.substr(secondSeparator + 1);
+
+	if (first > last || step.empty())
+		return false;
+
+	if (step[0] == 'x' || step[0] == '*')
+	{
+		double factor = atof(step.c_str() + 1);
+
+		if (factor <= 1.0 || first <= 0)
+			return false;
+
+		// Skip the values that round to the previous one
+		int previous = 0;
+
+		for (double current = first; current <= last + 0.5; current *= factor)
+		{
+			int rounded = (int)(current + 0.5);
+
+			if (rounded != previous)
+				values.Add(rounded);
+
+			previous = rounded;
+		}
+	}
+	else
+	{
+		int increment = atoi(step.c_str());
+
+		if (increment <= 0)
+			return false;
+
+		for (int current = first; current <= last; current += increment)
+			values.Add(current);
+	}
+
+	return true;
+}
+
+/** Returns an array, allocated with malloc, with the values of the given list */
+int* GetRangeValues(const RangeValuesList& values)
+{
+	int* result = (int*)malloc(sizeof(int) * (values.GetSize() > 0 ? values.GetSize() : 1));
+
+	RangeValuesList::ConstIterator it = values.Begin();
+	RangeValuesList::ConstIterator end = values.End();
+
+	for (int i = 0; it && it != end; i++, ++it)
+		result[i] = *it;
+
+	return result;
+}
+
+/**
+* Writes the average time of every point of a sweep and the exponents of the power laws that fit the time against the number of nodes
+* for every edge chance, against the number of edges for every number of nodes, and against both over all the points
+*/
+void PrintScaling(const int* numbersOfNodes, int numbersOfNodesCount, const int* edgeChances, int edgeChancesCount, const double* pointsNodes, const double* pointsEdges, const double* pointsTimes)
+{
+	int pointsCount = numbersOfNodesCount * edgeChancesCount;
+
+	std::cout << std::endl << "Sweep results:" << std::endl;
+	std::cout << "\t" << std::left << std::setw(12) << "Nodes" << std::setw(16) << "Edge chance" << std::setw(16) << "Avg edges" << "Avg time (s)" << std::endl;
+
+	for (int point = 0; point < pointsCount; point++)
+	{
+		std::cout << "\t" << std::setw(12) << numbersOfNodes[point / edgeChancesCount] << std::setw(16) << (std::to_string(edgeChances[point % edgeChancesCount]) + "%")
+			<< std::setw(16) << pointsEdges[point] << pointsTimes[point] << std::endl;
+	}
+
+	std::cout << std::right << std::endl << "Empirical complexity (least squares fit of log(time)):" << std::endl;
+
+	// The points of a row or of a column of the sweep, with the time of every point
+	double* x = (double*)malloc(sizeof(double) * pointsCount);
+	double* y = (double*)malloc(sizeof(double) * pointsCount);
+	double exponent = 0.0;
+	double exponent2 = 0.0;
+	double rSquared = 0.0;
+
+	std::cout << std::fixed << std::setprecision(2);
+
+	// Time against the nodes with the same edge chance
+	for (int column = 0; column < edgeChancesCount && numbersOfNodesCount > 1; column++)
+	{
+		for (int row = 0; row < numbersOfNodesCount; row++)
+		{
+			x[row] = pointsNodes[row * edgeChancesCount + column];
+			y[row] = pointsTimes[row * edgeChancesCount + column];
+		}
+
+		if (ASDProjectTimeTester::FitPowerLaw(x, y, numbersOfNodesCount, exponent, rSquared))
+			std::cout << "\tedge chance " << edgeChances[column] << "%: time ~ N^" << exponent << " (R^2 " << rSquared << ")" << std::endl;
+	}
+
+	// Time against the edges with the same number of nodes
+	for (int row = 0; row < numbersOfNodesCount && edgeChancesCount > 1; row++)
+	{
+		if (ASDProjectTimeTester::FitPowerLaw(pointsEdges + row * edgeChancesCount, pointsTimes + row * edgeChancesCount, edgeChancesCount, exponent, rSquared))
+			std::cout << "\t" << numbersOfNodes[row] << " nodes: time ~ E^" << exponent << " (R^2 " << rSquared << ")" << std::endl;
+	}
+
+	// Time against the edges and against both over all the points
+	if (ASDProjectTimeTester::FitPowerLaw(pointsEdges, pointsTimes, pointsCount, exponent, rSquared))
+		std::cout << "\tall points: time ~ E^" << exponent << " (R^2 " << rSquared << ")" << std::endl;
+
+	if (ASDProjectTimeTester::FitPowerLaw(pointsNodes, pointsEdges, pointsTimes, pointsCount, exponent, exponent2, rSquared))
+		std::cout << "\tall points: time ~ N^" << exponent << " * E^" << exponent2 << " (R^2 " << rSquared << ")" << std::endl;
+
+	std::cout << std::defaultfloat << std::setprecision(6);
+
+	free(x);
+	free(y);
+}
+
+/** Writes the mean of the available performance counters on one run of the solver, with the instructions per cycle and the misses per thousand instructions */
+void PrintCounters(const double* counters, const ASDProjectPerformanceCounters& performanceCounters)
+{
+	bool hasInstructions = performanceCounters.IsAvailable(ASDProjectPerformanceCounters::PC_Instructions) && counters[ASDProjectPerformanceCounters::PC_Instructions] > 0.0;
+	double instructions = counters[ASDProjectPerformanceCounters::PC_Instructions];
+
+	std::cout << "\tCounters per run:" << std::fixed << std::setprecision(0);
+
+	for (int counter = 0, printed = 0; counter < ASDProjectPerformanceCounters::PC_Count; counter++)
+	{
+		if (!performanceCounters.IsAvailable((ASDProjectPerformanceCounters::Counter)counter))
+			continue;
+
+		std::cout << (printed++ > 0 ? ", " : " ") << ASDProjectPerformanceCounters::GetCounterName((ASDProjectPerformanceCounters::Counter)counter) << " " << counters[counter];
+
+		if (counter == ASDProjectPerformanceCounters::PC_Instructions && performanceCounters.IsAvailable(ASDProjectPerformanceCounters::PC_Cycles) && counters[ASDProjectPerformanceCounters::PC_Cycles] > 0.0)
+			std::cout << std::setprecision(2) << " (IPC " << (instructions / counters[ASDProjectPerformanceCounters::PC_Cycles]) << ")" << std::setprecision(0);
+		else if (counter != ASDProjectPerformanceCounters::PC_Cycles && counter != ASDProjectPerformanceCounters::PC_Instructions && hasInstructions)
+			std::cout << std::setprecision(2) << " (" << (counters[counter] / instructions * 1000.0) << " per 1000 instructions)" << std::setprecision(0);
+	}
+
+	std::cout << std::defaultfloat << std::setprecision(6) << std::endl;
+}
+
+/**
+* Writes the memory used by one run of the solver: the breakdown of the memory of the input graph and of the result,
+* the allocations of every category and the peak resident memory
+*/
+void PrintMemoryUsage(const ASDProjectTimeTester::MemoryUsage& usage)
+{
+	const Graph::MemoryFootprint* footprints[2] = { &usage._inputFootprint, &usage._resultFootprint };
+	const char* footprintsNames[2] = { "Graph", "Result" };
+
+	for (int i = 0; i < 2; i++)
+	{
+		const Graph::MemoryFootprint& footprint = *footprints[i];
+
+		std::cout << "\t" << footprintsNames[i] << " memory: " << footprint.GetTotal() << " bytes (nodes " << footprint._nodesBytes << ", edges " << footprint._edgesBytes
+			<< ", adjacency " << footprint._adjacencyBytes << ", attributes " << footprint._attributesBytes << ", free list slack " << footprint._freeListSlackBytes << ")" << std::endl;
+	}
+
+	std::cout << "\tAllocations per run:";
+
+	for (int category = 0; category < MemoryAccounting::MC_Count; category++)
+	{
+		const MemoryAccounting::Counters& counters = usage._counters[category];
+
+		std::cout << (category > 0 ? ", " : " ") << MemoryAccounting::GetCategoryName((MemoryAccounting::Category)category) << " " << counters._allocationsCount
+			<< " (" << counters._allocatedBytes << " bytes, peak " << counters._peakBytes << ")";
+	}
+
+	std::cout << std::endl << "\tPeak resident memory" << (usage._peakResidentOfRun ? " of the run: " : " of the process: ") << usage._peakResidentBytes << " bytes" << std::endl;
 }
\ No newline at end of file